@@ -44,6 +44,7 @@ void export_Analyzer(py::module& m)
     py::class_<Analyzer, std::shared_ptr<Analyzer>>(m,"Analyzer")
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("analyze", &Analyzer::analyze)
+        .def("flush", &Analyzer::flush)
         .def("setProfiler", &Analyzer::setProfiler)
         ;
     }
@@ -92,6 +92,13 @@ class PYBIND11_EXPORT Analyzer
         */
         virtual void resetStats(){}
 
+        //! Complete any pending output
+        /*! Derived classes that defer work past the return of analyze() (e.g. to a background thread) must finish it
+            in flush(). System calls flush() on all analyzers at the end of every run() and when the run is
+            interrupted.
+        */
+        virtual void flush(){}
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
@@ -89,11 +89,13 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
 /*! \param exec_conf Execution configuration
     \param pdata The particle data to associate with
     \param snapshot Snapshot to initialize from
+    \param distributed True if every rank holds a contiguous range of tags of the snapshot
  */
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
-    const Snapshot& snapshot)
+    const Snapshot& snapshot,
+    bool distributed)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0), m_groups_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
@@ -111,7 +113,12 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     #endif
 
     // initialize from snapshot
-    initializeFromSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    if (distributed && m_pdata->getDomainDecomposition())
+        initializeFromDistributedSnapshot(snapshot);
+    else
+    #endif
+        initializeFromSnapshot(snapshot);
 
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -303,6 +310,355 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+#ifdef ENABLE_MPI
+//! Initialize from a distributed snapshot
+/*! \param snapshot The part of the groups held by this rank
+
+    Every rank holds a contiguous range of groups, ordered by rank. The ranks look up the owners of the member
+    particles with a collective query and send every group to each rank that owns one of its members. This avoids
+    broadcasting all groups to all ranks.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromDistributedSnapshot(
+    const Snapshot& snapshot)
+    {
+    // check that all fields in the snapshot have correct length
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid " << name << " data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+        }
+
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+
+    // the local groups follow those of the lower ranks
+    unsigned int n_local = snapshot.groups.size();
+    unsigned int first_tag = 0;
+    MPI_Exscan(&n_local, &first_tag, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    if (m_exec_conf->getRank() == 0)
+        first_tag = 0;
+
+    unsigned int nglobal = 0;
+    MPI_Allreduce(&n_local, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+
+    if (nglobal == 0)
+        return;
+
+    // look up the owners of all member particles
+    std::vector<unsigned int> member_tags(n_local*group_size);
+    for (unsigned int group_idx = 0; group_idx < n_local; ++group_idx)
+        for (unsigned int i = 0; i < group_size; ++i)
+            member_tags[group_idx*group_size + i] = snapshot.groups[group_idx].tag[i];
+
+    std::vector<unsigned int> owners;
+    m_pdata->getOwnerRanks(member_tags, owners);
+
+    // send every group once to each rank that owns one of its members
+    std::vector< std::vector<packed_t> > send(size);
+    for (unsigned int group_idx = 0; group_idx < n_local; ++group_idx)
+        {
+        packed_t p;
+        p.tags = snapshot.groups[group_idx];
+        p.group_tag = first_tag + group_idx;
+        if (has_type_mapping)
+            {
+            p.typeval.type = snapshot.type_id[group_idx];
+            if (p.typeval.type >= m_type_mapping.size())
+                {
+                m_exec_conf->msg->error() << name << ".*: Invalid " << name << " type " << p.typeval.type
+                    << "! The number of types is " << m_type_mapping.size() << std::endl;
+                throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+                }
+            }
+        else
+            {
+            p.typeval.val = snapshot.val[group_idx];
+            }
+
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            p.ranks.idx[i] = owners[group_idx*group_size + i];
+            if (p.ranks.idx[i] == NOT_LOCAL)
+                {
+                m_exec_conf->msg->error() << name << ".*: Particle " << p.tags.tag[i] << " in " << name << " "
+                    << p.group_tag << " does not exist" << std::endl;
+                throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+                }
+            }
+
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            bool sent = false;
+            for (unsigned int j = 0; j < i; ++j)
+                if (p.ranks.idx[j] == p.ranks.idx[i])
+                    sent = true;
+
+            if (!sent)
+                send[p.ranks.idx[i]].push_back(p);
+            }
+        }
+
+    std::vector< std::vector<packed_t> > recv;
+    alltoall_v(send, recv, mpi_comm);
+    send.clear();
+
+    unsigned int n_recv = 0;
+    for (unsigned int i = 0; i < size; ++i)
+        n_recv += recv[i].size();
+
+    m_groups.resize(n_recv);
+    m_group_typeval.resize(n_recv);
+    m_group_tag.resize(n_recv);
+    m_group_ranks.resize(n_recv);
+    m_group_rtag.resize(nglobal);
+
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < nglobal; ++tag)
+            h_group_rtag.data[tag] = GROUP_NOT_LOCAL;
+
+        unsigned int n = 0;
+        for (unsigned int i = 0; i < size; ++i)
+            for (unsigned int j = 0; j < recv[i].size(); ++j)
+                {
+                const packed_t& p = recv[i][j];
+                h_groups.data[n] = p.tags;
+                h_typeval.data[n] = p.typeval;
+                h_group_tag.data[n] = p.group_tag;
+                h_group_ranks.data[n] = p.ranks;
+                h_group_rtag.data[p.group_tag] = n;
+                n++;
+                }
+        }
+
+    m_n_groups = n_recv;
+    m_nglobal = nglobal;
+
+    for (unsigned int tag = 0; tag < nglobal; ++tag)
+        m_tag_set.insert(tag);
+    m_invalid_cached_tags = true;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+#endif
+
+//! Restore the groups from a checkpoint
+/*! \param groups Groups read from the checkpoint by this rank (consumed)
+    \param type_mapping Names of the group types
+    \param n_tags One more than the largest active group tag (0 if there are no groups)
+    \param free_tags Tags below \a n_tags that are not in use
+    \param redistribute If true, send every group to the ranks that own its members
+
+    The group tags of the checkpoint are preserved. A group may have been stored by several ranks, so the copies
+    are merged by tag. Without redistribution, the groups and their member ranks must match the particles already
+    restored on this rank. This call is collective when \a redistribute is true.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::restoreFromCheckpoint(
+    std::vector<packed_t>& groups,
+    const std::vector<std::string>& type_mapping,
+    unsigned int n_tags,
+    const std::vector<unsigned int>& free_tags,
+    bool redistribute)
+    {
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = type_mapping;
+
+    if (redistribute)
+        {
+        // keep one copy of every group
+        std::set<unsigned int> seen;
+        std::vector<packed_t> unique_groups;
+        for (unsigned int group_idx = 0; group_idx < groups.size(); ++group_idx)
+            if (seen.insert(groups[group_idx].group_tag).second)
+                unique_groups.push_back(groups[group_idx]);
+        groups.swap(unique_groups);
+        }
+
+    #ifdef ENABLE_MPI
+    if (redistribute && m_pdata->getDomainDecomposition())
+        {
+        unsigned int size = m_exec_conf->getNRanks();
+        std::vector<packed_t> unique_groups;
+        unique_groups.swap(groups);
+
+        // look up the new owners of all member particles
+        unsigned int n_unique = unique_groups.size();
+        std::vector<unsigned int> member_tags(n_unique*group_size);
+        for (unsigned int group_idx = 0; group_idx < n_unique; ++group_idx)
+            for (unsigned int i = 0; i < group_size; ++i)
+                member_tags[group_idx*group_size + i] = unique_groups[group_idx].tags.tag[i];
+
+        std::vector<unsigned int> owners;
+        m_pdata->getOwnerRanks(member_tags, owners);
+
+        // send every group once to each rank that owns one of its members
+        std::vector< std::vector<packed_t> > send(size);
+        for (unsigned int group_idx = 0; group_idx < n_unique; ++group_idx)
+            {
+            packed_t& p = unique_groups[group_idx];
+            for (unsigned int i = 0; i < group_size; ++i)
+                {
+                p.ranks.idx[i] = owners[group_idx*group_size + i];
+                if (p.ranks.idx[i] == NOT_LOCAL)
+                    {
+                    m_exec_conf->msg->error() << name << ".*: Particle " << p.tags.tag[i] << " in " << name << " "
+                        << p.group_tag << " does not exist" << std::endl;
+                    throw std::runtime_error(std::string("Error initializing ") + name + std::string(" data."));
+                    }
+                }
+
+            for (unsigned int i = 0; i < group_size; ++i)
+                {
+                bool sent = false;
+                for (unsigned int j = 0; j < i; ++j)
+                    if (p.ranks.idx[j] == p.ranks.idx[i])
+                        sent = true;
+
+                if (!sent)
+                    send[p.ranks.idx[i]].push_back(p);
+                }
+            }
+        unique_groups.clear();
+
+        std::vector< std::vector<packed_t> > recv;
+        alltoall_v(send, recv, m_exec_conf->getMPICommunicator());
+        send.clear();
+
+        // several ranks may have read the same group
+        std::set<unsigned int> seen;
+        for (unsigned int i = 0; i < size; ++i)
+            for (unsigned int j = 0; j < recv[i].size(); ++j)
+                if (seen.insert(recv[i][j].group_tag).second)
+                    groups.push_back(recv[i][j]);
+        }
+    #endif
+
+    unsigned int n_local = groups.size();
+
+    m_groups.resize(n_local);
+    m_group_typeval.resize(n_local);
+    m_group_tag.resize(n_local);
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        m_group_ranks.resize(n_local);
+    #endif
+    m_group_rtag.resize(n_tags);
+
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < n_tags; ++tag)
+            h_group_rtag.data[tag] = GROUP_NOT_LOCAL;
+
+        for (unsigned int group_idx = 0; group_idx < n_local; ++group_idx)
+            {
+            const packed_t& p = groups[group_idx];
+            h_groups.data[group_idx] = p.tags;
+            h_typeval.data[group_idx] = p.typeval;
+            h_group_tag.data[group_idx] = p.group_tag;
+            h_group_rtag.data[p.group_tag] = group_idx;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::overwrite);
+        for (unsigned int group_idx = 0; group_idx < n_local; ++group_idx)
+            h_group_ranks.data[group_idx] = groups[group_idx].ranks;
+        }
+    #endif
+    groups.clear();
+
+    m_n_groups = n_local;
+    m_nglobal = n_tags - free_tags.size();
+
+    // rebuild the set of active tags, keeping the unused ones for reuse
+    std::vector<bool> is_free(n_tags, false);
+    for (std::vector<unsigned int>::const_iterator it = free_tags.begin(); it != free_tags.end(); ++it)
+        {
+        assert(*it < n_tags);
+        is_free[*it] = true;
+        m_recycled_tags.push(*it);
+        }
+
+    for (unsigned int tag = 0; tag < n_tags; ++tag)
+        if (! is_free[tag])
+            m_tag_set.insert(tag);
+    m_invalid_cached_tags = true;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+
+/*! \param groups Buffer to pack the local groups into
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::getCheckpointGroups(
+    std::vector<packed_t>& groups) const
+    {
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::read);
+
+    groups.resize(m_n_groups);
+    for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+        {
+        packed_t& p = groups[group_idx];
+        p.tags = h_groups.data[group_idx];
+        p.typeval = h_typeval.data[group_idx];
+        p.group_tag = h_group_tag.data[group_idx];
+        for (unsigned int i = 0; i < group_size; ++i)
+            p.ranks.idx[i] = 0;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::read);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            groups[group_idx].ranks = h_group_ranks.data[group_idx];
+        }
+    #endif
+    }
+
+/*! \returns the tags below the maximum active tag that are not in use
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+std::vector<unsigned int> BondedGroupData<group_size, Group, name, has_type_mapping>::getFreeTags() const
+    {
+    std::vector<unsigned int> free_tags;
+    unsigned int next = 0;
+    for (std::set<unsigned int>::const_iterator it = m_tag_set.begin(); it != m_tag_set.end(); ++it)
+        {
+        for (; next < *it; ++next)
+            free_tags.push_back(next);
+        next = *it + 1;
+        }
+    return free_tags;
+    }
+
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
@@ -63,8 +63,7 @@ union typeval_union
 
 typedef typeval_union typeval_t;
 
-#ifdef ENABLE_MPI
-//! Packed group entry for communication
+//! Packed group entry for communication and checkpoints
 template<unsigned int group_size>
 struct packed_storage
     {
@@ -73,7 +72,6 @@ struct packed_storage
     unsigned int group_tag;          //!< Tag of this group
     group_storage<group_size> ranks; //!< Current list of member ranks
     };
-#endif
 
 #ifdef ENABLE_MPI
 namespace cereal
@@ -137,9 +135,11 @@ class BondedGroupData
         #ifdef ENABLE_MPI
         //! Type for storing per-member ranks
         typedef members_t ranks_t;
-        typedef packed_storage<group_size> packed_t;
         #endif
 
+        //! Type for storing a group with its tag
+        typedef packed_storage<group_size> packed_t;
+
         //! Handy structure for passing around and initializing the group data
         /*!
          * Bonds in a snapshot are stored with reference to (non-contiguous) particle tags.
@@ -239,13 +239,32 @@ class BondedGroupData
 
         //! Constructor to initialize from a snapshot
         BondedGroupData(std::shared_ptr<ParticleData> pdata,
-            const Snapshot& snapshot);
+            const Snapshot& snapshot,
+            bool distributed=false);
 
         virtual ~BondedGroupData();
 
         //! Initialize from a snapshot
         virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from a snapshot of which every rank holds a contiguous range of tags
+        void initializeFromDistributedSnapshot(const Snapshot& snapshot);
+        #endif
+
+        //! Restore the groups from a checkpoint
+        void restoreFromCheckpoint(std::vector<packed_t>& groups,
+            const std::vector<std::string>& type_mapping,
+            unsigned int n_tags,
+            const std::vector<unsigned int>& free_tags,
+            bool redistribute);
+
+        //! Get the local groups for a checkpoint
+        void getCheckpointGroups(std::vector<packed_t>& groups) const;
+
+        //! Get the tags below the maximum tag that are not in use
+        std::vector<unsigned int> getFreeTags() const;
+
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -297,6 +316,12 @@ class BondedGroupData
             return m_type_mapping.size();
             }
 
+        //! Get the names of all group types
+        const std::vector<std::string>& getTypeMapping() const
+            {
+            return m_type_mapping;
+            }
+
         //! Return name of this template
         static std::string getName()
             {
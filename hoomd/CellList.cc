@@ -29,6 +29,8 @@ CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     // allocation is deferred until the first compute() call - initialize values to dummy variables
     m_dim = make_uint3(0,0,0);
     m_Nmax = 0;
+    m_n_compact = 0;
+    m_compact = false;
     m_params_changed = true;
     m_particles_sorted = false;
     m_box_changed = false;
@@ -57,6 +59,20 @@ CellList::~CellList()
     m_pdata->getBoxChangeSignal().disconnect<CellList, &CellList::slotBoxChanged>(this);
     }
 
+/*! \param compact true to store the members of all cells back to back
+*/
+void CellList::setCompact(bool compact)
+    {
+    if (compact && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "The compact cell list is not supported on the GPU" << endl;
+        throw runtime_error("Error setting cell list parameters");
+        }
+
+    m_compact = compact;
+    m_params_changed = true;
+    }
+
 //! Round down to the nearest multiple
 /*! \param v Value to round
     \param m Multiple
@@ -289,18 +305,41 @@ void CellList::initializeMemory()
             m_Nmax = 1;
         }
 
-    m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y << " x " << m_dim.z
-                                << " x " << m_Nmax << endl;
+    // the compact cell list needs one entry per particle, with some room for a growing number of ghosts
+    unsigned int n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    if (m_compact && m_n_compact < n_tot_particles)
+        m_n_compact = n_tot_particles + n_tot_particles/8 + 1;
 
     // initialize indexers
     m_cell_indexer = Index3D(m_dim.x, m_dim.y, m_dim.z);
     m_cell_list_indexer = Index2D(m_Nmax, m_cell_indexer.getNumElements());
 
+    unsigned int n_entries = m_compact ? m_n_compact : m_cell_list_indexer.getNumElements();
+
+    if (m_compact)
+        m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y << " x " << m_dim.z
+                                    << " cells with " << m_n_compact << " entries" << endl;
+    else
+        m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y << " x " << m_dim.z
+                                    << " x " << m_Nmax << endl;
+
     // allocate memory
     GlobalArray<unsigned int> cell_size(m_cell_indexer.getNumElements(), m_exec_conf);
     m_cell_size.swap(cell_size);
     TAG_ALLOCATION(m_cell_size);
 
+    GlobalArray<unsigned int> cell_start(m_cell_indexer.getNumElements()+1, m_exec_conf);
+    m_cell_start.swap(cell_start);
+    TAG_ALLOCATION(m_cell_start);
+
+    if (!m_compact)
+        {
+        // the padded layout starts every cell at a fixed offset
+        ArrayHandle<unsigned int> h_cell_start(m_cell_start, access_location::host, access_mode::overwrite);
+        for (unsigned int cur_cell = 0; cur_cell <= m_cell_indexer.getNumElements(); cur_cell++)
+            h_cell_start.data[cur_cell] = cur_cell*m_Nmax;
+        }
+
     if (m_compute_adj_list)
         {
         // if we have less than radius*2+1 cells in a direction, restrict to unique neighbors
@@ -332,7 +371,7 @@ void CellList::initializeMemory()
 
     if (m_compute_xyzf)
         {
-        GlobalArray<Scalar4> xyzf(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<Scalar4> xyzf(n_entries, m_exec_conf);
         m_xyzf.swap(xyzf);
         TAG_ALLOCATION(m_xyzf);
         }
@@ -344,7 +383,7 @@ void CellList::initializeMemory()
 
     if (m_compute_tdb)
         {
-        GlobalArray<Scalar4> tdb(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<Scalar4> tdb(n_entries, m_exec_conf);
         m_tdb.swap(tdb);
         TAG_ALLOCATION(m_tdb);
         }
@@ -357,7 +396,7 @@ void CellList::initializeMemory()
 
     if (m_compute_orientation)
         {
-        GlobalArray<Scalar4> orientation(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<Scalar4> orientation(n_entries, m_exec_conf);
         m_orientation.swap(orientation);
         TAG_ALLOCATION(m_orientation);
         }
@@ -370,7 +409,7 @@ void CellList::initializeMemory()
 
     if (m_compute_idx || m_sort_cell_list)
         {
-        GlobalArray<unsigned int> idx(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<unsigned int> idx(n_entries, m_exec_conf);
         m_idx.swap(idx);
         TAG_ALLOCATION(m_idx);
         }
@@ -454,8 +493,72 @@ void CellList::initializeCellAdj()
         m_prof->pop();
     }
 
+/*! \param postype Position and type of the particle
+    \param n Index of the particle
+    \param box Local box
+    \param conditions Condition flags to set on errors
+    \returns The index of the cell of the particle, or 0xffffffff if the particle is not put into any cell
+*/
+inline unsigned int CellList::findCell(const Scalar4& postype, unsigned int n, const BoxDim& box, uint3& conditions) const
+    {
+    Scalar3 p = make_scalar3(postype.x, postype.y, postype.z);
+    if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+        {
+        conditions.y = n+1;
+        return 0xffffffff;
+        }
+
+    // find the bin each particle belongs in
+    Scalar3 f = box.makeFraction(p,m_ghost_width);
+    int ib = (int)(f.x * m_dim.x);
+    int jb = (int)(f.y * m_dim.y);
+    int kb = (int)(f.z * m_dim.z);
+
+    // check if the particle is inside the unit cell + ghost layer in all dimensions
+    if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
+        (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
+        (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
+        {
+        // if a ghost particle is out of bounds, silently ignore it
+        if (n < m_pdata->getN())
+            conditions.z = n+1;
+        return 0xffffffff;
+        }
+
+    // need to handle the case where the particle is exactly at the box hi
+    uchar3 periodic = box.getPeriodic();
+    if (ib == (int)m_dim.x && periodic.x)
+        ib = 0;
+    if (jb == (int)m_dim.y && periodic.y)
+        jb = 0;
+    if (kb == (int)m_dim.z && periodic.z)
+        kb = 0;
+
+    // sanity check
+    assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
+
+    // all particles should be in a valid cell
+    if (ib < 0 || ib >= (int)m_dim.x ||
+        jb < 0 || jb >= (int)m_dim.y ||
+        kb < 0 || kb >= (int)m_dim.z)
+        {
+        // but ghost particles that are out of range should not produce an error
+        if (n < m_pdata->getN())
+            conditions.z = n+1;
+        return 0xffffffff;
+        }
+
+    return m_cell_indexer(ib, jb, kb);
+    }
+
 void CellList::computeCellList()
     {
+    if (m_compact)
+        {
+        computeCellListCompact();
+        return;
+        }
+
     if (m_prof)
         m_prof->push("compute");
 
@@ -475,72 +578,21 @@ void CellList::computeCellList()
     ArrayHandle<Scalar4> h_tdb(m_tdb, access_location::host, access_mode::overwrite);
     uint3 conditions = make_uint3(0,0,0);
 
-    // shorthand copies of the indexers
-    Index3D ci = m_cell_indexer;
+    // shorthand copy of the indexer
     Index2D cli = m_cell_list_indexer;
 
     // clear the bin sizes to 0
     memset(h_cell_size.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
 
-    Scalar3 ghost_width = getGhostWidth();
-
-    // get periodic flags
-    uchar3 periodic = box.getPeriodic();
-
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
     for (unsigned int n = 0; n < n_tot_particles; n++)
         {
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
-            {
-            conditions.y = n+1;
-            continue;
-            }
-
-
-        // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(p,ghost_width);
-        int ib = (int)(f.x * m_dim.x);
-        int jb = (int)(f.y * m_dim.y);
-        int kb = (int)(f.z * m_dim.z);
-
-        // check if the particle is inside the unit cell + ghost layer in all dimensions
-        if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
-            (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
-            (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
-            {
-            // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
-            }
-
-        // need to handle the case where the particle is exactly at the box hi
-        if (ib == (int)m_dim.x && periodic.x)
-            ib = 0;
-        if (jb == (int)m_dim.y && periodic.y)
-            jb = 0;
-        if (kb == (int)m_dim.z && periodic.z)
-            kb = 0;
-
-        // sanity check
-        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
-
         // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
-        // all particles should be in a valid cell
-        if (ib < 0 || ib >= (int)m_dim.x ||
-            jb < 0 || jb >= (int)m_dim.y ||
-            kb < 0 || kb >= (int)m_dim.z)
-            {
-            // but ghost particles that are out of range should not produce an error
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
+        unsigned int bin = findCell(h_pos.data[n], n, box, conditions);
+        if (bin == 0xffffffff)
             continue;
-            }
 
         // setup the flag value to store
         Scalar flag;
@@ -598,6 +650,123 @@ void CellList::computeCellList()
         m_prof->pop();
     }
 
+/*! The members of every cell are counted first, and then written to the entries from the prefix sum of the cell
+    sizes in the order of the particle index.
+*/
+void CellList::computeCellListCompact()
+    {
+    if (m_prof)
+        m_prof->push("compute");
+
+    // acquire the particle data
+    ArrayHandle< Scalar4 > h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+
+    uint3 conditions = make_uint3(0,0,0);
+    unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // reallocate if the number of particles and ghosts has grown
+    if (n_tot_particles > m_n_compact)
+        {
+        conditions.x = n_tot_particles;
+
+        ArrayHandle<uint3> h_conditions(m_conditions, access_location::host, access_mode::overwrite);
+        *h_conditions.data = conditions;
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_size(m_cell_size, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_start(m_cell_start, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_cell_orientation(m_orientation, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_tdb(m_tdb, access_location::host, access_mode::overwrite);
+
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+
+    // count the members of every cell
+    memset(h_cell_size.data, 0, sizeof(unsigned int) * n_cells);
+    m_particle_cell.resize(n_tot_particles);
+
+    for (unsigned int n = 0; n < n_tot_particles; n++)
+        {
+        unsigned int bin = findCell(h_pos.data[n], n, box, conditions);
+        m_particle_cell[n] = bin;
+        if (bin != 0xffffffff)
+            h_cell_size.data[bin]++;
+        }
+
+    // the cells start at the prefix sum of the cell sizes
+    m_cell_fill.resize(n_cells);
+    unsigned int n_max = 0;
+    h_cell_start.data[0] = 0;
+    for (unsigned int cur_cell = 0; cur_cell < n_cells; cur_cell++)
+        {
+        m_cell_fill[cur_cell] = h_cell_start.data[cur_cell];
+        h_cell_start.data[cur_cell+1] = h_cell_start.data[cur_cell] + h_cell_size.data[cur_cell];
+        n_max = max(n_max, h_cell_size.data[cur_cell]);
+        }
+    m_Nmax = n_max;
+
+    // write the members
+    for (unsigned int n = 0; n < n_tot_particles; n++)
+        {
+        unsigned int bin = m_particle_cell[n];
+        if (bin == 0xffffffff)
+            continue;
+
+        unsigned int entry = m_cell_fill[bin]++;
+
+        if (m_compute_xyzf)
+            {
+            Scalar flag;
+            if (m_flag_charge)
+                flag = h_charge.data[n];
+            else if (m_flag_type)
+                flag = h_pos.data[n].w;
+            else
+                flag = __int_as_scalar(n);
+
+            h_xyzf.data[entry] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
+            }
+
+        if (m_compute_tdb)
+            {
+            h_tdb.data[entry] = make_scalar4(h_pos.data[n].w,
+                                             h_diameter.data[n],
+                                             __int_as_scalar(h_body.data[n]),
+                                             Scalar(0.0));
+            }
+
+        if (m_compute_orientation)
+            {
+            h_cell_orientation.data[entry] = h_orientation.data[n];
+            }
+
+        if (m_compute_idx)
+            {
+            h_cell_idx.data[entry] = n;
+            }
+        }
+
+        {
+        // write out conditions
+        ArrayHandle<uint3> h_conditions(m_conditions, access_location::host, access_mode::overwrite);
+        *h_conditions.data = conditions;
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 bool CellList::checkConditions()
     {
     bool result = false;
@@ -605,8 +774,17 @@ bool CellList::checkConditions()
     uint3 conditions;
     conditions = readConditions();
 
+    // the compact cell list overflows when the number of particles grows
+    if (m_compact)
+        {
+        if (conditions.x > m_n_compact)
+            {
+            m_n_compact = conditions.x + conditions.x/8 + 1;
+            result = true;
+            }
+        }
     // up m_Nmax to the overflow value, reallocate memory and set the overflow condition
-    if (conditions.x > m_Nmax)
+    else if (conditions.x > m_Nmax)
         {
         m_Nmax = conditions.x;
         result = true;
@@ -709,6 +887,8 @@ void export_CellList(py::module& m)
         .def("setFlagCharge", &CellList::setFlagCharge)
         .def("setFlagIndex", &CellList::setFlagIndex)
         .def("setSortCellList", &CellList::setSortCellList)
+        .def("setCompact", &CellList::setCompact)
+        .def("getCompact", &CellList::getCompact)
         .def("getDim", &CellList::getDim, py::return_value_policy::reference_internal)
         .def("getNmax", &CellList::getNmax)
         .def("benchmark", &CellList::benchmark)
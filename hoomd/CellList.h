@@ -11,6 +11,7 @@
 #include "Compute.h"
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file CellList.h
@@ -75,6 +76,16 @@
      - <code>cell_adj[cell_adj_indexer(offset,cidx)]</code> is the cell index for neighboring cell \c offset to \c cidx.
        \c offset can vary from 0 to (radius*2+1)^3-1 (typically 26 with radius 1)
 
+    <b>Compact storage:</b>
+
+    With setCompact(), the members of all cells are stored back to back instead of in Nmax slots per cell, so that
+    a few dense cells in an otherwise dilute system do not inflate the memory of every cell. The cell list is then
+    built with a counting sort, and the members of a cell are ordered by particle index. Consumers should not use
+    getCellListIndexer(), but find the first member of cell \c cidx at <code>cell_start[cidx]</code> from
+    getCellStartArray(). \c cell_start is also filled with <code>cell_list_indexer(0,cidx)</code> in the padded
+    layout, so that code written for the compact layout works with both. Compact storage is only available on the
+    CPU.
+
     <b>Parameters:</b>
      - \c width - minimum width of a cell in any x,y,z direction
      - \c radius - integer radius of cells to generate in \c cell_adj (1,2,3,4,...)
@@ -207,6 +218,9 @@ class PYBIND11_EXPORT CellList : public Compute
             m_params_changed = true;
             }
 
+        //! Store the members of all cells back to back
+        void setCompact(bool compact);
+
         //! Request a multi-GPU cell list
         virtual void setPerDevice(bool per_device)
             {
@@ -245,9 +259,21 @@ class PYBIND11_EXPORT CellList : public Compute
         //! Get an indexer to index into the cell lists
         const Index2D& getCellListIndexer() const
             {
+            if (m_compact)
+                {
+                m_exec_conf->msg->error() << "The compact cell list has no cell list indexer!" << std::endl;
+                m_exec_conf->msg->error() << "Use getCellStartArray() to find the members of a cell" << std::endl;
+                throw std::runtime_error("Cell list indexer not available");
+                }
             return m_cell_list_indexer;
             }
 
+        //! Return true if the members of all cells are stored back to back
+        bool getCompact() const
+            {
+            return m_compact;
+            }
+
         //! Get an indexer to index into the adjacency list
         const Index2D& getCellAdjIndexer() const
             {
@@ -288,6 +314,12 @@ class PYBIND11_EXPORT CellList : public Compute
             throw std::runtime_error("Per-device cell size array not available in base class.\n");
             }
 
+        //! Get the index of the first member of every cell in the cell lists
+        const GlobalArray<unsigned int>& getCellStartArray() const
+            {
+            return m_cell_start;
+            }
+
         //! Get the adjacency list
         const GlobalArray<unsigned int>& getCellAdjArray() const
             {
@@ -368,6 +400,7 @@ class PYBIND11_EXPORT CellList : public Compute
         bool m_particles_sorted;     //!< Set to true when the particles have been sorted
         bool m_box_changed;          //!< Set to true when the box size has changed
         unsigned int m_multiple;     //!< Round cell dimensions down to a multiple of this value
+        bool m_compact;              //!< true if the members of all cells are stored back to back
 
         // parameters determined by initialize
         uint3 m_dim;                 //!< Current dimensions
@@ -375,11 +408,13 @@ class PYBIND11_EXPORT CellList : public Compute
         Index2D m_cell_list_indexer; //!< Indexes elements in the cell list
         Index2D m_cell_adj_indexer;  //!< Indexes elements in the cell adjacency list
         unsigned int m_Nmax;         //!< Numer of spaces reserved for particles in each cell
+        unsigned int m_n_compact;    //!< Number of spaces reserved for all particles in the compact cell list
         Scalar3 m_actual_width;      //!< Actual width of a cell in each direction
         Scalar3 m_ghost_width;       //!< Width of ghost layer sized for (on one side only)
 
         // values computed by compute()
         GlobalArray<unsigned int> m_cell_size;  //!< Number of members in each cell
+        GlobalArray<unsigned int> m_cell_start; //!< Index of the first member of each cell
         GlobalArray<unsigned int> m_cell_adj;   //!< Cell adjacency list
         GlobalArray<Scalar4> m_xyzf;            //!< Cell list with position and flags
         GlobalArray<Scalar4> m_tdb;             //!< Cell list with type,diameter,body
@@ -390,6 +425,9 @@ class PYBIND11_EXPORT CellList : public Compute
         bool m_sort_cell_list;               //!< If true, sort cell list
         bool m_compute_adj_list;            //!< If true, compute the cell adjacency lists
 
+        std::vector<unsigned int> m_particle_cell;  //!< Cell of every particle in the compact cell list
+        std::vector<unsigned int> m_cell_fill;      //!< Next free entry of every cell in the compact cell list
+
         //! Computes what the dimensions should me
         uint3 computeDimensions();
 
@@ -408,6 +446,12 @@ class PYBIND11_EXPORT CellList : public Compute
         //! Compute the cell list
         virtual void computeCellList();
 
+        //! Compute the compact cell list
+        void computeCellListCompact();
+
+        //! Find the cell of a particle
+        unsigned int findCell(const Scalar4& postype, unsigned int n, const BoxDim& box, uint3& conditions) const;
+
         //! Check the status of the conditions
         bool checkConditions();
 
@@ -0,0 +1,304 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CheckpointReader.cc
+    \brief Defines the CheckpointReader class
+*/
+
+#include "CheckpointReader.h"
+
+#ifdef ENABLE_MPI
+#include "DomainDecomposition.h"
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <string.h>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+//! Read a table of records from a stream and append them to a vector
+template<class T>
+static void read_records(std::istream& in, std::vector<T>& v, unsigned int n)
+    {
+    unsigned int offset = v.size();
+    v.resize(offset + n);
+    if (n)
+        in.read((char *)&v[offset], sizeof(T)*n);
+    }
+
+/*! \param exec_conf The execution configuration
+    \param fname Base name of the checkpoint
+
+    Only the root rank reads the manifest from the file system.
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &fname)
+    : m_exec_conf(exec_conf), m_fname(fname), m_in_place(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointReader: " << m_fname << endl;
+
+    std::string manifest;
+    int success = 1;
+    if (m_exec_conf->isRoot())
+        {
+        std::ifstream f(m_fname.c_str(), ios::in | ios::binary);
+        if (f.good())
+            {
+            std::ostringstream s;
+            s << f.rdbuf();
+            manifest = s.str();
+            }
+        else
+            success = 0;
+        }
+
+    #ifdef ENABLE_MPI
+    bcast(success, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (! success)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: Unable to open " << m_fname << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    #ifdef ENABLE_MPI
+    bcast(manifest, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    std::istringstream in(manifest);
+    if (! m_manifest.read(in))
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << m_fname << " is not a checkpoint written by this "
+                                  << "version and precision of HOOMD-blue" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    m_exec_conf->msg->notice(2) << "Checkpoint " << m_fname << " at time step " << m_manifest.timestep
+                                << " with " << m_manifest.nranks << " shard(s)" << endl;
+    }
+
+BoxDim CheckpointReader::getBox() const
+    {
+    BoxDim box(m_manifest.L);
+    box.setTiltFactors(m_manifest.xy, m_manifest.xz, m_manifest.yz);
+    return box;
+    }
+
+#ifdef ENABLE_MPI
+/*! \returns a decomposition with the processor grid and the domain boundaries stored in the checkpoint
+
+    \pre The number of ranks is the same as when the checkpoint was written
+*/
+std::shared_ptr<DomainDecomposition> CheckpointReader::getDomainDecomposition() const
+    {
+    if (m_manifest.nranks != m_exec_conf->getNRanks() || m_manifest.grid.x == 0)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: The checkpoint was written with a different "
+                                  << "number of ranks" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    std::shared_ptr<ExecutionConfiguration> exec_conf = std::const_pointer_cast<ExecutionConfiguration>(m_exec_conf);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf,
+        m_manifest.L, m_manifest.grid.x, m_manifest.grid.y, m_manifest.grid.z, false));
+
+    decomposition->setCumulativeFractions(0, m_manifest.cum_frac_x, 0);
+    decomposition->setCumulativeFractions(1, m_manifest.cum_frac_y, 0);
+    decomposition->setCumulativeFractions(2, m_manifest.cum_frac_z, 0);
+    if (m_manifest.staggered)
+        {
+        decomposition->setStaggered(true);
+        decomposition->setColumnCumulativeFractions(m_manifest.cum_frac_z_col, 0);
+        }
+
+    return decomposition;
+    }
+#endif
+
+/*! \param pdata The particle data to restore into
+    \returns true if every rank can restore the shard it wrote without communication
+*/
+bool CheckpointReader::hasSameLayout(std::shared_ptr<ParticleData> pdata) const
+    {
+    if (m_manifest.nranks != m_exec_conf->getNRanks())
+        return false;
+
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid = decomposition->getGridSize();
+        if (grid.x != m_manifest.grid.x || grid.y != m_manifest.grid.y || grid.z != m_manifest.grid.z)
+            return false;
+
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+        if (m_manifest.cart_ranks.size() != decomposition->getCartRanks().getNumElements()
+            || ! std::equal(m_manifest.cart_ranks.begin(), m_manifest.cart_ranks.end(), h_cart_ranks.data))
+            return false;
+
+        if (decomposition->getCumulativeFractions(0) != m_manifest.cum_frac_x
+            || decomposition->getCumulativeFractions(1) != m_manifest.cum_frac_y
+            || decomposition->isStaggered() != m_manifest.staggered)
+            return false;
+
+        if (m_manifest.staggered)
+            {
+            std::vector<Scalar> cum_frac_z_col;
+            for (unsigned int iy = 0; iy < grid.y; ++iy)
+                for (unsigned int ix = 0; ix < grid.x; ++ix)
+                    {
+                    std::vector<Scalar> col = decomposition->getColumnCumulativeFractions(ix, iy);
+                    cum_frac_z_col.insert(cum_frac_z_col.end(), col.begin(), col.end());
+                    }
+            return cum_frac_z_col == m_manifest.cum_frac_z_col;
+            }
+
+        return decomposition->getCumulativeFractions(2) == m_manifest.cum_frac_z;
+        }
+    #endif
+
+    return true;
+    }
+
+/*! \param shard Index of the shard to read
+    \returns true on success
+*/
+bool CheckpointReader::readShard(unsigned int shard)
+    {
+    std::string name = getCheckpointShardName(m_fname, shard);
+    std::ifstream f(name.c_str(), ios::in | ios::binary);
+    if (! f.good())
+        {
+        m_exec_conf->msg->errorAllRanks() << "init.read_checkpoint: Unable to open " << name << endl;
+        return false;
+        }
+
+    CheckpointShardHeader header;
+    f.read((char *)&header, sizeof(header));
+    if (! f.good() || memcmp(header.magic, CHECKPOINT_SHARD_MAGIC, sizeof(header.magic)) != 0
+        || header.version != CHECKPOINT_VERSION || header.scalar_size != sizeof(Scalar) || header.rank != shard)
+        {
+        m_exec_conf->msg->errorAllRanks() << "init.read_checkpoint: " << name << " is not a valid shard of "
+                                          << m_fname << endl;
+        return false;
+        }
+
+    if (header.timestep != m_manifest.timestep)
+        {
+        m_exec_conf->msg->errorAllRanks() << "init.read_checkpoint: " << name << " is from time step "
+            << header.timestep << ", but the manifest is from time step " << m_manifest.timestep
+            << ". Was the checkpoint interrupted?" << endl;
+        return false;
+        }
+
+    read_records(f, m_particles, header.n_particles);
+    read_records(f, m_bonds, header.n_groups[checkpoint_group::bond]);
+    read_records(f, m_angles, header.n_groups[checkpoint_group::angle]);
+    read_records(f, m_dihedrals, header.n_groups[checkpoint_group::dihedral]);
+    read_records(f, m_impropers, header.n_groups[checkpoint_group::improper]);
+    read_records(f, m_constraints, header.n_groups[checkpoint_group::constraint]);
+    read_records(f, m_pairs, header.n_groups[checkpoint_group::pair]);
+
+    if (f.fail())
+        {
+        m_exec_conf->msg->errorAllRanks() << "init.read_checkpoint: " << name << " is truncated" << endl;
+        return false;
+        }
+
+    return true;
+    }
+
+/*! \param sysdef An empty system definition with the box of the checkpoint
+
+    This call is collective.
+*/
+void CheckpointReader::restore(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    unsigned int rank = m_exec_conf->getRank();
+    unsigned int size = m_exec_conf->getNRanks();
+
+    int same_layout = hasSameLayout(pdata);
+    #ifdef ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &same_layout, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+    #endif
+
+    m_in_place = same_layout;
+    if (same_layout)
+        m_exec_conf->msg->notice(2) << "Restoring every shard on the rank that wrote it" << endl;
+    else
+        m_exec_conf->msg->notice(2) << "Redistributing " << m_manifest.nranks << " shard(s) over "
+                                    << size << " rank(s)" << endl;
+
+    // with the same layout, every rank reads its own shard only
+    int success = 1;
+    for (unsigned int shard = rank; shard < m_manifest.nranks; shard += size)
+        if (! readShard(shard))
+            success = 0;
+
+    #ifdef ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (! success)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: Error reading checkpoint shards of " << m_fname << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    bool redistribute = !same_layout;
+    sysdef->setNDimensions(m_manifest.dimensions);
+
+    const CheckpointTagInfo& ptl = m_manifest.particles;
+    pdata->restoreFromCheckpoint(m_particles, ptl.type_mapping, ptl.n_tags, ptl.free_tags, redistribute);
+
+    int3 o_image = m_manifest.o_image;
+    pdata->setOrigin(m_manifest.origin, o_image);
+    if (m_manifest.accel_set)
+        pdata->notifyAccelSet();
+
+    const CheckpointTagInfo *groups = m_manifest.groups;
+    const CheckpointTagInfo& bond = groups[checkpoint_group::bond];
+    sysdef->getBondData()->restoreFromCheckpoint(m_bonds, bond.type_mapping, bond.n_tags, bond.free_tags,
+        redistribute);
+    const CheckpointTagInfo& angle = groups[checkpoint_group::angle];
+    sysdef->getAngleData()->restoreFromCheckpoint(m_angles, angle.type_mapping, angle.n_tags, angle.free_tags,
+        redistribute);
+    const CheckpointTagInfo& dihedral = groups[checkpoint_group::dihedral];
+    sysdef->getDihedralData()->restoreFromCheckpoint(m_dihedrals, dihedral.type_mapping, dihedral.n_tags,
+        dihedral.free_tags, redistribute);
+    const CheckpointTagInfo& improper = groups[checkpoint_group::improper];
+    sysdef->getImproperData()->restoreFromCheckpoint(m_impropers, improper.type_mapping, improper.n_tags,
+        improper.free_tags, redistribute);
+    const CheckpointTagInfo& constraint = groups[checkpoint_group::constraint];
+    sysdef->getConstraintData()->restoreFromCheckpoint(m_constraints, constraint.type_mapping, constraint.n_tags,
+        constraint.free_tags, redistribute);
+    const CheckpointTagInfo& pair = groups[checkpoint_group::pair];
+    sysdef->getPairData()->restoreFromCheckpoint(m_pairs, pair.type_mapping, pair.n_tags, pair.free_tags,
+        redistribute);
+
+    std::shared_ptr<IntegratorData> integrator_data = sysdef->getIntegratorData();
+    integrator_data->load(m_manifest.integrator_variables.size());
+    for (unsigned int i = 0; i < m_manifest.integrator_variables.size(); ++i)
+        integrator_data->setIntegratorVariables(i, m_manifest.integrator_variables[i]);
+    }
+
+void export_CheckpointReader(py::module& m)
+    {
+    py::class_< CheckpointReader, std::shared_ptr<CheckpointReader> >(m,"CheckpointReader")
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&>())
+    .def("getTimeStep", &CheckpointReader::getTimeStep)
+    .def("getNRanks", &CheckpointReader::getNRanks)
+    .def("getNumParticleTypes", &CheckpointReader::getNumParticleTypes)
+    .def("getBox", &CheckpointReader::getBox)
+#ifdef ENABLE_MPI
+    .def("getDomainDecomposition", &CheckpointReader::getDomainDecomposition)
+#endif
+    .def("restore", &CheckpointReader::restore)
+    .def("restoredInPlace", &CheckpointReader::restoredInPlace)
+    ;
+    }
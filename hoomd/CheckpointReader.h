@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CheckpointReader.h
+    \brief Declares the CheckpointReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "CheckpointWriter.h"
+#include "SystemDefinition.h"
+
+#include <string>
+#include <vector>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __CHECKPOINT_READER_H__
+#define __CHECKPOINT_READER_H__
+
+//! Restores a system from a checkpoint written by CheckpointWriter
+/*! The manifest is read on the root rank and broadcast. restore() fills an empty SystemDefinition with the
+    particles and bonded groups of the shards.
+
+    When the system is restarted on the same number of ranks with the domain decomposition returned by
+    getDomainDecomposition(), every rank reads exactly the shard it wrote and copies it into the particle data
+    without any communication. Otherwise, the shards are divided among the ranks, and the particles and groups are
+    sent to their new owners. A checkpoint written on any number of ranks can be restored on any other number.
+
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT CheckpointReader
+    {
+    public:
+        //! Read the manifest of a checkpoint
+        CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &fname);
+
+        //! Returns the timestep of the checkpoint
+        uint64_t getTimeStep() const
+            {
+            return m_manifest.timestep;
+            }
+
+        //! Returns the number of ranks that wrote the checkpoint
+        unsigned int getNRanks() const
+            {
+            return m_manifest.nranks;
+            }
+
+        //! Returns the number of particle types
+        unsigned int getNumParticleTypes() const
+            {
+            return m_manifest.particles.type_mapping.size();
+            }
+
+        //! Returns the global box of the checkpoint
+        BoxDim getBox() const;
+
+        #ifdef ENABLE_MPI
+        //! Create the domain decomposition the checkpoint was written with
+        std::shared_ptr<DomainDecomposition> getDomainDecomposition() const;
+        #endif
+
+        //! Restore the checkpoint into a system
+        void restore(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Returns true if the last restore() read every shard on the rank that wrote it, without communication
+        bool restoredInPlace() const
+            {
+            return m_in_place;
+            }
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+        std::string m_fname;                                       //!< Base name of the checkpoint
+        CheckpointManifest m_manifest;                             //!< Global state of the checkpoint
+        bool m_in_place;                                           //!< True if the shards were restored in place
+
+        std::vector<pdata_element> m_particles;                    //!< Particles read from the shards
+        std::vector<BondData::packed_t> m_bonds;                   //!< Bonds read from the shards
+        std::vector<AngleData::packed_t> m_angles;                 //!< Angles read from the shards
+        std::vector<DihedralData::packed_t> m_dihedrals;           //!< Dihedrals read from the shards
+        std::vector<ImproperData::packed_t> m_impropers;           //!< Impropers read from the shards
+        std::vector<ConstraintData::packed_t> m_constraints;       //!< Constraints read from the shards
+        std::vector<PairData::packed_t> m_pairs;                   //!< Special pairs read from the shards
+
+        //! Test if the shard of every rank lies in its domain
+        bool hasSameLayout(std::shared_ptr<ParticleData> pdata) const;
+
+        //! Read a shard and append its contents to the buffers
+        bool readShard(unsigned int shard);
+    };
+
+//! Exports CheckpointReader to python
+void export_CheckpointReader(pybind11::module& m);
+
+#endif
@@ -0,0 +1,467 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CheckpointWriter.cc
+    \brief Defines the CheckpointWriter class
+*/
+
+#include "CheckpointWriter.h"
+
+#ifdef ENABLE_MPI
+#include "DomainDecomposition.h"
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <string.h>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+//! Write a plain value to a stream
+template<class T>
+static void write_value(std::ostream& out, const T& v)
+    {
+    out.write((const char *)&v, sizeof(T));
+    }
+
+//! Read a plain value from a stream
+template<class T>
+static void read_value(std::istream& in, T& v)
+    {
+    in.read((char *)&v, sizeof(T));
+    }
+
+//! Write a vector of plain values to a stream, preceded by its length
+template<class T>
+static void write_vector(std::ostream& out, const std::vector<T>& v)
+    {
+    unsigned int n = v.size();
+    write_value(out, n);
+    if (n)
+        out.write((const char *)&v[0], sizeof(T)*n);
+    }
+
+//! Read a vector of plain values from a stream
+template<class T>
+static void read_vector(std::istream& in, std::vector<T>& v)
+    {
+    unsigned int n = 0;
+    read_value(in, n);
+    if (! in.good())
+        return;
+    v.resize(n);
+    if (n)
+        in.read((char *)&v[0], sizeof(T)*n);
+    }
+
+//! Write a string to a stream, preceded by its length
+static void write_string(std::ostream& out, const std::string& s)
+    {
+    unsigned int n = s.size();
+    write_value(out, n);
+    out.write(s.data(), n);
+    }
+
+//! Read a string from a stream
+static void read_string(std::istream& in, std::string& s)
+    {
+    unsigned int n = 0;
+    read_value(in, n);
+    if (! in.good())
+        return;
+    s.resize(n);
+    if (n)
+        in.read(&s[0], n);
+    }
+
+//! Write the tag information of a table
+static void write_tag_info(std::ostream& out, const CheckpointTagInfo& info)
+    {
+    unsigned int n_types = info.type_mapping.size();
+    write_value(out, n_types);
+    for (unsigned int i = 0; i < n_types; ++i)
+        write_string(out, info.type_mapping[i]);
+    write_value(out, info.n_tags);
+    write_vector(out, info.free_tags);
+    }
+
+//! Read the tag information of a table
+static void read_tag_info(std::istream& in, CheckpointTagInfo& info)
+    {
+    unsigned int n_types = 0;
+    read_value(in, n_types);
+    if (! in.good())
+        return;
+    info.type_mapping.resize(n_types);
+    for (unsigned int i = 0; i < n_types; ++i)
+        read_string(in, info.type_mapping[i]);
+    read_value(in, info.n_tags);
+    read_vector(in, info.free_tags);
+    }
+
+//! Write a table of records to a stream
+template<class T>
+static void write_records(std::ostream& out, const std::vector<T>& v)
+    {
+    if (v.size())
+        out.write((const char *)&v[0], sizeof(T)*v.size());
+    }
+
+CheckpointManifest::CheckpointManifest()
+    : timestep(0), nranks(1), dimensions(3), xy(0), xz(0), yz(0), accel_set(false), staggered(false)
+    {
+    L = make_scalar3(0,0,0);
+    origin = make_scalar3(0,0,0);
+    o_image = make_int3(0,0,0);
+    grid = make_uint3(0,0,0);
+    }
+
+/*! \param out Stream to write to
+*/
+void CheckpointManifest::write(std::ostream& out) const
+    {
+    out.write(CHECKPOINT_MANIFEST_MAGIC, sizeof(CHECKPOINT_MANIFEST_MAGIC));
+    write_value(out, CHECKPOINT_VERSION);
+    unsigned int scalar_size = sizeof(Scalar);
+    write_value(out, scalar_size);
+
+    write_value(out, timestep);
+    write_value(out, nranks);
+    write_value(out, dimensions);
+    write_value(out, L);
+    write_value(out, xy);
+    write_value(out, xz);
+    write_value(out, yz);
+    write_value(out, origin);
+    write_value(out, o_image);
+    unsigned int accel = accel_set;
+    write_value(out, accel);
+
+    write_tag_info(out, particles);
+    for (unsigned int i = 0; i < checkpoint_group::num_groups; ++i)
+        write_tag_info(out, groups[i]);
+
+    unsigned int n_integrators = integrator_variables.size();
+    write_value(out, n_integrators);
+    for (unsigned int i = 0; i < n_integrators; ++i)
+        {
+        write_string(out, integrator_variables[i].type);
+        write_vector(out, integrator_variables[i].variable);
+        }
+
+    write_value(out, grid);
+    write_vector(out, cum_frac_x);
+    write_vector(out, cum_frac_y);
+    write_vector(out, cum_frac_z);
+    unsigned int stagger = staggered;
+    write_value(out, stagger);
+    write_vector(out, cum_frac_z_col);
+    write_vector(out, cart_ranks);
+    }
+
+/*! \param in Stream to read from
+    \returns false if the stream does not hold a manifest written by a compatible build
+*/
+bool CheckpointManifest::read(std::istream& in)
+    {
+    char magic[sizeof(CHECKPOINT_MANIFEST_MAGIC)];
+    in.read(magic, sizeof(magic));
+    unsigned int version = 0;
+    read_value(in, version);
+    unsigned int scalar_size = 0;
+    read_value(in, scalar_size);
+    if (! in.good() || memcmp(magic, CHECKPOINT_MANIFEST_MAGIC, sizeof(magic)) != 0
+        || version != CHECKPOINT_VERSION || scalar_size != sizeof(Scalar))
+        return false;
+
+    read_value(in, timestep);
+    read_value(in, nranks);
+    read_value(in, dimensions);
+    read_value(in, L);
+    read_value(in, xy);
+    read_value(in, xz);
+    read_value(in, yz);
+    read_value(in, origin);
+    read_value(in, o_image);
+    unsigned int accel = 0;
+    read_value(in, accel);
+    accel_set = accel;
+
+    read_tag_info(in, particles);
+    for (unsigned int i = 0; i < checkpoint_group::num_groups; ++i)
+        read_tag_info(in, groups[i]);
+
+    unsigned int n_integrators = 0;
+    read_value(in, n_integrators);
+    if (! in.good())
+        return false;
+    integrator_variables.resize(n_integrators);
+    for (unsigned int i = 0; i < n_integrators; ++i)
+        {
+        read_string(in, integrator_variables[i].type);
+        read_vector(in, integrator_variables[i].variable);
+        }
+
+    read_value(in, grid);
+    read_vector(in, cum_frac_x);
+    read_vector(in, cum_frac_y);
+    read_vector(in, cum_frac_z);
+    unsigned int stagger = 0;
+    read_value(in, stagger);
+    staggered = stagger;
+    read_vector(in, cum_frac_z_col);
+    read_vector(in, cart_ranks);
+
+    return in.good();
+    }
+
+/*! \param fname Base name of the checkpoint
+    \param rank Rank that writes the shard
+    \returns the file name of the shard
+*/
+std::string getCheckpointShardName(const std::string& fname, unsigned int rank)
+    {
+    std::ostringstream s;
+    s << fname << "." << rank;
+    return s.str();
+    }
+
+/*! \param sysdef SystemDefinition containing the ParticleData to write
+    \param fname Base name of the checkpoint
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string &fname)
+    : Analyzer(sysdef), m_fname(fname)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << m_fname << endl;
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    All ranks write their shards concurrently to temporary files. Only after every shard has been written
+    successfully are the temporary files renamed over the shards of the previous checkpoint, and the manifest is
+    committed last. A failure while writing leaves the previous checkpoint intact.
+*/
+void CheckpointWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Checkpoint");
+
+    std::string name = getCheckpointShardName(m_fname, m_exec_conf->getRank());
+    std::string tmp_name = name + ".tmp";
+
+    int success = writeShard(timestep, tmp_name);
+
+    // wait until all ranks have written their shards
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (! success)
+        {
+        std::remove(tmp_name.c_str());
+        m_exec_conf->msg->error() << "dump.checkpoint: Error writing checkpoint shards of " << m_fname << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    // replace the shards of the previous checkpoint
+    success = std::rename(tmp_name.c_str(), name.c_str()) == 0;
+    if (! success)
+        m_exec_conf->msg->errorAllRanks() << "dump.checkpoint: Unable to rename " << tmp_name << " to " << name << endl;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (! success)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Error writing checkpoint shards of " << m_fname << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    // commit the checkpoint
+    writeManifest(timestep);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep Current time step of the simulation
+    \param name File to write the shard of this rank to
+    \returns true on success
+*/
+bool CheckpointWriter::writeShard(unsigned int timestep, const std::string& name)
+    {
+    std::vector<pdata_element> particles;
+    m_pdata->getCheckpointParticles(particles);
+
+    std::vector<BondData::packed_t> bonds;
+    m_sysdef->getBondData()->getCheckpointGroups(bonds);
+    std::vector<AngleData::packed_t> angles;
+    m_sysdef->getAngleData()->getCheckpointGroups(angles);
+    std::vector<DihedralData::packed_t> dihedrals;
+    m_sysdef->getDihedralData()->getCheckpointGroups(dihedrals);
+    std::vector<ImproperData::packed_t> impropers;
+    m_sysdef->getImproperData()->getCheckpointGroups(impropers);
+    std::vector<ConstraintData::packed_t> constraints;
+    m_sysdef->getConstraintData()->getCheckpointGroups(constraints);
+    std::vector<PairData::packed_t> pairs;
+    m_sysdef->getPairData()->getCheckpointGroups(pairs);
+
+    CheckpointShardHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CHECKPOINT_SHARD_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.scalar_size = sizeof(Scalar);
+    header.timestep = timestep;
+    header.rank = m_exec_conf->getRank();
+    header.n_particles = particles.size();
+    header.n_groups[checkpoint_group::bond] = bonds.size();
+    header.n_groups[checkpoint_group::angle] = angles.size();
+    header.n_groups[checkpoint_group::dihedral] = dihedrals.size();
+    header.n_groups[checkpoint_group::improper] = impropers.size();
+    header.n_groups[checkpoint_group::constraint] = constraints.size();
+    header.n_groups[checkpoint_group::pair] = pairs.size();
+
+    std::ofstream f(name.c_str(), ios::out | ios::binary | ios::trunc);
+    if (! f.good())
+        {
+        m_exec_conf->msg->errorAllRanks() << "dump.checkpoint: Unable to open " << name << endl;
+        return false;
+        }
+
+    f.write((const char *)&header, sizeof(header));
+    write_records(f, particles);
+    write_records(f, bonds);
+    write_records(f, angles);
+    write_records(f, dihedrals);
+    write_records(f, impropers);
+    write_records(f, constraints);
+    write_records(f, pairs);
+    f.close();
+
+    if (f.fail())
+        {
+        m_exec_conf->msg->errorAllRanks() << "dump.checkpoint: Error writing " << name << endl;
+        return false;
+        }
+
+    return true;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    The manifest is written to a temporary file and then renamed, so that a valid manifest always exists once
+    the first checkpoint is complete.
+*/
+void CheckpointWriter::writeManifest(unsigned int timestep)
+    {
+    CheckpointManifest manifest;
+    manifest.timestep = timestep;
+    manifest.nranks = m_exec_conf->getNRanks();
+    manifest.dimensions = m_sysdef->getNDimensions();
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    manifest.L = box.getL();
+    manifest.xy = box.getTiltFactorXY();
+    manifest.xz = box.getTiltFactorXZ();
+    manifest.yz = box.getTiltFactorYZ();
+    manifest.origin = m_pdata->getOrigin();
+    manifest.o_image = m_pdata->getOriginImage();
+    manifest.accel_set = m_pdata->isAccelSet();
+
+    manifest.particles.type_mapping = m_pdata->getTypeMapping();
+    manifest.particles.free_tags = m_pdata->getFreeTags();
+    manifest.particles.n_tags = m_pdata->getNGlobal() + manifest.particles.free_tags.size();
+
+    CheckpointTagInfo *groups = manifest.groups;
+    groups[checkpoint_group::bond].type_mapping = m_sysdef->getBondData()->getTypeMapping();
+    groups[checkpoint_group::bond].free_tags = m_sysdef->getBondData()->getFreeTags();
+    groups[checkpoint_group::bond].n_tags = m_sysdef->getBondData()->getNGlobal();
+    groups[checkpoint_group::angle].type_mapping = m_sysdef->getAngleData()->getTypeMapping();
+    groups[checkpoint_group::angle].free_tags = m_sysdef->getAngleData()->getFreeTags();
+    groups[checkpoint_group::angle].n_tags = m_sysdef->getAngleData()->getNGlobal();
+    groups[checkpoint_group::dihedral].type_mapping = m_sysdef->getDihedralData()->getTypeMapping();
+    groups[checkpoint_group::dihedral].free_tags = m_sysdef->getDihedralData()->getFreeTags();
+    groups[checkpoint_group::dihedral].n_tags = m_sysdef->getDihedralData()->getNGlobal();
+    groups[checkpoint_group::improper].type_mapping = m_sysdef->getImproperData()->getTypeMapping();
+    groups[checkpoint_group::improper].free_tags = m_sysdef->getImproperData()->getFreeTags();
+    groups[checkpoint_group::improper].n_tags = m_sysdef->getImproperData()->getNGlobal();
+    groups[checkpoint_group::constraint].free_tags = m_sysdef->getConstraintData()->getFreeTags();
+    groups[checkpoint_group::constraint].n_tags = m_sysdef->getConstraintData()->getNGlobal();
+    groups[checkpoint_group::pair].type_mapping = m_sysdef->getPairData()->getTypeMapping();
+    groups[checkpoint_group::pair].free_tags = m_sysdef->getPairData()->getFreeTags();
+    groups[checkpoint_group::pair].n_tags = m_sysdef->getPairData()->getNGlobal();
+    for (unsigned int i = 0; i < checkpoint_group::num_groups; ++i)
+        groups[i].n_tags += groups[i].free_tags.size();
+
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    for (unsigned int i = 0; i < integrator_data->getNumIntegrators(); ++i)
+        manifest.integrator_variables.push_back(integrator_data->getIntegratorVariables(i));
+
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        manifest.grid = decomposition->getGridSize();
+        manifest.cum_frac_x = decomposition->getCumulativeFractions(0);
+        manifest.cum_frac_y = decomposition->getCumulativeFractions(1);
+        manifest.staggered = decomposition->isStaggered();
+        if (manifest.staggered)
+            {
+            for (unsigned int iy = 0; iy < manifest.grid.y; ++iy)
+                for (unsigned int ix = 0; ix < manifest.grid.x; ++ix)
+                    {
+                    std::vector<Scalar> col = decomposition->getColumnCumulativeFractions(ix, iy);
+                    manifest.cum_frac_z_col.insert(manifest.cum_frac_z_col.end(), col.begin(), col.end());
+                    }
+            manifest.cum_frac_z = decomposition->getColumnCumulativeFractions(0, 0);
+            }
+        else
+            {
+            manifest.cum_frac_z = decomposition->getCumulativeFractions(2);
+            }
+
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+        manifest.cart_ranks.assign(h_cart_ranks.data, h_cart_ranks.data + decomposition->getCartRanks().getNumElements());
+        }
+    #endif
+
+    int success = 1;
+    if (m_exec_conf->isRoot())
+        {
+        std::string tmp_name = m_fname + ".tmp";
+        std::ofstream f(tmp_name.c_str(), ios::out | ios::binary | ios::trunc);
+        manifest.write(f);
+        f.close();
+
+        success = !f.fail() && std::rename(tmp_name.c_str(), m_fname.c_str()) == 0;
+        }
+
+    #ifdef ENABLE_MPI
+    bcast(success, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (! success)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Error writing checkpoint manifest " << m_fname << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+    }
+
+void export_CheckpointWriter(py::module& m)
+    {
+    py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter> >(m,"CheckpointWriter",py::base<Analyzer>())
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::string >())
+        ;
+    }
@@ -0,0 +1,154 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifndef __CHECKPOINTWRITER_H__
+#define __CHECKPOINTWRITER_H__
+
+#include "Analyzer.h"
+#include "IntegratorData.h"
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+/*! \file CheckpointWriter.h
+    \brief Declares the CheckpointWriter class and the checkpoint file layout
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Version of the checkpoint file layout
+const unsigned int CHECKPOINT_VERSION = 1;
+
+//! Magic bytes at the start of the manifest
+const char CHECKPOINT_MANIFEST_MAGIC[8] = {'H','O','O','M','D','C','K','P'};
+
+//! Magic bytes at the start of a shard
+const char CHECKPOINT_SHARD_MAGIC[8] = {'H','O','O','M','D','C','K','S'};
+
+//! Indices of the bonded group tables in a checkpoint
+struct checkpoint_group
+    {
+    enum Enum
+        {
+        bond = 0,
+        angle,
+        dihedral,
+        improper,
+        constraint,
+        pair,
+        num_groups
+        };
+    };
+
+//! Header at the beginning of every checkpoint shard
+/*! A shard holds the particles and bonded groups local to one rank. The header is followed by n_particles
+    pdata_element records and, for every table in checkpoint_group, n_groups[i] packed group records.
+*/
+struct CheckpointShardHeader
+    {
+    char magic[8];                                      //!< Identifies a checkpoint shard
+    unsigned int version;                               //!< Version of the file layout
+    unsigned int scalar_size;                           //!< Size of a Scalar when the shard was written
+    uint64_t timestep;                                  //!< Time step of the checkpoint
+    unsigned int rank;                                  //!< Rank that wrote the shard
+    unsigned int n_particles;                           //!< Number of particles in the shard
+    unsigned int n_groups[checkpoint_group::num_groups]; //!< Number of groups in every table
+    };
+
+//! Tag information of a particle or bonded group table
+struct CheckpointTagInfo
+    {
+    CheckpointTagInfo() : n_tags(0) {}
+
+    std::vector<std::string> type_mapping;  //!< Names of the types
+    unsigned int n_tags;                    //!< One more than the largest tag in use
+    std::vector<unsigned int> free_tags;    //!< Tags below n_tags that are not in use
+    };
+
+//! Global state of a checkpoint
+/*! The manifest is written by the root rank after all shards are complete. It holds everything that is not local
+    to a rank: the box, the tag tables, the integrator variables and the layout of the domain decomposition that
+    the shards were written with.
+*/
+struct CheckpointManifest
+    {
+    CheckpointManifest();
+
+    //! Write the manifest to a stream
+    void write(std::ostream& out) const;
+
+    //! Read the manifest from a stream
+    bool read(std::istream& in);
+
+    uint64_t timestep;                      //!< Time step of the checkpoint
+    unsigned int nranks;                    //!< Number of shards
+    unsigned int dimensions;                //!< Dimensionality of the system
+    Scalar3 L;                              //!< Box lengths
+    Scalar xy;                              //!< Box tilt factor xy
+    Scalar xz;                              //!< Box tilt factor xz
+    Scalar yz;                              //!< Box tilt factor yz
+    Scalar3 origin;                         //!< Origin of the particle coordinates
+    int3 o_image;                           //!< Image of the origin
+    bool accel_set;                         //!< True if the accelerations are valid
+
+    CheckpointTagInfo particles;                                //!< Particle tags and types
+    CheckpointTagInfo groups[checkpoint_group::num_groups];     //!< Bonded group tags and types
+
+    std::vector<IntegratorVariables> integrator_variables;      //!< State of the integrators
+
+    uint3 grid;                             //!< Dimensions of the processor grid (0 without decomposition)
+    std::vector<Scalar> cum_frac_x;         //!< Cumulative domain fractions along x
+    std::vector<Scalar> cum_frac_y;         //!< Cumulative domain fractions along y
+    std::vector<Scalar> cum_frac_z;         //!< Cumulative domain fractions along z
+    bool staggered;                         //!< True if the z cuts are set per column
+    std::vector<Scalar> cum_frac_z_col;     //!< Cumulative z fractions of all columns (staggered only)
+    std::vector<unsigned int> cart_ranks;   //!< Map from domain index to the rank that wrote its shard
+    };
+
+//! Get the file name of a checkpoint shard
+std::string getCheckpointShardName(const std::string& fname, unsigned int rank);
+
+//! Writes restart checkpoints with one shard per rank
+/*! Every rank writes its local particles and bonded groups as raw binary records to its own shard file
+    <tt>fname.rank</tt>, without any communication. The root rank then writes the small manifest \a fname, which
+    holds the global state. The manifest is replaced atomically once all shards are complete, so an interrupted
+    write leaves a detectable mismatch between the time steps of the manifest and the shards.
+
+    The checkpoint stores all per-particle quantities, the tags, the bonded groups, the integrator variables and
+    the domain decomposition. Random number streams in HOOMD are derived from the user seeds and the time step,
+    so no generator state needs to be saved.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CheckpointWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string &fname);
+
+        //! Destructor
+        ~CheckpointWriter();
+
+        //! Write a checkpoint
+        void analyze(unsigned int timestep);
+
+    private:
+        std::string m_fname;    //!< Base name of the checkpoint
+
+        //! Write the shard of this rank to the given file
+        bool writeShard(unsigned int timestep, const std::string& name);
+
+        //! Write the manifest on the root rank
+        void writeManifest(unsigned int timestep);
+    };
+
+//! Exports the CheckpointWriter class to python
+void export_CheckpointWriter(pybind11::module& m);
+
+#endif
@@ -71,6 +71,10 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             uint3 my_pos = m_comm.m_pdata->getDomainDecomposition()->getGridPos();
             unsigned int my_rank = m_exec_conf->getRank();
 
+            ArrayHandle<Scalar4> h_pos(m_comm.m_pdata->getPositions(), access_location::host, access_mode::read);
+            const BoxDim& global_box = m_comm.m_pdata->getGlobalBox();
+            bool staggered = m_comm.m_decomposition->isStaggered();
+
             // mark groups whose member ranks need to be updated
             unsigned int n_groups = m_gdata->getN();
             for (unsigned int group_idx = 0; group_idx < n_groups; group_idx++)
@@ -150,6 +154,14 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                             else if (nk < 0)
                                 nk += di.getD();
 
+                            // in a staggered decomposition, the domain in a neighboring column depends on the z coordinate
+                            if (staggered && (ix || iy))
+                                {
+                                Scalar4 postype = h_pos.data[pidx];
+                                Scalar3 f = global_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+                                nk = m_comm.m_decomposition->getColumnDomain(ni, nj, f.z);
+                                }
+
                             // update ranks
                             r.idx[i] = h_cart_ranks.data[di(ni,nj,nk)];
 
@@ -712,6 +724,8 @@ void Communicator::GroupCommunicator<group_data>::markGhostParticles(
         unsigned int my_rank = m_exec_conf->getRank();
         uint3 my_pos = m_comm.m_pdata->getDomainDecomposition()->getGridPos();
         const BoxDim& box = m_comm.m_pdata->getBox();
+        const BoxDim& global_box = m_comm.m_pdata->getGlobalBox();
+        bool staggered = m_comm.m_decomposition->isStaggered();
 
         unsigned int ngroups = m_gdata->getN();
 
@@ -742,10 +756,16 @@ void Communicator::GroupCommunicator<group_data>::markGhostParticles(
                         flags |= send_north;
                     if (neigh_pos.y == my_pos.y - 1 || (my_pos.y == 0 && neigh_pos.y == di.getH()-1))
                         flags |= send_south;
-                    if (neigh_pos.z == my_pos.z + 1 || (my_pos.z == di.getD()-1 && neigh_pos.z == 0))
-                        flags |= send_up;
-                    if (neigh_pos.z == my_pos.z - 1 || (my_pos.z == 0 && neigh_pos.z == di.getD()-1))
-                        flags |= send_down;
+
+                    // in a staggered decomposition, the z grid positions are only comparable within a column
+                    bool same_column = (neigh_pos.x == my_pos.x && neigh_pos.y == my_pos.y);
+                    if (!staggered || same_column)
+                        {
+                        if (neigh_pos.z == my_pos.z + 1 || (my_pos.z == di.getD()-1 && neigh_pos.z == 0))
+                            flags |= send_up;
+                        if (neigh_pos.z == my_pos.z - 1 || (my_pos.z == 0 && neigh_pos.z == di.getD()-1))
+                            flags |= send_down;
+                        }
 
                     flags &= mask;
 
@@ -785,7 +805,30 @@ void Communicator::GroupCommunicator<group_data>::markGhostParticles(
                                 flags &= ~(f.z > Scalar(0.5) ? send_down : send_up);
                                 }
 
-                            h_plan.data[rtag_j] |= flags;
+                            unsigned int column_flags = 0;
+                            if (staggered && !same_column && (flags & (send_east | send_west | send_north | send_south)))
+                                {
+                                // route along z inside the target column, starting from the rank that receives the ghost
+                                Scalar4 postype = h_postype.data[rtag_j];
+                                Scalar3 f = global_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+                                unsigned int k = m_comm.m_decomposition->getColumnDomain(neigh_pos.x, neigh_pos.y, f.z);
+
+                                if (neigh_pos.z == k + 1 || (k == di.getD()-1 && neigh_pos.z == 0))
+                                    column_flags = send_up;
+                                else if (neigh_pos.z == k - 1 || (k == 0 && neigh_pos.z == di.getD()-1))
+                                    column_flags = send_down;
+
+                                bool lateral_x = flags & (send_east | send_west);
+                                bool lateral_y = flags & (send_north | send_south);
+                                if (lateral_x && lateral_y)
+                                    column_flags <<= 6;
+                                else if (lateral_x)
+                                    column_flags <<= 2;
+                                else
+                                    column_flags <<= 4;
+                                }
+
+                            h_plan.data[rtag_j] |= flags | column_flags;
                             }
                         } // end inner loop over group members
                     }
@@ -854,14 +897,9 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
             {
             if (! m_comm.isCommunicating(dir) ) continue;
 
-            unsigned int send_neighbor = m_comm.m_decomposition->getNeighborRank(dir);
-
-            // we receive from the direction opposite to the one we send to
-            unsigned int recv_neighbor;
-            if (dir % 2 == 0)
-                recv_neighbor = m_comm.m_decomposition->getNeighborRank(dir+1);
-            else
-                recv_neighbor = m_comm.m_decomposition->getNeighborRank(dir-1);
+            // groups are sent to every partner of the stage (all ranks of the neighboring column in a staggered decomposition)
+            const std::vector<unsigned int>& send_ranks = m_comm.m_stage_send_ranks[dir];
+            const std::vector<unsigned int>& recv_ranks = m_comm.m_stage_recv_ranks[dir];
 
             /*
              * Fill send buffers, exchange groups according to plans
@@ -913,24 +951,39 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
                 m_comm.m_prof->push("MPI send/recv");
 
             // communicate size of the message that will contain the particle data
-            MPI_Request reqs[4];
-            MPI_Status status[4];
-
-            MPI_Isend(&num_copy_ghosts,
-                sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                0,
-                m_comm.m_mpi_comm,
-                &reqs[0]);
-            MPI_Irecv(&num_recv_ghosts,
-                sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                0,
-                m_comm.m_mpi_comm,
-                &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+            std::vector<MPI_Request> reqs;
+            std::vector<MPI_Status> stats;
+            MPI_Request req;
+            std::vector<unsigned int> num_recv_partner(recv_ranks.size());
+
+            for (unsigned int i = 0; i < send_ranks.size(); ++i)
+                {
+                MPI_Isend(&num_copy_ghosts,
+                    sizeof(unsigned int),
+                    MPI_BYTE,
+                    send_ranks[i],
+                    0,
+                    m_comm.m_mpi_comm,
+                    &req);
+                reqs.push_back(req);
+                }
+            for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+                {
+                MPI_Irecv(&num_recv_partner[i],
+                    sizeof(unsigned int),
+                    MPI_BYTE,
+                    recv_ranks[i],
+                    0,
+                    m_comm.m_mpi_comm,
+                    &req);
+                reqs.push_back(req);
+                }
+            stats.resize(reqs.size());
+            MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
+
+            num_recv_ghosts = 0;
+            for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+                num_recv_ghosts += num_recv_partner[i];
 
             if (m_comm.m_prof)
                 m_comm.m_prof->pop();
@@ -951,36 +1004,61 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
                 }
 
                 {
-                MPI_Isend(&plan_copybuf.front(),
-                    num_copy_ghosts*sizeof(unsigned int),
-                    MPI_BYTE,
-                    send_neighbor,
-                    1,
-                    m_comm.m_mpi_comm,
-                    &reqs[0]);
-                MPI_Irecv(&group_plan.front()+ start_idx,
-                    num_recv_ghosts*sizeof(unsigned int),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    1,
-                    m_comm.m_mpi_comm,
-                    &reqs[1]);
+                reqs.clear();
+                for (unsigned int i = 0; i < send_ranks.size(); ++i)
+                    {
+                    MPI_Isend(&plan_copybuf.front(),
+                        num_copy_ghosts*sizeof(unsigned int),
+                        MPI_BYTE,
+                        send_ranks[i],
+                        1,
+                        m_comm.m_mpi_comm,
+                        &req);
+                    reqs.push_back(req);
 
-                MPI_Isend(&m_groups_sendbuf.front(),
-                    num_copy_ghosts*sizeof(typename group_data::packed_t),
-                    MPI_BYTE,
-                    send_neighbor,
-                    2,
-                    m_comm.m_mpi_comm,
-                    &reqs[2]);
-                MPI_Irecv(&m_groups_recvbuf.front(),
-                    num_recv_ghosts*sizeof(typename group_data::packed_t),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    2,
-                    m_comm.m_mpi_comm,
-                    &reqs[3]);
-                MPI_Waitall(4, reqs, status);
+                    MPI_Isend(&m_groups_sendbuf.front(),
+                        num_copy_ghosts*sizeof(typename group_data::packed_t),
+                        MPI_BYTE,
+                        send_ranks[i],
+                        2,
+                        m_comm.m_mpi_comm,
+                        &req);
+                    reqs.push_back(req);
+                    }
+
+                unsigned int offset = 0;
+                for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+                    {
+                    MPI_Irecv(&group_plan.front()+ start_idx + offset,
+                        num_recv_partner[i]*sizeof(unsigned int),
+                        MPI_BYTE,
+                        recv_ranks[i],
+                        1,
+                        m_comm.m_mpi_comm,
+                        &req);
+                    reqs.push_back(req);
+
+                    MPI_Irecv(&m_groups_recvbuf.front() + offset,
+                        num_recv_partner[i]*sizeof(typename group_data::packed_t),
+                        MPI_BYTE,
+                        recv_ranks[i],
+                        2,
+                        m_comm.m_mpi_comm,
+                        &req);
+                    reqs.push_back(req);
+
+                    offset += num_recv_partner[i];
+                    }
+
+                stats.resize(reqs.size());
+                MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
+                }
+
+            // groups received from a neighboring column already reached all of its ranks
+            if (send_ranks.size() > 1)
+                {
+                for (unsigned int i = 0; i < num_recv_ghosts; ++i)
+                    group_plan[start_idx + i] &= ~(send_up | send_down);
                 }
 
             if (m_comm.m_prof)
@@ -1078,6 +1156,7 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_nettorque_copybuf(m_exec_conf),
             m_netvirial_copybuf(m_exec_conf),
             m_netvirial_recvbuf(m_exec_conf),
+            m_field_copybuf(m_exec_conf),
             m_plan(m_exec_conf),
             m_plan_reverse(m_exec_conf),
             m_tag_reverse(m_exec_conf),
@@ -1207,17 +1286,17 @@ Communicator::~Communicator()
 void Communicator::initializeNeighborArrays()
     {
     Index3D di= m_decomposition->getDomainIndexer();
+    bool staggered = m_decomposition->isStaggered();
 
     uint3 mypos = m_decomposition->getGridPos();
     int l = mypos.x;
     int m = mypos.y;
     int n = mypos.z;
 
-    ArrayHandle<unsigned int> h_neighbors(m_neighbors, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_adj_mask(m_adj_mask, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
-    m_nneigh = 0;
+    std::vector<unsigned int> neighbors;
+    std::vector<unsigned int> adj_mask;
 
     // loop over neighbors
     for (int ix=-1; ix <= 1; ix++)
@@ -1243,6 +1322,21 @@ void Communicator::initializeNeighborArrays()
             // only if communicating along y-direction
             if (iy && di.getH() == 1) continue;
 
+            if (staggered && (ix || iy))
+                {
+                // the z cuts of neighboring columns are not aligned with ours, any of their ranks may be adjacent
+                unsigned int mask = 0;
+                for (int iz=-1; iz <= 1; iz++)
+                    mask |= 1 << (((iz+1)*3+(iy+1))*3+(ix + 1));
+
+                for (unsigned int k = 0; k < di.getD(); k++)
+                    {
+                    neighbors.push_back(h_cart_ranks.data[di(i,j,k)]);
+                    adj_mask.push_back(mask);
+                    }
+                continue;
+                }
+
             for (int iz=-1; iz <= 1; iz++)
                 {
                 int k = iz + n;
@@ -1261,14 +1355,38 @@ void Communicator::initializeNeighborArrays()
                 unsigned int dir = ((iz+1)*3+(iy+1))*3+(ix + 1);
                 unsigned int mask = 1 << dir;
 
-                unsigned int neighbor = h_cart_ranks.data[di(i,j,k)];
-                h_neighbors.data[m_nneigh] = neighbor;
-                h_adj_mask.data[m_nneigh] = mask;
-                m_nneigh++;
+                neighbors.push_back(h_cart_ranks.data[di(i,j,k)]);
+                adj_mask.push_back(mask);
                 }
             }
         }
 
+    m_nneigh = neighbors.size();
+
+    // reallocate if there are more neighbors than on a Cartesian grid
+    if (m_nneigh > m_neighbors.getNumElements())
+        {
+        GlobalArray<unsigned int> new_neighbors(m_nneigh, m_exec_conf);
+        m_neighbors.swap(new_neighbors);
+
+        GlobalArray<unsigned int> new_unique_neighbors(m_nneigh, m_exec_conf);
+        m_unique_neighbors.swap(new_unique_neighbors);
+
+        GlobalArray<unsigned int> new_adj_mask(m_nneigh, m_exec_conf);
+        m_adj_mask.swap(new_adj_mask);
+
+        GlobalArray<unsigned int> new_begin(m_nneigh, m_exec_conf);
+        m_begin.swap(new_begin);
+
+        GlobalArray<unsigned int> new_end(m_nneigh, m_exec_conf);
+        m_end.swap(new_end);
+        }
+
+    ArrayHandle<unsigned int> h_neighbors(m_neighbors, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_adj_mask(m_adj_mask, access_location::host, access_mode::overwrite);
+    std::copy(neighbors.begin(), neighbors.end(), h_neighbors.data);
+    std::copy(adj_mask.begin(), adj_mask.end(), h_adj_mask.data);
+
     ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors, access_location::host, access_mode::overwrite);
 
     // filter neighbors, combining adjacency masks
@@ -1294,6 +1412,104 @@ void Communicator::initializeNeighborArrays()
         h_adj_mask.data[n] = it->second;
         n++;
         }
+
+    // initialize the partners of the communication stages
+    int adj[6][3] = {{1,0,0},{-1,0,0},{0,1,0},{0,-1,0},{0,0,1},{0,0,-1}};
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        // we receive from the direction opposite to the one we send to
+        int i = (l + adj[dir][0] + di.getW()) % di.getW();
+        int j = (m + adj[dir][1] + di.getH()) % di.getH();
+        int k = (n + adj[dir][2] + di.getD()) % di.getD();
+        int i_recv = (l - adj[dir][0] + di.getW()) % di.getW();
+        int j_recv = (m - adj[dir][1] + di.getH()) % di.getH();
+        int k_recv = (n - adj[dir][2] + di.getD()) % di.getD();
+        m_stage_column[dir] = make_uint2(i, j);
+
+        m_stage_send_ranks[dir].clear();
+        m_stage_recv_ranks[dir].clear();
+        if (staggered && dir < face_up)
+            {
+            // exchange with all ranks of the neighboring columns, ordered by their position along z
+            for (unsigned int kz = 0; kz < di.getD(); kz++)
+                {
+                m_stage_send_ranks[dir].push_back(h_cart_ranks.data[di(i,j,kz)]);
+                m_stage_recv_ranks[dir].push_back(h_cart_ranks.data[di(i_recv,j_recv,kz)]);
+                }
+            }
+        else
+            {
+            m_stage_send_ranks[dir].push_back(h_cart_ranks.data[di(i,j,k)]);
+            m_stage_recv_ranks[dir].push_back(h_cart_ranks.data[di(i_recv,j_recv,k_recv)]);
+            }
+
+        m_num_copy_ghosts_stage[dir].assign(m_stage_send_ranks[dir].size(), 0);
+        m_num_recv_ghosts_stage[dir].assign(m_stage_recv_ranks[dir].size(), 0);
+        }
+    }
+
+/*! \param dir Direction of the communication stage
+    \param postype Position of the particle
+    \returns Index of the rank in the list of stage partners that the particle is sent to
+ */
+unsigned int Communicator::getStagePartner(unsigned int dir, const Scalar4& postype) const
+    {
+    if (m_stage_send_ranks[dir].size() == 1)
+        return 0;
+
+    // send to the domain of the neighboring column that contains the particle
+    Scalar3 f = m_pdata->getGlobalBox().makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    return m_decomposition->getColumnDomain(m_stage_column[dir].x, m_stage_column[dir].y, f.z);
+    }
+
+/*! \param dx Offset of the column along x (-1, 0, or 1)
+    \param dy Offset of the column along y (-1, 0, or 1)
+    \param fz Fractional z coordinate of the ghost in the global box
+    \param ghost_frac_z Ghost layer width as a fraction of the global box
+    \returns The send_up and send_down flags of the ghost on the rank of the column that receives it
+ */
+unsigned int Communicator::getColumnGhostPlan(int dx, int dy, Scalar fz, Scalar ghost_frac_z) const
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    uint3 my_pos = m_decomposition->getGridPos();
+    unsigned int i = ((int)my_pos.x + dx + (int)di.getW()) % di.getW();
+    unsigned int j = ((int)my_pos.y + dy + (int)di.getH()) % di.getH();
+
+    unsigned int k = m_decomposition->getColumnDomain(i, j, fz);
+
+    unsigned int plan = 0;
+    if (fz >= m_decomposition->getColumnCumulativeFraction(i, j, k+1) - ghost_frac_z)
+        plan |= send_up;
+    if (fz < m_decomposition->getColumnCumulativeFraction(i, j, k) + ghost_frac_z)
+        plan |= send_down;
+    return plan;
+    }
+
+/*! \param dir Direction of the communication stage
+    \param n_send Number of elements sent to every partner
+    \param n_recv Number of elements received from every partner (output)
+ */
+void Communicator::exchangeStageCounts(unsigned int dir,
+    const std::vector<unsigned int>& n_send,
+    std::vector<unsigned int>& n_recv)
+    {
+    n_recv.resize(m_stage_recv_ranks[dir].size());
+
+    m_reqs.clear();
+    MPI_Request req;
+    for (unsigned int i = 0; i < m_stage_send_ranks[dir].size(); ++i)
+        {
+        MPI_Isend((void *)&n_send[i], 1, MPI_UNSIGNED, m_stage_send_ranks[dir][i], 0, m_mpi_comm, &req);
+        m_reqs.push_back(req);
+        }
+    for (unsigned int i = 0; i < m_stage_recv_ranks[dir].size(); ++i)
+        {
+        MPI_Irecv(&n_recv[i], 1, MPI_UNSIGNED, m_stage_recv_ranks[dir][i], 0, m_mpi_comm, &req);
+        m_reqs.push_back(req);
+        }
+
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
     }
 
 //! Interface to the communication methods.
@@ -1310,6 +1526,10 @@ void Communicator::communicate(unsigned int timestep)
                                         }
                                       , timestep);
 
+    // forwarding ghosts between columns of a staggered decomposition requires their positions
+    if (m_decomposition->isStaggered())
+        m_flags[comm_flag::position] = 1;
+
     if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
@@ -1353,6 +1573,9 @@ void Communicator::communicate(unsigned int timestep)
         // If so, migrate atoms
         migrateParticles();
 
+        // call subscribers while no ghosts are present
+        m_migrate_callbacks.emit(timestep);
+
         // Construct ghost send lists, exchange ghost atom data
         exchangeGhosts();
 
@@ -1446,46 +1669,58 @@ void Communicator::migrateParticles()
         std::vector<unsigned int> comm_flag_out; // not currently used
         m_pdata->removeParticles(m_sendbuf, comm_flag_out);
 
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
-
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        // group the particles by the rank they are sent to
+        unsigned int n_partners = m_stage_send_ranks[dir].size();
+        std::vector<unsigned int> n_send_ptls(n_partners, 0);
+        std::vector<unsigned int> n_recv_ptls;
+        if (n_partners == 1)
+            {
+            n_send_ptls[0] = m_sendbuf.size();
+            }
         else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+            {
+            std::vector<unsigned int> partner(m_sendbuf.size());
+            for (unsigned int i = 0; i < m_sendbuf.size(); ++i)
+                {
+                partner[i] = getStagePartner(dir, m_sendbuf[i].pos);
+                n_send_ptls[partner[i]]++;
+                }
+
+            std::vector<unsigned int> offset(n_partners, 0);
+            for (unsigned int i = 1; i < n_partners; ++i)
+                offset[i] = offset[i-1] + n_send_ptls[i-1];
+
+            std::vector<pdata_element> sorted_sendbuf(m_sendbuf.size());
+            for (unsigned int i = 0; i < m_sendbuf.size(); ++i)
+                sorted_sendbuf[offset[partner[i]]++] = m_sendbuf[i];
+            m_sendbuf.swap(sorted_sendbuf);
+            }
 
         if (m_prof)
             m_prof->push("MPI send/recv");
 
-        unsigned int n_recv_ptls;
-
         // communicate size of the message that will contain the particle data
-        m_reqs.resize(2);
-        m_stats.resize(2);
+        exchangeStageCounts(dir, n_send_ptls, n_recv_ptls);
 
-        unsigned int n_send_ptls = m_sendbuf.size();
-
-        MPI_Isend(&n_send_ptls, 1, MPI_UNSIGNED, send_neighbor, 0, m_mpi_comm, & m_reqs[0]);
-        MPI_Irecv(&n_recv_ptls, 1, MPI_UNSIGNED, recv_neighbor, 0, m_mpi_comm, & m_reqs[1]);
-        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+        unsigned int n_recv_tot = 0;
+        for (unsigned int i = 0; i < n_recv_ptls.size(); ++i)
+            n_recv_tot += n_recv_ptls[i];
 
         // Resize receive buffer
-        m_recvbuf.resize(n_recv_ptls);
+        m_recvbuf.resize(n_recv_tot);
 
         // exchange particle data
-        m_reqs.resize(2);
-        m_stats.resize(2);
-        MPI_Isend(&m_sendbuf.front(), n_send_ptls*sizeof(pdata_element), MPI_BYTE, send_neighbor, 1, m_mpi_comm, & m_reqs[0]);
-        MPI_Irecv(&m_recvbuf.front(), n_recv_ptls*sizeof(pdata_element), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, & m_reqs[1]);
-        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+        m_reqs.clear();
+        postStageMessages(dir, m_sendbuf.data(), n_send_ptls, m_recvbuf.data(), n_recv_ptls, 1);
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
         if (m_prof)
             m_prof->pop();
 
         // wrap received particles across a global boundary back into global box
         const BoxDim shifted_box = getShiftedBox();
-        for (unsigned int idx = 0; idx < n_recv_ptls; idx++)
+        for (unsigned int idx = 0; idx < n_recv_tot; idx++)
             {
             pdata_element& p = m_recvbuf[idx];
             Scalar4& postype = p.pos;
@@ -1602,6 +1837,17 @@ void Communicator::exchangeGhosts()
         ghost_fractions_body[cur_type] = h_r_ghost_body.data[cur_type] / box_dist;
         }
 
+    unsigned int mask = 0;
+    Index3D di = m_decomposition->getDomainIndexer();
+    if (di.getW() > 1) mask |= (send_east | send_west);
+    if (di.getH() > 1) mask |= (send_north| send_south);
+    if (di.getD() > 1) mask |= (send_up | send_down);
+
+    // in a staggered decomposition, the z itinerary in the neighboring columns is computed in the global box
+    bool staggered = m_decomposition->isStaggered() && di.getD() > 1;
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar global_box_dist_z = global_box.getNearestPlaneDistance().z;
+
         {
         // scan all local atom positions if they are within r_ghost from a neighbor
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -1640,15 +1886,35 @@ void Communicator::exchangeGhosts()
 
             if (f.z < ghost_fraction.z)
                 h_plan.data[idx] |= send_down;
+
+            unsigned int lateral = h_plan.data[idx] & mask & (send_east | send_west | send_north | send_south);
+            if (staggered && lateral)
+                {
+                // find the itinerary along z inside every neighboring column the ghost is sent to
+                Scalar fz = global_box.makeFraction(pos).z;
+                Scalar ghost_frac_z = ghost_fraction.z * box_dist.z / global_box_dist_z;
+
+                unsigned int column_plan = 0;
+                for (int dx = -1; dx <= 1; ++dx)
+                    {
+                    if (dx == 1 && !(lateral & send_east)) continue;
+                    if (dx == -1 && !(lateral & send_west)) continue;
+
+                    for (int dy = -1; dy <= 1; ++dy)
+                        {
+                        if (dy == 1 && !(lateral & send_north)) continue;
+                        if (dy == -1 && !(lateral & send_south)) continue;
+                        if (!dx && !dy) continue;
+
+                        unsigned int shift = (dx && dy) ? 6 : (dx ? 2 : 4);
+                        column_plan |= getColumnGhostPlan(dx, dy, fz, ghost_frac_z) << shift;
+                        }
+                    }
+                h_plan.data[idx] |= column_plan;
+                }
             }
         }
 
-    unsigned int mask = 0;
-    Index3D di = m_decomposition->getDomainIndexer();
-    if (di.getW() > 1) mask |= (send_east | send_west);
-    if (di.getH() > 1) mask |= (send_north| send_south);
-    if (di.getD() > 1) mask |= (send_up | send_down);
-
     // bonds
     m_bond_comm.markGhostParticles(m_plan, mask);
 
@@ -1674,6 +1940,12 @@ void Communicator::exchangeGhosts()
     // ghost particle flags
     CommFlags flags = getFlags();
 
+    if (staggered && flags[comm_flag::reverse_net_force])
+        {
+        m_exec_conf->msg->error() << "comm: reverse ghost communication is not supported with a staggered decomposition" << std::endl;
+        throw std::runtime_error("Error during communication");
+        }
+
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (! isCommunicating(dir) ) continue;
@@ -1732,61 +2004,64 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
 
+            // count the ghosts sent to every stage partner, to group them in the send buffer
+            unsigned int n_partners = m_stage_send_ranks[dir].size();
+            std::vector<unsigned int>& n_copy_stage = m_num_copy_ghosts_stage[dir];
+            n_copy_stage.assign(n_partners, 0);
+
+            std::vector<unsigned int> partner;
+            if (n_partners > 1)
+                {
+                partner.resize(m_pdata->getN() + m_pdata->getNGhosts());
+                for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
+                    {
+                    if (h_plan.data[idx] & (1 << dir))
+                        {
+                        partner[idx] = getStagePartner(dir, h_pos.data[idx]);
+                        n_copy_stage[partner[idx]]++;
+                        }
+                    }
+                }
+
+            std::vector<unsigned int> offset(n_partners, 0);
+            for (unsigned int i = 1; i < n_partners; ++i)
+                offset[i] = offset[i-1] + n_copy_stage[i-1];
+
             for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
                 {
 
                 if (h_plan.data[idx] & (1 << dir))
                     {
                     // send with next message
-                    if (flags[comm_flag::position]) h_pos_copybuf.data[m_num_copy_ghosts[dir]] = h_pos.data[idx];
-                    if (flags[comm_flag::charge]) h_charge_copybuf.data[m_num_copy_ghosts[dir]] = h_charge.data[idx];
-                    if (flags[comm_flag::diameter]) h_diameter_copybuf.data[m_num_copy_ghosts[dir]] = h_diameter.data[idx];
-                    if (flags[comm_flag::body]) h_body_copybuf.data[m_num_copy_ghosts[dir]] = h_body.data[idx];
-                    if (flags[comm_flag::image]) h_image_copybuf.data[m_num_copy_ghosts[dir]] = h_image.data[idx];
-                    if (flags[comm_flag::velocity]) h_velocity_copybuf.data[m_num_copy_ghosts[dir]] = h_vel.data[idx];
-                    if (flags[comm_flag::orientation]) h_orientation_copybuf.data[m_num_copy_ghosts[dir]] = h_orientation.data[idx];
-                    h_plan_copybuf.data[m_num_copy_ghosts[dir]] = h_plan.data[idx];
-
-                    h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
+                    unsigned int i = (n_partners > 1) ? offset[partner[idx]]++ : m_num_copy_ghosts[dir];
+
+                    if (flags[comm_flag::position]) h_pos_copybuf.data[i] = h_pos.data[idx];
+                    if (flags[comm_flag::charge]) h_charge_copybuf.data[i] = h_charge.data[idx];
+                    if (flags[comm_flag::diameter]) h_diameter_copybuf.data[i] = h_diameter.data[idx];
+                    if (flags[comm_flag::body]) h_body_copybuf.data[i] = h_body.data[idx];
+                    if (flags[comm_flag::image]) h_image_copybuf.data[i] = h_image.data[idx];
+                    if (flags[comm_flag::velocity]) h_velocity_copybuf.data[i] = h_vel.data[idx];
+                    if (flags[comm_flag::orientation]) h_orientation_copybuf.data[i] = h_orientation.data[idx];
+                    h_plan_copybuf.data[i] = h_plan.data[idx];
+
+                    h_copy_ghosts.data[i] = h_tag.data[idx];
                     m_num_copy_ghosts[dir]++;
                     }
                 }
-            }
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+            if (n_partners == 1)
+                n_copy_stage[0] = m_num_copy_ghosts[dir];
+            }
 
         if (m_prof)
             m_prof->push("MPI send/recv");
 
-        m_reqs.clear();
-        m_stats.clear();
-        MPI_Request req;
-
-        MPI_Isend(&m_num_copy_ghosts[dir],
-            sizeof(unsigned int),
-            MPI_BYTE,
-            send_neighbor,
-            0,
-            m_mpi_comm,
-            &req);
-        m_reqs.push_back(req);
-        MPI_Irecv(&m_num_recv_ghosts[dir],
-            sizeof(unsigned int),
-            MPI_BYTE,
-            recv_neighbor,
-            0,
-            m_mpi_comm,
-            &req);
-        m_reqs.push_back(req);
+        // exchange the number of ghosts with every stage partner
+        exchangeStageCounts(dir, m_num_copy_ghosts_stage[dir], m_num_recv_ghosts_stage[dir]);
 
-        m_stats.resize(2);
-        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        m_num_recv_ghosts[dir] = 0;
+        for (unsigned int i = 0; i < m_num_recv_ghosts_stage[dir].size(); ++i)
+            m_num_recv_ghosts[dir] += m_num_recv_ghosts_stage[dir][i];
 
         if (m_prof)
             m_prof->pop();
@@ -1827,187 +2102,46 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
 
+            const std::vector<unsigned int>& n_send = m_num_copy_ghosts_stage[dir];
+            const std::vector<unsigned int>& n_recv = m_num_recv_ghosts_stage[dir];
+
             // Clear out the mpi variables for new statuses and requests
             m_reqs.clear();
             m_stats.clear();
 
-            MPI_Isend(h_plan_copybuf.data,
-                m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                1,
-                m_mpi_comm,
-                &req);
-            m_reqs.push_back(req);
-            MPI_Irecv(h_plan.data + start_idx,
-                m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                1,
-                m_mpi_comm,
-                &req);
-            m_reqs.push_back(req);
-
-            MPI_Isend(h_copy_ghosts.data,
-                m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                send_neighbor,
-                2,
-                m_mpi_comm,
-                &req);
-            m_reqs.push_back(req);
-            MPI_Irecv(h_tag.data + start_idx,
-                m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                MPI_BYTE,
-                recv_neighbor,
-                2,
-                m_mpi_comm,
-                &req);
-            m_reqs.push_back(req);
+            postStageMessages(dir, h_plan_copybuf.data, n_send, h_plan.data + start_idx, n_recv, 1);
+            postStageMessages(dir, h_copy_ghosts.data, n_send, h_tag.data + start_idx, n_recv, 2);
 
             if (flags[comm_flag::position])
-                {
-                MPI_Isend(h_pos_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    3,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_pos.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    3,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
+                postStageMessages(dir, h_pos_copybuf.data, n_send, h_pos.data + start_idx, n_recv, 3);
 
             if (flags[comm_flag::charge])
-                {
-                MPI_Isend(h_charge_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    send_neighbor,
-                    4,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_charge.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    4,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
+                postStageMessages(dir, h_charge_copybuf.data, n_send, h_charge.data + start_idx, n_recv, 4);
 
             if (flags[comm_flag::diameter])
-                {
-                MPI_Isend(h_diameter_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    send_neighbor,
-                    5,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_diameter.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    5,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
+                postStageMessages(dir, h_diameter_copybuf.data, n_send, h_diameter.data + start_idx, n_recv, 5);
 
             if (flags[comm_flag::velocity])
-                {
-                MPI_Isend(h_velocity_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    6,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_vel.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    6,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
-
+                postStageMessages(dir, h_velocity_copybuf.data, n_send, h_vel.data + start_idx, n_recv, 6);
 
             if (flags[comm_flag::orientation])
-                {
-                MPI_Isend(h_orientation_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    send_neighbor,
-                    7,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_orientation.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(Scalar4),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    7,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
+                postStageMessages(dir, h_orientation_copybuf.data, n_send, h_orientation.data + start_idx, n_recv, 7);
 
             if (flags[comm_flag::body])
-                {
-                MPI_Isend(h_body_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(unsigned int),
-                    MPI_BYTE,
-                    send_neighbor,
-                    8,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_body.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(unsigned int),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    8,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
+                postStageMessages(dir, h_body_copybuf.data, n_send, h_body.data + start_idx, n_recv, 8);
 
             if (flags[comm_flag::image])
-                {
-                MPI_Isend(h_image_copybuf.data,
-                    m_num_copy_ghosts[dir]*sizeof(int3),
-                    MPI_BYTE,
-                    send_neighbor,
-                    9,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                MPI_Irecv(h_image.data + start_idx,
-                    m_num_recv_ghosts[dir]*sizeof(int3),
-                    MPI_BYTE,
-                    recv_neighbor,
-                    9,
-                    m_mpi_comm,
-                    &req);
-                m_reqs.push_back(req);
-                }
+                postStageMessages(dir, h_image_copybuf.data, n_send, h_image.data + start_idx, n_recv, 9);
 
             m_stats.resize(m_reqs.size());
             MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+            if (staggered)
+                {
+                // the sender encoded the z itinerary inside this column in the column bits
+                for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+                    h_plan.data[idx] = translateStaggeredPlan(dir, h_plan.data[idx]);
+                }
             }
 
         if (m_prof)
@@ -2048,6 +2182,14 @@ void Communicator::exchangeGhosts()
 
     m_ghosts_added = m_pdata->getNGhosts();
 
+    if (staggered)
+        {
+        // the column bits are no longer needed
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
+        for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
+            h_plan.data[idx] &= (send_east | send_west | send_north | send_south | send_up | send_down);
+        }
+
     // exchange ghost constraints along with ghost particles
     m_constraint_comm.exchangeGhostGroups(m_plan, mask);
 
@@ -2372,15 +2514,8 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
             }
 
 
-        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
-
-        // we receive from the direction opposite to the one we send to
-        unsigned int recv_neighbor;
-        if (dir % 2 == 0)
-            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
-        else
-            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
-
+        const std::vector<unsigned int>& n_send = m_num_copy_ghosts_stage[dir];
+        const std::vector<unsigned int>& n_recv = m_num_recv_ghosts_stage[dir];
 
         unsigned int start_idx;
 
@@ -2396,48 +2531,45 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         // charge, body, image and diameter are not updated between neighbor list builds
         if (flags[comm_flag::position])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            m_reqs.clear();
 
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postStageMessages(dir, h_pos_copybuf.data, n_send, h_pos.data + start_idx, n_recv, 1);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::velocity])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            m_reqs.clear();
 
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postStageMessages(dir, h_vel_copybuf.data, n_send, h_vel.data + start_idx, n_recv, 2);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::orientation])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            m_reqs.clear();
 
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postStageMessages(dir, h_orientation_copybuf.data, n_send, h_orientation.data + start_idx, n_recv, 3);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
@@ -2656,6 +2788,9 @@ void Communicator::updateNetForce(unsigned int timestep)
         else
             recv_neighbor = m_decomposition->getNeighborRank(dir-1);
 
+        const std::vector<unsigned int>& n_send = m_num_copy_ghosts_stage[dir];
+        const std::vector<unsigned int>& n_recv = m_num_recv_ghosts_stage[dir];
+
         unsigned int start_idx;
 
         if (m_prof)
@@ -2669,15 +2804,14 @@ void Communicator::updateNetForce(unsigned int timestep)
         if (flags[comm_flag::net_force])
             {
             m_reqs.clear();
-            m_stats.clear();
 
             ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_netforce_copybuf(m_netforce_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_netforce_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_netforce.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postStageMessages(dir, h_netforce_copybuf.data, n_send, h_netforce.data + start_idx, n_recv, 1);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
@@ -2732,15 +2866,14 @@ void Communicator::updateNetForce(unsigned int timestep)
 
         if (flags[comm_flag::net_torque])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            m_reqs.clear();
 
             ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_nettorque_copybuf(m_nettorque_copybuf, access_location::host, access_mode::read);
 
-            MPI_Isend(h_nettorque_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_nettorque.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postStageMessages(dir, h_nettorque_copybuf.data, n_send, h_nettorque.data + start_idx, n_recv, 2);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
@@ -2748,15 +2881,14 @@ void Communicator::updateNetForce(unsigned int timestep)
         if (flags[comm_flag::net_virial])
             {
             m_netvirial_recvbuf.resize(6*m_num_recv_ghosts[dir]);
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            m_reqs.clear();
 
             ArrayHandle<Scalar> h_netvirial_recvbuf(m_netvirial_recvbuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar> h_netvirial_copybuf(m_netvirial_copybuf, access_location::host, access_mode::read);
 
-            MPI_Isend(h_netvirial_copybuf.data, 6*m_num_copy_ghosts[dir]*sizeof(Scalar), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_netvirial_recvbuf.data, 6*m_num_recv_ghosts[dir]*sizeof(Scalar), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            postStageMessages(dir, h_netvirial_copybuf.data, n_send, h_netvirial_recvbuf.data, n_recv, 3, 6);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             sz += 6*sizeof(Scalar);
             }
@@ -2788,6 +2920,66 @@ void Communicator::updateNetForce(unsigned int timestep)
             m_prof->pop();
     }
 
+void Communicator::updateGhostField(const GlobalArray<Scalar>& field)
+    {
+    assert(field.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push("comm_ghost_field");
+
+    m_exec_conf->msg->notice(7) << "Communicator: update ghost field" << std::endl;
+
+    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        m_field_copybuf.resize(m_num_copy_ghosts[dir]);
+
+            {
+            ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_field_copybuf(m_field_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+            // ghosts received in earlier stages are forwarded with their current values
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                h_field_copybuf.data[ghost_idx] = h_field.data[idx];
+                }
+            }
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+            {
+            m_reqs.clear();
+
+            ArrayHandle<Scalar> h_field(field, access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar> h_field_copybuf(m_field_copybuf, access_location::host, access_mode::read);
+
+            // exchange the field, write directly to the ghost entries of the array
+            postStageMessages(dir, h_field_copybuf.data, m_num_copy_ghosts_stage[dir], h_field.data + start_idx,
+                m_num_recv_ghosts_stage[dir], 1);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+            }
+
+        if (m_prof)
+            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sizeof(Scalar));
+        } // end dir loop
+
+    if (m_prof)
+        m_prof->pop();
+    }
 
 void Communicator::removeGhostParticleTags()
     {
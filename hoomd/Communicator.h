@@ -55,7 +55,7 @@ class Profiler;
 struct BoxDim;
 class ParticleData;
 
-// in 3d, there are 27 neighbors max.
+// in 3d, there are 27 neighbors max. on a Cartesian grid (staggered decompositions may have more)
 #define NEIGH_MAX 27
 
 //! Optional flags to enable communication of certain ParticleData fields for ghost particles
@@ -147,6 +147,12 @@ struct rank_element
  * In stage two and three, ghost atoms received from a neighboring processor are always included in the local
  * ghost atom lists, and they maybe replicated to more neighboring processors by the communication pattern
  * described above.
+ *
+ * In a staggered decomposition (see DomainDecomposition), the z cuts of adjacent columns are not aligned. The
+ * stages along x and y then exchange particles with all ranks of the neighboring column, and every particle is
+ * sent to the rank of that column which contains its z coordinate. The itinerary along z inside the neighboring
+ * column is computed by the sender with respect to the receiving rank, and it is carried in additional plan bits
+ * (see Enum) that the receiver translates into its own up/down bits.
  * \ingroup communication
  */
 class PYBIND11_EXPORT Communicator
@@ -181,6 +187,16 @@ class PYBIND11_EXPORT Communicator
             return m_migrate_requests;
             }
 
+        //! Subscribe to list of call-backs after particle migration
+        /*! Subscribers are called after the particles have been migrated and before the ghost particles are
+         * exchanged, i.e. while only local particles are present. They may reorder the local particles.
+         * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+         */
+        Nano::Signal<void (unsigned int timestep)>& getMigrateCallbackSignal()
+            {
+            return m_migrate_callbacks;
+            }
+
         //! Subscribe to list of functions that request a minimum ghost layer width
         /*! This method keeps track of all functions that request a minimum ghost layer width
          * The actual ghost layer width is chosen from the max over the inputs
@@ -321,6 +337,16 @@ class PYBIND11_EXPORT Communicator
          */
         virtual void updateNetForce(unsigned int timestep);
 
+        /*! Copy a per-particle field of the local particles to their ghost copies
+         * \param field Array of at least N + Nghosts values, indexed like the particle data
+         *
+         * This is used by force computes that need intermediate per-particle results of ghost particles
+         * in the middle of a force evaluation, e.g. the embedding function derivative of EAM.
+         *
+         * \pre The ghost exchange list has been constructed in this time step, using exchangeGhosts().
+         */
+        void updateGhostField(const GlobalArray<Scalar>& field);
+
         /*! This methods finds all the particles that are no longer inside the domain
          * boundaries and transfers them to neighboring processors.
          *
@@ -368,7 +394,13 @@ class PYBIND11_EXPORT Communicator
             send_north = 4,
             send_south = 8,
             send_up = 16,
-            send_down = 32
+            send_down = 32,
+            send_up_x = 64,       //!< Up in the column reached along x (staggered decomposition)
+            send_down_x = 128,    //!< Down in the column reached along x (staggered decomposition)
+            send_up_y = 256,      //!< Up in the column reached along y (staggered decomposition)
+            send_down_y = 512,    //!< Down in the column reached along y (staggered decomposition)
+            send_up_xy = 1024,    //!< Up in the column reached along x and y (staggered decomposition)
+            send_down_xy = 2048   //!< Down in the column reached along x and y (staggered decomposition)
             };
 
         //@}
@@ -456,6 +488,72 @@ class PYBIND11_EXPORT Communicator
         //! Helper function to update the shifted box for ghost particle PBC
         const BoxDim getShiftedBox() const;
 
+        //! Find the partner of a communication stage that a particle is sent to
+        unsigned int getStagePartner(unsigned int dir, const Scalar4& postype) const;
+
+        //! Compute the up/down plan bits of a ghost particle with respect to the receiving rank of a neighboring column
+        unsigned int getColumnGhostPlan(int dx, int dy, Scalar fz, Scalar ghost_frac_z) const;
+
+        //! Translate the column plan bits of ghosts received in a lateral stage of a staggered decomposition
+        static unsigned int translateStaggeredPlan(unsigned int dir, unsigned int plan)
+            {
+            const unsigned int column_bits = send_up_x | send_down_x | send_up_y | send_down_y | send_up_xy | send_down_xy;
+            unsigned int new_plan = plan & ~(column_bits | send_up | send_down);
+            if (dir == face_east || dir == face_west)
+                {
+                // the column reached along x becomes our own column, the diagonal column is reached along y
+                new_plan |= (plan & (send_up_x | send_down_x)) >> 2;
+                new_plan |= (plan & (send_up_xy | send_down_xy)) >> 2;
+                }
+            else if (dir == face_north || dir == face_south)
+                {
+                new_plan |= (plan & (send_up_y | send_down_y)) >> 4;
+                }
+            else
+                {
+                new_plan |= plan & (send_up | send_down);
+                }
+            return new_plan;
+            }
+
+        //! Exchange the number of elements sent to and received from every partner of a communication stage
+        void exchangeStageCounts(unsigned int dir, const std::vector<unsigned int>& n_send, std::vector<unsigned int>& n_recv);
+
+        //! Post non-blocking sends and receives for all partners of a communication stage
+        /*! \param dir Direction of the communication stage
+         *  \param sendbuf Send buffer, grouped by partner
+         *  \param n_send Number of elements sent to every partner
+         *  \param recvbuf Receive buffer, filled in the order of the partners
+         *  \param n_recv Number of elements received from every partner
+         *  \param tag The MPI message tag
+         *  \param width Number of values of type T per element
+         *
+         *  The requests are appended to m_reqs.
+         */
+        template<class T>
+        void postStageMessages(unsigned int dir, const T *sendbuf, const std::vector<unsigned int>& n_send,
+            T *recvbuf, const std::vector<unsigned int>& n_recv, int tag, unsigned int width = 1)
+            {
+            MPI_Request req;
+            unsigned int offset = 0;
+            for (unsigned int i = 0; i < m_stage_send_ranks[dir].size(); ++i)
+                {
+                MPI_Isend((void *)(sendbuf + width*offset), width*n_send[i]*sizeof(T), MPI_BYTE,
+                    m_stage_send_ranks[dir][i], tag, m_mpi_comm, &req);
+                m_reqs.push_back(req);
+                offset += n_send[i];
+                }
+
+            offset = 0;
+            for (unsigned int i = 0; i < m_stage_recv_ranks[dir].size(); ++i)
+                {
+                MPI_Irecv(recvbuf + width*offset, width*n_recv[i]*sizeof(T), MPI_BYTE,
+                    m_stage_recv_ranks[dir][i], tag, m_mpi_comm, &req);
+                m_reqs.push_back(req);
+                offset += n_recv[i];
+                }
+            }
+
         std::shared_ptr<SystemDefinition> m_sysdef;                 //!< System definition
         std::shared_ptr<ParticleData> m_pdata;                      //!< Particle data
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf;  //!< Execution configuration
@@ -489,11 +587,18 @@ class PYBIND11_EXPORT Communicator
         GlobalVector<Scalar4> m_nettorque_copybuf;   //!< Buffer for net torque
         GlobalVector<Scalar> m_netvirial_copybuf;   //!< Buffer for net virial
         GlobalVector<Scalar> m_netvirial_recvbuf;   //!< Buffer for net virial (receive)
+        GlobalVector<Scalar> m_field_copybuf;       //!< Buffer for per-particle fields of force computes
 
         GlobalVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
         unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
         unsigned int m_num_recv_ghosts[6];       //!< Number of ghosts received per direction
 
+        std::vector<unsigned int> m_stage_send_ranks[6];      //!< Ranks sent to in every direction
+        std::vector<unsigned int> m_stage_recv_ranks[6];      //!< Ranks received from in every direction
+        uint2 m_stage_column[6];                              //!< Grid column sent to in every direction
+        std::vector<unsigned int> m_num_copy_ghosts_stage[6]; //!< Number of ghosts sent to every partner per direction
+        std::vector<unsigned int> m_num_recv_ghosts_stage[6]; //!< Number of ghosts received from every partner per direction
+
         GlobalVector<unsigned int> m_plan;          //!< Array of per-direction flags that determine the sending route
 
         // Variables needed for sending ghost particles backwards
@@ -528,6 +633,9 @@ class PYBIND11_EXPORT Communicator
         Nano::Signal<bool(unsigned int timestep)>
             m_migrate_requests; //!< List of functions that may request particle migration
 
+        Nano::Signal<void (unsigned int timestep)>
+            m_migrate_callbacks; //!< List of functions that are called after particle migration
+
         Nano::Signal<CommFlags(unsigned int timestep) >
             m_requested_flags;  //!< List of functions that may request ghost communication flags
 
@@ -32,6 +32,12 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
       m_constraint_comm(*this, m_sysdef->getConstraintData()),
       m_pair_comm(*this, m_sysdef->getPairData())
     {
+    if (m_decomposition->isStaggered())
+        {
+        m_exec_conf->msg->error() << "comm: staggered domain decompositions are not supported on the GPU" << std::endl;
+        throw std::runtime_error("Error initializing communicator");
+        }
+
     if (m_exec_conf->allConcurrentManagedAccess())
         {
         // inform the user to use a cuda-aware MPI
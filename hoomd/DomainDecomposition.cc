@@ -35,7 +35,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                unsigned int nz,
                                bool twolevel
                                )
-      : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+      : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_staggered(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -64,7 +64,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          const std::vector<Scalar>& fxs,
                                          const std::vector<Scalar>& fys,
                                          const std::vector<Scalar>& fzs)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_staggered(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -515,6 +515,13 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
                 m_exec_conf->msg->error() << "comm: specified fractions are invalid" << std::endl;
                 throw std::runtime_error("comm: specified fractions are invalid");
                 }
+
+            // setting the z fractions aligns all columns of a staggered decomposition
+            if (m_staggered)
+                {
+                for (unsigned int col = 0; col < m_nx*m_ny; ++col)
+                    std::copy(m_cum_frac_z.begin(), m_cum_frac_z.end(), m_cum_frac_z_col.begin() + col*(m_nz+1));
+                }
             }
         }
     else // if no change, it's because things don't match up
@@ -524,6 +531,121 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
         }
     }
 
+/*!
+ * \param staggered If true, the z cuts can be adjusted independently in every column of the processor grid
+ *
+ * When the staggered decomposition is enabled, every column starts out with the current z cuts. Disabling it
+ * reverts all columns to the common z cuts. This method must be called on all ranks.
+ */
+void DomainDecomposition::setStaggered(bool staggered)
+    {
+    if (staggered == m_staggered)
+        return;
+
+    if (staggered)
+        {
+        m_cum_frac_z_col.resize(m_nx*m_ny*(m_nz+1));
+        for (unsigned int col = 0; col < m_nx*m_ny; ++col)
+            std::copy(m_cum_frac_z.begin(), m_cum_frac_z.end(), m_cum_frac_z_col.begin() + col*(m_nz+1));
+        }
+    else
+        {
+        m_cum_frac_z_col.clear();
+        }
+
+    m_staggered = staggered;
+    }
+
+/*!
+ * \param ix Grid position of the column along x
+ * \param iy Grid position of the column along y
+ * \returns Array of cumulative fractions of global box length below rank in the column
+ */
+std::vector<Scalar> DomainDecomposition::getColumnCumulativeFractions(unsigned int ix, unsigned int iy) const
+    {
+    if (!m_staggered)
+        return m_cum_frac_z;
+
+    assert(ix < m_nx && iy < m_ny);
+    std::vector<Scalar>::const_iterator begin = m_cum_frac_z_col.begin() + (iy*m_nx + ix)*(m_nz+1);
+    return std::vector<Scalar>(begin, begin + m_nz + 1);
+    }
+
+/*!
+ * \param cum_frac Cumulative fractions of all columns, each beginning with 0 and ending with 1, ordered by column
+ *        index ix + nx*iy
+ * \param root Rank to broadcast the set fractions from
+ *
+ * \note Setting the cumulative fractions is a collective call requiring all ranks to participate in order to keep the
+ *       decomposition properly synchronized between ranks.
+ */
+void DomainDecomposition::setColumnCumulativeFractions(const std::vector<Scalar>& cum_frac, unsigned int root)
+    {
+    if (!m_staggered)
+        {
+        m_exec_conf->msg->error() << "comm: column fractions require a staggered decomposition" << std::endl;
+        throw std::runtime_error("comm: column fractions require a staggered decomposition");
+        }
+
+    bool changed = false;
+    if (m_exec_conf->getRank() == root && cum_frac.size() == m_cum_frac_z_col.size())
+        {
+        m_cum_frac_z_col = cum_frac;
+        changed = true;
+        }
+
+    // sync the update from the root to all ranks
+    bcast(changed, root, m_mpi_comm);
+    if (!changed)
+        {
+        m_exec_conf->msg->error() << "comm: domain decomposition cannot change topology after construction" << std::endl;
+        throw std::runtime_error("comm: domain decomposition cannot change topology after construction");
+        }
+
+    MPI_Bcast(&m_cum_frac_z_col[0], m_cum_frac_z_col.size(), MPI_HOOMD_SCALAR, root, m_mpi_comm);
+
+    for (unsigned int col = 0; col < m_nx*m_ny; ++col)
+        {
+        if (m_cum_frac_z_col[col*(m_nz+1)] != Scalar(0.0) || m_cum_frac_z_col[col*(m_nz+1) + m_nz] != Scalar(1.0))
+            {
+            m_exec_conf->msg->error() << "comm: specified fractions are invalid" << std::endl;
+            throw std::runtime_error("comm: specified fractions are invalid");
+            }
+        }
+    }
+
+/*!
+ * \param ix Grid position of the column along x
+ * \param iy Grid position of the column along y
+ * \param fz Fractional z coordinate in the global box
+ * \returns Grid position along z of the domain that contains \a fz
+ *
+ * Coordinates outside the global box are assigned to the nearest domain of the column.
+ */
+unsigned int DomainDecomposition::getColumnDomain(unsigned int ix, unsigned int iy, Scalar fz) const
+    {
+    std::vector<Scalar>::const_iterator begin, end;
+    if (m_staggered)
+        {
+        begin = m_cum_frac_z_col.begin() + (iy*m_nx + ix)*(m_nz+1);
+        end = begin + m_nz + 1;
+        }
+    else
+        {
+        begin = m_cum_frac_z.begin();
+        end = m_cum_frac_z.end();
+        }
+
+    // the domain to place into is the one below the first cut that does not compare less than fz
+    int iz = std::lower_bound(begin, end, fz) - 1 - begin;
+    if (iz < 0)
+        iz = 0;
+    else if (iz >= (int)m_nz)
+        iz = m_nz - 1;
+
+    return iz;
+    }
+
 /*!
  * \param global_box The global simulation box
  * \returns The local simulation box for the current rank
@@ -535,10 +657,10 @@ const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim & global_box)
     Scalar3 L = global_box.getL();
 
     // position of this domain in the grid
-    Scalar3 lo_cum_frac = make_scalar3(m_cum_frac_x[m_grid_pos.x], m_cum_frac_y[m_grid_pos.y], m_cum_frac_z[m_grid_pos.z]);
+    Scalar3 lo_cum_frac = make_scalar3(m_cum_frac_x[m_grid_pos.x], m_cum_frac_y[m_grid_pos.y], getCumulativeFraction(2, m_grid_pos.z));
     Scalar3 lo = global_box.getLo() + lo_cum_frac * L;
 
-    Scalar3 hi_cum_frac = make_scalar3(m_cum_frac_x[m_grid_pos.x+1], m_cum_frac_y[m_grid_pos.y+1], m_cum_frac_z[m_grid_pos.z+1]);
+    Scalar3 hi_cum_frac = make_scalar3(m_cum_frac_x[m_grid_pos.x+1], m_cum_frac_y[m_grid_pos.y+1], getCumulativeFraction(2, m_grid_pos.z+1));
     Scalar3 hi = global_box.getLo() + hi_cum_frac * L;
 
     // set periodic flags
@@ -600,12 +722,8 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box, Scalar
     else if (iy >= (int)m_ny)
         iy--;
 
-    it = std::lower_bound(m_cum_frac_z.begin(), m_cum_frac_z.end(), f.z);
-    int iz = it - 1 - m_cum_frac_z.begin();
-    if (iz < 0)
-        iz++;
-    else if (iz >= (int)m_nz)
-        iz--;
+    // the z cuts depend on the column in a staggered decomposition
+    int iz = getColumnDomain(ix, iy, f.z);
 
     unsigned int rank = cart_ranks[m_index(ix, iy, iz)];
 
@@ -678,6 +796,9 @@ void export_DomainDecomposition(py::module& m)
               const std::vector<Scalar>&,
               const std::vector<Scalar>&>())
     .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
+    .def("isStaggered", &DomainDecomposition::isStaggered)
+    .def("setStaggered", &DomainDecomposition::setStaggered)
+    .def("getColumnCumulativeFractions", &DomainDecomposition::getColumnCumulativeFractions)
     ;
     }
 #endif // ENABLE_MPI
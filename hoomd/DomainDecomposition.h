@@ -44,6 +44,11 @@
  *  ranks does not match the number that is available, behavior is reverted to the normal default with
  *  uniform cuts along each dimension.
  *
+ *  In a staggered decomposition, the cut planes along x and y are shared by all ranks, but every column of
+ *  ranks along z has its own set of cut planes. The z cuts of neighboring columns need not be aligned, so that
+ *  the load can be balanced around interfaces that are not parallel to the grid planes. A rank then borders on
+ *  all ranks of the adjacent columns whose z interval overlaps its own.
+ *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
  */
 class PYBIND11_EXPORT DomainDecomposition
@@ -123,6 +128,8 @@ class PYBIND11_EXPORT DomainDecomposition
             else if (dir == 2)
                 {
                 assert(idx >= 0 && idx < m_nz+1);
+                if (m_staggered)
+                    return getColumnCumulativeFraction(m_grid_pos.x, m_grid_pos.y, idx);
                 return m_cum_frac_z[idx];
                 }
             else
@@ -136,11 +143,14 @@ class PYBIND11_EXPORT DomainDecomposition
         /*!
          * \param dir Direction (0=x, 1=y, 2=z) to get fraction
          * \returns Array of cumulative fractions of global box length below rank
+         *
+         * In a staggered decomposition, the z fractions of the column of this rank are returned.
          */
         std::vector<Scalar> getCumulativeFractions(unsigned int dir) const
             {
             if (dir == 0) return m_cum_frac_x;
             else if (dir == 1) return m_cum_frac_y;
+            else if (dir == 2 && m_staggered) return getColumnCumulativeFractions(m_grid_pos.x, m_grid_pos.y);
             else if (dir == 2) return m_cum_frac_z;
             else
                 {
@@ -152,6 +162,39 @@ class PYBIND11_EXPORT DomainDecomposition
         //! Collectively set the cumulative fractions along a dimension from a given rank
         void setCumulativeFractions(unsigned int dir, const std::vector<Scalar>& cum_frac, unsigned int root);
 
+        //! Returns true if the z cuts are set independently in every column of the processor grid
+        bool isStaggered() const
+            {
+            return m_staggered;
+            }
+
+        //! Enable or disable the staggered decomposition
+        void setStaggered(bool staggered);
+
+        //! Get the cumulative box fraction along z in a column of the processor grid
+        /*!
+         * \param ix Grid position of the column along x
+         * \param iy Grid position of the column along y
+         * \param idx The rank index to get the cumulative fraction below (0 to nz+1)
+         * \returns Cumulative fraction of global box length below rank at \a idx in the column
+         */
+        Scalar getColumnCumulativeFraction(unsigned int ix, unsigned int iy, unsigned int idx) const
+            {
+            assert(ix < m_nx && iy < m_ny && idx < m_nz+1);
+            if (!m_staggered)
+                return m_cum_frac_z[idx];
+            return m_cum_frac_z_col[(iy*m_nx + ix)*(m_nz+1) + idx];
+            }
+
+        //! Get the cumulative box fractions along z in a column of the processor grid
+        std::vector<Scalar> getColumnCumulativeFractions(unsigned int ix, unsigned int iy) const;
+
+        //! Collectively set the cumulative z fractions of all columns from a given rank
+        void setColumnCumulativeFractions(const std::vector<Scalar>& cum_frac, unsigned int root);
+
+        //! Get the grid position along z of the domain in a column that contains a fractional z coordinate
+        unsigned int getColumnDomain(unsigned int ix, unsigned int iy, Scalar fz) const;
+
         //! Get the dimensions of the local simulation box
         const BoxDim calculateLocalBox(const BoxDim& global_box);
 
@@ -211,6 +254,9 @@ class PYBIND11_EXPORT DomainDecomposition
         std::vector<Scalar> m_cum_frac_x;   //!< Cumulative fractions in x below cut plane index
         std::vector<Scalar> m_cum_frac_y;   //!< Cumulative fractions in y below cut plane index
         std::vector<Scalar> m_cum_frac_z;   //!< Cumulative fractions in z below cut plane index
+
+        bool m_staggered;                       //!< True if the z cuts are set per column of the processor grid
+        std::vector<Scalar> m_cum_frac_z_col;   //!< Cumulative fractions in z below cut plane index, per column
 #endif // ENABLE_MPI
    };
 
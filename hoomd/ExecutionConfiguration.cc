@@ -62,6 +62,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         msg = std::shared_ptr<Messenger>(new Messenger(m_mpi_config));
         }
 
+    m_memory_accounting = std::unique_ptr<MemoryAccounting>(new MemoryAccounting(msg));
+
     ostringstream s;
     for (auto it = gpu_id.begin(); it != gpu_id.end(); ++it)
         {
@@ -849,7 +851,9 @@ void export_ExecutionConfiguration(py::module& m)
 #endif
         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
-        .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer);
+        .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
+        .def("getMemoryAccounting", &ExecutionConfiguration::getMemoryAccounting,
+            py::return_value_policy::reference_internal);
     ;
 
     py::enum_<ExecutionConfiguration::executionMode>(executionconfiguration,"executionMode")
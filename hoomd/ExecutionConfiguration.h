@@ -31,6 +31,7 @@
 
 #include "Messenger.h"
 #include "MemoryTraceback.h"
+#include "MemoryAccounting.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -308,6 +309,12 @@ struct PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get();
         }
 
+    //! Returns the accounting of array allocations
+    MemoryAccounting& getMemoryAccounting() const
+        {
+        return *m_memory_accounting;
+        }
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -367,6 +374,7 @@ private:
     void setupStats();
 
     std::unique_ptr<MemoryTraceback> m_memory_traceback;    //!< Keeps track of allocations
+    std::unique_ptr<MemoryAccounting> m_memory_accounting;  //!< Counts the allocated bytes per array
     };
 
 // Macro for easy checking of CUDA errors - enabled all the time
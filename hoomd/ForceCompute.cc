@@ -17,6 +17,7 @@
 #endif
 
 #include <iostream>
+#include <stdexcept>
 using namespace std;
 
 namespace py = pybind11;
@@ -29,7 +30,7 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-     : Compute(sysdef), m_particles_sorted(false)
+     : Compute(sysdef), m_particles_sorted(false), m_mixed_precision_supported(false), m_mixed_precision(false)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -89,6 +90,17 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
     updateGPUAdvice();
     }
 
+/*! \param name Name of this instance, such as its log quantity
+
+    Derived class templates call this after construction, so that the memory accounting can tell their instances apart.
+*/
+void ForceCompute::tagForceAllocations(const std::string& name)
+    {
+    TAG_ALLOCATION_INSTANCE(m_force, name);
+    TAG_ALLOCATION_INSTANCE(m_virial, name);
+    TAG_ALLOCATION_INSTANCE(m_torque, name);
+    }
+
 /*! \post m_force, m_virial and m_torque are resized to the current maximum particle number
  */
 void ForceCompute::reallocate()
@@ -113,6 +125,41 @@ void ForceCompute::reallocate()
     updateGPUAdvice();
     }
 
+/*! \param mixed True to read the positions in single precision
+ */
+void ForceCompute::setMixedPrecision(bool mixed)
+    {
+    if (mixed && (!m_mixed_precision_supported || m_exec_conf->isCUDAEnabled()))
+        {
+        m_exec_conf->msg->error() << "This force does not support mixed precision" << endl;
+        throw std::runtime_error("Error setting mixed precision");
+        }
+
+    m_mixed_precision = mixed;
+    }
+
+/*! \post m_pos_mixed holds the positions of all local and ghost particles relative to the lower corner of the
+    local box in single precision, and their types in w
+ */
+void ForceCompute::updateMixedPositions()
+    {
+    const unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+    const Scalar3 lo = m_pdata->getBox().getLo();
+
+    if (m_pos_mixed.size() < n)
+        m_pos_mixed.resize(m_pdata->getMaxN());
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        const Scalar4& postype = h_pos.data[i];
+        m_pos_mixed[i] = make_float4(float(postype.x - lo.x),
+                                     float(postype.y - lo.y),
+                                     float(postype.z - lo.z),
+                                     __int_as_float(__scalar_as_int(postype.w)));
+        }
+    }
+
 void ForceCompute::updateGPUAdvice()
     {
     #ifdef ENABLE_CUDA
@@ -422,5 +469,7 @@ void export_ForceCompute(py::module& m)
     .def("calcEnergyGroup", &ForceCompute::calcEnergyGroup)
     .def("calcForceGroup", &ForceCompute::calcForceGroup)
     .def("calcVirialGroup", &ForceCompute::calcVirialGroup)
+    .def("setMixedPrecision", &ForceCompute::setMixedPrecision)
+    .def("getMixedPrecision", &ForceCompute::getMixedPrecision)
     ;
     }
@@ -19,6 +19,7 @@
 #endif
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file ForceCompute.h
@@ -63,6 +64,19 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             m_deltaT = dt;
             }
 
+        //! Enable or disable mixed precision
+        /*! In mixed precision, the force reads the positions in single precision relative to the origin of the local
+            box, and accumulates the forces, energies and virials in Scalar. The particle data and the integration
+            state are not affected. Only forces that set m_mixed_precision_supported accept it.
+        */
+        void setMixedPrecision(bool mixed);
+
+        //! Get whether mixed precision is enabled
+        bool getMixedPrecision() const
+            {
+            return m_mixed_precision;
+            }
+
         #ifdef ENABLE_MPI
         //! Pre-compute the forces
         /*! This method is called in MPI simulations BEFORE the particles are migrated
@@ -153,6 +167,12 @@ class PYBIND11_EXPORT ForceCompute : public Compute
 
     protected:
         bool m_particles_sorted;    //!< Flag set to true when particles are resorted in memory
+        bool m_mixed_precision_supported;   //!< True if the force implements mixed precision
+        bool m_mixed_precision;             //!< True if the positions are read in single precision
+        std::vector<float4> m_pos_mixed;    //!< Positions relative to the local box origin, with the type in w
+
+        //! Convert the positions of the local and ghost particles to single precision
+        void updateMixedPositions();
 
         //! Helper function called when particles are sorted
         /*! setParticlesSorted() is passed as a slot to the particle sort signal.
@@ -171,6 +191,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         //! Update GPU memory hints
         void updateGPUAdvice();
 
+        //! Append the name of this instance to the allocation tags of the force arrays
+        void tagForceAllocations(const std::string& name);
+
         Scalar m_deltaT;  //!< timestep size (required for some types of non-conservative forces)
 
         GlobalArray<Scalar4> m_force;            //!< m_force.x,m_force.y,m_force.z are the x,y,z components of the force, m_force.u is the PE
@@ -134,11 +134,20 @@ class host_deleter
         //! Ctor
         /*! \param exec_conf Execution configuration
             \param use_device whether the array is managed or on the host
+            \param N Number of elements
+            \param tag Tag under which the allocation is accounted
          */
-        host_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf, bool use_device, const unsigned int N)
-            : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N)
+        host_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf, bool use_device, const unsigned int N,
+            const std::string& tag)
+            : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N), m_tag(tag)
             { }
 
+        //! Set the tag under which the allocation is accounted
+        void setTag(const std::string& tag)
+            {
+            m_tag = tag;
+            }
+
         //! Delete the CUDA array
         /*! \param ptr Start of aligned memory allocation
          */
@@ -148,7 +157,10 @@ class host_deleter
                 return;
 
             if (m_exec_conf)
+                {
                 m_exec_conf->msg->notice(7) << "Freeing " << m_N*sizeof(T) << " bytes of host memory." << std::endl;
+                m_exec_conf->getMemoryAccounting().remove(m_tag, m_N*sizeof(T));
+                }
 
             #ifdef ENABLE_CUDA
             if (m_use_device)
@@ -169,6 +181,7 @@ class host_deleter
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
         bool m_use_device;     //!< Whether to use hostMallocManaged
         unsigned int m_N;      //!< Number of elements in array
+        std::string m_tag;     //!< Tag of the allocation
     };
 } // end namespace detail
 
@@ -476,6 +489,24 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
         //! Swap the pointers in two GPUArrays
         inline void swap(GPUArray& from);
 
+        //! Set the tag under which the host memory is accounted
+        /*! \param tag New tag of the array
+        */
+        void setTag(const std::string& tag)
+            {
+            if (h_data && m_exec_conf)
+                m_exec_conf->getMemoryAccounting().retag(m_tag, tag, m_num_elements*sizeof(T));
+            if (h_data)
+                h_data.get_deleter().setTag(tag);
+            m_tag = tag;
+            }
+
+        //! Get the tag under which the host memory is accounted
+        const std::string& getTag() const
+            {
+            return m_tag;
+            }
+
         //! Get the number of elements
         /*!
          - For 1-D allocated GPUArrays, this is the number of elements allocated.
@@ -567,6 +598,7 @@ class GPUArray : public GPUArrayBase<T, GPUArray<T> >
 #ifdef ENABLE_CUDA
         bool m_mapped;                          //!< True if we are using mapped memory
 #endif
+        std::string m_tag;                      //!< Tag under which the host memory is accounted
 
     // ok, this looks weird, but I want m_exec_conf to be protected and not have to go reorder all of the initializers
     protected:
@@ -752,6 +784,7 @@ template<class T> GPUArray<T>::GPUArray(const GPUArray& from) noexcept
 #ifdef ENABLE_CUDA
         m_mapped(from.m_mapped),
 #endif
+        m_tag(from.m_tag),
         m_exec_conf(from.m_exec_conf)
     {
     // allocate and clear new memory the same size as the data in from
@@ -781,6 +814,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
 #ifdef ENABLE_CUDA
         m_mapped = rhs.m_mapped;
 #endif
+        m_tag = rhs.m_tag;
         // initialize state variables
         m_data_location = data_location::host;
 
@@ -816,6 +850,9 @@ template<class T> GPUArray<T>::GPUArray(GPUArray&& from) noexcept
     m_data_location(std::move(from.m_data_location)),
 #ifdef ENABLE_CUDA
     m_mapped(std::move(from.m_mapped)),
+#endif
+    m_tag(std::move(from.m_tag)),
+#ifdef ENABLE_CUDA
     d_data(std::move(from.d_data)),
 #endif
     h_data(std::move(from.h_data)),
@@ -836,6 +873,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
         d_data = std::move(rhs.d_data);
     #endif
         h_data = std::move(rhs.h_data);
+        m_tag = std::move(rhs.m_tag);
         m_data_location = std::move(rhs.m_data_location);
         m_acquired = std::move(rhs.m_acquired);
         }
@@ -872,6 +910,7 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_mapped, from.m_mapped);
 #endif
     std::swap(h_data, from.h_data);
+    std::swap(m_tag, from.m_tag);
     }
 
 /*! \pre m_num_elements is set
@@ -928,9 +967,12 @@ template<class T> void GPUArray<T>::allocate()
 #endif
 
     // store in smart ptr with custom deleter
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements);
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements, m_tag);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T> >(reinterpret_cast<T *>(host_ptr), host_deleter);
 
+    if (m_exec_conf)
+        m_exec_conf->getMemoryAccounting().add(m_tag, m_num_elements*sizeof(T));
+
 #ifdef ENABLE_CUDA
     assert(!d_data);
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1251,9 +1293,12 @@ template<class T> T* GPUArray<T>::resizeHostArray(unsigned int num_elements)
 
     // update smart pointer
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements);
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements, m_tag);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T> >(h_tmp, host_deleter);
 
+    if (m_exec_conf)
+        m_exec_conf->getMemoryAccounting().add(m_tag, num_elements*sizeof(T));
+
 #ifdef ENABLE_CUDA
     // update device pointer
     if (m_mapped)
@@ -1310,9 +1355,12 @@ template<class T> T* GPUArray<T>::resize2DHostArray(unsigned int pitch, unsigned
 
     // update smart pointer
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch*new_height);
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch*new_height, m_tag);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T> >(h_tmp, host_deleter);
 
+    if (m_exec_conf)
+        m_exec_conf->getMemoryAccounting().add(m_tag, new_pitch*new_height*sizeof(T));
+
 #ifdef ENABLE_CUDA
     // update device pointer
     if (m_mapped)
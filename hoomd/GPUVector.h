@@ -238,9 +238,13 @@ void GPUVectorBase<T, Array>::reallocate(unsigned int size)
         // reallocate
         unsigned int new_allocated_size = Array::getNumElements() ? Array::getNumElements() : 1;
 
+        // grow more slowly when close to the memory budget
+        float factor = this->m_exec_conf ? this->m_exec_conf->getMemoryAccounting().getGrowthFactor(RESIZE_FACTOR)
+            : RESIZE_FACTOR;
+
         // double the size as often as necessary
         while (size > new_allocated_size)
-            new_allocated_size = ((unsigned int) (((float) new_allocated_size) * RESIZE_FACTOR)) + 1 ;
+            new_allocated_size = ((unsigned int) (((float) new_allocated_size) * factor)) + 1 ;
 
         // actually resize the underlying GPUArray
         Array::resize(new_allocated_size);
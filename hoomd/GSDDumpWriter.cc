@@ -22,6 +22,8 @@
 #include <string.h>
 #include <stdexcept>
 #include <list>
+#include <algorithm>
+#include <cerrno>
 using namespace std;
 namespace py = pybind11;
 
@@ -44,7 +46,17 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
-                        m_group(group)
+                        m_group(group),
+                        m_parallel_io(false),
+                        m_num_aggregators(0),
+                        m_async(false),
+                        m_max_queue(2),
+                        m_has_write_slots(false),
+                        m_nframes(0),
+                        m_writing(false),
+                        m_stop_writer(false),
+                        m_async_retval(0),
+                        m_async_errno(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
     }
@@ -136,6 +148,7 @@ void GSDDumpWriter::initFileIO()
         throw runtime_error("Error opening GSD file");
         }
 
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
     }
 
@@ -143,6 +156,12 @@ GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
 
+    // write out all queued frames before closing the file
+    stopWriterThread();
+    if (m_async_retval != 0)
+        m_exec_conf->msg->error() << "dump.gsd: error " << m_async_retval << " writing queued frames to " << m_fname
+                                  << endl;
+
     bool root=true;
     #ifdef ENABLE_MPI
     root = m_exec_conf->isRoot();
@@ -168,10 +187,18 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
+    // in parallel mode, every rank writes its own particles and no snapshot is gathered
+    bool parallel = false;
+#ifdef ENABLE_MPI
+    parallel = m_parallel_io && m_pdata->getDomainDecomposition();
+#endif
+
     // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
     SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
+    static const std::map<unsigned int, unsigned int> empty_map;
+    if (!parallel)
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+    const std::map<unsigned int, unsigned int>& map = parallel ? empty_map : m_pdata->takeSnapshot<float>(snapshot);
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -185,7 +212,11 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     // truncate the file if requested
     if (m_truncate && root)
         {
+        // the writer thread must not touch the handle while it is truncated
+        flush();
+
         m_exec_conf->msg->notice(10) << "dump.gsd: truncating file" << endl;
+        m_nframes = 0;
         retval = gsd_truncate(&m_handle);
         if (retval == -1)
             {
@@ -222,7 +253,7 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "dump.gsd: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -232,18 +263,32 @@ void GSDDumpWriter::analyze(unsigned int timestep)
 
     if (root)
         {
+        // queue the frame when possible, otherwise write it directly once all previous frames are on disk
+        if (m_async && !parallel && !m_truncate && !m_has_write_slots)
+            beginQueuedFrame();
+        else
+            flush();
+
         // write out the frame header on all frames
         writeFrameHeader(timestep);
 
         // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+        if (!parallel)
+            {
+            if (m_write_attribute || nframes == 0)
+                writeAttributes(snapshot, map);
+            if (m_write_property || nframes == 0)
+                writeProperties(snapshot, map);
+            if (m_write_momentum || nframes == 0)
+                writeMomenta(snapshot, map);
+            }
         }
 
+#ifdef ENABLE_MPI
+    if (parallel)
+        writeParticlesParallel(nframes);
+#endif
+
     // topology is only meaningful if this is the all group
     if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0))
         {
@@ -275,16 +320,196 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     writeUser(timestep, root);
 
     if (root)
+        endFrame();
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+
+/*! \param async True to write frames from a background thread
+    \param max_queue Maximum number of frames waiting to be written before analyze() blocks
+
+    In asynchronous mode, analyze() copies all chunks of the frame into a recycled buffer and hands it to a
+    background thread on the root rank, which writes it to the file. The simulation only waits for the file when
+    \a max_queue frames are already waiting. Frames are always written in order, and flush() waits for all of them.
+*/
+void GSDDumpWriter::setAsync(bool async, unsigned int max_queue)
+    {
+    if (max_queue == 0)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: max_queue must be at least 1" << endl;
+        throw runtime_error("Error setting up GSD file writes");
+        }
+
+    if (!async)
+        flush();
+
+    m_async = async;
+    m_max_queue = max_queue;
+    }
+
+/*! \param name Name of the chunk
+    \param type Type of the chunk data
+    \param N Number of rows
+    \param M Number of columns
+    \param data Chunk data
+
+    \returns The gsd error code when writing directly, 0 when queuing
+*/
+int GSDDumpWriter::writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data)
+    {
+    if (!m_frame)
+        return gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+
+    // reuse the chunk buffers of a previously written frame
+    if (m_frame->n_chunks == m_frame->chunks.size())
+        m_frame->chunks.push_back(ChunkBuffer());
+    ChunkBuffer& chunk = m_frame->chunks[m_frame->n_chunks];
+    m_frame->n_chunks++;
+
+    size_t size = gsd_sizeof_type(type) * N * M;
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    chunk.data.resize(size);
+    if (size > 0)
+        memcpy(&chunk.data[0], data, size);
+    return 0;
+    }
+
+void GSDDumpWriter::beginQueuedFrame()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+
+    // apply backpressure when the writer thread falls behind
+    if (m_queue.size() >= m_max_queue)
+        {
+        if (m_prof)
+            m_prof->push("Wait");
+        m_queue_cv.wait(lock, [this]{ return m_queue.size() < m_max_queue; });
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    if (m_free_frames.empty())
+        {
+        m_frame.reset(new FrameBuffer);
+        }
+    else
+        {
+        m_frame = std::move(m_free_frames.back());
+        m_free_frames.pop_back();
+        }
+    m_frame->n_chunks = 0;
+
+    if (!m_writer_thread.joinable())
+        {
+        m_stop_writer = false;
+        m_writer_thread = std::thread(&GSDDumpWriter::writerThreadFunc, this);
+        }
+    }
+
+void GSDDumpWriter::endFrame()
+    {
+    m_nframes++;
+
+    if (m_frame)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: queuing frame" << endl;
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_queue.push_back(std::move(m_frame));
+        lock.unlock();
+        m_queue_cv.notify_all();
+        }
+    else
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
+        int retval = gsd_end_frame(&m_handle);
         checkError(retval);
         }
+    }
 
-    if (m_prof)
-        m_prof->pop();
+/*! The writer thread owns m_handle while frames are queued. It stops writing after the first error, which
+    flush() reports on the main thread.
+*/
+void GSDDumpWriter::writerThreadFunc()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    while (true)
+        {
+        m_queue_cv.wait(lock, [this]{ return m_stop_writer || !m_queue.empty(); });
+        if (m_queue.empty())
+            break;
+
+        std::unique_ptr<FrameBuffer> frame = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writing = true;
+        bool failed = m_async_retval != 0;
+        lock.unlock();
+
+        int retval = 0;
+        int err = 0;
+        if (!failed)
+            {
+            for (unsigned int i = 0; i < frame->n_chunks && retval == 0; i++)
+                {
+                const ChunkBuffer& chunk = frame->chunks[i];
+                retval = gsd_write_chunk(&m_handle, chunk.name.c_str(), chunk.type, chunk.N, chunk.M, 0,
+                    chunk.data.size() ? &chunk.data[0] : NULL);
+                }
+            if (retval == 0)
+                retval = gsd_end_frame(&m_handle);
+            err = errno;
+            }
+
+        lock.lock();
+        if (retval != 0 && m_async_retval == 0)
+            {
+            m_async_retval = retval;
+            m_async_errno = err;
+            }
+        m_free_frames.push_back(std::move(frame));
+        m_writing = false;
+        m_queue_cv.notify_all();
+        }
     }
 
+void GSDDumpWriter::stopWriterThread()
+    {
+    if (!m_writer_thread.joinable())
+        return;
+
+    // the writer thread drains the queue before it exits
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_stop_writer = true;
+    lock.unlock();
+    m_queue_cv.notify_all();
+    m_writer_thread.join();
+    }
+
+void GSDDumpWriter::flush()
+    {
+    // drop a frame left incomplete by an exception in analyze()
+    m_frame.reset();
+
+    if (!m_writer_thread.joinable())
+        return;
+
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_queue_cv.wait(lock, [this]{ return m_queue.empty() && !m_writing; });
+
+    // report errors from the writer thread
+    int retval = m_async_retval;
+    if (retval != 0)
+        {
+        errno = m_async_errno;
+        m_async_retval = 0;
+        lock.unlock();
+        checkError(retval);
+        }
+    }
 
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
     {
@@ -300,7 +525,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle, chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, 0, (void *)&types[0]);
+        int retval = writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, (void *)&types[0]);
         checkError(retval);
         }
 
@@ -319,14 +544,14 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     int retval;
     m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
+    retval = writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void *)&step);
     checkError(retval);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/dimensions" << endl;
         uint8_t dimensions = m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
+        retval = writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, (void *)&dimensions);
         checkError(retval);
         }
 
@@ -339,12 +564,12 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     box_a[3] = box.getTiltFactorXY();
     box_a[4] = box.getTiltFactorXZ();
     box_a[5] = box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
+    retval = writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, (void *)box_a);
     checkError(retval);
 
     m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+    retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
     checkError(retval);
     }
 
@@ -356,7 +581,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -382,7 +607,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
+            retval = writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&type[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
@@ -411,7 +636,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
@@ -435,7 +660,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
@@ -460,7 +685,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
@@ -489,7 +714,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
+            retval = writeChunk("particles/body", GSD_TYPE_INT32, N, 1, (void *)&body[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
@@ -524,7 +749,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
@@ -540,7 +765,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -560,7 +785,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+        retval = writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
         checkError(retval);
         }
 
@@ -594,7 +819,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
@@ -610,7 +835,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -640,7 +865,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
@@ -677,7 +902,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
+            retval = writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
@@ -712,7 +937,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
+            retval = writeChunk("particles/image", GSD_TYPE_INT32, N, 3, (void *)&data[0]);
             checkError(retval);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
@@ -720,6 +945,318 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
     }
 
+#ifdef ENABLE_MPI
+/*! \param name Name of the chunk
+    \param type Type of the data in the chunk
+    \param M Number of columns in the chunk
+    \param data Rows held by this rank, in the order of m_file_row
+    \param all_default True if all rows on this rank hold the default value
+    \param nframes Number of frames in the file
+
+    The chunk is written if it holds a non-default value on any rank, or if it was present in frame 0. The root rank
+    reserves the space for the chunk in the file, and all ranks then write their rows collectively.
+*/
+template<class T>
+void GSDDumpWriter::writeChunkParallel(const char *name, gsd_type type, uint32_t M, const std::vector<T>& data,
+    bool all_default, uint64_t nframes)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    bool root = m_exec_conf->isRoot();
+
+    int local_default = all_default;
+    int global_default = 1;
+    MPI_Allreduce(&local_default, &global_default, 1, MPI_INT, MPI_LAND, mpi_comm);
+
+    bool write = false;
+    int64_t location = 0;
+    if (root)
+        {
+        write = !global_default || (nframes > 0 && m_nondefault[name]);
+        if (write)
+            {
+            m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << endl;
+            int retval = gsd_reserve_chunk(&m_handle, name, type, m_group->getNumMembersGlobal(), M, 0, &location);
+            checkError(retval);
+            if (nframes == 0)
+                m_nondefault[name] = true;
+            }
+        }
+
+    bcast(write, 0, mpi_comm);
+    if (!write)
+        return;
+    bcast(location, 0, mpi_comm);
+
+    // every row is placed at the position of the particle in the group
+    MPI_Aint row_size = M*sizeof(T);
+    std::vector<MPI_Aint> displacements(m_file_row.size());
+    for (unsigned int i = 0; i < m_file_row.size(); ++i)
+        displacements[i] = MPI_Aint(m_file_row[i])*row_size;
+
+    MPI_Datatype row_type, file_type;
+    MPI_Type_contiguous(row_size, MPI_BYTE, &row_type);
+    MPI_Type_commit(&row_type);
+    MPI_Type_create_hindexed_block(m_file_row.size(), 1, displacements.data(), row_type, &file_type);
+    MPI_Type_commit(&file_type);
+
+    MPI_File_set_view(m_mpi_file, location, row_type, file_type, "native", MPI_INFO_NULL);
+
+    MPI_Status status;
+    int retval = MPI_File_write_all(m_mpi_file, data.data(), m_file_row.size(), row_type, &status);
+
+    MPI_Type_free(&file_type);
+    MPI_Type_free(&row_type);
+
+    if (retval != MPI_SUCCESS)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: error writing " << name << " with MPI-IO - " << m_fname << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+    }
+
+/*! \param nframes Number of frames in the file
+
+    Writes the particle attributes, properties and momenta (as selected) without gathering a snapshot. Every rank
+    sorts its group members by their position in the group and writes them into the chunks reserved by the root rank
+    with collective MPI-IO, so that the file is identical to the one written by writeAttributes(), writeProperties()
+    and writeMomenta().
+*/
+void GSDDumpWriter::writeParticlesParallel(uint64_t nframes)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+    // the aggregators collect the data of the other ranks and perform the file access
+    MPI_Info info;
+    MPI_Info_create(&info);
+    if (m_num_aggregators > 0)
+        {
+        std::string cb_nodes = std::to_string(m_num_aggregators);
+        MPI_Info_set(info, "cb_nodes", cb_nodes.c_str());
+        MPI_Info_set(info, "romio_cb_write", "enable");
+        }
+
+    // the file name given on the root rank is authoritative
+    std::string fname = m_fname;
+    bcast(fname, 0, mpi_comm);
+
+    int retval = MPI_File_open(mpi_comm, fname.c_str(), MPI_MODE_WRONLY, info, &m_mpi_file);
+    MPI_Info_free(&info);
+    if (retval != MPI_SUCCESS)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: unable to open " << m_fname << " with MPI-IO" << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+
+    // sort the local members by their row in the file
+    unsigned int n_local = m_group->getNumMembers();
+        {
+        ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        const unsigned int *tags_begin = h_member_tags.data;
+        const unsigned int *tags_end = h_member_tags.data + m_group->getNumMembersGlobal();
+
+        std::vector< std::pair<unsigned int, unsigned int> > rows(n_local);
+        for (unsigned int j = 0; j < n_local; ++j)
+            {
+            unsigned int idx = h_member_idx.data[j];
+            unsigned int row = std::lower_bound(tags_begin, tags_end, h_tag.data[idx]) - tags_begin;
+            rows[j] = std::make_pair(row, idx);
+            }
+        std::sort(rows.begin(), rows.end());
+
+        m_file_row.resize(n_local);
+        m_local_idx.resize(n_local);
+        for (unsigned int j = 0; j < n_local; ++j)
+            {
+            m_file_row[j] = rows[j].first;
+            m_local_idx[j] = rows[j].second;
+            }
+        }
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 origin = m_pdata->getOrigin();
+    const int3 origin_image = m_pdata->getOriginImage();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+
+    // positions and images are written relative to the origin and wrapped into the global box, as in a snapshot
+    std::vector<float> pos(uint64_t(n_local)*3);
+    std::vector<int32_t> image(uint64_t(n_local)*3);
+    bool image_default = true;
+    for (unsigned int j = 0; j < n_local; ++j)
+        {
+        unsigned int idx = m_local_idx[j];
+        Scalar3 p = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+        int3 img = h_image.data[idx];
+        img.x -= origin_image.x;
+        img.y -= origin_image.y;
+        img.z -= origin_image.z;
+        global_box.wrap(p, img);
+
+        pos[j*3+0] = float(p.x);
+        pos[j*3+1] = float(p.y);
+        pos[j*3+2] = float(p.z);
+        image[j*3+0] = img.x;
+        image[j*3+1] = img.y;
+        image[j*3+2] = img.z;
+
+        if (img.x != 0 || img.y != 0 || img.z != 0)
+            image_default = false;
+        }
+
+    if (m_write_attribute || nframes == 0)
+        {
+        if (m_exec_conf->isRoot())
+            {
+            std::vector<std::string> type_mapping;
+            for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+                type_mapping.push_back(m_pdata->getNameByType(i));
+            writeTypeMapping("particles/types", type_mapping);
+            }
+
+            {
+            std::vector<uint32_t> type(n_local);
+            bool all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                type[j] = __scalar_as_int(h_pos.data[m_local_idx[j]].w);
+                if (type[j] != 0)
+                    all_default = false;
+                }
+            writeChunkParallel("particles/typeid", GSD_TYPE_UINT32, 1, type, all_default, nframes);
+            }
+
+            {
+            std::vector<float> data(n_local);
+            bool all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                data[j] = float(h_vel.data[m_local_idx[j]].w);
+                if (data[j] != float(1.0))
+                    all_default = false;
+                }
+            writeChunkParallel("particles/mass", GSD_TYPE_FLOAT, 1, data, all_default, nframes);
+
+            all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                data[j] = float(h_charge.data[m_local_idx[j]]);
+                if (data[j] != float(0.0))
+                    all_default = false;
+                }
+            writeChunkParallel("particles/charge", GSD_TYPE_FLOAT, 1, data, all_default, nframes);
+
+            all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                data[j] = float(h_diameter.data[m_local_idx[j]]);
+                if (data[j] != float(1.0))
+                    all_default = false;
+                }
+            writeChunkParallel("particles/diameter", GSD_TYPE_FLOAT, 1, data, all_default, nframes);
+            }
+
+            {
+            std::vector<int32_t> body(n_local);
+            bool all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                unsigned int b = h_body.data[m_local_idx[j]];
+                if (b != NO_BODY)
+                    all_default = false;
+                body[j] = int32_t(b);
+                }
+            writeChunkParallel("particles/body", GSD_TYPE_INT32, 1, body, all_default, nframes);
+            }
+
+            {
+            std::vector<float> data(uint64_t(n_local)*3);
+            bool all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                Scalar3 I = h_inertia.data[m_local_idx[j]];
+                data[j*3+0] = float(I.x);
+                data[j*3+1] = float(I.y);
+                data[j*3+2] = float(I.z);
+                if (data[j*3+0] != float(0.0) || data[j*3+1] != float(0.0) || data[j*3+2] != float(0.0))
+                    all_default = false;
+                }
+            writeChunkParallel("particles/moment_inertia", GSD_TYPE_FLOAT, 3, data, all_default, nframes);
+            }
+        }
+
+    if (m_write_property || nframes == 0)
+        {
+        writeChunkParallel("particles/position", GSD_TYPE_FLOAT, 3, pos, false, nframes);
+
+        std::vector<float> data(uint64_t(n_local)*4);
+        bool all_default = true;
+        for (unsigned int j = 0; j < n_local; ++j)
+            {
+            Scalar4 q = h_orientation.data[m_local_idx[j]];
+            data[j*4+0] = float(q.x);
+            data[j*4+1] = float(q.y);
+            data[j*4+2] = float(q.z);
+            data[j*4+3] = float(q.w);
+            if (data[j*4+0] != float(1.0) || data[j*4+1] != float(0.0) ||
+                data[j*4+2] != float(0.0) || data[j*4+3] != float(0.0))
+                all_default = false;
+            }
+        writeChunkParallel("particles/orientation", GSD_TYPE_FLOAT, 4, data, all_default, nframes);
+        }
+
+    if (m_write_momentum || nframes == 0)
+        {
+            {
+            std::vector<float> data(uint64_t(n_local)*3);
+            bool all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                Scalar4 v = h_vel.data[m_local_idx[j]];
+                data[j*3+0] = float(v.x);
+                data[j*3+1] = float(v.y);
+                data[j*3+2] = float(v.z);
+                if (data[j*3+0] != float(0.0) || data[j*3+1] != float(0.0) || data[j*3+2] != float(0.0))
+                    all_default = false;
+                }
+            writeChunkParallel("particles/velocity", GSD_TYPE_FLOAT, 3, data, all_default, nframes);
+            }
+
+            {
+            std::vector<float> data(uint64_t(n_local)*4);
+            bool all_default = true;
+            for (unsigned int j = 0; j < n_local; ++j)
+                {
+                Scalar4 a = h_angmom.data[m_local_idx[j]];
+                data[j*4+0] = float(a.x);
+                data[j*4+1] = float(a.y);
+                data[j*4+2] = float(a.z);
+                data[j*4+3] = float(a.w);
+                if (data[j*4+0] != float(0.0) || data[j*4+1] != float(0.0) ||
+                    data[j*4+2] != float(0.0) || data[j*4+3] != float(0.0))
+                    all_default = false;
+                }
+            writeChunkParallel("particles/angmom", GSD_TYPE_FLOAT, 4, data, all_default, nframes);
+            }
+
+        writeChunkParallel("particles/image", GSD_TYPE_INT32, 3, image, image_default, nframes);
+        }
+
+    // closing the file flushes the data before the root rank writes the frame index
+    MPI_File_close(&m_mpi_file);
+    }
+#endif
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -740,68 +1277,68 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, (void *)&bond.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
+        retval = writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, (void *)&bond.groups[0]);
         checkError(retval);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, (void *)&angle.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
+        retval = writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, (void *)&angle.groups[0]);
         checkError(retval);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, (void *)&dihedral.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, (void *)&dihedral.groups[0]);
         checkError(retval);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, (void *)&improper.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
+        retval = writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, (void *)&improper.groups[0]);
         checkError(retval);
         }
 
@@ -809,7 +1346,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
@@ -819,12 +1356,12 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle, "constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
+            retval = writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, (void *)&data[0]);
             checkError(retval);
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
+        retval = writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, (void *)&constraint.groups[0]);
         checkError(retval);
         }
 
@@ -832,17 +1369,17 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, (void *)&pair.type_id[0]);
         checkError(retval);
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle, "pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&pair.groups[0]);
+        retval = writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, (void *)&pair.groups[0]);
         checkError(retval);
         }
     }
@@ -920,7 +1457,7 @@ void GSDDumpWriter::writeUser(unsigned int timestep, bool root)
                 throw runtime_error("Invalid numpy dimension in gsd user-defined log data [" + item.first + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle, name.c_str(), type, arr.shape(0), M, 0, (void *)arr.data());
+            int retval = writeChunk(name.c_str(), type, arr.shape(0), M, (void *)arr.data());
             checkError(retval);
             }
         }
@@ -1010,6 +1547,8 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setParallelIO", &GSDDumpWriter::setParallelIO)
+        .def("setAsync", &GSDDumpWriter::setAsync)
         .def_readwrite("user_log", &GSDDumpWriter::m_user_log)
     ;
     }
@@ -11,6 +11,11 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -67,13 +72,34 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control parallel writes of per-particle data
+        /*! \param parallel_io True if every rank should write its own particles with collective MPI-IO
+            \param num_aggregators Number of ranks that perform the file access (0 lets MPI choose)
+        */
+        void setParallelIO(bool parallel_io, unsigned int num_aggregators)
+            {
+            m_parallel_io = parallel_io;
+            m_num_aggregators = num_aggregators;
+            }
+
+        //! Control asynchronous writes
+        void setAsync(bool async, unsigned int max_queue);
+
         //! Destructor
         ~GSDDumpWriter();
 
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
-        hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
+        //! Wait until all queued frames are written to the file
+        virtual void flush();
+
+        hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal()
+            {
+            // slots write directly to the handle, which is not possible while frames are queued
+            m_has_write_slots = true;
+            return m_write_signal;
+            }
 
     private:
         std::string m_fname;                //!< The file name we are writing to
@@ -92,6 +118,74 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        bool m_parallel_io;                 //!< True if per-particle chunks are written collectively by all ranks
+        unsigned int m_num_aggregators;     //!< Number of MPI-IO aggregators (0 for the MPI default)
+
+        //! One chunk of a frame waiting to be written
+        struct ChunkBuffer
+            {
+            std::string name;               //!< Chunk name
+            gsd_type type;                  //!< Data type
+            uint64_t N;                     //!< Number of rows
+            uint32_t M;                     //!< Number of columns
+            std::vector<char> data;         //!< Chunk data
+            };
+
+        //! All chunks of a frame waiting to be written
+        /*! Frame buffers are recycled after they are written, so \a chunks keeps its allocations from frame to
+            frame and only the first \a n_chunks entries are valid.
+        */
+        struct FrameBuffer
+            {
+            std::vector<ChunkBuffer> chunks;  //!< Chunks in the frame
+            unsigned int n_chunks;          //!< Number of valid entries in chunks
+            };
+
+        bool m_async;                       //!< True if frames are written by a background thread
+        unsigned int m_max_queue;           //!< Maximum number of frames waiting to be written
+        bool m_has_write_slots;             //!< True if a slot may be connected to m_write_signal
+        uint64_t m_nframes;                 //!< Number of frames in the file, including queued frames
+
+        std::unique_ptr<FrameBuffer> m_frame;   //!< Frame being filled by analyze() (null when writing directly)
+        std::deque< std::unique_ptr<FrameBuffer> > m_queue;        //!< Frames waiting to be written
+        std::vector< std::unique_ptr<FrameBuffer> > m_free_frames; //!< Written frames available for reuse
+        std::thread m_writer_thread;        //!< Background writer thread
+        std::mutex m_queue_mutex;           //!< Protects the queue, the free list, and the writer state
+        std::condition_variable m_queue_cv; //!< Signals changes to the queue
+        bool m_writing;                     //!< True while the writer thread writes a frame
+        bool m_stop_writer;                 //!< Set to request the writer thread to exit
+        int m_async_retval;                 //!< First error returned by gsd in the writer thread
+        int m_async_errno;                  //!< errno value at the time of m_async_retval
+
+        //! Write one chunk, or append it to m_frame when queuing
+        int writeChunk(const char *name, gsd_type type, uint64_t N, uint32_t M, const void *data);
+
+        //! Get a frame buffer to fill, blocking while the queue is full
+        void beginQueuedFrame();
+
+        //! End the current frame
+        void endFrame();
+
+        //! Body of the background writer thread
+        void writerThreadFunc();
+
+        //! Stop and join the background writer thread
+        void stopWriterThread();
+
+        #ifdef ENABLE_MPI
+        MPI_File m_mpi_file;                //!< MPI-IO handle of the file for the current frame
+        std::vector<unsigned int> m_local_idx;  //!< Local indices of the group members, sorted by the row in the file
+        std::vector<unsigned int> m_file_row;   //!< Row in the file of each entry in m_local_idx
+
+        //! Write per-particle data directly from every rank
+        void writeParticlesParallel(uint64_t nframes);
+
+        //! Write the rows of one per-particle chunk held by this rank
+        template<class T>
+        void writeChunkParallel(const char *name, gsd_type type, uint32_t M, const std::vector<T>& data,
+            bool all_default, uint64_t nframes);
+        #endif
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -13,6 +13,7 @@
 #include "ExecutionConfiguration.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
+#include <unistd.h>
 
 #include <stdexcept>
 using namespace std;
@@ -23,24 +24,28 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Read a part of the frame on every rank
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
-    memory (on the root rank).
+    memory (on the root rank, or distributed over all ranks).
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_N(0), m_distributed(distributed)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
+    #else
+    m_distributed = false;
     #endif
 
     // open the GSD file in read mode
@@ -110,7 +115,7 @@ GSDReader::~GSDReader()
     {
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -180,6 +185,99 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
         }
     }
 
+/*! \param data Pointer to data to read into
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param row_size Expected size of one row of the data chunk in bytes.
+    \param first_row First row to read
+    \param n_rows Number of rows to read
+    \param cur_n N in the current frame.
+
+    Same as readChunk(), but only reads the given rows directly from the file with pread, so that many ranks can
+    read different parts of a large chunk concurrently.
+*/
+bool GSDReader::readChunkRows(void *data, uint64_t frame, const char *name, size_t row_size, uint64_t first_row,
+    uint64_t n_rows, unsigned int cur_n)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading rows " << first_row << " to " << first_row + n_rows
+                                << " of chunk " << name << endl;
+    size_t actual_row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_row_size != row_size || first_row + n_rows > entry->N)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << row_size << " bytes per row in " << name
+                                  << " but found " << actual_row_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    size_t size = n_rows * row_size;
+    int64_t offset = entry->location + first_row * row_size;
+    size_t total = 0;
+    while (total < size)
+        {
+        ssize_t bytes_read = pread(m_handle.fd, (char *)data + total, size - total, offset + total);
+        if (bytes_read == -1)
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << strerror(errno) << " - " << m_name << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+        else if (bytes_read == 0)
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid GSD file " << m_name << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+        total += bytes_read;
+        }
+
+    return true;
+    }
+
+/*! \param N Number of rows in the chunk
+    \param first_row First row read by this rank
+    \param n_rows Number of rows read by this rank
+*/
+void GSDReader::getRowRange(uint64_t N, uint64_t& first_row, uint64_t& n_rows) const
+    {
+    first_row = 0;
+    n_rows = N;
+
+    #ifdef ENABLE_MPI
+    if (m_distributed)
+        {
+        uint64_t rank = m_exec_conf->getRank();
+        uint64_t size = m_exec_conf->getNRanks();
+        first_row = N * rank / size;
+        n_rows = N * (rank + 1) / size - first_row;
+        }
+    #endif
+    }
+
+/*! \param data Pointer to data to read into
+    \param name Name of the data chunk
+    \param row_size Size of one row of the data chunk in bytes.
+    \param N Number of rows of the chunk in the current frame
+
+    Reads the whole chunk, or only the rows of this rank in distributed mode.
+*/
+bool GSDReader::readRows(void *data, const char *name, size_t row_size, uint64_t N)
+    {
+    if (!m_distributed)
+        return readChunk(data, m_frame, name, N*row_size, N);
+
+    uint64_t first_row, n_rows;
+    getRowRange(N, first_row, n_rows);
+    return readChunkRows(data, m_frame, name, row_size, first_row, n_rows, N);
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -264,86 +362,116 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_N = N;
+
+    uint64_t first_row, n_rows;
+    getRowRange(N, first_row, n_rows);
+    m_snapshot->particle_data.resize(n_rows);
     }
 
 /*! Read the same data chunks for particles
 */
 void GSDReader::readParticles()
     {
-    uint64_t N = m_snapshot->particle_data.size;
+    uint64_t N = m_N;
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
+    // a rank may hold no particles in distributed mode
+    if (m_snapshot->particle_data.size == 0)
+        return;
+
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N*4, N);
-    readChunk(&m_snapshot->particle_data.mass[0], m_frame, "particles/mass", N*4, N);
-    readChunk(&m_snapshot->particle_data.charge[0], m_frame, "particles/charge", N*4, N);
-    readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N*4, N);
-    readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N*4, N);
-    readChunk(&m_snapshot->particle_data.inertia[0], m_frame, "particles/moment_inertia", N*12, N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N*12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0], m_frame, "particles/orientation", N*16, N);
-    readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N*12, N);
-    readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N*16, N);
-    readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
+    readRows(&m_snapshot->particle_data.type[0], "particles/typeid", 4, N);
+    readRows(&m_snapshot->particle_data.mass[0], "particles/mass", 4, N);
+    readRows(&m_snapshot->particle_data.charge[0], "particles/charge", 4, N);
+    readRows(&m_snapshot->particle_data.diameter[0], "particles/diameter", 4, N);
+    readRows(&m_snapshot->particle_data.body[0], "particles/body", 4, N);
+    readRows(&m_snapshot->particle_data.inertia[0], "particles/moment_inertia", 12, N);
+    readRows(&m_snapshot->particle_data.pos[0], "particles/position", 12, N);
+    readRows(&m_snapshot->particle_data.orientation[0], "particles/orientation", 16, N);
+    readRows(&m_snapshot->particle_data.vel[0], "particles/velocity", 12, N);
+    readRows(&m_snapshot->particle_data.angmom[0], "particles/angmom", 16, N);
+    readRows(&m_snapshot->particle_data.image[0], "particles/image", 12, N);
     }
 
 /*! Read the same data chunks for topology
 */
 void GSDReader::readTopology()
     {
+    uint64_t first_row, n_rows;
+
     uint64_t N = 0;
     readChunk(&N, m_frame, "bonds/N", 4);
     if (N > 0)
         {
-        m_snapshot->bond_data.resize(N);
+        getRowRange(N, first_row, n_rows);
+        m_snapshot->bond_data.resize(n_rows);
         m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
-        readChunk(&m_snapshot->bond_data.type_id[0], m_frame, "bonds/typeid", N*4, N);
-        readChunk(&m_snapshot->bond_data.groups[0], m_frame, "bonds/group", N*8, N);
+        if (n_rows > 0)
+            {
+            readRows(&m_snapshot->bond_data.type_id[0], "bonds/typeid", 4, N);
+            readRows(&m_snapshot->bond_data.groups[0], "bonds/group", 8, N);
+            }
         }
 
     N = 0;
     readChunk(&N, m_frame, "angles/N", 4);
     if (N > 0)
         {
-        m_snapshot->angle_data.resize(N);
+        getRowRange(N, first_row, n_rows);
+        m_snapshot->angle_data.resize(n_rows);
         m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
-        readChunk(&m_snapshot->angle_data.type_id[0], m_frame, "angles/typeid", N*4, N);
-        readChunk(&m_snapshot->angle_data.groups[0], m_frame, "angles/group", N*12, N);
+        if (n_rows > 0)
+            {
+            readRows(&m_snapshot->angle_data.type_id[0], "angles/typeid", 4, N);
+            readRows(&m_snapshot->angle_data.groups[0], "angles/group", 12, N);
+            }
         }
 
     N = 0;
     readChunk(&N, m_frame, "dihedrals/N", 4);
     if (N > 0)
         {
-        m_snapshot->dihedral_data.resize(N);
+        getRowRange(N, first_row, n_rows);
+        m_snapshot->dihedral_data.resize(n_rows);
         m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
-        readChunk(&m_snapshot->dihedral_data.type_id[0], m_frame, "dihedrals/typeid", N*4, N);
-        readChunk(&m_snapshot->dihedral_data.groups[0], m_frame, "dihedrals/group", N*16, N);
+        if (n_rows > 0)
+            {
+            readRows(&m_snapshot->dihedral_data.type_id[0], "dihedrals/typeid", 4, N);
+            readRows(&m_snapshot->dihedral_data.groups[0], "dihedrals/group", 16, N);
+            }
         }
 
     N = 0;
     readChunk(&N, m_frame, "impropers/N", 4);
     if (N > 0)
         {
-        m_snapshot->improper_data.resize(N);
+        getRowRange(N, first_row, n_rows);
+        m_snapshot->improper_data.resize(n_rows);
         m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
-        readChunk(&m_snapshot->improper_data.type_id[0], m_frame, "impropers/typeid", N*4, N);
-        readChunk(&m_snapshot->improper_data.groups[0], m_frame, "impropers/group", N*16, N);
+        if (n_rows > 0)
+            {
+            readRows(&m_snapshot->improper_data.type_id[0], "impropers/typeid", 4, N);
+            readRows(&m_snapshot->improper_data.groups[0], "impropers/group", 16, N);
+            }
         }
 
     N = 0;
     readChunk(&N, m_frame, "constraints/N", 4);
     if (N > 0)
         {
-        m_snapshot->constraint_data.resize(N);
-        std::vector<float> data(N);
-        readChunk(&data[0], m_frame, "constraints/value", N*4, N);
-        for (unsigned int i=0; i < N; i++)
-            m_snapshot->constraint_data.val[i] = Scalar(data[i]);
+        getRowRange(N, first_row, n_rows);
+        m_snapshot->constraint_data.resize(n_rows);
+        if (n_rows > 0)
+            {
+            std::vector<float> data(n_rows);
+            readRows(&data[0], "constraints/value", 4, N);
+            for (unsigned int i=0; i < n_rows; i++)
+                m_snapshot->constraint_data.val[i] = Scalar(data[i]);
 
-        readChunk(&m_snapshot->constraint_data.groups[0], m_frame, "constraints/group", N*8, N);
+            readRows(&m_snapshot->constraint_data.groups[0], "constraints/group", 8, N);
+            }
         }
 
     if (m_handle.header.schema_version >= gsd_make_version(1,1))
@@ -352,10 +480,14 @@ void GSDReader::readTopology()
         readChunk(&N, m_frame, "pairs/N", 4);
         if (N > 0)
             {
-            m_snapshot->pair_data.resize(N);
+            getRowRange(N, first_row, n_rows);
+            m_snapshot->pair_data.resize(n_rows);
             m_snapshot->pair_data.type_mapping = readTypes(m_frame, "pairs/types");
-            readChunk(&m_snapshot->pair_data.type_id[0], m_frame, "pairs/typeid", N*4, N);
-            readChunk(&m_snapshot->pair_data.groups[0], m_frame, "pairs/group", N*8, N);
+            if (n_rows > 0)
+                {
+                readRows(&m_snapshot->pair_data.type_id[0], "pairs/typeid", 4, N);
+                readRows(&m_snapshot->pair_data.groups[0], "pairs/group", 8, N);
+                }
             }
         }
     }
@@ -373,6 +505,7 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
@@ -30,6 +30,10 @@ template <class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    When \a distributed is set, every rank opens the file and reads only a contiguous range of the particles and
+    bonded groups into its snapshot. Pass the snapshot to SystemDefinition with \a distributed set to initialize
+    the system without assembling it on the root rank.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -39,7 +43,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool distributed=false);
 
         //! Destructor
         ~GSDReader();
@@ -73,6 +78,16 @@ class PYBIND11_EXPORT GSDReader
         //! Helper function to read a quantity from the file
         bool readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n=0);
 
+        //! Helper function to read a range of rows of a quantity from the file
+        bool readChunkRows(void *data, uint64_t frame, const char *name, size_t row_size, uint64_t first_row,
+            uint64_t n_rows, unsigned int cur_n);
+
+        //! Test if every rank reads a part of the frame
+        bool isDistributed() const
+            {
+            return m_distributed;
+            }
+
         //! clears the snapshot object
         void clearSnapshot()
             {
@@ -92,8 +107,16 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_timestep;                                         //!< Timestep at the selected frame
         std::string m_name;                                          //!< Cached file name
         uint64_t m_frame;                                            //!< Cached frame
+        uint64_t m_N;                                                //!< Number of particles in the frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_distributed;                                          //!< True if every rank reads a part of the frame
+
+        //! Get the range of rows of an \a N row chunk read by this rank
+        void getRowRange(uint64_t N, uint64_t& first_row, uint64_t& n_rows) const;
+
+        //! Helper function to read this rank's rows of a per-particle or per-group quantity
+        bool readRows(void *data, const char *name, size_t row_size, uint64_t N);
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
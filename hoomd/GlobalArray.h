@@ -52,8 +52,16 @@
         } \
     }
 
+//! Tag an array with its name, qualified by the class of the calling member function
 #define TAG_ALLOCATION(array) { \
-    array.setTag(std::string(#array)); \
+    array.setTag(hoomd::detail::make_allocation_tag(__PRETTY_FUNCTION__, #array)); \
+    }
+
+//! Tag an array like TAG_ALLOCATION, followed by the name of the instance that owns it
+/*! Use this in class templates and other classes with many instances, whose arrays would otherwise share one tag.
+*/
+#define TAG_ALLOCATION_INSTANCE(array, name) { \
+    array.setTag(hoomd::detail::make_allocation_tag(__PRETTY_FUNCTION__, #array) + " [" + (name) + "]"); \
     }
 
 namespace hoomd
@@ -61,6 +69,42 @@ namespace hoomd
 namespace detail
 {
 
+//! Build the tag of an array from the signature of the function that tags it
+/*! \param function Signature of the calling function, as given by __PRETTY_FUNCTION__
+    \param array Name of the array
+    \returns <code>Class::array</code> when called from a member function, otherwise \a array
+*/
+inline std::string make_allocation_tag(const char *function, const char *array)
+    {
+    // qualified name of the function, without the return type and the argument list
+    std::string name(function);
+    name = name.substr(0, name.find('('));
+
+    int depth = 0;
+    size_t start = 0;
+    size_t scope = std::string::npos;
+    for (size_t i = name.size(); i > 0; --i)
+        {
+        char c = name[i-1];
+        if (c == '>')
+            depth++;
+        else if (c == '<')
+            depth--;
+        else if (depth == 0 && c == ' ')
+            {
+            start = i;
+            break;
+            }
+        else if (depth == 0 && c == ':' && scope == std::string::npos && i >= 2 && name[i-2] == ':')
+            scope = i-2;
+        }
+
+    if (scope == std::string::npos || scope < start)
+        return std::string(array);
+
+    return name.substr(start, scope - start) + "::" + array;
+    }
+
 #ifdef __GNUC__
 #define GCC_VERSION (__GNUC__ * 10000 \
                      + __GNUC_MINOR__ * 100 \
@@ -155,6 +199,8 @@ class managed_deleter
             if (m_exec_conf->getMemoryTracer())
                 this->m_exec_conf->getMemoryTracer()->unregisterAllocation(reinterpret_cast<const void *>(ptr),
                     sizeof(T)*m_N);
+
+            this->m_exec_conf->getMemoryAccounting().remove(m_tag, sizeof(T)*m_N);
             }
 
     private:
@@ -235,7 +281,10 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             {
             #ifndef ALWAYS_USE_MANAGED_MEMORY
             if (!(m_is_managed))
+                {
+                m_fallback.setTag(m_tag);
                 return;
+                }
             #endif
 
             assert(this->m_exec_conf);
@@ -613,6 +662,14 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
          */
         inline void setTag(const std::string& tag)
             {
+            #ifndef ALWAYS_USE_MANAGED_MEMORY
+            // the host memory of the fallback is accounted by the GPUArray
+            m_fallback.setTag(tag);
+            #endif
+
+            if (this->m_exec_conf && get())
+                this->m_exec_conf->getMemoryAccounting().retag(m_tag, tag, sizeof(T)*m_num_elements);
+
             // update the tag
             m_tag = tag;
             if (this->m_exec_conf && this->m_exec_conf->getMemoryTracer() && get() )
@@ -624,6 +681,12 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 m_data.get_deleter().setTag(tag);
             }
 
+        //! Get the tag under which the memory is accounted
+        const std::string& getTag() const
+            {
+            return m_tag;
+            }
+
     protected:
         inline ArrayHandleDispatch<T> acquire(const access_location::Enum location, const access_mode::Enum mode
         #ifdef ENABLE_CUDA
@@ -755,6 +818,9 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             if (this->m_exec_conf && this->m_exec_conf->getMemoryTracer())
                 this->m_exec_conf->getMemoryTracer()->registerAllocation(reinterpret_cast<const void *>(m_data.get()),
                     sizeof(T)*m_num_elements, typeid(T).name(), m_tag);
+
+            if (this->m_exec_conf)
+                this->m_exec_conf->getMemoryAccounting().add(m_tag, sizeof(T)*m_num_elements);
             }
     };
 
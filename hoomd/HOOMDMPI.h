@@ -24,6 +24,9 @@
 
 #include <sstream>
 #include <vector>
+#include <string.h>
+#include <climits>
+#include <algorithm>
 
 #include <cereal/types/set.hpp>
 #include <cereal/types/string.hpp>
@@ -416,6 +419,84 @@ void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm
     delete[] rbuf;
     }
 
+//! Wrapper around MPI_Alltoallv for vectors of plain data
+/*! \param in_values Values to send to every rank, indexed by destination rank
+    \param out_values Values received from every rank, indexed by source rank
+
+    Unlike the other wrappers, the data is sent as raw bytes without serialization, so T must be trivially copyable.
+
+    MPI counts and displacements are of type int, so the data is exchanged in as many rounds as needed for the bytes
+    of one round to stay below INT_MAX on every rank.
+*/
+template<typename T>
+void alltoall_v(const std::vector< std::vector<T> >& in_values, std::vector< std::vector<T> >& out_values,
+    const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+
+    std::vector<unsigned long long> send_bytes(size);
+    std::vector<unsigned long long> recv_bytes(size);
+
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        send_bytes[i] = (unsigned long long) in_values[i].size()*sizeof(T);
+
+    // exchange lengths of buffers
+    MPI_Alltoall(&send_bytes[0], 1, MPI_UNSIGNED_LONG_LONG, &recv_bytes[0], 1, MPI_UNSIGNED_LONG_LONG, mpi_comm);
+
+    out_values.resize(size);
+    unsigned long long max_bytes = 0;
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        {
+        out_values[i].resize(recv_bytes[i]/sizeof(T));
+        max_bytes = std::max(max_bytes, std::max(send_bytes[i], recv_bytes[i]));
+        }
+
+    // bytes exchanged with every rank per round, so that the counts and displacements of a round fit into an int
+    const unsigned long long chunk = (unsigned long long) INT_MAX / (unsigned long long) size;
+    unsigned long long n_rounds = (max_bytes + chunk - 1) / chunk;
+    MPI_Allreduce(MPI_IN_PLACE, &n_rounds, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, mpi_comm);
+
+    std::vector<int> send_counts(size);
+    std::vector<int> recv_counts(size);
+    std::vector<int> send_displs(size);
+    std::vector<int> recv_displs(size);
+    std::vector<char> sbuf;
+    std::vector<char> rbuf;
+
+    for (unsigned long long round = 0; round < n_rounds; round++)
+        {
+        const unsigned long long offset = round*chunk;
+
+        size_t send_len = 0;
+        size_t recv_len = 0;
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            {
+            send_counts[i] = (send_bytes[i] > offset) ? (int) std::min(chunk, send_bytes[i] - offset) : 0;
+            recv_counts[i] = (recv_bytes[i] > offset) ? (int) std::min(chunk, recv_bytes[i] - offset) : 0;
+            send_displs[i] = (int) send_len;
+            recv_displs[i] = (int) recv_len;
+            send_len += send_counts[i];
+            recv_len += recv_counts[i];
+            }
+
+        // pack send buffer
+        sbuf.resize(send_len);
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            if (send_counts[i])
+                memcpy(&sbuf[send_displs[i]], (const char *) &in_values[i][0] + offset, send_counts[i]);
+
+        rbuf.resize(recv_len);
+        MPI_Alltoallv(send_len ? &sbuf[0] : NULL, &send_counts[0], &send_displs[0], MPI_BYTE,
+            recv_len ? &rbuf[0] : NULL, &recv_counts[0], &recv_displs[0], MPI_BYTE, mpi_comm);
+
+        // unpack receive buffer
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            if (recv_counts[i])
+                memcpy((char *) &out_values[i][0] + offset, &rbuf[recv_displs[i]], recv_counts[i]);
+        }
+    }
+
 //! Wrapper around MPI_Send that handles any serializable object
 template<typename T>
 void send(const T& val,const unsigned int dest, const MPI_Comm mpi_comm)
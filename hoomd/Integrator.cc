@@ -20,6 +20,8 @@ namespace py = pybind11;
 #include "Communicator.h"
 #endif
 
+#include <algorithm>
+
 using namespace std;
 
 /*! \param sysdef System to update
@@ -48,9 +50,57 @@ void Integrator::addForceCompute(std::shared_ptr<ForceCompute> fc)
     {
     assert(fc);
     m_forces.push_back(fc);
+    m_force_periods.push_back(1);
     fc->setDeltaT(m_deltaT);
     }
 
+/*! \param fc ForceCompute previously added with addForceCompute()
+    \param period Evaluate the force every \a period time steps
+
+    The force is evaluated on time steps that are a multiple of \a period and is then applied as an impulse
+    scaled by \a period.
+*/
+void Integrator::setForcePeriod(std::shared_ptr<ForceCompute> fc, unsigned int period)
+    {
+    if (period == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.*: The period of a force must be at least 1" << endl;
+        throw runtime_error("Error setting force period");
+        }
+
+    if (period > 1 && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "integrate.*: Multiple time step integration is not supported on the GPU"
+            << endl;
+        throw runtime_error("Error setting force period");
+        }
+
+    std::vector< std::shared_ptr<ForceCompute> >::iterator it = std::find(m_forces.begin(), m_forces.end(), fc);
+    if (it == m_forces.end())
+        {
+        m_exec_conf->msg->error() << "integrate.*: Setting the period of a force that is not active" << endl;
+        throw runtime_error("Error setting force period");
+        }
+
+    m_force_periods[it - m_forces.begin()] = period;
+    }
+
+/*! \param i Index of the force compute in m_forces
+    \param timestep Current time step
+
+    \returns True if the force is applied at \a timestep, or if the energy and virial are needed for logging
+*/
+bool Integrator::isForceEvaluated(unsigned int i, unsigned int timestep)
+    {
+    unsigned int period = m_force_periods[i];
+    if (period == 1 || timestep % period == 0)
+        return true;
+
+    PDataFlags flags = m_pdata->getFlags();
+    return flags[pdata_flag::potential_energy] || flags[pdata_flag::pressure_tensor]
+        || flags[pdata_flag::isotropic_virial];
+    }
+
 /*! \param fc ForceConstraint to add
 */
 void Integrator::addForceConstraint(std::shared_ptr<ForceConstraint> fc)
@@ -74,6 +124,7 @@ void Integrator::setHalfStepHook(std::shared_ptr<HalfStepHook> hook)
 void Integrator::removeForceComputes()
     {
     m_forces.clear();
+    m_force_periods.clear();
     m_constraint_forces.clear();
     }
 
@@ -309,9 +360,11 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    for (unsigned int i = 0; i < m_forces.size(); ++i)
+        {
+        if (isForceEvaluated(i, timestep))
+            m_forces[i]->compute(timestep);
+        }
 
     if (m_prof)
         {
@@ -349,11 +402,19 @@ void Integrator::computeNetForce(unsigned int timestep)
         assert(6*nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        for (unsigned int i = 0; i < m_forces.size(); ++i)
             {
-            GlobalArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GlobalArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GlobalArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
+            if (! isForceEvaluated(i, timestep))
+                continue;
+
+            // forces with a period > 1 act as an impulse on every period-th step, and otherwise only contribute
+            // their energy and virial
+            unsigned int period = m_force_periods[i];
+            Scalar impulse = (timestep % period == 0) ? Scalar(period) : Scalar(0.0);
+
+            GlobalArray<Scalar4>& h_force_array = m_forces[i]->getForceArray();
+            GlobalArray<Scalar>& h_virial_array = m_forces[i]->getVirialArray();
+            GlobalArray<Scalar4>& h_torque_array = m_forces[i]->getTorqueArray();
 
             assert(nparticles <= h_force_array.getNumElements());
             assert(6*nparticles <= h_virial_array.getNumElements());
@@ -366,15 +427,15 @@ void Integrator::computeNetForce(unsigned int timestep)
             unsigned int virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += impulse*h_force.data[j].x;
+                h_net_force.data[j].y += impulse*h_force.data[j].y;
+                h_net_force.data[j].z += impulse*h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
+                h_net_torque.data[j].x += impulse*h_torque.data[j].x;
+                h_net_torque.data[j].y += impulse*h_torque.data[j].y;
+                h_net_torque.data[j].z += impulse*h_torque.data[j].z;
+                h_net_torque.data[j].w += impulse*h_torque.data[j].w;
 
                 for (unsigned int k = 0; k < 6; k++)
                     {
@@ -383,9 +444,9 @@ void Integrator::computeNetForce(unsigned int timestep)
                 }
 
             for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
+                external_virial[k] += m_forces[i]->getExternalVirial(k);
 
-            external_energy += (*force_compute)->getExternalEnergy();
+            external_energy += m_forces[i]->getExternalEnergy();
             }
         }
 
@@ -878,10 +939,12 @@ CommFlags Integrator::determineFlags(unsigned int timestep)
     {
     CommFlags flags(0);
 
-    // query all forces
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        flags |= (*force_compute)->getRequestedCommFlags(timestep);
+    // query all forces that are evaluated at this time step
+    for (unsigned int i = 0; i < m_forces.size(); ++i)
+        {
+        if (isForceEvaluated(i, timestep))
+            flags |= m_forces[i]->getRequestedCommFlags(timestep);
+        }
 
     // query all constraints
     std::vector< std::shared_ptr<ForceConstraint> >::iterator force_constraint;
@@ -912,10 +975,11 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
 void Integrator::computeCallback(unsigned int timestep)
     {
     // pre-compute all active forces
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->preCompute(timestep);
+    for (unsigned int i = 0; i < m_forces.size(); ++i)
+        {
+        if (isForceEvaluated(i, timestep))
+            m_forces[i]->preCompute(timestep);
+        }
     }
 #endif
 
@@ -942,6 +1006,7 @@ void export_Integrator(py::module& m)
     .def(py::init< std::shared_ptr<SystemDefinition>, Scalar >())
     .def("addForceCompute", &Integrator::addForceCompute)
     .def("addForceConstraint", &Integrator::addForceConstraint)
+    .def("setForcePeriod", &Integrator::setForcePeriod)
     .def("setHalfStepHook", &Integrator::setHalfStepHook)
     .def("removeForceComputes", &Integrator::removeForceComputes)
     .def("removeHalfStepHook", &Integrator::removeHalfStepHook)
@@ -50,6 +50,13 @@
     via the constraint forces can be totaled up with a call to getNDOFRemoved for convenience in derived classes
     implementing correct counting in getNDOF().
 
+    Slowly varying forces can be evaluated less often with setForcePeriod(). A force with period k is only
+    computed on every k-th time step, where its force and torque enter the net force multiplied by k. Two-step
+    integration methods apply the net force in half kicks at the end of one step and at the beginning of the next,
+    so this realizes the impulse form of the reversible reference system propagator algorithm (r-RESPA) with an
+    outer time step of k*deltaT. On the other steps, the force is only computed if the potential energy or the
+    virial are requested, and then contributes those but no force.
+
     Integrators take "ownership" of the particle's accelerations. Any other updater
     that modifies the particles accelerations will produce undefined results. If
     accelerations are to be modified, they must be done through forces, and added to
@@ -81,6 +88,9 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! Add a ForceConstraint to the list
         virtual void addForceConstraint(std::shared_ptr<ForceConstraint> fc);
 
+        //! Set the evaluation period of a ForceCompute for multiple time step integration
+        virtual void setForcePeriod(std::shared_ptr<ForceCompute> fc, unsigned int period);
+
         //! Set HalfStepHook
         virtual void setHalfStepHook(std::shared_ptr<HalfStepHook> hook);
 
@@ -142,6 +152,7 @@ class PYBIND11_EXPORT Integrator : public Updater
     protected:
         Scalar m_deltaT;                                            //!< The time step
         std::vector< std::shared_ptr<ForceCompute> > m_forces;    //!< List of all the force computes
+        std::vector<unsigned int> m_force_periods;                  //!< Evaluation period of every force compute
 
         std::vector< std::shared_ptr<ForceConstraint> > m_constraint_forces;    //!< List of all the constraints
 
@@ -154,6 +165,9 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! helper function to compute net force/virial
         void computeNetForce(unsigned int timestep);
 
+        //! Test if a force compute needs to be evaluated at this time step
+        bool isForceEvaluated(unsigned int i, unsigned int timestep);
+
 #ifdef ENABLE_CUDA
         //! helper function to compute net force/virial on the GPU
         void computeNetForceGPU(unsigned int timestep);
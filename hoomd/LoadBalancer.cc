@@ -14,6 +14,7 @@
 #include "hoomd/extern/BVLSSolver.h"
 #include "hoomd/extern/Eigen/Eigen/Dense"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
@@ -112,6 +113,22 @@ void LoadBalancer::update(unsigned int timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
+            if (dim == 2 && m_decomposition->isStaggered())
+                {
+                // balance every column independently
+                vector<Scalar> cum_frac_col;
+                bool adjusted = adjustColumns(cum_frac_col, L_i, min_frac_i, reduce_root);
+                bcast(adjusted, reduce_root, m_mpi_comm);
+
+                if (adjusted)
+                    {
+                    m_decomposition->setColumnCumulativeFractions(cum_frac_col, reduce_root);
+                    m_pdata->setGlobalBox(box); // force a domain resizing to trigger
+                    signalResize();
+                    }
+                continue;
+                }
+
             vector<unsigned int> N_i;
             bool adjusted = false;
 
@@ -197,25 +214,12 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
     if (N_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
-
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
-
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    std::vector<unsigned int> N_per_cart_rank;
 
     // only the root rank performs the reduction
-    if (m_exec_conf->getRank() != reduce_root)
+    if (!gatherCartesian(N_per_cart_rank, reduce_root))
         return false;
 
-    // rearrange the data from ranks to cartesian order in case it is jumbled around
-    ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
-    for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
-        {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
-        }
-
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
@@ -271,6 +275,79 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
     return true;
     }
 
+/*!
+ * \param N_cart Vector holding the number of particles owned by each rank in Cartesian order (output)
+ * \param reduce_root The rank to gather on
+ * \returns true if the current rank holds the active \a N_cart
+ *
+ * All ranks must call this method, but the data is only valid on \a reduce_root.
+ */
+bool LoadBalancer::gatherCartesian(std::vector<unsigned int>& N_cart, unsigned int reduce_root)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    std::vector<unsigned int> N_per_rank(di.getNumElements());
+
+    // get the number of particles the current rank owns (the quantity to be reduced)
+    unsigned int N_own = getNOwn();
+
+    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+
+    if (m_exec_conf->getRank() != reduce_root)
+        return false;
+
+    // rearrange the data from ranks to cartesian order in case it is jumbled around
+    ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
+    N_cart.resize(di.getNumElements());
+    for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
+        {
+        N_cart[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        }
+
+    return true;
+    }
+
+/*!
+ * \param cum_frac_col The cumulative fractions of all columns to write output into
+ * \param L_z The global box length along z
+ * \param min_frac_z The minimum fractional width of a domain along z
+ * \param reduce_root The rank to perform the adjustment on
+ * \returns true if an adjustment occurred in any column (valid on \a reduce_root only)
+ *
+ * Each column of a staggered decomposition is balanced along z with adjust(), using the particle numbers of the
+ * domains in that column only.
+ */
+bool LoadBalancer::adjustColumns(std::vector<Scalar>& cum_frac_col,
+                                 Scalar L_z,
+                                 Scalar min_frac_z,
+                                 unsigned int reduce_root)
+    {
+    std::vector<unsigned int> N_cart;
+    if (!gatherCartesian(N_cart, reduce_root))
+        return false;
+
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    const unsigned int nz = di.getD();
+    cum_frac_col.resize(di.getW()*di.getH()*(nz+1));
+
+    bool adjusted = false;
+    for (unsigned int j=0; j < di.getH(); ++j)
+        {
+        for (unsigned int i=0; i < di.getW(); ++i)
+            {
+            vector<unsigned int> N_k(nz);
+            for (unsigned int k=0; k < nz; ++k)
+                N_k[k] = N_cart[di(i,j,k)];
+
+            vector<Scalar> cum_frac = m_decomposition->getColumnCumulativeFractions(i,j);
+            adjusted |= adjust(cum_frac, N_k, L_z, min_frac_z);
+
+            std::copy(cum_frac.begin(), cum_frac.end(), cum_frac_col.begin() + (j*di.getW()+i)*(nz+1));
+            }
+        }
+
+    return adjusted;
+    }
+
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
  * \param N_i The reduced number of particles along the dimension
@@ -298,8 +375,8 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target particles per rank is uniform distribution (of the particles in the slices, which may be a single column)
+    const Scalar target = Scalar(std::accumulate(N_i.begin(), N_i.end(), 0u)) / Scalar(N_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -427,6 +504,8 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
     const BoxDim& box = m_pdata->getBox();
     const Index3D& di = m_decomposition->getDomainIndexer();
     const uint3 rank_pos = m_decomposition->getGridPos();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const bool staggered = m_decomposition->isStaggered();
 
     for (unsigned int cur_p=0; cur_p < m_pdata->getN(); ++cur_p)
         {
@@ -487,6 +566,15 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
             else if (grid_pos.z < 0)
                 grid_pos.z += di.getD();
 
+            // the z boundaries differ between the columns of a staggered decomposition
+            if (staggered && (grid_pos.x != (int)rank_pos.x || grid_pos.y != (int)rank_pos.y))
+                {
+                Scalar fz = global_box.makeFraction(cur_pos).z;
+                if (fz >= Scalar(1.0)) fz -= Scalar(1.0);
+                if (fz < Scalar(0.0)) fz += Scalar(1.0);
+                grid_pos.z = m_decomposition->getColumnDomain(grid_pos.x, grid_pos.y, fz);
+                }
+
             unsigned int cur_rank = h_cart_ranks.data[di(grid_pos.x,grid_pos.y,grid_pos.z)];
             cnts[cur_rank]++;
             }
@@ -41,6 +41,9 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * For a staggered decomposition (DomainDecomposition::isStaggered()), the z boundaries are balanced independently
+ * within every column of domains, so that the partitioning can follow interfaces that are not planar.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Updater
@@ -122,6 +125,12 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         //! Reduce the particle numbers per rank down to one dimension
         bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
 
+        //! Gather the particle numbers per rank in Cartesian order
+        bool gatherCartesian(std::vector<unsigned int>& N_cart, unsigned int reduce_root);
+
+        //! Adjust the z partitioning of every column of a staggered decomposition
+        bool adjustColumns(std::vector<Scalar>& cum_frac_col, Scalar L_z, Scalar min_frac_z, unsigned int reduce_root);
+
         //! Set flags within the class that a resize has been performed
         void signalResize()
             {
@@ -188,6 +188,18 @@ Scalar Logger::getValue(const std::string &quantity, int timestep)
         {
         return Scalar(double(m_clk.getTime())/1e9);
         }
+    // built-in memory quantities, the maximum over all ranks
+    else if (quantity == "memory_allocated" || quantity == "memory_peak")
+        {
+        const MemoryAccounting& accounting = m_exec_conf->getMemoryAccounting();
+        double nbytes = double((quantity == "memory_allocated") ? accounting.getAllocatedBytes()
+            : accounting.getPeakBytes());
+        #ifdef ENABLE_MPI
+        if (m_exec_conf->getNRanks() > 1)
+            MPI_Allreduce(MPI_IN_PLACE, &nbytes, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        #endif
+        return Scalar(nbytes/1024.0/1024.0);
+        }
     // check to see if the quantity exists in the compute list
     else if (m_compute_quantities.count(quantity))
         {
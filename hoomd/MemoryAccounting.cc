@@ -0,0 +1,213 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MemoryAccounting.cc
+    \brief Implements a class for always-on accounting of array allocations
+*/
+
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <hoomd/extern/pybind/include/pybind11/stl.h>
+
+namespace py = pybind11;
+
+//! Pretty print number of bytes
+static std::string format_bytes(double nbytes)
+    {
+    const char* units[] = {"B", "kB", "MB", "GB", "TB", "PB"};
+    unsigned int i = 0;
+    while (nbytes > 1024 && i < 5)
+        {
+        nbytes /= 1024;
+        i++;
+        }
+
+    std::ostringstream oss;
+    oss << std::setprecision(3) << nbytes << units[i];
+    return oss.str();
+    }
+
+/*! \param msg Messenger for the budget warning
+*/
+MemoryAccounting::MemoryAccounting(std::shared_ptr<Messenger> msg)
+    : m_msg(msg), m_total(0), m_peak(0), m_budget(0), m_budget_warned(false)
+    {
+    }
+
+/*! \param tag Tag of the array
+    \returns The key under which the bytes of \a tag are counted
+*/
+const std::string& MemoryAccounting::getKey(const std::string& tag)
+    {
+    static const std::string untagged("untagged");
+    return tag.empty() ? untagged : tag;
+    }
+
+/*! \param tag Tag of the array
+    \param nbytes Size of the allocation
+*/
+void MemoryAccounting::add(const std::string& tag, size_t nbytes)
+    {
+    bool warn = false;
+
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bytes[getKey(tag)] += nbytes;
+        m_total += nbytes;
+        m_peak = std::max(m_peak, m_total);
+
+        if (m_budget && m_total > m_budget && !m_budget_warned)
+            {
+            m_budget_warned = true;
+            warn = true;
+            }
+        }
+
+    // print outside of the lock, printStats() takes it again
+    if (warn && m_msg)
+        {
+        m_msg->warning() << "Allocated memory of " << format_bytes(double(getAllocatedBytes()))
+                         << " exceeds the memory budget of " << format_bytes(double(getBudget())) << std::endl;
+        printStats();
+        }
+    }
+
+/*! \param tag Tag of the array
+    \param nbytes Size of the allocation
+*/
+void MemoryAccounting::remove(const std::string& tag, size_t nbytes)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_bytes.find(getKey(tag));
+    if (it == m_bytes.end())
+        return;
+
+    it->second -= std::min(it->second, nbytes);
+    if (it->second == 0)
+        m_bytes.erase(it);
+
+    m_total -= std::min(m_total, nbytes);
+    }
+
+/*! \param old_tag Tag the allocation was added with
+    \param new_tag New tag of the allocation
+    \param nbytes Size of the allocation
+*/
+void MemoryAccounting::retag(const std::string& old_tag, const std::string& new_tag, size_t nbytes)
+    {
+    if (getKey(old_tag) == getKey(new_tag))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_bytes.find(getKey(old_tag));
+    if (it == m_bytes.end())
+        return;
+
+    size_t moved = std::min(it->second, nbytes);
+    it->second -= moved;
+    if (it->second == 0)
+        m_bytes.erase(it);
+
+    m_bytes[getKey(new_tag)] += moved;
+    }
+
+size_t MemoryAccounting::getAllocatedBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_total;
+    }
+
+size_t MemoryAccounting::getPeakBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_peak;
+    }
+
+/*! \param tag Tag of the arrays
+*/
+size_t MemoryAccounting::getAllocatedBytes(const std::string& tag) const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_bytes.find(getKey(tag));
+    return (it == m_bytes.end()) ? 0 : it->second;
+    }
+
+std::map<std::string, size_t> MemoryAccounting::getAllocations() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+    }
+
+/*! \param nbytes Memory budget in bytes, 0 to remove the budget
+*/
+void MemoryAccounting::setBudget(size_t nbytes)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = nbytes;
+    m_budget_warned = false;
+    }
+
+size_t MemoryAccounting::getBudget() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+    }
+
+/*! \param factor The default growth factor of the caller
+    \returns \a factor, or 1+1/64 if a budget is set and more than half of it is allocated
+*/
+float MemoryAccounting::getGrowthFactor(float factor) const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_budget && 2*m_total > m_budget)
+        return std::min(factor, 1.0f + 1.0f/64.0f);
+    return factor;
+    }
+
+/*! \param max_tags Maximum number of tags to list
+*/
+void MemoryAccounting::printStats(unsigned int max_tags) const
+    {
+    if (!m_msg || m_msg->getNoticeLevel() < 1)
+        return;
+
+    std::vector< std::pair<size_t, std::string> > sorted;
+    size_t total, peak, budget;
+
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_bytes.begin(); it != m_bytes.end(); ++it)
+            sorted.push_back(std::make_pair(it->second, it->first));
+        total = m_total;
+        peak = m_peak;
+        budget = m_budget;
+        }
+
+    std::sort(sorted.rbegin(), sorted.rend());
+
+    m_msg->notice(1) << "-- Memory stats:" << std::endl;
+    m_msg->notice(1) << "Allocated: " << format_bytes(double(total)) << " / peak: " << format_bytes(double(peak));
+    if (budget)
+        m_msg->notice(1) << " / budget: " << format_bytes(double(budget));
+    m_msg->notice(1) << std::endl;
+
+    for (unsigned int i = 0; i < sorted.size() && i < max_tags; i++)
+        m_msg->notice(1) << std::setw(10) << format_bytes(double(sorted[i].first)) << "  " << sorted[i].second << std::endl;
+    }
+
+void export_MemoryAccounting(py::module& m)
+    {
+    py::class_<MemoryAccounting>(m, "MemoryAccounting")
+        .def("getAllocatedBytes", (size_t (MemoryAccounting::*)() const) &MemoryAccounting::getAllocatedBytes)
+        .def("getPeakBytes", &MemoryAccounting::getPeakBytes)
+        .def("getAllocations", &MemoryAccounting::getAllocations)
+        .def("setBudget", &MemoryAccounting::setBudget)
+        .def("getBudget", &MemoryAccounting::getBudget)
+        .def("printStats", &MemoryAccounting::printStats)
+        ;
+    }
@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file MemoryAccounting.h
+    \brief Declares a class for always-on accounting of array allocations
+*/
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+
+#include "Messenger.h"
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Counts the bytes allocated by GPUArray and GlobalArray per tag
+/*! Every GPUArray and GlobalArray adds the size of its host (or managed) allocation under its tag when it is
+    allocated, and removes it when the memory is freed. Arrays tagged with TAG_ALLOCATION are listed as
+    <code>Class::m_array</code>, and those tagged with TAG_ALLOCATION_INSTANCE as <code>Class::m_array [name]</code>.
+    All others are collected under "untagged". Only the running totals are kept, so the accounting is always enabled,
+    unlike MemoryTraceback which records a stack trace per allocation.
+
+    A memory budget can be set with setBudget(). Once more than half of the budget is allocated, getGrowthFactor()
+    returns a growth factor close to 1, which the amortized resizing of the particle data, the neighbor list and
+    GPUVector use, so that growable arrays only reserve little more than they need. A warning with the largest
+    consumers is printed the first time the budget is exceeded.
+*/
+class PYBIND11_EXPORT MemoryAccounting
+    {
+    public:
+        //! Constructor
+        MemoryAccounting(std::shared_ptr<Messenger> msg);
+
+        //! Add an allocation
+        void add(const std::string& tag, size_t nbytes);
+
+        //! Remove an allocation
+        void remove(const std::string& tag, size_t nbytes);
+
+        //! Move an allocation to a new tag
+        void retag(const std::string& old_tag, const std::string& new_tag, size_t nbytes);
+
+        //! Get the number of bytes currently allocated
+        size_t getAllocatedBytes() const;
+
+        //! Get the maximum number of bytes allocated at any time
+        size_t getPeakBytes() const;
+
+        //! Get the number of bytes currently allocated under a tag
+        size_t getAllocatedBytes(const std::string& tag) const;
+
+        //! Get the number of bytes currently allocated per tag
+        std::map<std::string, size_t> getAllocations() const;
+
+        //! Set the memory budget in bytes (0 for no budget)
+        void setBudget(size_t nbytes);
+
+        //! Get the memory budget in bytes
+        size_t getBudget() const;
+
+        //! Get the growth factor for amortized resizing
+        float getGrowthFactor(float factor) const;
+
+        //! Print the largest allocations
+        void printStats(unsigned int max_tags = 10) const;
+
+    private:
+        std::shared_ptr<Messenger> m_msg;           //!< Messenger for the budget warning
+        mutable std::mutex m_mutex;                 //!< Protects the counters
+        std::map<std::string, size_t> m_bytes;      //!< Bytes allocated per tag
+        size_t m_total;                             //!< Total number of bytes allocated
+        size_t m_peak;                              //!< Maximum of m_total
+        size_t m_budget;                            //!< Memory budget in bytes, 0 if not set
+        bool m_budget_warned;                       //!< True once the budget warning was printed
+
+        //! Get the key of a tag
+        static const std::string& getKey(const std::string& tag);
+    };
+
+//! Exports MemoryAccounting to python
+void export_MemoryAccounting(pybind11::module& m);
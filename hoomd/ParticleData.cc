@@ -62,7 +62,8 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
           m_nglobal(0),
           m_accel_set(false),
           m_resize_factor(9./8.),
-          m_arrays_allocated(false)
+          m_arrays_allocated(false),
+          m_in_place_permutation(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -137,12 +138,14 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
  * \param global_box The dimensions of the global simulation box
  * \param exec_conf The execution configuration
  * \param decomposition (optional) Domain decomposition layout
+ * \param distributed True if every rank holds a contiguous range of tags of the snapshot
  */
 template <class Real>
 ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            const BoxDim& global_box,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                           std::shared_ptr<DomainDecomposition> decomposition
+                           std::shared_ptr<DomainDecomposition> decomposition,
+                           bool distributed
                           )
     : m_exec_conf(exec_conf),
       m_nparticles(0),
@@ -151,7 +154,8 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
       m_nglobal(0),
       m_accel_set(false),
       m_resize_factor(9./8.),
-      m_arrays_allocated(false)
+      m_arrays_allocated(false),
+      m_in_place_permutation(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -163,8 +167,14 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     // initialize box dimensions on all processors
     setGlobalBox(global_box);
 
+    // a snapshot can only be distributed over the domains
+    #ifdef ENABLE_MPI
+    if (!m_decomposition)
+    #endif
+        distributed = false;
+
     // it is an error for particles to be initialized outside of their box
-    if (!inBox(snapshot))
+    if (!inBox(snapshot, distributed))
         {
         m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
         throw runtime_error("Error initializing ParticleData");
@@ -183,7 +193,12 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     TAG_ALLOCATION(m_rtag);
 
     // initialize particle data with snapshot contents
-    initializeFromSnapshot(snapshot);
+    #ifdef ENABLE_MPI
+    if (distributed)
+        initializeFromDistributedSnapshot(snapshot);
+    else
+    #endif
+        initializeFromSnapshot(snapshot);
 
     // reset external virial
     for (unsigned int i = 0; i < 6; i++)
@@ -448,7 +463,8 @@ void ParticleData::allocate(unsigned int N)
     #endif
 
     // allocate alternate particle data arrays (for swapping in-out)
-    allocateAlternateArrays(N);
+    if (!m_in_place_permutation)
+        allocateAlternateArrays(N);
 
     // notify observers
     m_max_particle_num_signal.emit();
@@ -565,6 +581,49 @@ void ParticleData::allocateAlternateArrays(unsigned int N)
     #endif
     }
 
+/*! \param in_place True to reorder the particles in place
+
+    In-place permutation frees the alternate arrays, which hold a second copy of every per-particle array. Particles
+    are then removed by compacting the arrays in place, and the sorter permutes them in place. The GPU code paths
+    require the alternate arrays, so this option is only available on the CPU.
+*/
+void ParticleData::setInPlacePermutation(bool in_place)
+    {
+    if (in_place && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "In-place permutation of the particle data is not supported on the GPU" << endl;
+        throw std::runtime_error("Error setting particle data options");
+        }
+
+    if (in_place == m_in_place_permutation)
+        return;
+
+    m_in_place_permutation = in_place;
+
+    if (in_place)
+        {
+        // release the alternate arrays
+        GlobalArray<Scalar4>().swap(m_pos_alt);
+        GlobalArray<Scalar4>().swap(m_vel_alt);
+        GlobalArray<Scalar3>().swap(m_accel_alt);
+        GlobalArray<Scalar>().swap(m_charge_alt);
+        GlobalArray<Scalar>().swap(m_diameter_alt);
+        GlobalArray<int3>().swap(m_image_alt);
+        GlobalArray<unsigned int>().swap(m_tag_alt);
+        GlobalArray<unsigned int>().swap(m_body_alt);
+        GlobalArray<Scalar4>().swap(m_orientation_alt);
+        GlobalArray<Scalar4>().swap(m_angmom_alt);
+        GlobalArray<Scalar3>().swap(m_inertia_alt);
+        GlobalArray<Scalar4>().swap(m_net_force_alt);
+        GlobalArray<Scalar>().swap(m_net_virial_alt);
+        GlobalArray<Scalar4>().swap(m_net_torque_alt);
+        }
+    else if (m_arrays_allocated)
+        {
+        allocateAlternateArrays(m_max_nparticles);
+        }
+    }
+
 
 //! Set global number of particles
 /*! \param nglobal Global number of particles
@@ -623,8 +682,9 @@ void ParticleData::resize(unsigned int new_nparticles)
     if (new_nparticles > max_nparticles)
         {
         // use amortized array resizing
+        float factor = m_exec_conf->getMemoryAccounting().getGrowthFactor(m_resize_factor);
         while (new_nparticles > max_nparticles)
-            max_nparticles = ((unsigned int) (((float) max_nparticles) * m_resize_factor)) + 1 ;
+            max_nparticles = ((unsigned int) (((float) max_nparticles) * factor)) + 1 ;
 
         // reallocate particle data arrays
         reallocate(max_nparticles);
@@ -782,10 +842,10 @@ void ParticleData::maybe_rebuild_tag_cache()
 /*! \return true If and only if all particles are in the simulation box
 */
 template <class Real>
-bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
+bool ParticleData::inBox(const SnapshotParticleData<Real> &snap, bool distributed)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (distributed || m_exec_conf->getRank() == 0)
         {
         Scalar3 lo = m_global_box.getLo();
         Scalar3 hi = m_global_box.getHi();
@@ -809,7 +869,13 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
             }
         }
     #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (distributed)
+        {
+        int all_in_box = in_box;
+        MPI_Allreduce(MPI_IN_PLACE, &all_in_box, 1, MPI_INT, MPI_LAND, m_exec_conf->getMPICommunicator());
+        in_box = all_in_box;
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -905,11 +971,6 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
                 {
@@ -923,57 +984,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
+                unsigned int rank = placeSnapshotParticle(pos, img, snap_idx, h_cart_ranks.data);
 
                 // fill up per-processor data structures
                 pos_proc[rank].push_back(pos);
@@ -1193,6 +1205,438 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle, wrapped into the box if it lies exactly on a boundary
+    \param img Image flags of the particle, updated along with \a pos
+    \param snap_idx Index of the particle in the snapshot (for error messages)
+    \param cart_ranks Map from domain index to rank
+    \returns the rank of the domain the particle is placed into
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos, int3& img, unsigned int snap_idx,
+    const unsigned int *cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= f.x * ((Scalar)di.getW());
+    int j= f.y * ((Scalar)di.getH());
+    int k= f.z * ((Scalar)di.getD());
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int) di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int) di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim global_box = m_global_box;
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= m_exec_conf->getNRanks())
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    return rank;
+    }
+
+//! Initialize from a distributed snapshot
+/*! \param snapshot The part of the initial particle data held by this rank
+
+    Every rank holds a contiguous range of particles, ordered by rank, so that the particles of rank r receive the
+    tags following those of rank r-1. Each rank places its own particles into the domains, and a single all-to-all
+    exchange moves them to their owners. No rank ever holds more than its own part of the system.
+
+    \pre The type mapping is set on all ranks
+*/
+template <class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // check that all fields in the snapshot have correct length
+    if (! snapshot.validate())
+        {
+        m_exec_conf->msg->error() << "init.*: invalid particle data snapshot."
+                                << std::endl << std::endl;
+        throw std::runtime_error("Error initializing particle data.");
+        }
+
+    if (snapshot.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+
+    // the local particles follow those of the lower ranks
+    unsigned int n_local = snapshot.size;
+    unsigned int first_tag = 0;
+    MPI_Exscan(&n_local, &first_tag, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    if (m_exec_conf->getRank() == 0)
+        first_tag = 0;
+
+    unsigned int nglobal = 0;
+    MPI_Allreduce(&n_local, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+
+    // pack the local particles by destination rank
+    std::vector< std::vector<pdata_element> > send(size);
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        for (unsigned int snap_idx = 0; snap_idx < n_local; snap_idx++)
+            {
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            int3 img = snapshot.image[snap_idx];
+            unsigned int rank = placeSnapshotParticle(pos, img, first_tag + snap_idx, h_cart_ranks.data);
+
+            pdata_element p;
+            p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[snap_idx]));
+            p.vel = make_scalar4(snapshot.vel[snap_idx].x,
+                                 snapshot.vel[snap_idx].y,
+                                 snapshot.vel[snap_idx].z,
+                                 snapshot.mass[snap_idx]);
+            p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+            p.charge = snapshot.charge[snap_idx];
+            p.diameter = snapshot.diameter[snap_idx];
+            p.image = img;
+            p.body = snapshot.body[snap_idx];
+            p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+            p.tag = first_tag + snap_idx;
+            p.net_force = make_scalar4(0,0,0,0);
+            p.net_torque = make_scalar4(0,0,0,0);
+            for (unsigned int j = 0; j < 6; ++j)
+                p.net_virial[j] = Scalar(0.0);
+
+            send[rank].push_back(p);
+            }
+        }
+
+    // move all particles to their owners at once
+    std::vector< std::vector<pdata_element> > recv;
+    alltoall_v(send, recv, mpi_comm);
+    send.clear();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    unsigned int n_recv = 0;
+    for (unsigned int i = 0; i < size; i++)
+        n_recv += recv[i].size();
+
+    // resize particle data
+    resize(n_recv);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        unsigned int idx = 0;
+        for (unsigned int i = 0; i < size; i++)
+            for (std::vector<pdata_element>::const_iterator it = recv[i].begin(); it != recv[i].end(); ++it)
+                {
+                h_pos.data[idx] = it->pos;
+                h_vel.data[idx] = it->vel;
+                h_accel.data[idx] = it->accel;
+                h_charge.data[idx] = it->charge;
+                h_diameter.data[idx] = it->diameter;
+                h_image.data[idx] = it->image;
+                h_tag.data[idx] = it->tag;
+                h_rtag.data[it->tag] = idx;
+                h_body.data[idx] = it->body;
+                h_orientation.data[idx] = it->orientation;
+                h_angmom.data[idx] = it->angmom;
+                h_inertia.data[idx] = it->inertia;
+
+                h_comm_flag.data[idx] = 0; // initialize with zero
+                idx++;
+                }
+        }
+
+    // copy over accel_set flag from snapshot
+    int accel_set = snapshot.is_accel_set;
+    MPI_Allreduce(MPI_IN_PLACE, &accel_set, 1, MPI_INT, MPI_LOR, mpi_comm);
+    m_accel_set = accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+#endif
+
+//! Restore the particle data from a checkpoint
+/*! \param particles Particles read from the checkpoint by this rank (consumed)
+    \param type_mapping Names of the particle types
+    \param n_tags One more than the largest active particle tag (0 if there are no particles)
+    \param free_tags Tags below \a n_tags that are not in use
+    \param redistribute If true, send every particle to the rank that owns its position
+
+    The particle tags of the checkpoint are preserved. Without redistribution, the particles must already lie in the
+    local domain, which is the case when the checkpoint was written with the same domain decomposition. This call is
+    collective when \a redistribute is true.
+*/
+void ParticleData::restoreFromCheckpoint(std::vector<pdata_element>& particles,
+    const std::vector<std::string>& type_mapping,
+    unsigned int n_tags,
+    const std::vector<unsigned int>& free_tags,
+    bool redistribute)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: restoring from checkpoint" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    if (type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    #ifdef ENABLE_MPI
+    if (redistribute && m_decomposition)
+        {
+        unsigned int size = m_exec_conf->getNRanks();
+
+        std::vector< std::vector<pdata_element> > send(size);
+            {
+            ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+            for (unsigned int i = 0; i < particles.size(); ++i)
+                {
+                pdata_element& p = particles[i];
+                Scalar3 pos = make_scalar3(p.pos.x, p.pos.y, p.pos.z);
+                int3 img = p.image;
+                unsigned int rank = placeSnapshotParticle(pos, img, p.tag, h_cart_ranks.data);
+
+                p.pos = make_scalar4(pos.x, pos.y, pos.z, p.pos.w);
+                p.image = img;
+                send[rank].push_back(p);
+                }
+            }
+        particles.clear();
+
+        std::vector< std::vector<pdata_element> > recv;
+        alltoall_v(send, recv, m_exec_conf->getMPICommunicator());
+        send.clear();
+
+        for (unsigned int i = 0; i < size; ++i)
+            particles.insert(particles.end(), recv[i].begin(), recv[i].end());
+        }
+    #endif
+
+    m_type_mapping = type_mapping;
+
+    // rebuild the set of active tags, keeping the unused ones for reuse
+    m_tag_set.clear();
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    std::vector<bool> is_free(n_tags, false);
+    for (std::vector<unsigned int>::const_iterator it = free_tags.begin(); it != free_tags.end(); ++it)
+        {
+        assert(*it < n_tags);
+        is_free[*it] = true;
+        m_recycled_tags.push(*it);
+        }
+
+    for (unsigned int tag = 0; tag < n_tags; ++tag)
+        if (! is_free[tag])
+            m_tag_set.insert(tag);
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    m_rtag.resize(n_tags);
+    unsigned int n_local = particles.size();
+    resize(n_local);
+
+        {
+        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < n_tags; ++tag)
+            h_rtag.data[tag] = NOT_LOCAL;
+
+        for (unsigned int idx = 0; idx < n_local; ++idx)
+            {
+            const pdata_element& p = particles[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_comm_flag.data[idx] = 0;
+            }
+        }
+    particles.clear();
+
+    // set global number of particles
+    setNGlobal(n_tags - free_tags.size());
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+
+/*! \param particles Buffer to pack the local particles into
+
+    The net forces, torques and virials are not stored, since they are recomputed after a restart.
+*/
+void ParticleData::getCheckpointParticles(std::vector<pdata_element>& particles)
+    {
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::read);
+    ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::read);
+    ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
+
+    particles.resize(m_nparticles);
+    for (unsigned int idx = 0; idx < m_nparticles; ++idx)
+        {
+        pdata_element& p = particles[idx];
+        p.pos = h_pos.data[idx];
+        p.vel = h_vel.data[idx];
+        p.accel = h_accel.data[idx];
+        p.charge = h_charge.data[idx];
+        p.diameter = h_diameter.data[idx];
+        p.image = h_image.data[idx];
+        p.body = h_body.data[idx];
+        p.orientation = h_orientation.data[idx];
+        p.angmom = h_angmom.data[idx];
+        p.inertia = h_inertia.data[idx];
+        p.tag = h_tag.data[idx];
+        p.net_force = make_scalar4(0,0,0,0);
+        p.net_torque = make_scalar4(0,0,0,0);
+        for (unsigned int j = 0; j < 6; ++j)
+            p.net_virial[j] = Scalar(0.0);
+        }
+    }
+
+/*! \returns the tags below the maximum active tag that are not in use
+*/
+std::vector<unsigned int> ParticleData::getFreeTags() const
+    {
+    std::vector<unsigned int> free_tags;
+    unsigned int next = 0;
+    for (std::set<unsigned int>::const_iterator it = m_tag_set.begin(); it != m_tag_set.end(); ++it)
+        {
+        for (; next < *it; ++next)
+            free_tags.push_back(next);
+        next = *it + 1;
+        }
+    return free_tags;
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -1450,8 +1894,9 @@ void ParticleData::addGhostParticles(const unsigned int nghosts)
 
     if (m_nparticles + m_nghosts > max_nparticles)
         {
+        float factor = m_exec_conf->getMemoryAccounting().getGrowthFactor(m_resize_factor);
         while (m_nparticles + m_nghosts > max_nparticles)
-            max_nparticles = ((unsigned int) (((float) max_nparticles) * m_resize_factor)) + 1 ;
+            max_nparticles = ((unsigned int) (((float) max_nparticles) * factor)) + 1 ;
 
         // reallocate particle data arrays
         reallocate(max_nparticles);
@@ -1494,6 +1939,74 @@ unsigned int ParticleData::getOwnerRank(unsigned int tag) const
 
     return (unsigned int) owner_rank;
     }
+
+/*! \param tags Tags of the particles to look up (may differ between ranks)
+    \param ranks The rank that owns each particle on output
+
+    Unlike getOwnerRank(), this costs three all-to-all exchanges independent of the number of tags. The ranks
+    register their particles in a directory that is split over all ranks in blocks of consecutive tags, and then
+    query the directory for the requested tags. This method must be called on all ranks.
+*/
+void ParticleData::getOwnerRanks(const std::vector<unsigned int>& tags, std::vector<unsigned int>& ranks) const
+    {
+    assert(m_decomposition);
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int size = m_exec_conf->getNRanks();
+    unsigned int my_rank = m_exec_conf->getRank();
+
+    unsigned int max_tag = getMaximumTag();
+    unsigned int block = (max_tag + size)/size;
+
+    // register the local particles with the directory
+    std::vector< std::vector<unsigned int> > send(size);
+        {
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            send[h_tag.data[idx]/block].push_back(h_tag.data[idx]);
+        }
+
+    std::vector< std::vector<unsigned int> > recv;
+    alltoall_v(send, recv, mpi_comm);
+
+    std::vector<unsigned int> directory(block, NOT_LOCAL);
+    unsigned int first_tag = my_rank*block;
+    for (unsigned int i = 0; i < size; i++)
+        for (unsigned int j = 0; j < recv[i].size(); j++)
+            directory[recv[i][j] - first_tag] = i;
+
+    // query the directory
+    for (unsigned int i = 0; i < size; i++)
+        send[i].clear();
+
+    for (unsigned int i = 0; i < tags.size(); i++)
+        {
+        if (tags[i] > max_tag)
+            {
+            m_exec_conf->msg->error() << "Particle tag " << tags[i] << " out of bounds." << endl;
+            throw std::runtime_error("Error accessing particle data.");
+            }
+        send[tags[i]/block].push_back(tags[i]);
+        }
+
+    std::vector< std::vector<unsigned int> > queries;
+    alltoall_v(send, queries, mpi_comm);
+
+    for (unsigned int i = 0; i < size; i++)
+        for (unsigned int j = 0; j < queries[i].size(); j++)
+            queries[i][j] = directory[queries[i][j] - first_tag];
+
+    alltoall_v(queries, recv, mpi_comm);
+
+    // the answers arrive in the order of the queries
+    std::vector<unsigned int> offset(size, 0);
+    ranks.resize(tags.size());
+    for (unsigned int i = 0; i < tags.size(); i++)
+        {
+        unsigned int d = tags[i]/block;
+        ranks[i] = recv[d][offset[d]++];
+        }
+    }
 #endif
 
 ///////////////////////////////////////////////////////////
@@ -2478,18 +2991,26 @@ string print_ParticleData(ParticleData *pdata)
 template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed
                                           );
 template void ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double> & snapshot, bool ignore_bodies);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<double>(const SnapshotParticleData<double> & snapshot);
+#endif
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<double>(SnapshotParticleData<double> &snapshot);
 
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            const BoxDim& global_box,
                                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                           std::shared_ptr<DomainDecomposition> decomposition
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           bool distributed
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<float>(const SnapshotParticleData<float> & snapshot);
+#endif
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
 
@@ -2506,6 +3027,8 @@ void export_ParticleData(py::module& m)
     .def("getNGlobal", &ParticleData::getNGlobal)
     .def("getNTypes", &ParticleData::getNTypes)
     .def("getMaxDiameter", &ParticleData::getMaxDiameter)
+    .def("setInPlacePermutation", &ParticleData::setInPlacePermutation)
+    .def("getInPlacePermutation", &ParticleData::getInPlacePermutation)
     .def("getNameByType", &ParticleData::getNameByType)
     .def("getTypeByName", &ParticleData::getTypeByName)
     .def("setTypeName", &ParticleData::setTypeName)
@@ -2698,6 +3221,22 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
         ArrayHandle<Scalar> h_net_virial_alt(m_net_virial_alt, access_location::host, access_mode::overwrite);
         ArrayHandle<unsigned int> h_tag_alt(m_tag_alt, access_location::host, access_mode::overwrite);
 
+        // destination of the remaining particles, in place they are moved to the front (n <= i)
+        Scalar4 *pos_out = m_in_place_permutation ? h_pos.data : h_pos_alt.data;
+        Scalar4 *vel_out = m_in_place_permutation ? h_vel.data : h_vel_alt.data;
+        Scalar3 *accel_out = m_in_place_permutation ? h_accel.data : h_accel_alt.data;
+        Scalar *charge_out = m_in_place_permutation ? h_charge.data : h_charge_alt.data;
+        Scalar *diameter_out = m_in_place_permutation ? h_diameter.data : h_diameter_alt.data;
+        int3 *image_out = m_in_place_permutation ? h_image.data : h_image_alt.data;
+        unsigned int *body_out = m_in_place_permutation ? h_body.data : h_body_alt.data;
+        Scalar4 *orientation_out = m_in_place_permutation ? h_orientation.data : h_orientation_alt.data;
+        Scalar4 *angmom_out = m_in_place_permutation ? h_angmom.data : h_angmom_alt.data;
+        Scalar3 *inertia_out = m_in_place_permutation ? h_inertia.data : h_inertia_alt.data;
+        Scalar4 *net_force_out = m_in_place_permutation ? h_net_force.data : h_net_force_alt.data;
+        Scalar4 *net_torque_out = m_in_place_permutation ? h_net_torque.data : h_net_torque_alt.data;
+        Scalar *net_virial_out = m_in_place_permutation ? h_net_virial.data : h_net_virial_alt.data;
+        unsigned int *tag_out = m_in_place_permutation ? h_tag.data : h_tag_alt.data;
+
         unsigned int n =0;
         unsigned int m = 0;
         unsigned int net_virial_pitch = m_net_virial.getPitch();
@@ -2706,22 +3245,22 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
             unsigned int tag = h_tag.data[i];
             if (h_rtag.data[tag] != NOT_LOCAL)
                 {
-                // copy over to alternate pdata arrays
-                h_pos_alt.data[n] = h_pos.data[i];
-                h_vel_alt.data[n] = h_vel.data[i];
-                h_accel_alt.data[n] = h_accel.data[i];
-                h_charge_alt.data[n] = h_charge.data[i];
-                h_diameter_alt.data[n] = h_diameter.data[i];
-                h_image_alt.data[n] = h_image.data[i];
-                h_body_alt.data[n] = h_body.data[i];
-                h_orientation_alt.data[n] = h_orientation.data[i];
-                h_angmom_alt.data[n] = h_angmom.data[i];
-                h_inertia_alt.data[n] = h_inertia.data[i];
-                h_net_force_alt.data[n] = h_net_force.data[i];
-                h_net_torque_alt.data[n] = h_net_torque.data[i];
+                // copy over to the remaining particles
+                pos_out[n] = h_pos.data[i];
+                vel_out[n] = h_vel.data[i];
+                accel_out[n] = h_accel.data[i];
+                charge_out[n] = h_charge.data[i];
+                diameter_out[n] = h_diameter.data[i];
+                image_out[n] = h_image.data[i];
+                body_out[n] = h_body.data[i];
+                orientation_out[n] = h_orientation.data[i];
+                angmom_out[n] = h_angmom.data[i];
+                inertia_out[n] = h_inertia.data[i];
+                net_force_out[n] = h_net_force.data[i];
+                net_torque_out[n] = h_net_torque.data[i];
                 for (unsigned int j = 0; j < 6; ++j)
-                    h_net_virial_alt.data[net_virial_pitch*j+n] = h_net_virial.data[net_virial_pitch*j+i];
-                h_tag_alt.data[n] = h_tag.data[i];
+                    net_virial_out[net_virial_pitch*j+n] = h_net_virial.data[net_virial_pitch*j+i];
+                tag_out[n] = h_tag.data[i];
                 ++n;
                 }
             else
@@ -2755,21 +3294,24 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out, std::vector<
         std::fill(h_comm_flags.data, h_comm_flags.data + new_nparticles, 0);
         }
 
-    // swap particle data arrays
-    swapPositions();
-    swapVelocities();
-    swapAccelerations();
-    swapCharges();
-    swapDiameters();
-    swapImages();
-    swapBodies();
-    swapOrientations();
-    swapAngularMomenta();
-    swapMomentsOfInertia();
-    swapNetForce();
-    swapNetTorque();
-    swapNetVirial();
-    swapTags();
+    if (!m_in_place_permutation)
+        {
+        // swap particle data arrays
+        swapPositions();
+        swapVelocities();
+        swapAccelerations();
+        swapCharges();
+        swapDiameters();
+        swapImages();
+        swapBodies();
+        swapOrientations();
+        swapAngularMomenta();
+        swapMomentsOfInertia();
+        swapNetForce();
+        swapNetTorque();
+        swapNetVirial();
+        swapTags();
+        }
 
         {
         ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
@@ -419,7 +419,8 @@ class PYBIND11_EXPORT ParticleData
                      const BoxDim& global_box,
                      std::shared_ptr<ExecutionConfiguration> exec_conf,
                      std::shared_ptr<DomainDecomposition> decomposition
-                        = std::shared_ptr<DomainDecomposition>()
+                        = std::shared_ptr<DomainDecomposition>(),
+                     bool distributed = false
                      );
 
         //! Destructor
@@ -508,6 +509,12 @@ class PYBIND11_EXPORT ParticleData
             return m_type_mapping.size();
             }
 
+        //! Get the names of all particle types
+        const std::vector<std::string>& getTypeMapping() const
+            {
+            return m_type_mapping;
+            }
+
         //! Get the origin for the particle system
         /*! \return origin of the system
         */
@@ -628,6 +635,8 @@ class PYBIND11_EXPORT ParticleData
          * m_pdata->swapPositions(); // swap in reordered data at no extra cost
          * notifyParticleSort();     // ensures that ghosts will be restored at next communication step
          * \endcode
+         *
+         * The alternate arrays are not allocated when in-place permutation is enabled, see setInPlacePermutation().
          */
 
         //! Return positions and types (alternate array)
@@ -642,6 +651,14 @@ class PYBIND11_EXPORT ParticleData
         //! Swap in velocities
         inline void swapVelocities() { m_vel.swap(m_vel_alt); }
 
+        //! Swap in velocities from an array of the caller
+        /*! \param vel Array with at least getMaxN() elements
+
+            Unlike swapVelocities(), this also works when the alternate arrays are not allocated. Swapping the same
+            array again restores the velocities.
+        */
+        inline void swapVelocities(GlobalArray< Scalar4 >& vel) { m_vel.swap(vel); }
+
         //! Return accelerations (alternate array)
         const GlobalArray< Scalar3 >& getAltAccelerations() const { return m_accel_alt; }
 
@@ -714,6 +731,15 @@ class PYBIND11_EXPORT ParticleData
         //! Swap in moments of inertia
         inline void swapMomentsOfInertia() { m_inertia.swap(m_inertia_alt); }
 
+        //! Set whether particles are reordered in place, without the alternate arrays
+        void setInPlacePermutation(bool in_place);
+
+        //! Get whether particles are reordered in place
+        bool getInPlacePermutation() const
+            {
+            return m_in_place_permutation;
+            }
+
         //! Set the profiler to profile CPU<-->GPU memory copies
         /*! \param prof Pointer to the profiler to use. Set to NULL to deactivate profiling
         */
@@ -813,6 +839,9 @@ class PYBIND11_EXPORT ParticleData
         #ifdef ENABLE_MPI
         //! Find the processor that owns a particle
         unsigned int getOwnerRank(unsigned int tag) const;
+
+        //! Find the processors that own many particles (collective call)
+        void getOwnerRanks(const std::vector<unsigned int>& tags, std::vector<unsigned int>& ranks) const;
         #endif
 
         //! Get the current position of a particle
@@ -977,6 +1006,25 @@ class PYBIND11_EXPORT ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from a snapshot of which every rank holds a contiguous range of tags
+        template <class Real>
+        void initializeFromDistributedSnapshot(const SnapshotParticleData<Real> & snapshot);
+        #endif
+
+        //! Restore the particle data from a checkpoint
+        void restoreFromCheckpoint(std::vector<pdata_element>& particles,
+            const std::vector<std::string>& type_mapping,
+            unsigned int n_tags,
+            const std::vector<unsigned int>& free_tags,
+            bool redistribute);
+
+        //! Get the local particles for a checkpoint
+        void getCheckpointParticles(std::vector<pdata_element>& particles);
+
+        //! Get the tags below the maximum tag that are not in use
+        std::vector<unsigned int> getFreeTags() const;
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
@@ -1153,7 +1201,8 @@ class PYBIND11_EXPORT ParticleData
         bool m_invalid_cached_tags;                  //!< true if m_cached_tag_set needs to be rebuilt
 
         /* Alternate particle data arrays are provided for fast swapping in and out of particle data
-           The size of these arrays is updated in sync with the main particle data arrays.
+           The size of these arrays is updated in sync with the main particle data arrays. They are null
+           arrays when m_in_place_permutation is set.
 
            The primary use case is when particle data has to be re-ordered in-place, i.e.
            a temporary array would otherwise be required. Instead of writing to a temporary
@@ -1191,6 +1240,7 @@ class PYBIND11_EXPORT ParticleData
         int3 m_o_image;                              //!< Tracks the origin image
 
         bool m_arrays_allocated;                     //!< True if arrays have been initialized
+        bool m_in_place_permutation;                 //!< True if particles are reordered without the alternate arrays
 
         #ifdef ENABLE_CUDA
         mgpu::ContextPtr m_mgpu_context;             //!< moderngpu context
@@ -1217,9 +1267,16 @@ class PYBIND11_EXPORT ParticleData
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
          * \param Snapshot to check
+         * \param distributed True if every rank holds a part of the snapshot
          */
         template <class Real>
-        bool inBox(const SnapshotParticleData<Real>& snap);
+        bool inBox(const SnapshotParticleData<Real>& snap, bool distributed=false);
+
+        #ifdef ENABLE_MPI
+        //! Helper function to find the domain of a snapshot particle
+        unsigned int placeSnapshotParticle(Scalar3& pos, int3& img, unsigned int snap_idx,
+            const unsigned int *cart_ranks);
+        #endif
 
         //! Update the CUDA memory hints
         void setGPUAdvice();
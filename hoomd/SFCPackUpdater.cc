@@ -24,7 +24,8 @@ namespace py = pybind11;
 /*! \param sysdef System to perform sorts on
  */
 SFCPackUpdater::SFCPackUpdater(std::shared_ptr<SystemDefinition> sysdef)
-        : Updater(sysdef), m_last_grid(0), m_last_dim(0)
+        : Updater(sysdef), m_last_grid(0), m_last_dim(0), m_incremental(false), m_sort_pending(false),
+          m_cell_order_dim(make_uint3(0,0,0))
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackUpdater" << endl;
 
@@ -60,8 +61,55 @@ SFCPackUpdater::~SFCPackUpdater()
     {
     m_exec_conf->msg->notice(5) << "Destroying SFCPackUpdater" << endl;
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<SFCPackUpdater, &SFCPackUpdater::reallocate>(this);
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        m_comm->getMigrateCallbackSignal().disconnect<SFCPackUpdater, &SFCPackUpdater::slotMigrate>(this);
+    #endif
     }
 
+/*! \param incremental True to enable the incremental sort
+ */
+void SFCPackUpdater::setIncremental(bool incremental)
+    {
+    if (incremental && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "sorter: incremental sorting is not supported on the GPU" << endl;
+        throw std::runtime_error("Error setting sorter parameters");
+        }
+
+    m_incremental = incremental;
+    m_sort_pending = false;
+    }
+
+#ifdef ENABLE_MPI
+/*! \param comm The Communicator
+ */
+void SFCPackUpdater::setCommunicator(std::shared_ptr<Communicator> comm)
+    {
+    if (!m_comm)
+        {
+        // only subscribe on the first call
+        assert(comm);
+        comm->getMigrateCallbackSignal().connect<SFCPackUpdater, &SFCPackUpdater::slotMigrate>(this);
+        }
+
+    Updater::setCommunicator(comm);
+    }
+
+/*! \param timestep Current timestep of the simulation
+ */
+void SFCPackUpdater::slotMigrate(unsigned int timestep)
+    {
+    if (!m_sort_pending)
+        return;
+
+    m_sort_pending = false;
+
+    // only local particles are present, and the ghosts are exchanged next
+    sortParticles(true);
+    }
+#endif
+
 /*! Performs the sort.
     \note In an updater list, this sort should be done first, before anyone else
     gets ahold of the particle data
@@ -73,6 +121,16 @@ void SFCPackUpdater::update(unsigned int timestep)
     m_exec_conf->msg->notice(6) << "SFCPackUpdater: particle sort" << std::endl;
 
     #ifdef ENABLE_MPI
+    if (m_comm && m_incremental)
+        {
+        // the sort is performed by the next particle migration, force one if none happened during the last period
+        if (m_sort_pending)
+            m_comm->forceMigrate();
+
+        m_sort_pending = true;
+        return;
+        }
+
     if (m_comm)
         {
         // make sure all particles that need to be local are
@@ -84,27 +142,41 @@ void SFCPackUpdater::update(unsigned int timestep)
         }
     #endif
 
+    sortParticles(m_incremental);
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        // restore ghosts
+        m_comm->communicate(timestep);
+        }
+    #endif
+    }
+
+/*! \param incremental True to sort over the cells of the cell list
+    \pre No ghost particles are present
+ */
+void SFCPackUpdater::sortParticles(bool incremental)
+    {
     if (m_prof) m_prof->push(m_exec_conf, "SFCPack");
 
     // figure out the sort order we need to apply
-    if (m_sysdef->getNDimensions() == 2)
+    bool reordered = true;
+    if (incremental && m_cl && m_cl->getDim().x > 0)
+        reordered = getSortedOrderCells();
+    else if (m_sysdef->getNDimensions() == 2)
         getSortedOrder2D();
     else
         getSortedOrder3D();
 
-    // apply that sort order to the particles
-    applySortOrder();
-
-    // trigger sort signal (this also forces particle migration)
-    m_pdata->notifyParticleSort();
-
-    #ifdef ENABLE_MPI
-    if (m_comm)
+    if (reordered)
         {
-        // restore ghosts
-        m_comm->communicate(timestep);
+        // apply that sort order to the particles
+        applySortOrder();
+
+        // trigger sort signal (this also forces particle migration)
+        m_pdata->notifyParticleSort();
         }
-    #endif
 
     if (m_prof) m_prof->pop(m_exec_conf);
     }
@@ -113,6 +185,13 @@ void SFCPackUpdater::applySortOrder()
     {
     assert(m_pdata);
     assert(m_sort_order.size() >= m_pdata->getN());
+
+    if (m_pdata->getInPlacePermutation())
+        {
+        applySortOrderInPlace();
+        return;
+        }
+
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
@@ -248,6 +327,101 @@ void SFCPackUpdater::applySortOrder()
 
     }
 
+/*! Applies the same permutation as applySortOrder() without temporary per-particle arrays. Every cycle of the sort
+    order is followed once, holding only the particle at the start of the cycle, and all per-particle arrays are moved
+    together.
+*/
+void SFCPackUpdater::applySortOrderInPlace()
+    {
+    const unsigned int N = m_pdata->getN();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::readwrite);
+
+    const unsigned int virial_pitch = m_pdata->getNetVirial().getPitch();
+
+    // read and write all fields of one particle
+    auto load = [&](unsigned int i) -> pdata_element
+        {
+        pdata_element p;
+        p.pos = h_pos.data[i];
+        p.vel = h_vel.data[i];
+        p.accel = h_accel.data[i];
+        p.charge = h_charge.data[i];
+        p.diameter = h_diameter.data[i];
+        p.image = h_image.data[i];
+        p.body = h_body.data[i];
+        p.orientation = h_orientation.data[i];
+        p.angmom = h_angmom.data[i];
+        p.inertia = h_inertia.data[i];
+        p.net_force = h_net_force.data[i];
+        p.net_torque = h_net_torque.data[i];
+        for (unsigned int j = 0; j < 6; j++)
+            p.net_virial[j] = h_net_virial.data[j*virial_pitch+i];
+        p.tag = h_tag.data[i];
+        return p;
+        };
+
+    auto store = [&](unsigned int i, const pdata_element& p)
+        {
+        h_pos.data[i] = p.pos;
+        h_vel.data[i] = p.vel;
+        h_accel.data[i] = p.accel;
+        h_charge.data[i] = p.charge;
+        h_diameter.data[i] = p.diameter;
+        h_image.data[i] = p.image;
+        h_body.data[i] = p.body;
+        h_orientation.data[i] = p.orientation;
+        h_angmom.data[i] = p.angmom;
+        h_inertia.data[i] = p.inertia;
+        h_net_force.data[i] = p.net_force;
+        h_net_torque.data[i] = p.net_torque;
+        for (unsigned int j = 0; j < 6; j++)
+            h_net_virial.data[j*virial_pitch+i] = p.net_virial[j];
+        h_tag.data[i] = p.tag;
+        };
+
+    // particle i receives the particle at m_sort_order[i]
+    std::vector<bool> done(N, false);
+    for (unsigned int start = 0; start < N; start++)
+        {
+        if (done[start])
+            continue;
+
+        done[start] = true;
+        if (m_sort_order[start] == start)
+            continue;
+
+        pdata_element first = load(start);
+        unsigned int i = start;
+        while (m_sort_order[i] != start)
+            {
+            unsigned int src = m_sort_order[i];
+            store(i, load(src));
+            done[src] = true;
+            i = src;
+            }
+        store(i, first);
+        }
+
+    // rebuild global rtag
+    for (unsigned int i = 0; i < N; i++)
+        h_rtag.data[h_tag.data[i]] = i;
+    }
+
 //! x walking table for the hilbert curve
 static int istep[] = {0, 0, 0, 0, 1, 1, 1, 1};
 //! y walking table for the hilbert curve
@@ -447,6 +621,20 @@ void SFCPackUpdater::getSortedOrder2D()
     assert(m_pdata);
     assert(m_sort_order.size() >= m_pdata->getN());
 
+    binParticles2D();
+
+    // sort the tuples
+    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+
+    // translate the sorted order
+    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+        {
+        m_sort_order[j] = m_particle_bins[j].second;
+        }
+    }
+
+void SFCPackUpdater::binParticles2D()
+    {
     // make even bin dimensions
     const BoxDim& box = m_pdata->getBox();
 
@@ -476,6 +664,15 @@ void SFCPackUpdater::getSortedOrder2D()
         m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
         }
     }
+    }
+
+void SFCPackUpdater::getSortedOrder3D()
+    {
+    // start by checking the saneness of some member variables
+    assert(m_pdata);
+    assert(m_sort_order.size() >= m_pdata->getN());
+
+    binParticles3D();
 
     // sort the tuples
     sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
@@ -487,12 +684,8 @@ void SFCPackUpdater::getSortedOrder2D()
         }
     }
 
-void SFCPackUpdater::getSortedOrder3D()
+void SFCPackUpdater::binParticles3D()
     {
-    // start by checking the saneness of some member variables
-    assert(m_pdata);
-    assert(m_sort_order.size() >= m_pdata->getN());
-
     // make even bin dimensions
     const BoxDim& box = m_pdata->getBox();
 
@@ -571,15 +764,131 @@ void SFCPackUpdater::getSortedOrder3D()
 
         m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
         }
+    }
 
-    // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+/*! \returns true if the particles need to be reordered
+
+    The particles are binned into the cells of the attached cell list with the same rules as CellList::computeCellList()
+    and put in order of the cell ranks with a stable counting sort.
+*/
+bool SFCPackUpdater::getSortedOrderCells()
+    {
+    assert(m_pdata);
+    assert(m_cl);
+    assert(m_sort_order.size() >= m_pdata->getN());
+
+    const uint3 dim = m_cl->getDim();
+    updateCellOrder(dim);
+
+    Index3D ci(dim.x, dim.y, dim.z);
+    const unsigned int n_cells = ci.getNumElements();
+    const Scalar3 ghost_width = m_cl->getGhostWidth();
+    const BoxDim& box = m_pdata->getBox();
+    const unsigned int N = m_pdata->getN();
+
+    // the rank of the cell of every particle, and the counts of all cells
+    m_cell_offset.assign(n_cells+1, 0);
+    bool in_order = true;
+    unsigned int last_rank = 0;
 
-    // translate the sorted order
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
         {
-        m_sort_order[j] = m_particle_bins[j].second;
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+        for (unsigned int n = 0; n < N; n++)
+            {
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            Scalar3 f = box.makeFraction(p, ghost_width);
+            int ib = (int)(f.x * dim.x);
+            int jb = (int)(f.y * dim.y);
+            int kb = (int)(f.z * dim.z);
+
+            // if the particle is slightly outside, move back into grid
+            if (ib < 0) ib = 0;
+            if (ib >= (int)dim.x) ib = dim.x - 1;
+
+            if (jb < 0) jb = 0;
+            if (jb >= (int)dim.y) jb = dim.y - 1;
+
+            if (kb < 0) kb = 0;
+            if (kb >= (int)dim.z) kb = dim.z - 1;
+
+            unsigned int rank = m_cell_order[ci(ib, jb, kb)];
+            if (rank < last_rank)
+                in_order = false;
+            last_rank = rank;
+
+            m_particle_bins[n].first = rank;
+            m_cell_offset[rank+1]++;
+            }
+        }
+
+    // nothing to do if no particle changed its place on the curve
+    if (in_order)
+        return false;
+
+    // exclusive scan of the counts
+    for (unsigned int c = 0; c < n_cells; c++)
+        m_cell_offset[c+1] += m_cell_offset[c];
+
+    // scatter in the current order to keep the order within every cell
+    for (unsigned int n = 0; n < N; n++)
+        m_sort_order[m_cell_offset[m_particle_bins[n].first]++] = n;
+
+    return true;
+    }
+
+/*! \param dim Dimensions of the cell list
+
+    In 3D, a hilbert curve is generated through the smallest power of 2 grid that covers the cell list, and the cells
+    are ranked in the order in which the curve visits them. In 2D, the cells are ranked in the same row order as the
+    fixed grid.
+*/
+void SFCPackUpdater::updateCellOrder(const uint3& dim)
+    {
+    if (dim.x == m_cell_order_dim.x && dim.y == m_cell_order_dim.y && dim.z == m_cell_order_dim.z)
+        return;
+
+    Index3D ci(dim.x, dim.y, dim.z);
+    m_cell_order.resize(ci.getNumElements());
+
+    if (m_sysdef->getNDimensions() == 2)
+        {
+        for (unsigned int i = 0; i < dim.x; i++)
+            for (unsigned int j = 0; j < dim.y; j++)
+                for (unsigned int k = 0; k < dim.z; k++)
+                    m_cell_order[ci(i,j,k)] = (i*dim.y + j)*dim.z + k;
+        }
+    else
+        {
+        unsigned int max_dim = std::max(dim.x, std::max(dim.y, dim.z));
+        unsigned int Mx = 1;
+        while (Mx < max_dim)
+            Mx *= 2;
+
+        vector< unsigned int > reverse_order;
+        reverse_order.reserve(Mx*Mx*Mx);
+
+        // we need to start the hilbert curve with a seed order 0,1,2,3,4,5,6,7
+        unsigned int cell_order[8];
+        for (unsigned int i = 0; i < 8; i++)
+            cell_order[i] = i;
+        generateTraversalOrder(0,0,0, Mx, Mx, cell_order, reverse_order);
+
+        // rank the cells that exist in the cell list
+        unsigned int rank = 0;
+        for (unsigned int m = 0; m < reverse_order.size(); m++)
+            {
+            unsigned int idx = reverse_order[m];
+            unsigned int i = idx / (Mx*Mx);
+            unsigned int j = (idx - i*Mx*Mx) / Mx;
+            unsigned int k = idx - i*Mx*Mx - j*Mx;
+
+            if (i < dim.x && j < dim.y && k < dim.z)
+                m_cell_order[ci(i,j,k)] = rank++;
+            }
         }
+
+    m_cell_order_dim = dim;
     }
 
 void SFCPackUpdater::writeTraversalOrder(const std::string& fname, const vector< unsigned int >& reverse_order)
@@ -617,5 +926,8 @@ void export_SFCPackUpdater(py::module& m)
     py::class_<SFCPackUpdater, std::shared_ptr<SFCPackUpdater> >(m,"SFCPackUpdater",py::base<Updater>())
     .def(py::init< std::shared_ptr<SystemDefinition> >())
     .def("setGrid", &SFCPackUpdater::setGrid)
+    .def("setIncremental", &SFCPackUpdater::setIncremental)
+    .def("getIncremental", &SFCPackUpdater::getIncremental)
+    .def("setCellList", &SFCPackUpdater::setCellList)
     ;
     }
@@ -14,6 +14,7 @@
 
 #include "Updater.h"
 #include "GPUVector.h"
+#include "CellList.h"
 
 #include <memory>
 #include <vector>
@@ -44,6 +45,15 @@
     which those bins appear along a hilbert curve. It is very efficient, even when the box size changes often as the
     grid dimension is kept constant.
 
+    Incremental sorting:<br>
+    When setIncremental() is enabled, the bins are the cells of the CellList attached with setCellList(), e.g. the one
+    of the neighbor list, and the cells are ranked along a hilbert curve through the cell grid. The particles are put in
+    order with a stable counting sort over the cells, which takes linear time and leaves the order within a cell
+    unchanged. Nothing is permuted if the particles are still in order. Without a cell list, the fixed grid is used.
+    With MPI, update() does not communicate itself. It marks the sort as pending and the sort is performed by the
+    next particle migration, after the particles are migrated and before the ghosts are exchanged. Migration is only
+    forced if no migration happened within a whole period.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT SFCPackUpdater : public Updater
@@ -67,20 +77,70 @@ class PYBIND11_EXPORT SFCPackUpdater : public Updater
             m_grid = (unsigned int)pow(2.0, ceil(log(double(grid)) / log(2.0)));;
             }
 
+        //! Enable or disable incremental sorting
+        void setIncremental(bool incremental);
+
+        //! Get whether incremental sorting is enabled
+        bool getIncremental() const
+            {
+            return m_incremental;
+            }
+
+        //! Set the cell list that provides the bins of the incremental sort
+        /*! \param cl Cell list, may be null to use the fixed grid
+        */
+        void setCellList(std::shared_ptr<CellList> cl)
+            {
+            m_cl = cl;
+            }
+
+        #ifdef ENABLE_MPI
+        //! Set the communicator to use
+        virtual void setCommunicator(std::shared_ptr<Communicator> comm);
+        #endif
+
     protected:
         unsigned int m_grid;        //!< Grid dimension to use
         unsigned int m_last_grid;   //!< The last value of MMax
         unsigned int m_last_dim;    //!< Check the last dimension we ran at
         GPUArray< unsigned int > m_traversal_order;      //!< Generated traversal order of bins
+        bool m_incremental;         //!< True if the incremental sort is enabled
+        bool m_sort_pending;        //!< True if a sort waits for the next particle migration
+        std::shared_ptr<CellList> m_cl;                  //!< Cell list providing the bins of the incremental sort
+        uint3 m_cell_order_dim;                          //!< Cell list dimensions of m_cell_order
+        std::vector<unsigned int> m_cell_order;          //!< Rank of every cell along the hilbert curve
+        std::vector<unsigned int> m_cell_offset;         //!< Offsets of the cells in the counting sort
 
         //! Helper function that actually performs the sort
         virtual void getSortedOrder2D();
         //! Helper function that actually performs the sort
         virtual void getSortedOrder3D();
 
+        //! Put the particles into the bins of the fixed grid
+        void binParticles2D();
+        //! Put the particles into the bins of the fixed grid
+        void binParticles3D();
+
+        //! Sort the local particles and notify the subscribers
+        void sortParticles(bool incremental);
+
+        //! Helper function that performs the incremental sort over the cells
+        bool getSortedOrderCells();
+
+        //! Rank the cells of the cell list along the hilbert curve
+        void updateCellOrder(const uint3& dim);
+
         //! Apply the sorted order to the particle data
         virtual void applySortOrder();
 
+        //! Apply the sorted order by following the cycles of the permutation
+        void applySortOrderInPlace();
+
+        #ifdef ENABLE_MPI
+        //! Perform a pending sort after particle migration
+        void slotMigrate(unsigned int timestep);
+        #endif
+
         //! Helper function to generate traversal order
         static void generateTraversalOrder(int i, int j, int k, int w, int Mx, unsigned int cell_order[8], std::vector< unsigned int > &traversal_order);
 
@@ -609,10 +609,14 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         if (g_sigint_recvd)
             {
             g_sigint_recvd = 0;
+            flushAnalyzers();
             return;
             }
         }
 
+    // write out any output that analyzers deferred
+    flushAnalyzers();
+
     // generate a final status line
     generateStatusLine();
     m_last_status_tstep = m_cur_tstep;
@@ -780,6 +784,9 @@ void System::printStats()
     for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
         compute->second->printStats();
 
+    // print the largest array allocations
+    m_exec_conf->getMemoryAccounting().printStats();
+
     // output memory trace information
     if (m_exec_conf->getMemoryTracer())
         m_exec_conf->getMemoryTracer()->outputTraces(m_exec_conf->msg);
@@ -806,6 +813,13 @@ void System::resetStats()
         compute->second->resetStats();
     }
 
+void System::flushAnalyzers()
+    {
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        analyzer->m_analyzer->flush();
+    }
+
 void System::generateStatusLine()
     {
     // a status line consists of
@@ -433,6 +433,9 @@ class PYBIND11_EXPORT System
         //! Resets stats for all contained classes
         void resetStats();
 
+        //! Completes pending output of all analyzers
+        void flushAnalyzers();
+
         //! Prints out a formatted status line
         void generateStatusLine();
 
@@ -66,18 +66,24 @@ SystemDefinition::SystemDefinition(unsigned int N,
     \param snapshot Snapshot to use
     \param exec_conf Execution configuration to run on
     \param decomposition (optional) The domain decomposition layout
+    \param distributed True if every rank holds a contiguous range of particles and bonded groups of the snapshot
+
+    A distributed snapshot is never assembled on a single rank. The particles and groups held by each rank are sent
+    directly to the ranks that own them. Every rank must hold the box, dimensions, and type mappings.
 */
 template <class Real>
 SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > snapshot,
                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                   std::shared_ptr<DomainDecomposition> decomposition)
+                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                   bool distributed)
     {
     setNDimensions(snapshot->dimensions);
 
     m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
                  snapshot->global_box,
                  exec_conf,
-                 decomposition));
+                 decomposition,
+                 distributed));
 
     #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
@@ -85,16 +91,19 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
         bcast(m_n_dimensions, 0,exec_conf->getMPICommunicator());
     #endif
 
-    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data));
+    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data, distributed));
 
-    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data));
+    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data, distributed));
 
-    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, snapshot->dihedral_data));
+    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, snapshot->dihedral_data,
+        distributed));
 
-    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, snapshot->improper_data));
+    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, snapshot->improper_data,
+        distributed));
 
-    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, snapshot->constraint_data));
-    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, snapshot->pair_data));
+    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, snapshot->constraint_data,
+        distributed));
+    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, snapshot->pair_data, distributed));
     m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(snapshot->integrator_data));
     }
 
@@ -266,7 +275,8 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr< SnapshotSystemDat
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<float> > snapshot,
                                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                                   std::shared_ptr<DomainDecomposition> decomposition);
+                                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                                   bool distributed);
 template std::shared_ptr< SnapshotSystemData<float> > SystemDefinition::takeSnapshot<float>(bool particles,
                                                                                               bool bonds,
                                                                                               bool angles,
@@ -279,7 +289,8 @@ template void SystemDefinition::initializeFromSnapshot<float>(std::shared_ptr< S
 
 template SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<double> > snapshot,
                                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                                   std::shared_ptr<DomainDecomposition> decomposition);
+                                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                                   bool distributed);
 template std::shared_ptr< SnapshotSystemData<double> > SystemDefinition::takeSnapshot<double>(bool particles,
                                                                                               bool bonds,
                                                                                               bool angles,
@@ -297,6 +308,7 @@ void export_SystemDefinition(py::module& m)
     .def(py::init<unsigned int, const BoxDim&, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, std::shared_ptr<ExecutionConfiguration> >())
     .def(py::init<unsigned int, const BoxDim&, unsigned int, unsigned int, unsigned int, unsigned int, unsigned int, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
+    .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition>, bool >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration> >())
@@ -286,6 +286,9 @@ class log(_analyzer):
     - **yz** - Box tilt factor in yz plane (dimensionless)
     - **momentum** - Magnitude of the average momentum of all particles (in momentum units)
     - **time** - Wall-clock running time from the start of the log (in seconds)
+    - **memory_allocated** - Host and managed memory currently allocated by the arrays of HOOMD (in MiB, maximum
+      over all MPI ranks)
+    - **memory_peak** - Maximum of **memory_allocated** since the start of the simulation (in MiB)
 
     Thermodynamic properties:
     - The following quantities are always available and computed over all particles in the system (see :py:class:`hoomd.compute.thermo` for detailed definitions):
@@ -92,6 +92,7 @@ class decomposition(object):
         nx (int): Number of processors to uniformly space in x dimension (if *x* is None)
         ny (int): Number of processors to uniformly space in y dimension (if *y* is None)
         nz (int): Number of processors to uniformly space in z dimension (if *z* is None)
+        staggered (bool): If True, let every column of domains along z have its own cut planes
 
     A single domain decomposition is defined for the simulation.
     A standard domain decomposition divides the simulation box into equal volumes along the Cartesian axes while minimizing
@@ -118,6 +119,14 @@ class decomposition(object):
     The decomposition can be adjusted dynamically if the best static decomposition is not known, or the system
     composition is changing dynamically. For this associated command, see update.balance().
 
+    In a *staggered* decomposition, the cut planes along x and y are shared by all domains, but every column of domains
+    (with the same x and y index) has its own cut planes along z. The load balancer (update.balance()) then adjusts the z
+    cut planes of each column independently, so that the decomposition can follow interfaces that are not planar,
+    for example a droplet or a slab that is tilted with respect to the box. Ghost particles and migrating particles are
+    exchanged with all domains of the neighboring columns, so a rank may have more than 26 neighbors. Staggered
+    decompositions are currently only supported on the CPU, and not in combination with charge.pppm, MPCD, or
+    many-body potentials that communicate forces back to the ghost particles.
+
     Priority is always given to specified arguments over the command line arguments. If one of these is not set but
     a command line option is, then the command line option is used. Otherwise, a default decomposition is chosen.
 
@@ -125,6 +134,7 @@ class decomposition(object):
 
         comm.decomposition(x=0.4, ny=2, nz=2)
         comm.decomposition(nx=2, y=0.8, z=[0.2,0.3])
+        comm.decomposition(nx=2, ny=2, nz=4, staggered=True)
 
     Warning:
         The decomposition command will override specified command line options.
@@ -142,7 +152,7 @@ class decomposition(object):
         raised if both are set.
     """
 
-    def __init__(self, x=None, y=None, z=None, nx=None, ny=None, nz=None):
+    def __init__(self, x=None, y=None, z=None, nx=None, ny=None, nz=None, staggered=False):
         hoomd.util.print_status_line()
 
         # check that the context has been initialized though
@@ -168,9 +178,10 @@ class decomposition(object):
             self.uniform_x = True
             self.uniform_y = True
             self.uniform_z = True
+            self.staggered = False
 
             hoomd.util.quiet_status()
-            self.set_params(x,y,z,nx,ny,nz)
+            self.set_params(x,y,z,nx,ny,nz,staggered)
             hoomd.util.unquiet_status()
 
             # do a one time update of the cuts to the global values if a global is set
@@ -194,7 +205,7 @@ class decomposition(object):
 
             hoomd.context.current.decomposition = self
 
-    def set_params(self,x=None,y=None,z=None,nx=None,ny=None,nz=None):
+    def set_params(self,x=None,y=None,z=None,nx=None,ny=None,nz=None,staggered=None):
         """Set parameters for the decomposition before initialization.
 
         Args:
@@ -204,6 +215,7 @@ class decomposition(object):
             nx (int): Number of processors to uniformly space in x dimension (if *x* is None)
             ny (int): Number of processors to uniformly space in y dimension (if *y* is None)
             nz (int): Number of processors to uniformly space in z dimension (if *z* is None)
+            staggered (bool): If True, let every column of domains along z have its own cut planes
 
         Examples::
 
@@ -250,6 +262,9 @@ class decomposition(object):
             self.nz = nz
             self.uniform_z = True
 
+        if staggered is not None:
+            self.staggered = staggered
+
     ## \internal
     # \brief Delayed construction of the C++ object for this balanced decomposition
     # \param box Global simulation box for decomposition
@@ -257,6 +272,7 @@ class decomposition(object):
         # if the box is uniform in all directions, just use these values
         if self.uniform_x and self.uniform_y and self.uniform_z:
             self.cpp_dd = _hoomd.DomainDecomposition(hoomd.context.exec_conf, box.getL(), self.nx, self.ny, self.nz, not hoomd.context.options.onelevel)
+            self.cpp_dd.setStaggered(self.staggered)
             return self.cpp_dd
 
         # otherwise, make the fractional decomposition
@@ -306,6 +322,7 @@ class decomposition(object):
                 raise RuntimeError("Sum of decomposition in z must lie between 0.0 and 1.0")
 
             self.cpp_dd = _hoomd.DomainDecomposition(hoomd.context.exec_conf, box.getL(), fxs, fys, fzs)
+            self.cpp_dd.setStaggered(self.staggered)
             return self.cpp_dd
 
         except TypeError as te:
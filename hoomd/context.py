@@ -254,6 +254,48 @@ def initialize(args=None, memory_traceback=False, mpi_comm=None):
     current = SimulationContext();
     return current
 
+def set_memory_budget(budget):
+    R""" Set a memory budget for the arrays of this rank
+
+    Args:
+        budget (float): Memory budget in MiB, or *None* to remove the budget.
+
+    The particle data, the neighbor list and other arrays that grow with the system reserve more memory than they
+    need, so that they are not reallocated too often. Once more than half of the budget is allocated, they only grow
+    by 1/64 of their size instead. HOOMD prints a warning with the largest allocations when the budget is exceeded,
+    but does not limit the allocations.
+
+    Example::
+
+        context.set_memory_budget(4096)
+
+    """
+    _verify_init()
+
+    if budget is None:
+        exec_conf.getMemoryAccounting().setBudget(0)
+    else:
+        exec_conf.getMemoryAccounting().setBudget(int(budget*1024*1024))
+
+def memory_usage():
+    R""" Get the memory allocated by the arrays of this rank
+
+    Returns:
+        A dictionary with the number of bytes of host and managed memory allocated per array. Arrays are named
+        ``Class::m_array`` after the class that owns them. The arrays of forces defined by evaluator templates, such
+        as the pair potentials, carry the log name of their instance, e.g. ``ForceCompute::m_force [pair_lj_energy]``.
+        Arrays that are not tagged are collected under ``untagged``.
+
+    Example::
+
+        usage = context.memory_usage()
+        print(sum(usage.values()))
+
+    """
+    _verify_init()
+
+    return exec_conf.getMemoryAccounting().getAllocations()
+
 ## Initializes the MPI configuration
 #
 # \internal
@@ -16,6 +16,65 @@ import os;
 import sys;
 import types;
 
+class checkpoint(hoomd.analyze._analyzer):
+    R""" Writes restart checkpoints with one file per MPI rank.
+
+    Args:
+        filename (str): Base name of the checkpoint.
+        period (int): Number of time steps between checkpoints (or *None* to write only once, at the current step).
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+
+    Every *period* time steps, each rank writes the particles and bonded groups it owns to a temporary file and
+    renames it to its shard ``filename.<rank>`` once all ranks have written theirs successfully. Shards hold raw
+    binary data. No data is gathered onto the root rank, so the cost of a checkpoint
+    stays constant per rank as the simulation is scaled to more ranks. The root rank then writes the manifest
+    *filename*, which holds the box, the tags, the type names, the integrator state, and the domain decomposition.
+    Each checkpoint overwrites the previous one.
+
+    Use :py:func:`hoomd.init.read_checkpoint` to restart from a checkpoint. When restarted on the same number of
+    ranks, every rank reads back only its own shard without any communication. A checkpoint can also be restarted
+    on a different number of ranks, in which case the particles are redistributed.
+
+    Note:
+        Checkpoints are meant for restarting a simulation on the same machine with the same build of HOOMD-blue.
+        Use :py:class:`gsd` to store simulation data permanently or to move it between machines.
+
+    Examples::
+
+        dump.checkpoint(filename="restart.ckpt", period=100000)
+        ckpt = dump.checkpoint(filename="restart.ckpt", period=None)
+
+    """
+    def __init__(self, filename, period, phase=0):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        hoomd.analyze._analyzer.__init__(self);
+
+        # all ranks write their shards next to the manifest of the root rank
+        filename = _hoomd.mpi_bcast_str(filename, hoomd.context.exec_conf);
+        self.cpp_analyzer = _hoomd.CheckpointWriter(hoomd.context.current.system_definition, filename);
+
+        if period is not None:
+            self.setupAnalyzer(period, phase);
+        else:
+            self.cpp_analyzer.analyze(hoomd.context.current.system.getCurrentTimeStep());
+
+        # store metadata
+        self.filename = filename
+        self.period = period
+        self.phase = phase
+        self.metadata_fields = ['filename', 'period', 'phase']
+
+    def write_restart(self):
+        """ Write a checkpoint at the current time step.
+
+        Call :py:meth:`write_restart` at the end of a simulation to ensure that the final state is saved.
+        """
+
+        time_step = hoomd.context.current.system.getCurrentTimeStep()
+        self.cpp_analyzer.analyze(time_step);
+
 class dcd(hoomd.analyze._analyzer):
     R""" Writes simulation snapshots in the DCD format
 
@@ -504,6 +563,10 @@ class gsd(hoomd.analyze._analyzer):
         time_step (int): Time step to write to the file (only used when period is None)
         dynamic (list): A list of quantity categories to save every frame. (added in version 2.2)
         static (list): A list of quantity categories save only in frame 0 (may not be set in conjunction with *dynamic*, deprecated in version 2.2).
+        parallel_io (bool): When True, every MPI rank writes its own particles to the file with MPI-IO.
+        aggregators (int): Number of ranks that access the file when *parallel_io* is True (0 lets MPI choose).
+        async_write (bool): When True, write frames from a background thread.
+        max_queue (int): Maximum number of frames waiting to be written when *async_write* is True.
 
     Write a simulation snapshot to the specified GSD file at regular intervals. GSD is capable of storing all particle
     and bond data fields in hoomd, in every frame of the trajectory. This allows GSD to store simulations where the
@@ -560,6 +623,23 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    .. rubric:: Parallel I/O
+
+    By default, :py:class:`gsd` gathers all particles on the root rank, which writes the file. For large systems on
+    many ranks, this stalls the simulation and requires memory for the whole system on the root rank. With
+    ``parallel_io=True``, the root rank only reserves space for every per-particle chunk, and all ranks write their
+    particles directly into it with collective MPI-IO. The number of ranks that actually access the file can be limited
+    with *aggregators*. The resulting file is identical to one written without parallel I/O. Topology and
+    user-defined log quantities are still gathered on the root rank.
+
+    .. rubric:: Asynchronous writes
+
+    With ``async_write=True``, :py:class:`gsd` copies the frame into a buffer and a background thread writes it to the
+    file while the simulation continues. The simulation only waits for the file when *max_queue* frames are already
+    waiting to be written. All queued frames are written by the end of every :py:func:`hoomd.run()`. Frames are
+    written synchronously when *truncate* is set, with ``parallel_io=True``, or when state data is saved with
+    :py:meth:`dump_state`.
+
     .. rubric:: State data
 
     :py:class:`gsd` can save internal state data for the following hoomd objects:
@@ -584,6 +664,8 @@ class gsd(hoomd.analyze._analyzer):
         dump.gsd(filename="configuration.gsd", overwrite=True, period=None, group=group.all(), time_step=0)
         dump.gsd(filename="momentum_too.gsd", period=1000, group=group.all(), phase=0, dynamic=['momentum'])
         dump.gsd(filename="saveall.gsd", overwrite=True, period=1000, group=group.all(), dynamic=['attribute', 'momentum', 'topology'])
+        dump.gsd(filename="large.gsd", period=1000, group=group.all(), parallel_io=True, aggregators=16)
+        dump.gsd(filename="trajectory.gsd", period=1000, group=group.all(), async_write=True, max_queue=4)
 
     """
     def __init__(self,
@@ -595,7 +677,11 @@ class gsd(hoomd.analyze._analyzer):
                  phase=0,
                  time_step=None,
                  static=None,
-                 dynamic=None):
+                 dynamic=None,
+                 parallel_io=False,
+                 aggregators=0,
+                 async_write=False,
+                 max_queue=2):
         hoomd.util.print_status_line();
 
         if static is not None and dynamic is not None:
@@ -635,6 +721,8 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' in dynamic_quantities);
         self.cpp_analyzer.setWriteMomentum('momentum' in dynamic_quantities);
         self.cpp_analyzer.setWriteTopology('topology' in dynamic_quantities);
+        self.cpp_analyzer.setParallelIO(parallel_io, int(aggregators));
+        self.cpp_analyzer.setAsync(async_write, int(max_queue));
 
         if period is not None:
             self.setupAnalyzer(period, phase);
@@ -642,6 +730,7 @@ class gsd(hoomd.analyze._analyzer):
             if time_step is None:
                 time_step = hoomd.context.current.system.getCurrentTimeStep()
             self.cpp_analyzer.analyze(time_step);
+            self.cpp_analyzer.flush();
 
         # store metadata
         self.filename = filename
@@ -660,6 +749,7 @@ class gsd(hoomd.analyze._analyzer):
 
         time_step = hoomd.context.current.system.getCurrentTimeStep()
         self.cpp_analyzer.analyze(time_step);
+        self.cpp_analyzer.flush();
 
     def dump_state(self, obj):
         """Write state information for a hoomd object.
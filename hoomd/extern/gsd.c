@@ -151,8 +151,10 @@ static int __gsd_expand_index(struct gsd_handle *handle)
         // zero the new memory
         memset(handle->index + old_size, 0, sizeof(struct gsd_index_entry) * (old_size * multiplication_factor - old_size));
 
-        // now, put the new larger index at the end of the file
+        // now, put the new larger index at the end of the file (after any reserved chunks)
         handle->header.index_location = lseek(handle->fd, 0, SEEK_END);
+        if (handle->header.index_location < handle->file_size)
+            handle->header.index_location = handle->file_size;
         ssize_t bytes_written = __pwrite_retry(handle->fd,
                                                handle->index,
                                                sizeof(struct gsd_index_entry) * handle->header.index_allocated_entries,
@@ -172,6 +174,8 @@ static int __gsd_expand_index(struct gsd_handle *handle)
         char buf[1024*16];
 
         int64_t new_index_location = lseek(handle->fd, 0, SEEK_END);
+        if (new_index_location < handle->file_size)
+            new_index_location = handle->file_size;
         int64_t old_index_location = handle->header.index_location;
         size_t total_bytes_written = 0;
         size_t old_index_bytes = old_size * sizeof(struct gsd_index_entry);
@@ -241,6 +245,42 @@ static int __gsd_expand_index(struct gsd_handle *handle)
     return 0;
     }
 
+/*! \internal
+    \brief Utility function to add an entry to the index of the current frame
+    \param handle handle to the open gsd file
+    \param index_entry entry to add
+*/
+static int __gsd_append_index_entry(struct gsd_handle *handle, const struct gsd_index_entry *index_entry)
+    {
+    // need to expand the index if it is already full
+    if (handle->index_num_entries >= handle->header.index_allocated_entries)
+        {
+        int retval = __gsd_expand_index(handle);
+        if (retval != 0)
+            return -1;
+        }
+
+    // once we get here, there is a free slot to add this entry to the index
+    size_t slot = handle->index_num_entries;
+
+    // in append mode, only unwritten entries are stored in memory
+    if (handle->open_flags == GSD_OPEN_APPEND)
+        {
+        slot -= handle->index_written_entries;
+        if (slot >= handle->append_index_size)
+            {
+            handle->append_index_size *= 2;
+            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
+            if (handle->index == NULL)
+                return -1;
+            }
+        }
+    handle->index[slot] = *index_entry;
+    handle->index_num_entries++;
+
+    return 0;
+    }
+
 /*! \internal
     \brief utility function to search the namelist and return the id assigned to the name
     \param handle handle to the open gsd file
@@ -985,34 +1025,60 @@ int gsd_write_chunk(struct gsd_handle* handle,
     // update the file_size in the handle
     handle->file_size += bytes_written;
 
-    // update the index entry in the index
-    // need to expand the index if it is already full
-    if (handle->index_num_entries >= handle->header.index_allocated_entries)
-        {
-        int retval = __gsd_expand_index(handle);
-        if (retval != 0)
-            return -1;
-        }
+    return __gsd_append_index_entry(handle, &index_entry);
+    }
 
-    // once we get here, there is a free slot to add this entry to the index
-    size_t slot = handle->index_num_entries;
+/*! \param handle Handle to an open GSD file
+    \param name Name of the data chunk (truncated to 63 chars)
+    \param type type ID that identifies the type of data in the chunk
+    \param N Number of rows in the data
+    \param M Number of columns in the data
+    \param flags set to 0, non-zero values reserved for future use
+    \param location Offset in the file where the caller must write the chunk data (output)
 
-    // in append mode, only unwritten entries are stored in memory
-    if (handle->open_flags == GSD_OPEN_APPEND)
-        {
-        slot -= handle->index_written_entries;
-        if (slot >= handle->append_index_size)
-            {
-            handle->append_index_size *= 2;
-            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
-            if (handle->index == NULL)
-                return -1;
-            }
-        }
-    handle->index[slot] = index_entry;
-    handle->index_num_entries++;
+    \pre \a handle was opened by gsd_open().
+    \pre \a name is a unique name for data chunks in the given frame.
 
-    return 0;
+    \post Space for the chunk is reserved at the end of the file and its location is updated in the in-memory index.
+    The caller must write `N * M * gsd_sizeof_type(type)` bytes at \a location (for example, with parallel I/O) before
+    calling gsd_end_frame().
+
+    \return 0 on success, -1 on a file IO failure - see errno for details, -2 on invalid input, and -3 when out of names
+*/
+int gsd_reserve_chunk(struct gsd_handle* handle,
+                      const char *name,
+                      enum gsd_type type,
+                      uint64_t N,
+                      uint32_t M,
+                      uint8_t flags,
+                      int64_t *location)
+    {
+    // validate input
+    if (location == NULL)
+        return -2;
+    if (M == 0)
+        return -2;
+    if (handle->open_flags == GSD_OPEN_READONLY)
+        return -2;
+
+    // populate fields in the index_entry data
+    struct gsd_index_entry index_entry;
+    memset(&index_entry, 0, sizeof(index_entry));
+    index_entry.frame = handle->cur_frame;
+    index_entry.id = __gsd_get_id(handle, name, 1);
+    if (index_entry.id == UINT16_MAX)
+        return -3;
+    index_entry.type = (uint8_t)type;
+    index_entry.N = N;
+    index_entry.M = M;
+    size_t size = N * M * gsd_sizeof_type(type);
+
+    // reserve the space at the end of the file for the chunk
+    index_entry.location = handle->file_size;
+    handle->file_size += size;
+    *location = index_entry.location;
+
+    return __gsd_append_index_entry(handle, &index_entry);
     }
 
 /*! \param handle Handle to an open GSD file
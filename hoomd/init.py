@@ -250,7 +250,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, parallel_io = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -258,6 +258,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file. Negative values index from the end of the file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        parallel_io (bool): When True, every MPI rank reads a part of the file.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -273,6 +274,10 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
+    By default, the root rank reads the whole frame and distributes it to the other ranks. For large systems on many
+    ranks, set *parallel_io* to True. Every rank then reads a contiguous range of the particles and bonded groups
+    directly from the file and sends them to the ranks that own them, so no rank needs memory for the whole system.
+
     See Also:
         :py:class:`hoomd.dump.gsd`
     """
@@ -288,10 +293,10 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     restart = _hoomd.mpi_bcast_str(restart, hoomd.context.exec_conf);
 
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0, parallel_io);
         time_step = reader.getTimeStep();
     else:
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0, parallel_io);
         if time_step is None:
             time_step = reader.getTimeStep();
 
@@ -302,7 +307,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
 
     if my_domain_decomposition is not None:
-        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition, parallel_io);
     else:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
 
@@ -314,6 +319,72 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     hoomd.context.current.state_reader.clearSnapshot();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
+def read_checkpoint(filename):
+    R""" Restart from a checkpoint written by :py:class:`hoomd.dump.checkpoint`.
+
+    Args:
+        filename (str): Base name of the checkpoint.
+
+    All particles, bonds, angles, dihedrals, impropers, constraints, special pairs, the box, the integrator state,
+    and the time step are restored from the checkpoint. Particle and bond tags are preserved.
+
+    When the number of ranks is the same as when the checkpoint was written, and no
+    :py:class:`hoomd.comm.decomposition` has been specified, the simulation resumes with the domain decomposition of
+    the checkpoint, including any boundaries set by load balancing. Every rank then reads back only its own shard,
+    without any communication. Otherwise, the shards are divided among the ranks and the particles are sent to the
+    ranks that own them.
+
+    Example::
+
+        dump.checkpoint(filename="restart.ckpt", period=100000)
+
+        # in the restarted job
+        if os.path.exists("restart.ckpt"):
+            system = init.read_checkpoint("restart.ckpt")
+        else:
+            system = init.read_gsd("init.gsd")
+
+    See Also:
+        :py:class:`hoomd.dump.checkpoint`
+    """
+    hoomd.context._verify_init();
+    hoomd.util.print_status_line();
+
+    # check if initialization has already occurred
+    if is_initialized():
+        hoomd.context.msg.error("Cannot initialize more than once\n");
+        raise RuntimeError("Error initializing");
+
+    filename = _hoomd.mpi_bcast_str(filename, hoomd.context.exec_conf);
+    reader = _hoomd.CheckpointReader(hoomd.context.exec_conf, filename);
+    box = reader.getBox();
+
+    # resume with the domain decomposition of the checkpoint, unless the user specified one
+    if (_hoomd.is_MPI_available() and hoomd.context.exec_conf.getNRanks() > 1 and
+        hoomd.context.current.decomposition is None and reader.getNRanks() == hoomd.context.exec_conf.getNRanks()):
+        hoomd.util.quiet_status();
+        hoomd.context.current.decomposition = hoomd.comm.decomposition();
+        hoomd.util.unquiet_status();
+        hoomd.context.current.decomposition.cpp_dd = reader.getDomainDecomposition();
+        my_domain_decomposition = hoomd.context.current.decomposition.cpp_dd;
+    else:
+        my_domain_decomposition = _create_domain_decomposition(box);
+
+    if my_domain_decomposition is not None:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(0, box, reader.getNumParticleTypes(),
+            0, 0, 0, 0, hoomd.context.exec_conf, my_domain_decomposition);
+    else:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(0, box, reader.getNumParticleTypes(),
+            0, 0, 0, 0, hoomd.context.exec_conf);
+
+    reader.restore(hoomd.context.current.system_definition);
+
+    # initialize the system
+    hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, reader.getTimeStep());
+
+    _perform_common_init_tasks();
+    return hoomd.data.system_data(hoomd.context.current.system_definition);
+
 def restore_getar(filename, modes={'any': 'any'}):
     """Restore a subset of the current system's parameters from a
     trajectory archive (.tar, .zip, .sqlite) file. For a detailed
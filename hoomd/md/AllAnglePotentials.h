@@ -0,0 +1,25 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifndef __ANGLE_POTENTIALS__H__
+#define __ANGLE_POTENTIALS__H__
+
+#include "PotentialAngle.h"
+#include "EvaluatorAngleHarmonic.h"
+#include "EvaluatorAngleCosineSq.h"
+
+/*! \file AllAnglePotentials.h
+    \brief Handy list of typedefs for all of the templated angle potentials in hoomd
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Angle potential force compute for harmonic forces
+typedef PotentialAngle<EvaluatorAngleHarmonic> PotentialAngleHarmonic;
+//! Angle potential force compute for cosine squared forces
+typedef PotentialAngle<EvaluatorAngleCosineSq> PotentialAngleCosineSq;
+
+#endif // __ANGLE_POTENTIALS_H__
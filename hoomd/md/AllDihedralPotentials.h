@@ -0,0 +1,25 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifndef __DIHEDRAL_POTENTIALS__H__
+#define __DIHEDRAL_POTENTIALS__H__
+
+#include "PotentialDihedral.h"
+#include "EvaluatorDihedralHarmonic.h"
+#include "EvaluatorDihedralOPLS.h"
+
+/*! \file AllDihedralPotentials.h
+    \brief Handy list of typedefs for all of the templated dihedral potentials in hoomd
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Dihedral potential force compute for harmonic forces
+typedef PotentialDihedral<EvaluatorDihedralHarmonic> PotentialDihedralHarmonic;
+//! Dihedral potential force compute for OPLS forces
+typedef PotentialDihedral<EvaluatorDihedralOPLS> PotentialDihedralOPLS;
+
+#endif // __DIHEDRAL_POTENTIALS_H__
@@ -26,6 +26,7 @@
 #include "EvaluatorPairLJ1208.h"
 #include "EvaluatorPairDLVO.h"
 #include "EvaluatorPairFourier.h"
+#include "EvaluatorPairLJPME.h"
 
 #ifdef ENABLE_CUDA
 #include "PotentialPairGPU.h"
@@ -80,6 +81,8 @@ typedef PotentialPair<EvaluatorPairLJ1208> PotentialPairLJ1208;
 typedef PotentialPair<EvaluatorPairDLVO> PotentialPairDLVO;
 //! Pair potential force compute for Fourier potential
 typedef PotentialPair<EvaluatorPairFourier> PotentialPairFourier;
+//! Pair potential force compute for the short-ranged part of LJ with mesh dispersion
+typedef PotentialPair<EvaluatorPairLJPME> PotentialPairLJPME;
 
 #ifdef ENABLE_CUDA
 //! Pair potential force compute for lj forces on the GPU
@@ -120,6 +123,8 @@ typedef PotentialPairGPU< EvaluatorPairLJ1208, gpu_compute_lj1208_forces > Poten
 typedef PotentialPairGPU< EvaluatorPairDLVO, gpu_compute_dlvo_forces > PotentialPairDLVOGPU;
 //! Pair potential force compute for Fourier forces on the gpu
 typedef PotentialPairGPU<EvaluatorPairFourier, gpu_compute_fourier_forces> PotentialPairFourierGPU;
+//! Pair potential force compute for the short-ranged part of LJ with mesh dispersion on the GPU
+typedef PotentialPairGPU<EvaluatorPairLJPME, gpu_compute_lj_pme_forces> PotentialPairLJPMEGPU;
 #endif
 
 #endif // __PAIR_POTENTIALS_H__
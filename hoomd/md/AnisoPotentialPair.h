@@ -17,6 +17,7 @@
 #endif
 
 #include "NeighborList.h"
+#include "NeighborListCluster.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
@@ -61,6 +62,8 @@
     potential aniso_evaluator class passed in. See the appropriate documentation for the aniso_evaluator for the definition of each
     element of the parameters.
 
+    When the neighbor list is a NeighborListCluster, the forces are computed directly from its cluster pairs.
+
     For profiling and logging, AnisoPotentialPair needs to know the name of the potential. For now, that will be queried from
     the aniso_evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -160,6 +163,9 @@ class AnisoPotentialPair : public ForceCompute
 
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
+        std::shared_ptr<NeighborListCluster> m_nlist_cluster; //!< m_nlist if it provides cluster pairs
+        std::vector<Scalar4> m_cluster_pos;         //!< Positions of the cluster members, in cluster order
+        std::vector<Scalar4> m_cluster_orientation; //!< Orientations of the cluster members, in cluster order
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
         Index2D m_typpair_idx;                      //!< Helper class for indexing per type pair arrays
         GlobalArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
@@ -171,6 +177,9 @@ class AnisoPotentialPair : public ForceCompute
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces from the cluster pairs of m_nlist_cluster
+        void computeForcesCluster(unsigned int timestep);
+
         //! Method to be called when number of types changes
         void slotNumTypesChange()
             {
@@ -190,6 +199,9 @@ class AnisoPotentialPair : public ForceCompute
             m_params.swap(params);
             GlobalArray<shape_param_type> shape_params(m_pdata->getNTypes(), m_exec_conf, "shape_params", true);
             m_shape_params.swap(shape_params);
+            TAG_ALLOCATION_INSTANCE(m_rcutsq, m_log_name);
+            TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+            TAG_ALLOCATION_INSTANCE(m_shape_params, m_log_name);
 
             #ifdef ENABLE_CUDA
             if (m_pdata->getExecConf()->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
@@ -247,6 +259,8 @@ AnisoPotentialPair< aniso_evaluator >::AnisoPotentialPair(std::shared_ptr<System
     assert(m_pdata);
     assert(m_nlist);
 
+    m_nlist_cluster = std::dynamic_pointer_cast<NeighborListCluster>(m_nlist);
+
     GlobalArray<Scalar> rcutsq(m_typpair_idx.getNumElements(), m_exec_conf);
     m_rcutsq.swap(rcutsq);
     GlobalArray<param_type> params(m_typpair_idx.getNumElements(), m_exec_conf, "my_params", true);
@@ -278,6 +292,12 @@ AnisoPotentialPair< aniso_evaluator >::AnisoPotentialPair(std::shared_ptr<System
     m_prof_name = std::string("Aniso_Pair ") + aniso_evaluator::getName();
     m_log_name = std::string("aniso_pair_") + aniso_evaluator::getName() + std::string("_energy") + log_suffix;
 
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_rcutsq, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_shape_params, m_log_name);
+
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_pdata->getNumTypesChangeSignal().template connect<AnisoPotentialPair<aniso_evaluator>,
                                                         &AnisoPotentialPair<aniso_evaluator>::slotNumTypesChange>(this);
@@ -391,6 +411,13 @@ Scalar AnisoPotentialPair< aniso_evaluator >::getLogValue(const std::string& qua
 template< class aniso_evaluator >
 void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     {
+    // the cluster pair neighbor list has its own kernel
+    if (m_nlist_cluster)
+        {
+        computeForcesCluster(timestep);
+        return;
+        }
+
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
@@ -595,6 +622,202 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     if (m_prof) m_prof->pop();
     }
 
+/*! Loops over the cluster pairs of a NeighborListCluster. The positions and orientations of the members of all
+    clusters are gathered in cluster order first, so that the members of a j-cluster are read from consecutive memory.
+
+    \param timestep specifies the current time step of the simulation
+*/
+template< class aniso_evaluator >
+void AnisoPotentialPair< aniso_evaluator >::computeForcesCluster(unsigned int timestep)
+    {
+    // start by updating the cluster pairs
+    m_nlist_cluster->computeClusters(timestep);
+
+    // start the profile for this compute
+    if (m_prof) m_prof->push(m_prof_name);
+
+    bool third_law = m_nlist_cluster->getStorageMode() == NeighborList::half;
+
+    const std::vector<unsigned int>& members = m_nlist_cluster->getClusterMembers();
+    const std::vector<unsigned int>& cluster_head = m_nlist_cluster->getClusterHeadList();
+    const std::vector<uint2>& cluster_pairs = m_nlist_cluster->getClusterPairs();
+    const unsigned int n_clusters = m_nlist_cluster->getNClusters();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host,access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    //force arrays
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_torque(m_torque,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getBox();
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<shape_param_type> h_shape_params(m_shape_params, access_location::host, access_mode::read);
+
+    // need to start from a zero force, energy and virial
+    memset(&h_force.data[0] , 0, sizeof(Scalar4)*m_pdata->getN());
+    memset(&h_torque.data[0] , 0, sizeof(Scalar4)*m_pdata->getN());
+    memset(&h_virial.data[0] , 0, sizeof(Scalar)*m_virial.getNumElements());
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+    // design specifies that energies are shifted if
+    // shift mode is set to shift
+    bool energy_shift = (m_shift_mode == shift);
+
+    // gather the positions and orientations of the cluster members, padding entries are never read
+    m_cluster_pos.resize(members.size());
+    m_cluster_orientation.resize(members.size());
+    for (unsigned int k = 0; k < members.size(); k++)
+        {
+        if (members[k] != NeighborListCluster::CLUSTER_PADDING)
+            {
+            m_cluster_pos[k] = h_pos.data[members[k]];
+            m_cluster_orientation[k] = h_orientation.data[members[k]];
+            }
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    for (unsigned int cluster_i = 0; cluster_i < n_clusters; cluster_i++)
+        {
+        const unsigned int *members_i = &members[cluster_i*NLIST_CLUSTER_SIZE];
+        const Scalar4 *pos_i = &m_cluster_pos[cluster_i*NLIST_CLUSTER_SIZE];
+        const Scalar4 *quat_i = &m_cluster_orientation[cluster_i*NLIST_CLUSTER_SIZE];
+
+        // initialize the force, torque, potential energy, and virial of the members to 0
+        Scalar3 fi[NLIST_CLUSTER_SIZE];
+        Scalar3 ti[NLIST_CLUSTER_SIZE];
+        Scalar pei[NLIST_CLUSTER_SIZE];
+        Scalar virial_i[NLIST_CLUSTER_SIZE][6];
+        for (unsigned int a = 0; a < NLIST_CLUSTER_SIZE; a++)
+            {
+            fi[a] = make_scalar3(0, 0, 0);
+            ti[a] = make_scalar3(0, 0, 0);
+            pei[a] = Scalar(0.0);
+            for (unsigned int l = 0; l < 6; l++)
+                virial_i[a][l] = Scalar(0.0);
+            }
+
+        // loop over all cluster pairs of this cluster
+        for (unsigned int p = cluster_head[cluster_i]; p < cluster_head[cluster_i+1]; p++)
+            {
+            const unsigned int *members_j = &members[cluster_pairs[p].x*NLIST_CLUSTER_SIZE];
+            const Scalar4 *pos_j = &m_cluster_pos[cluster_pairs[p].x*NLIST_CLUSTER_SIZE];
+            const Scalar4 *quat_j = &m_cluster_orientation[cluster_pairs[p].x*NLIST_CLUSTER_SIZE];
+
+            // loop over the interacting particle pairs
+            unsigned int mask = cluster_pairs[p].y;
+            for (unsigned int bit = 0; mask; bit++, mask >>= 1)
+                {
+                if (!(mask & 1))
+                    continue;
+
+                const unsigned int a = bit / NLIST_CLUSTER_SIZE;
+                const unsigned int b = bit % NLIST_CLUSTER_SIZE;
+                const unsigned int i = members_i[a];
+                const unsigned int j = members_j[b];
+
+                Scalar3 dx = make_scalar3(pos_i[a].x - pos_j[b].x, pos_i[a].y - pos_j[b].y, pos_i[a].z - pos_j[b].z);
+                dx = box.minImage(dx);
+
+                unsigned int typei = __scalar_as_int(pos_i[a].w);
+                unsigned int typej = __scalar_as_int(pos_j[b].w);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+
+                // compute the force and potential energy
+                Scalar3 force = make_scalar3(0.0,0.0,0.0);
+                Scalar3 torque_i = make_scalar3(0.0,0.0,0.0);
+                Scalar3 torque_j = make_scalar3(0.0,0.0,0.0);
+                Scalar pair_eng = Scalar(0.0);
+
+                Scalar4 qi = quat_i[a];
+                Scalar4 qj = quat_j[b];
+                aniso_evaluator eval(dx, qi, qj, h_rcutsq.data[typpair_idx], h_params.data[typpair_idx]);
+
+                if (aniso_evaluator::needsDiameter())
+                    eval.setDiameter(h_diameter.data[i], h_diameter.data[j]);
+                if (aniso_evaluator::needsCharge())
+                    eval.setCharge(h_charge.data[i], h_charge.data[j]);
+                if (aniso_evaluator::needsShape())
+                    eval.setShape(&h_shape_params.data[typei], &h_shape_params.data[typej]);
+                if (aniso_evaluator::needsTags())
+                    eval.setTags(h_tag.data[i], h_tag.data[j]);
+
+                if (!eval.evaluate(force, pair_eng, energy_shift, torque_i, torque_j))
+                    continue;
+
+                Scalar3 force2 = Scalar(0.5)*force;
+
+                fi[a] += force;
+                ti[a] += torque_i;
+                pei[a] += pair_eng * Scalar(0.5);
+                if (compute_virial)
+                    {
+                    virial_i[a][0] += dx.x*force2.x;
+                    virial_i[a][1] += dx.y*force2.x;
+                    virial_i[a][2] += dx.z*force2.x;
+                    virial_i[a][3] += dx.y*force2.y;
+                    virial_i[a][4] += dx.z*force2.y;
+                    virial_i[a][5] += dx.z*force2.z;
+                    }
+
+                // add the force to particle j if we are using the third law, only for local particles
+                if (third_law && j < N)
+                    {
+                    h_force.data[j].x -= force.x;
+                    h_force.data[j].y -= force.y;
+                    h_force.data[j].z -= force.z;
+                    h_torque.data[j].x += torque_j.x;
+                    h_torque.data[j].y += torque_j.y;
+                    h_torque.data[j].z += torque_j.z;
+                    h_force.data[j].w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        {
+                        h_virial.data[0*m_virial_pitch+j] += dx.x*force2.x;
+                        h_virial.data[1*m_virial_pitch+j] += dx.y*force2.x;
+                        h_virial.data[2*m_virial_pitch+j] += dx.z*force2.x;
+                        h_virial.data[3*m_virial_pitch+j] += dx.y*force2.y;
+                        h_virial.data[4*m_virial_pitch+j] += dx.z*force2.y;
+                        h_virial.data[5*m_virial_pitch+j] += dx.z*force2.z;
+                        }
+                    }
+                }
+            }
+
+        // finally, increment the force, torque, potential energy and virial of the local members
+        for (unsigned int a = 0; a < NLIST_CLUSTER_SIZE; a++)
+            {
+            const unsigned int i = members_i[a];
+            if (i >= N)
+                continue;
+
+            h_force.data[i].x += fi[a].x;
+            h_force.data[i].y += fi[a].y;
+            h_force.data[i].z += fi[a].z;
+            h_torque.data[i].x += ti[a].x;
+            h_torque.data[i].y += ti[a].y;
+            h_torque.data[i].z += ti[a].z;
+            h_force.data[i].w += pei[a];
+            if (compute_virial)
+                {
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial.data[l*m_virial_pitch+i] += virial_i[a][l];
+                }
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 #ifdef ENABLE_MPI
 /*! \param timestep Current time step
  */
@@ -15,9 +15,11 @@ namespace py = pybind11;
 using namespace std;
 
 /*! \param sysdef System to compute angle forces on
+    \param log_suffix Name given to this instance of the force
 */
-CosineSqAngleForceComputeGPU::CosineSqAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef)
-        : CosineSqAngleForceCompute(sysdef)
+CosineSqAngleForceComputeGPU::CosineSqAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                           const std::string& log_suffix)
+        : PotentialAngleCosineSq(sysdef, log_suffix)
     {
     // can't run on the GPU if there aren't any GPUs in the execution configuration
     if (!m_exec_conf->isCUDAEnabled())
@@ -26,10 +28,6 @@ CosineSqAngleForceComputeGPU::CosineSqAngleForceComputeGPU(std::shared_ptr<Syste
         throw std::runtime_error("Error initializing AngleForceComputeGPU");
         }
 
-    // allocate and zero device memory
-    GPUArray<Scalar2> params(m_angle_data->getNTypes(), m_exec_conf);
-    m_params.swap(params);
-
     m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "cosinesq_angle", this->m_exec_conf));
     }
 
@@ -37,22 +35,6 @@ CosineSqAngleForceComputeGPU::~CosineSqAngleForceComputeGPU()
     {
     }
 
-/*! \param type Type of the angle to set parameters for
-    \param K Stiffness parameter for the force computation
-    \param t_0 Equilibrium angle (in radians) for the force computation
-
-    Sets parameters for the potential of a particular angle type and updates the
-    parameters on the GPU.
-*/
-void CosineSqAngleForceComputeGPU::setParams(unsigned int type, Scalar K, Scalar t_0)
-    {
-    CosineSqAngleForceCompute::setParams(type, K, t_0);
-
-    ArrayHandle<Scalar2> h_params(m_params, access_location::host, access_mode::readwrite);
-    // update the local copy of the memory
-    h_params.data[type] = make_scalar2(K, t_0);
-    }
-
 /*! Internal method for computing the forces on the GPU.
     \post The force data on the GPU is written with the calculated forces
 
@@ -103,7 +85,7 @@ void CosineSqAngleForceComputeGPU::computeForces(unsigned int timestep)
 
 void export_CosineSqAngleForceComputeGPU(py::module& m)
     {
-    py::class_<CosineSqAngleForceComputeGPU, std::shared_ptr<CosineSqAngleForceComputeGPU> >(m, "CosineSqAngleForceComputeGPU", py::base<CosineSqAngleForceCompute>())
-    .def(py::init< std::shared_ptr<SystemDefinition> >())
+    py::class_<CosineSqAngleForceComputeGPU, std::shared_ptr<CosineSqAngleForceComputeGPU> >(m, "CosineSqAngleForceComputeGPU", py::base<PotentialAngleCosineSq>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string& >())
     ;
     }
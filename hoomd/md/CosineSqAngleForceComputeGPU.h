@@ -3,7 +3,7 @@
 
 
 
-#include "CosineSqAngleForceCompute.h"
+#include "AllAnglePotentials.h"
 #include "CosineSqAngleForceGPU.cuh"
 #include "hoomd/Autotuner.h"
 
@@ -22,22 +22,21 @@
 #define __COSINESQANGLEFORCECOMPUTEGPU_H__
 
 //! Implements the cosine squared angle force calculation on the GPU
-/*! CosineSqAngleForceComputeGPU implements the same calculations as CosineSqAngleForceCompute,
+/*! CosineSqAngleForceComputeGPU implements the same calculations as PotentialAngleCosineSq,
     but executing on the GPU.
 
-    Per-type parameters are stored in a simple global memory area pointed to by
-    \a m_gpu_params. They are stored as Scalar2's with the \a x component being K and the
-    \a y component being t_0.
+    The per-type parameters of PotentialAngleCosineSq are passed to the kernel directly. They are stored as
+    Scalar2's with the \a x component being K and the \a y component being t_0.
 
     The GPU kernel can be found in angleforce_kernel.cu.
 
     \ingroup computes
 */
-class PYBIND11_EXPORT CosineSqAngleForceComputeGPU : public CosineSqAngleForceCompute
+class PYBIND11_EXPORT CosineSqAngleForceComputeGPU : public PotentialAngleCosineSq
     {
     public:
         //! Constructs the compute
-        CosineSqAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef);
+        CosineSqAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef, const std::string& log_suffix="");
         //! Destructor
         ~CosineSqAngleForceComputeGPU();
 
@@ -47,17 +46,13 @@ class PYBIND11_EXPORT CosineSqAngleForceComputeGPU : public CosineSqAngleForceCo
         */
         virtual void setAutotunerParams(bool enable, unsigned int period)
             {
-            CosineSqAngleForceCompute::setAutotunerParams(enable, period);
+            PotentialAngleCosineSq::setAutotunerParams(enable, period);
             m_tuner->setPeriod(period);
             m_tuner->setEnabled(enable);
             }
 
-        //! Set the parameters
-        virtual void setParams(unsigned int type, Scalar K, Scalar t_0);
-
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<Scalar2>  m_params;          //!< Parameters stored on the GPU
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -0,0 +1,78 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __ANGLE_EVALUATOR_COSINESQ_H__
+#define __ANGLE_EVALUATOR_COSINESQ_H__
+
+#ifndef NVCC
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorAngleCosineSq.h
+    \brief Defines the angle evaluator class for cosine squared potentials
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Class for evaluating the cosine squared angle potential
+/*! See EvaluatorAngleHarmonic for the interface used by PotentialAngle.
+
+    \f$ V(\theta) = \frac{1}{2} K (\cos\theta - \cos\theta_0)^2 \f$
+
+    params.x is the K stiffness parameter, and params.y is the rest angle t_0 in radians.
+    The stiffness K has units of energy, unlike the one of EvaluatorAngleHarmonic.
+*/
+class EvaluatorAngleCosineSq
+    {
+    public:
+        //! Define the parameter type used by this angle potential evaluator
+        typedef Scalar2 param_type;
+
+        //! Constructs the angle potential evaluator
+        /*! \param _cos_th Cosine of the angle
+            \param _params Per type parameters of this potential
+        */
+        DEVICE EvaluatorAngleCosineSq(Scalar _cos_th, const param_type& _params)
+            : cos_th(_cos_th), K(_params.x), t_0(_params.y)
+            {
+            }
+
+        //! Evaluate the force and energy
+        /*! \param dU_dcos Output parameter to write the derivative of the energy with respect to the cosine
+            \param angle_eng Output parameter to write the computed angle energy
+        */
+        DEVICE void evalForceAndEnergy(Scalar& dU_dcos, Scalar& angle_eng)
+            {
+            Scalar dcosth = cos_th - fast::cos(t_0);
+            Scalar tk = K*dcosth;
+
+            dU_dcos = tk;
+            angle_eng = Scalar(0.5)*tk*dcosth;
+            }
+
+        #ifndef NVCC
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("cosinesq");
+            }
+        #endif
+
+    protected:
+        Scalar cos_th;     //!< Cosine of the angle
+        Scalar K;          //!< K parameter
+        Scalar t_0;        //!< t_0 parameter
+    };
+
+#endif // __ANGLE_EVALUATOR_COSINESQ_H__
@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __ANGLE_EVALUATOR_HARMONIC_H__
+#define __ANGLE_EVALUATOR_HARMONIC_H__
+
+#ifndef NVCC
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorAngleHarmonic.h
+    \brief Defines the angle evaluator class for harmonic potentials
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Class for evaluating the harmonic angle potential
+/*! Angle evaluators are used by PotentialAngle, which computes the geometry of an angle a-b-c. The evaluator is
+    constructed with the cosine of the angle and the parameters of the angle type. evalForceAndEnergy() computes the
+    derivative of the energy with respect to the cosine and the energy of the angle, from which PotentialAngle
+    computes the forces on the three particles.
+
+    \f$ V(\theta) = \frac{1}{2} K (\theta - \theta_0)^2 \f$
+
+    params.x is the K stiffness parameter, and params.y is the rest angle t_0 in radians.
+*/
+class EvaluatorAngleHarmonic
+    {
+    public:
+        //! Define the parameter type used by this angle potential evaluator
+        typedef Scalar2 param_type;
+
+        //! Constructs the angle potential evaluator
+        /*! \param _cos_th Cosine of the angle
+            \param _params Per type parameters of this potential
+        */
+        DEVICE EvaluatorAngleHarmonic(Scalar _cos_th, const param_type& _params)
+            : cos_th(_cos_th), K(_params.x), t_0(_params.y)
+            {
+            }
+
+        //! Evaluate the force and energy
+        /*! \param dU_dcos Output parameter to write the derivative of the energy with respect to the cosine
+            \param angle_eng Output parameter to write the computed angle energy
+        */
+        DEVICE void evalForceAndEnergy(Scalar& dU_dcos, Scalar& angle_eng)
+            {
+            // dtheta/dcos diverges for straight angles, limit the inverse sine
+            Scalar s = fast::sqrt(Scalar(1.0) - cos_th*cos_th);
+            if (s < Scalar(0.001)) s = Scalar(0.001);
+
+            Scalar dth = fast::acos(cos_th) - t_0;
+            Scalar tk = K*dth;
+
+            dU_dcos = -tk/s;
+            angle_eng = Scalar(0.5)*tk*dth;
+            }
+
+        #ifndef NVCC
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("harmonic");
+            }
+        #endif
+
+    protected:
+        Scalar cos_th;     //!< Cosine of the angle
+        Scalar K;          //!< K parameter
+        Scalar t_0;        //!< t_0 parameter
+    };
+
+#endif // __ANGLE_EVALUATOR_HARMONIC_H__
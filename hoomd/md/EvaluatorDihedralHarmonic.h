@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __DIHEDRAL_EVALUATOR_HARMONIC_H__
+#define __DIHEDRAL_EVALUATOR_HARMONIC_H__
+
+#ifndef NVCC
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorDihedralHarmonic.h
+    \brief Defines the dihedral evaluator class for harmonic potentials
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Class for evaluating the harmonic dihedral potential
+/*! Dihedral evaluators are used by PotentialDihedral, which computes the geometry of a dihedral a-b-c-d. The evaluator
+    is constructed with the cosine and the sine of the dihedral angle phi and the parameters of the dihedral type.
+    evalForceAndEnergy() computes -dU/dphi and the energy of the dihedral, from which PotentialDihedral computes the
+    forces on the four particles.
+
+    \f$ V(\phi) = \frac{1}{2} K \left( 1 + d \cos(n \phi - \phi_0) \right) \f$
+
+    params.x is the K stiffness parameter, params.y is the sign d, params.z is the multiplicity n, and params.w is the
+    phase shift phi_0.
+*/
+class EvaluatorDihedralHarmonic
+    {
+    public:
+        //! Define the parameter type used by this dihedral potential evaluator
+        typedef Scalar4 param_type;
+
+        //! Constructs the dihedral potential evaluator
+        /*! \param _cos_phi Cosine of the dihedral angle
+            \param _sin_phi Sine of the dihedral angle
+            \param _params Per type parameters of this potential
+        */
+        DEVICE EvaluatorDihedralHarmonic(Scalar _cos_phi, Scalar _sin_phi, const param_type& _params)
+            : cos_phi(_cos_phi), sin_phi(_sin_phi), K(_params.x), sign(_params.y), multi(int(_params.z)),
+              phi_0(_params.w)
+            {
+            }
+
+        //! Evaluate the force and energy
+        /*! \param df Output parameter to write -dU/dphi
+            \param dihedral_eng Output parameter to write the computed dihedral energy
+        */
+        DEVICE void evalForceAndEnergy(Scalar& df, Scalar& dihedral_eng)
+            {
+            if (multi == 0)
+                {
+                df = Scalar(0.0);
+                dihedral_eng = Scalar(0.5)*K*(Scalar(1.0) + sign);
+                return;
+                }
+
+            // cos(n phi) and sin(n phi) by recurrence
+            Scalar p = Scalar(1.0);
+            Scalar dfab = Scalar(0.0);
+            Scalar ddfab = Scalar(0.0);
+            for (int j = 0; j < multi; j++)
+                {
+                ddfab = p*cos_phi - dfab*sin_phi;
+                dfab = p*sin_phi + dfab*cos_phi;
+                p = ddfab;
+                }
+
+            // shift by phi_0
+            Scalar sin_phi_0 = fast::sin(phi_0);
+            Scalar cos_phi_0 = fast::cos(phi_0);
+            p = sign*(p*cos_phi_0 + dfab*sin_phi_0);
+            dfab = -Scalar(multi)*sign*(dfab*cos_phi_0 - ddfab*sin_phi_0);
+
+            df = -Scalar(0.5)*K*dfab;
+            dihedral_eng = Scalar(0.5)*K*(Scalar(1.0) + p);
+            }
+
+        #ifndef NVCC
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("harmonic");
+            }
+        #endif
+
+    protected:
+        Scalar cos_phi;    //!< Cosine of the dihedral angle
+        Scalar sin_phi;    //!< Sine of the dihedral angle
+        Scalar K;          //!< K parameter
+        Scalar sign;       //!< Sign of the cosine term
+        int multi;         //!< Multiplicity
+        Scalar phi_0;      //!< Phase shift
+    };
+
+#endif // __DIHEDRAL_EVALUATOR_HARMONIC_H__
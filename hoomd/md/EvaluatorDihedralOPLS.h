@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __DIHEDRAL_EVALUATOR_OPLS_H__
+#define __DIHEDRAL_EVALUATOR_OPLS_H__
+
+#ifndef NVCC
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorDihedralOPLS.h
+    \brief Defines the dihedral evaluator class for OPLS potentials
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Class for evaluating the OPLS dihedral potential
+/*! See EvaluatorDihedralHarmonic for the interface used by PotentialDihedral.
+
+    \f$ V(\phi) = \frac{1}{2} \left[ k_1 (1 + \cos\phi) + k_2 (1 - \cos 2\phi) + k_3 (1 + \cos 3\phi)
+                  + k_4 (1 - \cos 4\phi) \right] \f$
+
+    params.x through params.w are the force constants k_1 through k_4.
+*/
+class EvaluatorDihedralOPLS
+    {
+    public:
+        //! Define the parameter type used by this dihedral potential evaluator
+        typedef Scalar4 param_type;
+
+        //! Constructs the dihedral potential evaluator
+        /*! \param _cos_phi Cosine of the dihedral angle
+            \param _sin_phi Sine of the dihedral angle
+            \param _params Per type parameters of this potential
+        */
+        DEVICE EvaluatorDihedralOPLS(Scalar _cos_phi, Scalar _sin_phi, const param_type& _params)
+            : cos_phi(_cos_phi), sin_phi(_sin_phi), k(_params)
+            {
+            }
+
+        //! Evaluate the force and energy
+        /*! \param df Output parameter to write -dU/dphi
+            \param dihedral_eng Output parameter to write the computed dihedral energy
+        */
+        DEVICE void evalForceAndEnergy(Scalar& df, Scalar& dihedral_eng)
+            {
+            // cos(phi) term
+            Scalar cos_term = cos_phi;
+            Scalar sin_term = sin_phi;
+            Scalar p = k.x*(Scalar(1.0) + cos_term);
+            df = k.x*sin_term;
+
+            // cos(2*phi) term
+            Scalar c = cos_term*cos_phi - sin_term*sin_phi;
+            sin_term = cos_term*sin_phi + sin_term*cos_phi;
+            cos_term = c;
+            p += k.y*(Scalar(1.0) - cos_term);
+            df -= Scalar(2.0)*k.y*sin_term;
+
+            // cos(3*phi) term
+            c = cos_term*cos_phi - sin_term*sin_phi;
+            sin_term = cos_term*sin_phi + sin_term*cos_phi;
+            cos_term = c;
+            p += k.z*(Scalar(1.0) + cos_term);
+            df += Scalar(3.0)*k.z*sin_term;
+
+            // cos(4*phi) term
+            c = cos_term*cos_phi - sin_term*sin_phi;
+            sin_term = cos_term*sin_phi + sin_term*cos_phi;
+            cos_term = c;
+            p += k.w*(Scalar(1.0) - cos_term);
+            df -= Scalar(4.0)*k.w*sin_term;
+
+            df *= Scalar(0.5);
+            dihedral_eng = Scalar(0.5)*p;
+            }
+
+        #ifndef NVCC
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("opls");
+            }
+        #endif
+
+    protected:
+        Scalar cos_phi;    //!< Cosine of the dihedral angle
+        Scalar sin_phi;    //!< Sine of the dihedral angle
+        Scalar4 k;         //!< Force constants k_1 through k_4
+    };
+
+#endif // __DIHEDRAL_EVALUATOR_OPLS_H__
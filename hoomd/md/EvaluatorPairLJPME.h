@@ -0,0 +1,171 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifndef __PAIR_EVALUATOR_LJPME_H__
+#define __PAIR_EVALUATOR_LJPME_H__
+
+#ifndef NVCC
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairLJPME.h
+    \brief Defines the pair evaluator class for the short-ranged part of Lennard-Jones potentials with mesh dispersion
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Evaluate 1 - exp(-y) (1 + y + y^2/2), the fraction of the r^-6 dispersion that is computed on the mesh
+/*! \param y Squared product of the splitting parameter and the distance
+
+    For small arguments, the difference is evaluated from the tail of the power series of exp(y) to avoid
+    cancellation.
+*/
+DEVICE inline Scalar lj_pme_long_range_fraction(Scalar y)
+    {
+    if (y < Scalar(1.0))
+        {
+        Scalar term = y*y*y/Scalar(6.0);
+        Scalar sum = term;
+        for (unsigned int n = 4; n < 16; ++n)
+            {
+            term *= y/Scalar(n);
+            sum += term;
+            }
+        return fast::exp(-y)*sum;
+        }
+
+    return Scalar(1.0) - fast::exp(-y)*(Scalar(1.0) + y + Scalar(0.5)*y*y);
+    }
+
+//! Class for evaluating the short-ranged part of the Lennard-Jones pair potential with mesh dispersion
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ.
+
+    <b>LJ-PME specifics</b>
+
+    The r^-6 dispersion between all particles is split into a short-ranged part and a long-ranged part
+    \f$ -C_{ij} \left[1 - g(\beta r)\right] / r^6 \f$, with \f$ g(x) = e^{-x^2} (1 + x^2 + x^4/2) \f$. The long-ranged
+    part uses the geometric combination \f$ C_{ij} = c_i c_j \f$ of per-type coefficients and is computed on a mesh by
+    PPPMDispersionForceCompute. EvaluatorPairLJPME evaluates the remainder:
+    \f[ V(r) = \frac{\mathrm{lj1}}{r^{12}} - \frac{\mathrm{lj2}}{r^6} + C_{ij} \frac{1 - g(\beta r)}{r^6} \f]
+
+    If the Lennard-Jones parameters follow the geometric combining rule, lj2 equals \f$ C_{ij} \f$ and the potential
+    reduces to the repulsion plus the screened dispersion \f$ -C_{ij} g(\beta r)/r^6 \f$, which decays like a
+    Gaussian. Otherwise, the difference between the actual and the geometric dispersion is computed within the cutoff.
+
+    The parameters are stored in a Scalar4:
+    - \a params.x = \a lj1 = 4 epsilon sigma^12
+    - \a params.y = \a lj2 = 4 epsilon sigma^6
+    - \a params.z = \a C_ij, the coefficient of the mesh dispersion
+    - \a params.w = \a beta, the splitting parameter
+*/
+class EvaluatorPairLJPME
+    {
+    public:
+        //! Define the parameter type used by this pair potential evaluator
+        typedef Scalar4 param_type;
+
+        //! Constructs the pair potential evaluator
+        /*! \param _rsq Squared distance between the particles
+            \param _rcutsq Squared distance at which the potential goes to 0
+            \param _params Per type pair parameters of this potential
+        */
+        DEVICE EvaluatorPairLJPME(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+            : rsq(_rsq), rcutsq(_rcutsq), lj1(_params.x), lj2(_params.y), c6_mesh(_params.z), beta(_params.w)
+            {
+            }
+
+        //! LJPME doesn't use diameter
+        DEVICE static bool needsDiameter() { return false; }
+        //! Accept the optional diameter values
+        /*! \param di Diameter of particle i
+            \param dj Diameter of particle j
+        */
+        DEVICE void setDiameter(Scalar di, Scalar dj) { }
+
+        //! LJPME doesn't use charge
+        DEVICE static bool needsCharge() { return false; }
+        //! Accept the optional charge values
+        /*! \param qi Charge of particle i
+            \param qj Charge of particle j
+        */
+        DEVICE void setCharge(Scalar qi, Scalar qj) { }
+
+        //! Evaluate the force and energy
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the cutoff
+            \note There is no need to check if rsq < rcutsq in this method. Cutoff tests are performed
+                  in PotentialPair.
+
+            \return True if they are evaluated or false if they are not because we are beyond the cutoff
+        */
+        DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+            {
+            if (rsq < rcutsq && (lj1 != Scalar(0.0) || lj2 != Scalar(0.0) || c6_mesh != Scalar(0.0)))
+                {
+                Scalar r2inv = Scalar(1.0)/rsq;
+                Scalar r6inv = r2inv * r2inv * r2inv;
+
+                Scalar y = beta*beta*rsq;
+                Scalar expfac = fast::exp(-y);
+                Scalar long_range = lj_pme_long_range_fraction(y);
+
+                Scalar beta2 = beta*beta;
+                Scalar beta6 = beta2*beta2*beta2;
+
+                force_divr = r2inv * r6inv * (Scalar(12.0)*lj1*r6inv - Scalar(6.0)*lj2 + Scalar(6.0)*c6_mesh*long_range)
+                    - c6_mesh*beta6*expfac*r2inv;
+
+                pair_eng = r6inv * (lj1*r6inv - lj2 + c6_mesh*long_range);
+
+                if (energy_shift)
+                    {
+                    Scalar rcut2inv = Scalar(1.0)/rcutsq;
+                    Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                    Scalar long_range_cut = lj_pme_long_range_fraction(beta2*rcutsq);
+                    pair_eng -= rcut6inv * (lj1*rcut6inv - lj2 + c6_mesh*long_range_cut);
+                    }
+                return true;
+                }
+            else
+                return false;
+            }
+
+        #ifndef NVCC
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("lj_pme");
+            }
+
+        std::string getShapeSpec() const
+            {
+            throw std::runtime_error("Shape definition not supported for this pair potential.");
+            }
+        #endif
+
+    protected:
+        Scalar rsq;     //!< Stored rsq from the constructor
+        Scalar rcutsq;  //!< Stored rcutsq from the constructor
+        Scalar lj1;     //!< lj1 parameter extracted from the params passed to the constructor
+        Scalar lj2;     //!< lj2 parameter extracted from the params passed to the constructor
+        Scalar c6_mesh; //!< Coefficient of the dispersion that is computed on the mesh
+        Scalar beta;    //!< Splitting parameter
+    };
+
+
+#endif // __PAIR_EVALUATOR_LJPME_H__
@@ -17,9 +17,11 @@ namespace py = pybind11;
 using namespace std;
 
 /*! \param sysdef System to compute angle forces on
+    \param log_suffix Name given to this instance of the force
 */
-HarmonicAngleForceComputeGPU::HarmonicAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef)
-        : HarmonicAngleForceCompute(sysdef)
+HarmonicAngleForceComputeGPU::HarmonicAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                           const std::string& log_suffix)
+        : PotentialAngleHarmonic(sysdef, log_suffix)
     {
     // can't run on the GPU if there aren't any GPUs in the execution configuration
     if (!m_exec_conf->isCUDAEnabled())
@@ -28,10 +30,6 @@ HarmonicAngleForceComputeGPU::HarmonicAngleForceComputeGPU(std::shared_ptr<Syste
         throw std::runtime_error("Error initializing AngleForceComputeGPU");
         }
 
-    // allocate and zero device memory
-    GPUArray<Scalar2> params(m_angle_data->getNTypes(), m_exec_conf);
-    m_params.swap(params);
-
     m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "harmonic_angle", this->m_exec_conf));
     }
 
@@ -39,22 +37,6 @@ HarmonicAngleForceComputeGPU::~HarmonicAngleForceComputeGPU()
     {
     }
 
-/*! \param type Type of the angle to set parameters for
-    \param K Stiffness parameter for the force computation
-    \param t_0 Equilibrium angle (in radians) for the force computation
-
-    Sets parameters for the potential of a particular angle type and updates the
-    parameters on the GPU.
-*/
-void HarmonicAngleForceComputeGPU::setParams(unsigned int type, Scalar K, Scalar t_0)
-    {
-    HarmonicAngleForceCompute::setParams(type, K, t_0);
-
-    ArrayHandle<Scalar2> h_params(m_params, access_location::host, access_mode::readwrite);
-    // update the local copy of the memory
-    h_params.data[type] = make_scalar2(K, t_0);
-    }
-
 /*! Internal method for computing the forces on the GPU.
     \post The force data on the GPU is written with the calculated forces
 
@@ -105,7 +87,7 @@ void HarmonicAngleForceComputeGPU::computeForces(unsigned int timestep)
 
 void export_HarmonicAngleForceComputeGPU(py::module& m)
     {
-    py::class_<HarmonicAngleForceComputeGPU, std::shared_ptr<HarmonicAngleForceComputeGPU> >(m, "HarmonicAngleForceComputeGPU", py::base<HarmonicAngleForceCompute>())
-    .def(py::init< std::shared_ptr<SystemDefinition> >())
+    py::class_<HarmonicAngleForceComputeGPU, std::shared_ptr<HarmonicAngleForceComputeGPU> >(m, "HarmonicAngleForceComputeGPU", py::base<PotentialAngleHarmonic>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string& >())
     ;
     }
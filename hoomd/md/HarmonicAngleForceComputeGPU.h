@@ -3,7 +3,7 @@
 
 
 // Maintainer: dnlebard
-#include "HarmonicAngleForceCompute.h"
+#include "AllAnglePotentials.h"
 #include "HarmonicAngleForceGPU.cuh"
 #include "hoomd/Autotuner.h"
 
@@ -22,22 +22,21 @@
 #define __HARMONICANGLEFORCECOMPUTEGPU_H__
 
 //! Implements the harmonic angle force calculation on the GPU
-/*! HarmonicAngleForceComputeGPU implements the same calculations as HarmonicAngleForceCompute,
+/*! HarmonicAngleForceComputeGPU implements the same calculations as PotentialAngleHarmonic,
     but executing on the GPU.
 
-    Per-type parameters are stored in a simple global memory area pointed to by
-    \a m_gpu_params. They are stored as Scalar2's with the \a x component being K and the
-    \a y component being t_0.
+    The per-type parameters of PotentialAngleHarmonic are passed to the kernel directly. They are stored as
+    Scalar2's with the \a x component being K and the \a y component being t_0.
 
     The GPU kernel can be found in angleforce_kernel.cu.
 
     \ingroup computes
 */
-class PYBIND11_EXPORT HarmonicAngleForceComputeGPU : public HarmonicAngleForceCompute
+class PYBIND11_EXPORT HarmonicAngleForceComputeGPU : public PotentialAngleHarmonic
     {
     public:
         //! Constructs the compute
-        HarmonicAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef);
+        HarmonicAngleForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef, const std::string& log_suffix="");
         //! Destructor
         ~HarmonicAngleForceComputeGPU();
 
@@ -47,17 +46,13 @@ class PYBIND11_EXPORT HarmonicAngleForceComputeGPU : public HarmonicAngleForceCo
         */
         virtual void setAutotunerParams(bool enable, unsigned int period)
             {
-            HarmonicAngleForceCompute::setAutotunerParams(enable, period);
+            PotentialAngleHarmonic::setAutotunerParams(enable, period);
             m_tuner->setPeriod(period);
             m_tuner->setEnabled(enable);
             }
 
-        //! Set the parameters
-        virtual void setParams(unsigned int type, Scalar K, Scalar t_0);
-
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<Scalar2>  m_params;          //!< Parameters stored on the GPU
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -16,9 +16,11 @@ namespace py = pybind11;
 using namespace std;
 
 /*! \param sysdef System to compute bond forces on
+    \param log_suffix Name given to this instance of the force
 */
-HarmonicDihedralForceComputeGPU::HarmonicDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef)
-    : HarmonicDihedralForceCompute(sysdef)
+HarmonicDihedralForceComputeGPU::HarmonicDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                                 const std::string& log_suffix)
+    : PotentialDihedralHarmonic(sysdef, log_suffix)
     {
     // can't run on the GPU if there aren't any GPUs in the execution configuration
     if (!m_exec_conf->isCUDAEnabled())
@@ -27,10 +29,6 @@ HarmonicDihedralForceComputeGPU::HarmonicDihedralForceComputeGPU(std::shared_ptr
         throw std::runtime_error("Error initializing DihedralForceComputeGPU");
         }
 
-    // allocate and zero device memory
-    GPUArray<Scalar4> params(m_dihedral_data->getNTypes(),m_exec_conf);
-    m_params.swap(params);
-
     m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "harmonic_dihedral", this->m_exec_conf));
     }
 
@@ -38,24 +36,6 @@ HarmonicDihedralForceComputeGPU::~HarmonicDihedralForceComputeGPU()
     {
     }
 
-/*! \param type Type of the dihedral to set parameters for
-    \param K Stiffness parameter for the force computation
-    \param sign the sign of the cosine term
-        \param multiplicity the multiplicity of the cosine term
-    \param phi_0 the phase offset
-
-    Sets parameters for the potential of a particular dihedral type and updates the
-    parameters on the GPU.
-*/
-void HarmonicDihedralForceComputeGPU::setParams(unsigned int type, Scalar K, int sign, unsigned int multiplicity, Scalar phi_0)
-    {
-    HarmonicDihedralForceCompute::setParams(type, K, sign, multiplicity, phi_0);
-
-    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::readwrite);
-    // update the local copy of the memory
-    h_params.data[type] = make_scalar4(Scalar(K), Scalar(sign), Scalar(multiplicity), Scalar(phi_0));
-    }
-
 /*! Internal method for computing the forces on the GPU.
     \post The force data on the GPU is written with the calculated forces
 
@@ -104,7 +84,7 @@ void HarmonicDihedralForceComputeGPU::computeForces(unsigned int timestep)
 
 void export_HarmonicDihedralForceComputeGPU(py::module& m)
     {
-    py::class_<HarmonicDihedralForceComputeGPU, std::shared_ptr<HarmonicDihedralForceComputeGPU> >(m, "HarmonicDihedralForceComputeGPU", py::base<HarmonicDihedralForceCompute>())
-    .def(py::init< std::shared_ptr<SystemDefinition> >())
+    py::class_<HarmonicDihedralForceComputeGPU, std::shared_ptr<HarmonicDihedralForceComputeGPU> >(m, "HarmonicDihedralForceComputeGPU", py::base<PotentialDihedralHarmonic>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string& >())
     ;
     }
@@ -3,7 +3,7 @@
 
 
 // Maintainer: dnlebard
-#include "HarmonicDihedralForceCompute.h"
+#include "AllDihedralPotentials.h"
 #include "HarmonicDihedralForceGPU.cuh"
 #include "hoomd/Autotuner.h"
 
@@ -18,22 +18,21 @@
 #define __HARMONICDIHEDRALFORCECOMPUTEGPU_H__
 
 //! Implements the harmonic dihedral force calculation on the GPU
-/*! HarmonicDihedralForceComputeGPU implements the same calculations as HarmonicDihedralForceCompute,
+/*! HarmonicDihedralForceComputeGPU implements the same calculations as PotentialDihedralHarmonic,
     but executing on the GPU.
 
-    Per-type parameters are stored in a simple global memory area pointed to by
-    \a m_gpu_params. They are stored as Scalar2's with the \a x component being K and the
-    \a y component being t_0.
+    The per-type parameters of PotentialDihedralHarmonic are passed to the kernel directly. They are stored as
+    Scalar4's with the components K, sign, multiplicity and phi_0.
 
     The GPU kernel can be found in dihedralforce_kernel.cu.
 
     \ingroup computes
 */
-class PYBIND11_EXPORT HarmonicDihedralForceComputeGPU : public HarmonicDihedralForceCompute
+class PYBIND11_EXPORT HarmonicDihedralForceComputeGPU : public PotentialDihedralHarmonic
     {
     public:
         //! Constructs the compute
-        HarmonicDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> system);
+        HarmonicDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> system, const std::string& log_suffix="");
         //! Destructor
         ~HarmonicDihedralForceComputeGPU();
 
@@ -43,17 +42,13 @@ class PYBIND11_EXPORT HarmonicDihedralForceComputeGPU : public HarmonicDihedralF
         */
         virtual void setAutotunerParams(bool enable, unsigned int period)
             {
-            HarmonicDihedralForceCompute::setAutotunerParams(enable, period);
+            PotentialDihedralHarmonic::setAutotunerParams(enable, period);
             m_tuner->setPeriod(period);
             m_tuner->setEnabled(enable);
             }
 
-        //! Set the parameters
-        virtual void setParams(unsigned int type, Scalar K, int sign, unsigned int multiplicity, Scalar phi_0);
-
     protected:
         std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
-        GPUArray<Scalar4> m_params;           //!< Parameters stored on the GPU (k,sign,m)
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -35,6 +35,10 @@
     To ensure that the user does not make a mistake and specify more than one method operating on a single particle,
     the particle groups are checked for intersections whenever a new method is added in addIntegrationMethod()
 
+    Forces can be assigned an evaluation period with setForcePeriod() for multiple time step (r-RESPA) integration,
+    see Integrator. The integration methods need no changes for this, since the slow forces enter the net force as
+    impulses at the boundaries of the outer time step.
+
     There is a special registration mechanism for ForceComposites which run after the integration steps
     one and two, and which can use the updated particle positions and velocities to update any slaved degrees
     of freedom (rigid bodies).
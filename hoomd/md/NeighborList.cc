@@ -15,6 +15,13 @@ namespace py = pybind11;
 
 #include <iostream>
 #include <stdexcept>
+#include <climits>
+#include <atomic>
+#include <limits>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 using namespace std;
 
@@ -22,6 +29,9 @@ using namespace std;
     \brief Defines the NeighborList class
 */
 
+//! Number of particles that NeighborList::distanceCheck() tests together
+const unsigned int DIST_CHECK_BLOCK_SIZE = 256;
+
 /*! \param sysdef System the neighborlist is to compute neighbors for
     \param _r_cut Cutoff radius for all pairs under which particles are considered neighbors
     \param r_buff Buffer radius around \a r_cut in which neighbors will be included
@@ -50,7 +60,22 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_last_checked_tstep = 0;
     m_last_check_result = false;
     m_every = 0;
+    m_autotune = false;
+    m_tune_period = 0;
+    m_tune_r_min = m_tune_r_max = Scalar(0.0);
+    m_tune_r_accepted = m_tune_r_current = m_r_buff;
+    m_tune_delta = Scalar(0.0);
+    m_tune_dir = 0;
+    m_tune_trial = false;
+    m_tune_best_time = 0.0;
+    m_r_buff_pending = Scalar(-1.0);
+    m_tune_last_time = 0;
+    m_tune_last_step = 0;
+    m_tune_skip = 0;
+    resetAutotuneWindow();
+    m_views_built = false;
     m_exclusions_set = false;
+    m_filter_in_build = true;
 
     m_need_reallocate_exlist = false;
 
@@ -182,6 +207,14 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_ex_list_idx.swap(ex_list_idx);
     TAG_ALLOCATION(m_ex_list_idx);
 
+    GlobalArray<unsigned int> ex_head_idx(m_pdata->getMaxN()+1, m_exec_conf);
+    m_ex_head_idx.swap(ex_head_idx);
+    TAG_ALLOCATION(m_ex_head_idx);
+
+    GlobalVector<unsigned int> ex_list_csr(m_exec_conf);
+    m_ex_list_csr.swap(ex_list_csr);
+    TAG_ALLOCATION(m_ex_list_csr);
+
     // reset exclusions
     clearExclusions();
 
@@ -225,9 +258,15 @@ void NeighborList::reallocate()
         memset(h_n_ex_idx.data+old_n_ex, 0, sizeof(unsigned int)*(m_n_ex_idx.getNumElements()-old_n_ex));
         }
 
-    unsigned int ex_list_height = m_ex_list_indexer.getH();
-    m_ex_list_idx.resize(m_pdata->getMaxN(), ex_list_height );
-    m_ex_list_indexer = Index2D(m_ex_list_idx.getPitch(), ex_list_height);
+    m_ex_head_idx.resize(m_pdata->getMaxN()+1);
+
+    // the padded exclusion list by index is only used on the GPU
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        unsigned int ex_list_height = m_ex_list_indexer_tag.getH();
+        m_ex_list_idx.resize(m_pdata->getMaxN(), ex_list_height );
+        m_ex_list_indexer = Index2D(m_ex_list_idx.getPitch(), ex_list_height);
+        }
 
     // resize the head list and number of neighbors per particle
     m_head_list.resize(m_pdata->getMaxN());
@@ -323,6 +362,10 @@ void NeighborList::compute(unsigned int timestep)
         updateRList();
         }
 
+    // measure the previous step for the online tuning, once per step
+    if (m_autotune && timestep != m_tune_last_step)
+        updateAutotune(timestep);
+
     // skip if we shouldn't compute this step
     if (!shouldCompute(timestep) && !m_force_update)
         return;
@@ -345,6 +388,8 @@ void NeighborList::compute(unsigned int timestep)
         // check simulation box size is OK
         checkBoxSize();
 
+        uint64_t build_start = m_autotune ? m_tune_clock.getTime() : 0;
+
         // rebuild the list until there is no overflow
         bool overflowed = false;
         do
@@ -363,9 +408,14 @@ void NeighborList::compute(unsigned int timestep)
                 }
             } while (overflowed);
 
-        if (m_exclusions_set)
+        if (m_exclusions_set && !m_filter_in_build)
             filterNlist();
 
+        buildViews();
+
+        if (m_autotune)
+            m_tune_build_time += m_tune_clock.getTime() - build_start;
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
         }
@@ -455,6 +505,211 @@ void NeighborList::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cu
     forceUpdate();
     }
 
+/*! \returns The index of the new view, to be passed to setViewRCutPair() and getViewNNeigh()
+    \post All cutoffs of the view are zero
+*/
+unsigned int NeighborList::addView()
+    {
+    // reuse the slot of a removed view
+    unsigned int view = 0;
+    while (view < m_view_r_cut.size() && !m_view_r_cut[view].empty())
+        view++;
+
+    if (view == m_view_r_cut.size())
+        {
+        m_view_r_cut.resize(view+1);
+        m_view_n_neigh.resize(view+1);
+        }
+
+    m_view_r_cut[view].assign(m_typpair_idx.getNumElements(), Scalar(0.0));
+    forceUpdate();
+    return view;
+    }
+
+/*! \param view View returned by addView()
+*/
+void NeighborList::removeView(unsigned int view)
+    {
+    assert(view < m_view_r_cut.size());
+    m_view_r_cut[view].clear();
+    m_view_n_neigh[view].clear();
+    forceUpdate();
+    }
+
+/*! \param view View returned by addView()
+    \param typ1 First type of the pair
+    \param typ2 Second type of the pair
+    \param r_cut Cutoff of the consumer of the view
+*/
+void NeighborList::setViewRCutPair(unsigned int view, unsigned int typ1, unsigned int typ2, Scalar r_cut)
+    {
+    if (typ1 >= m_pdata->getNTypes() || typ2 >= m_pdata->getNTypes())
+        {
+        this->m_exec_conf->msg->error() << "nlist: Trying to set rcut for a non existent type! "
+                  << typ1 << "," << typ2 << std::endl;
+        throw std::runtime_error("Error changing NeighborList parameters");
+        }
+
+    assert(view < m_view_r_cut.size() && !m_view_r_cut[view].empty());
+    std::vector<Scalar>& view_r_cut = m_view_r_cut[view];
+
+    // the number of types may have changed
+    if (view_r_cut.size() != m_typpair_idx.getNumElements())
+        view_r_cut.assign(m_typpair_idx.getNumElements(), Scalar(0.0));
+
+    view_r_cut[m_typpair_idx(typ1, typ2)] = r_cut;
+    view_r_cut[m_typpair_idx(typ2, typ1)] = r_cut;
+    forceUpdate();
+    }
+
+/*! The neighbors of every particle of type i are partitioned into shells, where shell s holds the neighbors beyond
+    the list radius of the first s views for type i, in the order of their radii. The list radius of a view for type i
+    is max_j r_cut(i,j) + r_buff over the nonzero cutoffs of the view. The order within a shell is kept.
+*/
+void NeighborList::buildViews()
+    {
+    m_views_built = false;
+
+    unsigned int n_views = 0;
+    for (unsigned int v = 0; v < m_view_r_cut.size(); v++)
+        {
+        if (!m_view_r_cut[v].empty())
+            n_views++;
+        }
+
+    // the whole list is as good as a single view
+    if (n_views < 2 || m_diameter_shift || m_exec_conf->isCUDAEnabled())
+        return;
+
+    if (m_prof) m_prof->push("views");
+
+    const unsigned int ntypes = m_pdata->getNTypes();
+    const unsigned int N = m_pdata->getN();
+
+    // the views of every type, ordered by their squared list radius
+    std::vector< std::vector< std::pair<Scalar, unsigned int> > > shells(ntypes);
+    for (unsigned int v = 0; v < m_view_r_cut.size(); v++)
+        {
+        const std::vector<Scalar>& view_r_cut = m_view_r_cut[v];
+        if (view_r_cut.empty())
+            continue;
+
+        m_view_n_neigh[v].resize(N);
+
+        for (unsigned int ti = 0; ti < ntypes; ti++)
+            {
+            Scalar rlistsq = Scalar(0.0);
+            if (view_r_cut.size() == m_typpair_idx.getNumElements())
+                {
+                for (unsigned int tj = 0; tj < ntypes; tj++)
+                    {
+                    Scalar r_cut = view_r_cut[m_typpair_idx(ti, tj)];
+                    if (r_cut > Scalar(0.0))
+                        rlistsq = std::max(rlistsq, (r_cut + m_r_buff)*(r_cut + m_r_buff));
+                    }
+                }
+            else
+                {
+                // the cutoffs have not been set since the number of types changed
+                rlistsq = std::numeric_limits<Scalar>::max();
+                }
+
+            shells[ti].push_back(std::make_pair(rlistsq, v));
+            }
+        }
+
+    // a single shell per type leaves the list as it is, and every view is the whole list
+    bool single_shell = true;
+    for (unsigned int ti = 0; ti < ntypes; ti++)
+        {
+        std::sort(shells[ti].begin(), shells[ti].end());
+        if (shells[ti].front().first != shells[ti].back().first)
+            single_shell = false;
+        }
+
+    if (single_shell)
+        {
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+
+    // scratch space for reordering the neighbors of one particle
+    struct ViewScratch
+        {
+        std::vector<unsigned int> shell_of;
+        std::vector<unsigned int> shell_offset;
+        std::vector<unsigned int> sorted;
+        };
+
+    auto reorder_particle = [&](unsigned int i, ViewScratch& scratch)
+        {
+        const Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const std::vector< std::pair<Scalar, unsigned int> >& shells_i = shells[__scalar_as_int(h_pos.data[i].w)];
+        const unsigned int n_shells = shells_i.size() + 1;
+
+        unsigned int *nlist_i = h_nlist.data + h_head_list.data[i];
+        const unsigned int n_neigh = h_n_neigh.data[i];
+
+        scratch.shell_of.resize(n_neigh);
+        scratch.shell_offset.assign(n_shells + 1, 0);
+
+        // find the shell of every neighbor
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            const unsigned int j = nlist_i[k];
+            Scalar3 dx = pi - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            dx = box.minImage(dx);
+            const Scalar rsq = dot(dx, dx);
+
+            unsigned int shell = 0;
+            while (shell < shells_i.size() && rsq >= shells_i[shell].first)
+                shell++;
+
+            scratch.shell_of[k] = shell;
+            scratch.shell_offset[shell+1]++;
+            }
+
+        for (unsigned int shell = 0; shell < n_shells; shell++)
+            scratch.shell_offset[shell+1] += scratch.shell_offset[shell];
+
+        // view s contains the shells up to s
+        for (unsigned int s = 0; s < shells_i.size(); s++)
+            m_view_n_neigh[shells_i[s].second][i] = scratch.shell_offset[s+1];
+
+        // reorder the neighbors by shell
+        scratch.sorted.resize(n_neigh);
+        for (unsigned int k = 0; k < n_neigh; k++)
+            scratch.sorted[scratch.shell_offset[scratch.shell_of[k]]++] = nlist_i[k];
+
+        std::copy(scratch.sorted.begin(), scratch.sorted.end(), nlist_i);
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<ViewScratch> thread_scratch;
+    tbb::parallel_for((unsigned int)0, N, [&](unsigned int i)
+        {
+        reorder_particle(i, thread_scratch.local());
+        });
+    #else
+    ViewScratch scratch;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        reorder_particle(i, scratch);
+        }
+    #endif
+
+    m_views_built = true;
+
+    if (m_prof) m_prof->pop();
+    }
+
 /*! \param r_buff New buffer radius to set
     \note Changing the buffer radius does NOT immediately update the neighborlist.
             The new buffer will take effect when compute is called for the next timestep.
@@ -603,10 +858,10 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
         ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::readwrite);
 
         // grow the list if necessary
-        if (h_n_ex_tag.data[tag1] == m_ex_list_indexer.getH())
+        if (h_n_ex_tag.data[tag1] == m_ex_list_indexer_tag.getH())
             grow = true;
 
-        if (h_n_ex_tag.data[tag2] == m_ex_list_indexer.getH())
+        if (h_n_ex_tag.data[tag2] == m_ex_list_indexer_tag.getH())
             grow = true;
         }
 
@@ -622,13 +877,13 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
 
         // add tag2 to tag1's exclusion list
         unsigned int pos1 = h_n_ex_tag.data[tag1];
-        assert(pos1 < m_ex_list_indexer.getH());
+        assert(pos1 < m_ex_list_indexer_tag.getH());
         h_ex_list_tag.data[m_ex_list_indexer_tag(tag1,pos1)] = tag2;
         h_n_ex_tag.data[tag1]++;
 
         // add tag1 to tag2's exclusion list
         unsigned int pos2 = h_n_ex_tag.data[tag2];
-        assert(pos2 < m_ex_list_indexer.getH());
+        assert(pos2 < m_ex_list_indexer_tag.getH());
         h_ex_list_tag.data[m_ex_list_indexer_tag(tag2,pos2)] = tag1;
         h_n_ex_tag.data[tag2]++;
         }
@@ -659,9 +914,11 @@ void NeighborList::clearExclusions()
 
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::overwrite);
 
     memset(h_n_ex_tag.data, 0, sizeof(unsigned int)*m_n_ex_tag.getNumElements());
     memset(h_n_ex_idx.data, 0, sizeof(unsigned int)*m_n_ex_idx.getNumElements());
+    memset(h_ex_head_idx.data, 0, sizeof(unsigned int)*m_ex_head_idx.getNumElements());
     m_exclusions_set = false;
 
     forceUpdate();
@@ -1111,6 +1368,10 @@ void NeighborList::addOneFourExclusionsFromTopology()
 
     Note: this method relies on data set by setLastUpdatedPos(), which must be called to set the previous data used
     in the next call to distanceCheck();
+
+    The particles are checked in blocks of DIST_CHECK_BLOCK_SIZE. Within a block, all particles are tested without
+    branching on the result, so that the loop can be vectorized. With TBB, the blocks are checked in parallel. No
+    further blocks are started once a particle has moved too far.
 */
 bool NeighborList::distanceCheck(unsigned int timestep)
     {
@@ -1139,32 +1400,67 @@ bool NeighborList::distanceCheck(unsigned int timestep)
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // the squared max displacement of each type
+    m_dist_check_maxsq.resize(m_pdata->getNTypes());
+    for (unsigned int type = 0; type < m_pdata->getNTypes(); type++)
         {
-        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
-
         // minimum distance within which all particles should be included
-        Scalar old_rmin = h_rcut_max.data[type_i];
+        Scalar old_rmin = h_rcut_max.data[type];
 
         // maximum value we have checked for neighbors, defined by the buffer layer
         Scalar rmax = old_rmin + m_r_buff;
 
         // max displacement for each particle (after subtraction of homogeneous dilations)
         const Scalar delta_max = (rmax*lambda_min - old_rmin)/Scalar(2.0);
-        Scalar maxsq = (delta_max > 0) ? delta_max*delta_max : 0;
+        m_dist_check_maxsq[type] = (delta_max > 0) ? delta_max*delta_max : 0;
+        }
 
-        Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x*h_last_pos.data[i].x,
-                                  h_pos.data[i].y - lambda.y*h_last_pos.data[i].y,
-                                  h_pos.data[i].z - lambda.z*h_last_pos.data[i].z);
+    const Scalar *maxsq = &m_dist_check_maxsq.front();
+    const Scalar4 *pos = h_pos.data;
+    const Scalar4 *last_pos = h_last_pos.data;
 
-        dx = box.minImage(dx);
+    // returns true if any particle in the block has moved too far
+    auto check_block = [=](unsigned int block, unsigned int N) -> bool
+        {
+        const unsigned int begin = block*DIST_CHECK_BLOCK_SIZE;
+        const unsigned int end = std::min(begin + DIST_CHECK_BLOCK_SIZE, N);
 
-        if (dot(dx, dx) >= maxsq)
+        unsigned int moved = 0;
+        for (unsigned int i = begin; i < end; i++)
             {
-            result = true;
-            break;
+            Scalar3 dx = make_scalar3(pos[i].x - lambda.x*last_pos[i].x,
+                                      pos[i].y - lambda.y*last_pos[i].y,
+                                      pos[i].z - lambda.z*last_pos[i].z);
+
+            dx = box.minImage(dx);
+
+            moved |= (dot(dx, dx) >= maxsq[__scalar_as_int(pos[i].w)]);
             }
+
+        return moved != 0;
+        };
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_blocks = (N + DIST_CHECK_BLOCK_SIZE - 1) / DIST_CHECK_BLOCK_SIZE;
+
+    #ifdef ENABLE_TBB
+    std::atomic<bool> moved(false);
+    tbb::parallel_for((unsigned int)0, n_blocks, [&](unsigned int block)
+        {
+        // stop early once any particle has moved too far
+        if (moved.load(std::memory_order_relaxed))
+            return;
+
+        if (check_block(block, N))
+            moved.store(true, std::memory_order_relaxed);
+        });
+    result = moved.load();
+    #else
+    for (unsigned int block = 0; block < n_blocks && !result; block++)
+        {
+        result = check_block(block, N);
         }
+    #endif
 
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -1243,6 +1539,14 @@ bool NeighborList::needsUpdating(unsigned int timestep)
 
     m_last_checked_tstep = timestep;
 
+    // apply a buffer radius chosen by the online tuning, in MPI runs this happens before the migration decision
+    if (m_r_buff_pending >= Scalar(0.0))
+        {
+        Scalar r_buff = m_r_buff_pending;
+        m_r_buff_pending = Scalar(-1.0);
+        setRBuff(r_buff);
+        }
+
     if (!m_force_update && !shouldCheckDistance(timestep))
         {
         m_last_check_result = false;
@@ -1292,6 +1596,13 @@ bool NeighborList::needsUpdating(unsigned int timestep)
             if (timestep > m_last_updated_tstep)
                 {
                 unsigned int period = timestep - m_last_updated_tstep;
+
+                if (m_autotune)
+                    {
+                    m_tune_builds++;
+                    m_tune_min_interval = std::min(m_tune_min_interval, period);
+                    }
+
                 if (period >= m_update_periods.size())
                     period = m_update_periods.size()-1;
                 m_update_periods[period]++;
@@ -1313,6 +1624,154 @@ bool NeighborList::needsUpdating(unsigned int timestep)
     return result;
     }
 
+/*! \param enable True to enable the tuning
+    \param period Minimum number of steps over which the time per step is averaged
+    \param r_buff_min Smallest buffer radius to choose
+    \param r_buff_max Largest buffer radius to choose
+
+    The check period is only tuned when distance checks are enabled.
+*/
+void NeighborList::setAutotune(bool enable, unsigned int period, Scalar r_buff_min, Scalar r_buff_max)
+    {
+    if (enable && (period == 0 || r_buff_min < Scalar(0.0) || r_buff_max <= r_buff_min))
+        {
+        m_exec_conf->msg->error() << "nlist: Invalid parameters for the buffer radius tuning" << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+
+    m_autotune = enable;
+    m_r_buff_pending = Scalar(-1.0);
+    if (!enable)
+        return;
+
+    m_tune_period = period;
+    m_tune_r_min = r_buff_min;
+    m_tune_r_max = r_buff_max;
+    m_tune_delta = (r_buff_max - r_buff_min) / Scalar(8.0);
+    m_tune_dir = 0;
+    m_tune_trial = false;
+
+    // start from the current buffer radius, within the allowed range
+    m_tune_r_current = m_tune_r_accepted = std::min(std::max(m_r_buff, r_buff_min), r_buff_max);
+    if (m_tune_r_current != m_r_buff)
+        m_r_buff_pending = m_tune_r_current;
+
+    m_tune_skip = 1;
+    resetAutotuneWindow();
+    }
+
+void NeighborList::resetAutotuneWindow()
+    {
+    m_tune_steps = 0;
+    m_tune_builds = 0;
+    m_tune_min_interval = UINT_MAX;
+    m_tune_dangerous = m_dangerous_updates;
+    m_tune_step_time = 0;
+    m_tune_build_time = 0;
+    }
+
+/*! \param timestep Current time step
+
+    Called by the first compute() of every step. The time since the previous call is the wall time of the previous
+    step.
+*/
+void NeighborList::updateAutotune(unsigned int timestep)
+    {
+    uint64_t now = m_tune_clock.getTime();
+    uint64_t dt = now - m_tune_last_time;
+    bool consecutive = timestep == m_tune_last_step + 1;
+    m_tune_last_time = now;
+    m_tune_last_step = timestep;
+
+    // steps between runs and the forced rebuild after a change are not measured
+    if (!consecutive || m_tune_skip > 0)
+        {
+        if (m_tune_skip > 0)
+            m_tune_skip--;
+        resetAutotuneWindow();
+        return;
+        }
+
+    m_tune_step_time += dt;
+    m_tune_steps++;
+
+    // average over enough steps and enough builds to include the build cost
+    if (m_tune_steps < m_tune_period || (m_tune_builds < 2 && m_tune_steps < 10*m_tune_period))
+        return;
+
+    // all ranks take the same decision based on the slowest rank
+    double times[2] = {double(m_tune_step_time), double(m_tune_build_time)};
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, times, 2, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+    #endif
+    double time_per_step = times[0] / double(m_tune_steps);
+
+    // restart the search from a buffer radius set by the user
+    if (m_r_buff != m_tune_r_current)
+        {
+        m_tune_r_current = m_tune_r_accepted = m_r_buff;
+        m_tune_trial = false;
+        }
+
+    // start by growing the buffer if the builds take a large fraction of the time
+    if (m_tune_dir == 0)
+        m_tune_dir = (times[1] > 0.2*times[0]) ? 1 : -1;
+
+    const Scalar delta_min = (m_tune_r_max - m_tune_r_min) / Scalar(64.0);
+    bool next_trial = true;
+    if (!m_tune_trial || time_per_step < m_tune_best_time)
+        {
+        // the measured buffer radius is the best one so far
+        m_tune_r_accepted = m_tune_r_current;
+        m_tune_best_time = time_per_step;
+        }
+    else
+        {
+        // go back to the best buffer radius, reverse and refine the search
+        m_tune_dir = -m_tune_dir;
+        m_tune_delta = std::max(m_tune_delta * Scalar(0.5), delta_min);
+        next_trial = false;
+        }
+
+    Scalar r_next = m_tune_r_accepted;
+    if (next_trial)
+        {
+        r_next = std::min(std::max(m_tune_r_accepted + m_tune_dir * m_tune_delta, m_tune_r_min), m_tune_r_max);
+        if (r_next == m_tune_r_accepted)
+            {
+            // reverse at the bounds of the range
+            m_tune_dir = -m_tune_dir;
+            r_next = std::min(std::max(m_tune_r_accepted + m_tune_dir * m_tune_delta, m_tune_r_min), m_tune_r_max);
+            }
+        }
+    m_tune_trial = next_trial;
+
+    // check again soon enough that no build is dangerous, shorter intervals follow a smaller buffer radius
+    if (m_dist_check)
+        {
+        if (m_dangerous_updates > m_tune_dangerous)
+            m_every = 1;
+        else if (m_tune_builds > 0)
+            {
+            Scalar scale = std::min(Scalar(1.0), r_next / m_r_buff);
+            m_every = std::max(1u, (unsigned int)(Scalar(0.5) * scale * m_tune_min_interval));
+            }
+        }
+
+    m_exec_conf->msg->notice(4) << "nlist: " << time_per_step / 1e6 << " ms per step at r_buff = " << m_tune_r_current
+        << ", next r_buff = " << r_next << ", check_period = " << m_every << endl;
+
+    if (r_next != m_r_buff)
+        {
+        m_r_buff_pending = r_next;
+        m_tune_skip = 2;
+        }
+    m_tune_r_current = r_next;
+
+    resetAutotuneWindow();
+    }
+
 /*! Generic statistics that apply to any neighbor list, like the number of updates,
     average number of neighbors, etc... are printed to stdout. Derived classes should
     print any pertinent information they see fit to.
@@ -1352,6 +1811,9 @@ void NeighborList::printStats()
     m_exec_conf->msg->notice(1) << "n_neigh_min: " << n_neigh_min << " / n_neigh_max: " << n_neigh_max << " / n_neigh_avg: " << n_neigh_avg << endl;
 
     m_exec_conf->msg->notice(1) << "shortest rebuild period: " << getSmallestRebuild() << endl;
+
+    if (m_autotune)
+        m_exec_conf->msg->notice(1) << "autotuned r_buff: " << m_r_buff << " / check_period: " << m_every << endl;
     }
 
 void NeighborList::resetStats()
@@ -1380,7 +1842,8 @@ void NeighborList::buildNlist(unsigned int timestep)
     throw runtime_error("Error updating neighborlist bins");
     }
 
-/*! Translates the exclusions set in \c m_n_ex_tag and \c m_ex_list_tag to indices in \c m_n_ex_idx and \c m_ex_list_idx
+/*! Translates the exclusions set in \c m_n_ex_tag and \c m_ex_list_tag to indices, and packs them sorted by index
+    in \c m_ex_head_idx and \c m_ex_list_csr. Exclusions of particles that are not present on this rank are dropped.
 */
 void NeighborList::updateExListIdx()
     {
@@ -1395,35 +1858,48 @@ void NeighborList::updateExListIdx()
 
     ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::overwrite);
 
-    // translate the number and exclusions from one array to the other
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+    const unsigned int N = m_pdata->getN();
+
+    // count the exclusions to size the list
+    unsigned int n_ex_total = 0;
+    for (unsigned int idx = 0; idx < N; idx++)
+        n_ex_total += h_n_ex_tag.data[h_tag.data[idx]];
+
+    m_ex_list_csr.resize(n_ex_total);
+
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_ex_list_csr(m_ex_list_csr, access_location::host, access_mode::overwrite);
+
+    // translate the exclusions of every particle and sort them by index
+    unsigned int offset = 0;
+    for (unsigned int idx = 0; idx < N; idx++)
         {
         // get the tag for this index
         unsigned int tag = h_tag.data[idx];
-
-        // copy the number of exclusions over
         unsigned int n = h_n_ex_tag.data[tag];
-        h_n_ex_idx.data[idx] = n;
 
-        // construct the exclusion list
-        for (unsigned int offset = 0; offset < n; offset++)
+        h_ex_head_idx.data[idx] = offset;
+        unsigned int *ex_begin = h_ex_list_csr.data + offset;
+        for (unsigned int cur_ex = 0; cur_ex < n; cur_ex++)
             {
-            unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag,offset)];
+            unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag,cur_ex)];
             unsigned int ex_idx = h_rtag.data[ex_tag];
 
-            // store excluded particle idx
-            h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
+            // particles that are neither local nor ghosts can never be neighbors
+            if (ex_idx != NOT_LOCAL)
+                h_ex_list_csr.data[offset++] = ex_idx;
             }
+        std::sort(ex_begin, h_ex_list_csr.data + offset);
         }
+    h_ex_head_idx.data[N] = offset;
 
     if (m_prof)
         m_prof->pop();
     }
 
-/*! Loops through the neighbor list and filters out any excluded pairs
+/*! Loops through the neighbor list and filters out any excluded pairs. This is only needed by derived classes that do
+    not skip excluded pairs in buildNlist() themselves.
 */
 void NeighborList::filterNlist()
     {
@@ -1432,8 +1908,8 @@ void NeighborList::filterNlist()
 
     // access data
     ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_csr(m_ex_list_csr, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
 
@@ -1442,28 +1918,21 @@ void NeighborList::filterNlist()
         {
         unsigned int myHead = h_head_list.data[idx];
         unsigned int n_neigh = h_n_neigh.data[idx];
-        unsigned int n_ex = h_n_ex_idx.data[idx];
+        const unsigned int *ex_begin = h_ex_list_csr.data + h_ex_head_idx.data[idx];
+        const unsigned int *ex_end = h_ex_list_csr.data + h_ex_head_idx.data[idx+1];
         unsigned int new_n_neigh = 0;
 
+        // nothing to filter
+        if (ex_begin == ex_end)
+            continue;
+
         // loop over the list, regenerating it as we go
         for (unsigned int cur_neigh_idx = 0; cur_neigh_idx < n_neigh; cur_neigh_idx++)
             {
             unsigned int cur_neigh = h_nlist.data[myHead + cur_neigh_idx];
 
-            // test if excluded
-            bool excluded = false;
-            for (unsigned int cur_ex_idx = 0; cur_ex_idx < n_ex; cur_ex_idx++)
-                {
-                unsigned int cur_ex = h_ex_list_idx.data[m_ex_list_indexer(idx, cur_ex_idx)];
-                if (cur_ex == cur_neigh)
-                    {
-                    excluded = true;
-                    break;
-                    }
-                }
-
             // add it back to the list if it is not excluded
-            if (!excluded)
+            if (!isExcludedIdx(ex_begin, ex_end, cur_neigh))
                 {
                 h_nlist.data[myHead + new_n_neigh] = cur_neigh;
                 new_n_neigh++;
@@ -1512,8 +1981,8 @@ void NeighborList::buildHeadList()
 /*!
  * \param size the requested number of elements in the neighbor list
  *
- * Increases the size of the neighbor list memory using amortized resizing (growth factor: 9/8)
- * only when needed.
+ * Increases the size of the neighbor list memory using amortized resizing (growth factor: 9/8, or less when
+ * close to the memory budget) only when needed.
  */
 void NeighborList::resizeNlist(unsigned int size)
     {
@@ -1523,9 +1992,10 @@ void NeighborList::resizeNlist(unsigned int size)
 
         unsigned int alloc_size = m_nlist.getNumElements() ? m_nlist.getNumElements() : 1;
 
+        float factor = m_exec_conf->getMemoryAccounting().getGrowthFactor(1.125f);
         while (size > alloc_size)
             {
-            alloc_size = ((unsigned int) (((float) alloc_size) * 1.125f)) + 1 ;
+            alloc_size = ((unsigned int) (((float) alloc_size) * factor)) + 1 ;
             }
 
         // round up to nearest multiple of 4
@@ -1568,15 +2038,18 @@ void NeighborList::resetConditions()
 
 void NeighborList::growExclusionList()
     {
-    unsigned int new_height = m_ex_list_indexer.getH() + 1;
+    unsigned int new_height = m_ex_list_indexer_tag.getH() + 1;
 
     m_ex_list_tag.resize(m_pdata->getRTags().size(), new_height);
-    m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
-
-    // update the indexers
-    m_ex_list_indexer = Index2D(m_ex_list_idx.getPitch(), new_height);
     m_ex_list_indexer_tag = Index2D(m_ex_list_tag.getPitch(), new_height);
 
+    // the padded exclusion list by index is only used on the GPU, the CPU packs it in CSR format
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
+        m_ex_list_indexer = Index2D(m_ex_list_idx.getPitch(), new_height);
+        }
+
     // we didn't copy data for the new idx list, force an update so it will be correct
     forceUpdate();
     }
@@ -1677,6 +2150,9 @@ void export_NeighborList(py::module& m)
         .def("setRCutPair", &NeighborList::setRCutPair)
         .def("setRBuff", &NeighborList::setRBuff)
         .def("setEvery", &NeighborList::setEvery)
+        .def("setAutotune", &NeighborList::setAutotune)
+        .def("getAutotune", &NeighborList::getAutotune)
+        .def("getRBuff", &NeighborList::getRBuff)
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def("addExclusion", &NeighborList::addExclusion)
         .def("clearExclusions", &NeighborList::clearExclusions)
@@ -9,10 +9,12 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/ClockSource.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <vector>
+#include <algorithm>
 
 /*! \file NeighborList.h
     \brief Declares the NeighborList class
@@ -91,13 +93,42 @@
     setEvery takes a dist_check parameter. When dist_check=True, the above described behavior is followed. When
     dist_check is false, the nlist is built exactly m_every steps. This is intended for use in profiling only.
 
+    <b>Online tuning:</b>
+
+    With setAutotune(), the buffer radius and the check period are tuned while the simulation runs. The wall time of
+    every step is measured between consecutive calls to compute(), which includes the build and the pair forces, and
+    averaged over windows of at least \a period steps. At the end of every window, a local search compares the time
+    per step of a trial buffer radius with that of the best one so far. It keeps moving in the same direction while
+    the time improves, and reverses and halves the step otherwise, down to a minimum step with which it keeps
+    following changes of the density and temperature. The check period is set to half of the shortest rebuild interval
+    of the window, and to 1 after a dangerous build. The times are reduced over all ranks with MPI, so that all ranks
+    take the same decisions. A new buffer radius is applied with setRBuff() at the next update check, which runs
+    before the Communicator decides on particle migration, so that the ghost layer and the cell list widths follow
+    through the rcut signal and the forced update.
+
+    <b>Views:</b>
+
+    Consumers with smaller cutoffs than the list, such as a short ranged potential sharing the list with a long
+    ranged one, can register a view with addView() and set its cutoffs with setViewRCutPair(). When at least two views
+    are registered, the neighbors of every particle of type i are reordered after each build into shells, such that
+    the neighbors within max_j r_cut(i,j) + r_buff of each view come first. getViewNNeigh() then returns the number of
+    neighbors of every particle in the view, and the consumer only loops over this prefix of the list. Views are not
+    built with diameter shifting or when all views have the same radii. getViewNNeigh() then returns NULL, and the
+    whole list is used.
+
     \b Exclusions:
 
-    Exclusions are stored in \a ex_list, a data structure similar in structure to \a nlist, except this time exclusions
-    are stored. User-specified exclusions are stored by tag and translated to indices whenever a particle sort occurs
-    (updateExListIdx()). If any exclusions are set, filterNlist() is called after buildNlist(). filterNlist() loops
-    through the neighbor list and removes any particles that are excluded. This allows an arbitrary number of exclusions
-    to be processed without slowing the performance of the buildNlist() step itself.
+    User-specified exclusions are stored by tag and translated to indices whenever a particle sort occurs
+    (updateExListIdx()). On the CPU, the exclusions by index are packed in compressed sparse row (CSR) format: the
+    excluded indices of particle i are stored in \a m_ex_list_csr between the offsets \a m_ex_head_idx[i] and
+    \a m_ex_head_idx[i+1], sorted in ascending order. A particle with many exclusions therefore costs no memory for the
+    others. The CPU buildNlist() implementations skip excluded pairs with isExcludedIdx() as they accept neighbors, so no
+    separate filtering pass over the list is needed (\a m_filter_in_build).
+
+    On the GPU, the exclusions by index are stored in \a ex_list, a data structure similar in structure to \a nlist,
+    except this time exclusions are stored. If any exclusions are set, filterNlist() is called after buildNlist().
+    filterNlist() loops through the neighbor list and removes any particles that are excluded. This allows an arbitrary
+    number of exclusions to be processed without slowing the performance of the buildNlist() step itself.
 
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition is stored in the
@@ -152,6 +183,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
             forceUpdate();
             }
 
+        //! Enable or disable online tuning of the buffer radius and the check period
+        void setAutotune(bool enable, unsigned int period, Scalar r_buff_min, Scalar r_buff_max);
+
+        //! Get whether online tuning is enabled
+        bool getAutotune() const
+            {
+            return m_autotune;
+            }
+
         //! Set the storage mode
         /*! \param mode Storage mode to set
             - half only stores neighbors where i < j
@@ -249,13 +289,13 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_head_list;
             }
 
-        //! Get the number of exclusions array
+        //! Get the number of exclusions array (GPU only)
         const GlobalArray<unsigned int>& getNExArray()
             {
             return m_n_ex_idx;
             }
 
-         //! Get the exclusion list
+         //! Get the exclusion list (GPU only)
          const GlobalArray<unsigned int>& getExListArray()
             {
             return m_ex_list_idx;
@@ -270,6 +310,41 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_ex_list_indexer;
             }
 
+        //! Get the CSR offsets into the sorted exclusion list by index (CPU only)
+        /*! The exclusions of particle \a idx are stored in getExListCSRArray() between the offsets \a idx and
+            \a idx+1.
+        */
+        const GlobalArray<unsigned int>& getExHeadArray()
+            {
+            return m_ex_head_idx;
+            }
+
+        //! Get the sorted exclusion list by index in CSR format (CPU only)
+        const GlobalVector<unsigned int>& getExListCSRArray()
+            {
+            return m_ex_list_csr;
+            }
+
+        //! Test if a particle index is in a sorted exclusion list
+        /*! \param ex_begin First entry of the exclusion list of a particle
+            \param ex_end One past the last entry
+            \param idx Index of the neighbor
+        */
+        static inline bool isExcludedIdx(const unsigned int *ex_begin, const unsigned int *ex_end, unsigned int idx)
+            {
+            // short lists are scanned until the first larger index
+            if (ex_end - ex_begin <= 8)
+                {
+                for (; ex_begin != ex_end && *ex_begin <= idx; ++ex_begin)
+                    {
+                    if (*ex_begin == idx)
+                        return true;
+                    }
+                return false;
+                }
+            return std::binary_search(ex_begin, ex_end, idx);
+            }
+
         bool getExclusionsSet()
             {
             return m_exclusions_set;
@@ -453,6 +528,25 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_rcut_signal;
             }
 
+        //! Add a view of the neighbor list
+        unsigned int addView();
+
+        //! Remove a view of the neighbor list
+        void removeView(unsigned int view);
+
+        //! Set the cutoff of a type pair in a view
+        void setViewRCutPair(unsigned int view, unsigned int typ1, unsigned int typ2, Scalar r_cut);
+
+        //! Get the number of neighbors of every particle in a view
+        /*! \param view The view returned by addView()
+            \returns The number of neighbors of each local particle at the start of its list, or NULL if the view
+                      contains the whole list
+        */
+        const unsigned int *getViewNNeigh(unsigned int view) const
+            {
+            return m_views_built ? m_view_n_neigh[view].data() : NULL;
+            }
+
    protected:
         Index2D m_typpair_idx;      //!< Indexer for full type pair storage
         GlobalArray<Scalar> m_r_cut;   //!< The potential cutoffs stored by pair type
@@ -469,6 +563,11 @@ class PYBIND11_EXPORT NeighborList : public Compute
         GlobalArray<unsigned int> m_nlist;      //!< Neighbor list data
         GlobalArray<unsigned int> m_n_neigh;    //!< Number of neighbors for each particle
         GlobalArray<Scalar4> m_last_pos;        //!< coordinates of last updated particle positions
+        std::vector<Scalar> m_dist_check_maxsq; //!< Squared max displacement of every type in distanceCheck()
+
+        std::vector< std::vector<Scalar> > m_view_r_cut;        //!< Cutoffs of every view by type pair, empty if removed
+        std::vector< std::vector<unsigned int> > m_view_n_neigh;//!< Number of neighbors of every particle in a view
+        bool m_views_built;                                     //!< True if the views match the current list
         Scalar3 m_last_L;                    //!< Box lengths at last update
         Scalar3 m_last_L_local;              //!< Local Box lengths at last update
 
@@ -482,7 +581,10 @@ class PYBIND11_EXPORT NeighborList : public Compute
         GlobalArray<unsigned int> m_n_ex_idx;     //!< Number of exclusions for a given particle index
         Index2D m_ex_list_indexer;             //!< Indexer for accessing the exclusion list
         Index2D m_ex_list_indexer_tag;         //!< Indexer for accessing the by-tag exclusion list
+        GlobalArray<unsigned int> m_ex_head_idx;  //!< CSR offsets of the exclusions of every particle index
+        GlobalVector<unsigned int> m_ex_list_csr; //!< Sorted exclusions by index in CSR format
         bool m_exclusions_set;                 //!< True if any exclusions have been set
+        bool m_filter_in_build;                //!< True if buildNlist() skips excluded pairs by itself
         bool m_need_reallocate_exlist;         //!< True if global exclusion list needs to be reallocated
 
         //! Return true if we are supposed to do a distance check in this time step
@@ -506,6 +608,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Checks that box is big enough for neighbor list cutoff
         void checkBoxSize();
 
+        //! Reorder the neighbors into the shells of the views
+        virtual void buildViews();
+
         //! Filter the neighbor list of excluded particles
         virtual void filterNlist();
 
@@ -560,6 +665,34 @@ class PYBIND11_EXPORT NeighborList : public Compute
         unsigned int m_every; //!< No update checks will be performed until m_every steps after the last one
         std::vector<unsigned int> m_update_periods;    //!< Steps between updates
 
+        bool m_autotune;                    //!< True if the buffer radius and the check period are tuned online
+        unsigned int m_tune_period;         //!< Minimum number of steps in a tuning window
+        Scalar m_tune_r_min;                //!< Smallest buffer radius the tuning may choose
+        Scalar m_tune_r_max;                //!< Largest buffer radius the tuning may choose
+        Scalar m_tune_r_accepted;           //!< Buffer radius with the best time per step so far
+        Scalar m_tune_r_current;            //!< Buffer radius measured in the current window
+        Scalar m_tune_delta;                //!< Current step size of the search
+        int m_tune_dir;                     //!< Current search direction (+1 or -1, 0 before the first window)
+        bool m_tune_trial;                  //!< True if the current window measures a trial buffer radius
+        double m_tune_best_time;            //!< Time per step at m_tune_r_accepted (ns)
+        Scalar m_r_buff_pending;            //!< Buffer radius to apply at the next update check (negative if none)
+        ClockSource m_tune_clock;           //!< Clock for the tuning measurements
+        uint64_t m_tune_last_time;          //!< Clock time of the last measured step
+        unsigned int m_tune_last_step;      //!< Last time step that was measured
+        unsigned int m_tune_skip;           //!< Number of steps to skip before the next window
+        unsigned int m_tune_steps;          //!< Number of steps in the current window
+        unsigned int m_tune_builds;         //!< Number of (not forced) builds in the current window
+        unsigned int m_tune_min_interval;   //!< Shortest rebuild interval in the current window
+        int64_t m_tune_dangerous;           //!< Number of dangerous builds at the start of the window
+        uint64_t m_tune_step_time;          //!< Total time of the steps in the current window (ns)
+        uint64_t m_tune_build_time;         //!< Total build time in the current window (ns)
+
+        //! Measure the last step and update the tuning at the end of a window
+        void updateAutotune(unsigned int timestep);
+
+        //! Start a new tuning window
+        void resetAutotuneWindow();
+
         //! Test if the list needs updating
         bool needsUpdating(unsigned int timestep);
 
@@ -54,6 +54,17 @@ void NeighborListBinned::setRCut(Scalar r_cut, Scalar r_buff)
     m_cl->setNominalWidth(rmax);
     }
 
+void NeighborListBinned::setRBuff(Scalar r_buff)
+    {
+    NeighborList::setRBuff(r_buff);
+
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
 void NeighborListBinned::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut)
     {
     NeighborList::setRCutPair(typ1,typ2,r_cut);
@@ -112,6 +123,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
     // access the cell list data arrays
     ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start(m_cl->getCellStartArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(), access_location::host, access_mode::read);
 
@@ -122,9 +134,12 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // excluded pairs are skipped as they are found
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_csr(m_ex_list_csr, access_location::host, access_mode::read);
+
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
     Index2D cadji = m_cl->getCellAdjIndexer();
 
     // get periodic flags
@@ -145,6 +160,15 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
 
+        // sorted exclusions of particle i
+        const unsigned int *ex_begin = NULL;
+        const unsigned int *ex_end = NULL;
+        if (m_exclusions_set)
+            {
+            ex_begin = h_ex_list_csr.data + h_ex_head_idx.data[i];
+            ex_end = h_ex_list_csr.data + h_ex_head_idx.data[i+1];
+            }
+
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos,ghost_width);
         int ib = (unsigned int)(f.x * dim.x);
@@ -169,9 +193,10 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
+            const unsigned int start = h_cell_start.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
-                Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                Scalar4& cur_xyzf = h_cell_xyzf.data[start + cur_offset];
                 unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
 
                 // get the current neighbor type from the position data (will use tdb on the GPU)
@@ -208,7 +233,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                 Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,cur_neigh_type)];
                 if (dr_sq <= (r_listsq + sqshift) && !excluded)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    if ((m_storage_mode == full || i < (int)cur_neigh) && !isExcludedIdx(ex_begin, ex_end, cur_neigh))
                         {
                         // local neighbor
                         if (cur_n_neigh < Nmax_i)
@@ -0,0 +1,408 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListCluster.cc
+    \brief Defines NeighborListCluster
+*/
+
+#include "NeighborListCluster.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+namespace py = pybind11;
+
+NeighborListCluster::NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef,
+                                         Scalar r_cut,
+                                         Scalar r_buff,
+                                         std::shared_ptr<CellList> cl)
+    : NeighborListBinned(sysdef, r_cut, r_buff, cl), m_n_clusters(0), m_particle_list_stale(true)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListCluster" << endl;
+    }
+
+NeighborListCluster::~NeighborListCluster()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListCluster" << endl;
+    }
+
+/*! \param timestep Current time step
+
+    Consumers that do not support cluster pairs call this method, so the per-particle list is filled in after every
+    build of the cluster pairs.
+*/
+void NeighborListCluster::compute(unsigned int timestep)
+    {
+    computeClusters(timestep);
+
+    if (m_particle_list_stale)
+        expandParticleList();
+    }
+
+//! Sort key of a particle in a cell
+struct ClusterSortKey
+    {
+    unsigned int column;    //!< Column of the particle in the cell
+    Scalar z;               //!< z coordinate
+    unsigned int idx;       //!< Particle index
+
+    //! Order by column, then along z
+    bool operator<(const ClusterSortKey& other) const
+        {
+        return (column < other.column) || (column == other.column && z < other.z);
+        }
+    };
+
+/*! The particles of every cell are split into s x s columns, with s chosen so that a cluster is about as wide as it
+    is high, and sorted along z in every column. Every column is then cut into clusters.
+*/
+void NeighborListCluster::buildClusters()
+    {
+    uint3 dim = m_cl->getDim();
+    Scalar3 ghost_width = m_cl->getGhostWidth();
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start(m_cl->getCellStartArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
+
+    Index3D ci = m_cl->getCellIndexer();
+
+    const unsigned int n_cells = ci.getNumElements();
+    m_cell_clusters.resize(n_cells+1);
+    m_cluster_members.clear();
+    m_cluster_bounds.clear();
+
+    std::vector<ClusterSortKey> keys;
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        {
+        m_cell_clusters[cell] = (unsigned int)m_cluster_bounds.size();
+
+        unsigned int size = h_cell_size.data[cell];
+        if (size == 0)
+            continue;
+
+        // number of columns along x and y
+        unsigned int s = (unsigned int)lround(cbrt(Scalar(size) / Scalar(NLIST_CLUSTER_SIZE)));
+        if (s < 1)
+            s = 1;
+
+        int ib = cell % dim.x;
+        int jb = (cell / dim.x) % dim.y;
+
+        keys.resize(size);
+        for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            {
+            const Scalar4& cur_xyzf = h_cell_xyzf.data[h_cell_start.data[cell] + cur_offset];
+            Scalar3 pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+
+            // position of the particle inside the cell
+            Scalar3 f = box.makeFraction(pos, ghost_width);
+            Scalar u = f.x * dim.x - ib;
+            Scalar v = f.y * dim.y - jb;
+
+            // particles that were wrapped into the cell are clamped to its boundary
+            int cx = min(max((int)(u * s), 0), (int)s - 1);
+            int cy = min(max((int)(v * s), 0), (int)s - 1);
+
+            keys[cur_offset].column = cx + s*cy;
+            keys[cur_offset].z = pos.z;
+            keys[cur_offset].idx = __scalar_as_int(cur_xyzf.w);
+            }
+
+        std::sort(keys.begin(), keys.end());
+
+        // cut every column into clusters
+        unsigned int start = 0;
+        while (start < size)
+            {
+            unsigned int n = 1;
+            while (n < NLIST_CLUSTER_SIZE && start + n < size && keys[start + n].column == keys[start].column)
+                n++;
+
+            // members and bounding sphere
+            Scalar3 center = make_scalar3(0,0,0);
+            for (unsigned int m = 0; m < NLIST_CLUSTER_SIZE; m++)
+                {
+                if (m < n)
+                    {
+                    unsigned int idx = keys[start + m].idx;
+                    m_cluster_members.push_back(idx);
+                    center += make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
+                    }
+                else
+                    m_cluster_members.push_back(CLUSTER_PADDING);
+                }
+            center = center / Scalar(n);
+
+            Scalar rsq_max = Scalar(0.0);
+            for (unsigned int m = 0; m < n; m++)
+                {
+                unsigned int idx = keys[start + m].idx;
+                Scalar3 dx = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - center;
+                rsq_max = max(rsq_max, dot(dx, dx));
+                }
+            m_cluster_bounds.push_back(make_scalar4(center.x, center.y, center.z, sqrt(rsq_max)));
+
+            start += n;
+            }
+        }
+
+    m_n_clusters = (unsigned int)m_cluster_bounds.size();
+    m_cell_clusters[n_cells] = m_n_clusters;
+    }
+
+void NeighborListCluster::buildNlist(unsigned int timestep)
+    {
+    m_cl->compute(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compute");
+
+    buildClusters();
+
+    // acquire the particle data and box dimension
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    // the largest list radius of any pair
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    // access the rlist data
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(), access_location::host, access_mode::read);
+    Index2D cadji = m_cl->getCellAdjIndexer();
+    Index3D ci = m_cl->getCellIndexer();
+
+    // excluded pairs are skipped as they are found
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_csr(m_ex_list_csr, access_location::host, access_mode::read);
+
+    const unsigned int N = m_pdata->getN();
+
+    m_cluster_head.resize(m_n_clusters+1);
+    m_cluster_pairs.clear();
+
+    for (unsigned int cell = 0; cell < ci.getNumElements(); cell++)
+        {
+        for (unsigned int cluster_i = m_cell_clusters[cell]; cluster_i < m_cell_clusters[cell+1]; cluster_i++)
+            {
+            m_cluster_head[cluster_i] = (unsigned int)m_cluster_pairs.size();
+
+            const unsigned int *members_i = &m_cluster_members[cluster_i*NLIST_CLUSTER_SIZE];
+
+            // only clusters with local particles have neighbors
+            bool has_local = false;
+            for (unsigned int a = 0; a < NLIST_CLUSTER_SIZE; a++)
+                has_local = has_local || members_i[a] < N;
+            if (!has_local)
+                continue;
+
+            const Scalar4 bounds_i = m_cluster_bounds[cluster_i];
+            const Scalar3 center_i = make_scalar3(bounds_i.x, bounds_i.y, bounds_i.z);
+
+            // loop through all neighboring cells
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, cell)];
+
+                for (unsigned int cluster_j = m_cell_clusters[neigh_cell];
+                     cluster_j < m_cell_clusters[neigh_cell+1]; cluster_j++)
+                    {
+                    // reject cluster pairs whose bounding spheres are too far apart
+                    const Scalar4 bounds_j = m_cluster_bounds[cluster_j];
+                    Scalar3 dc = box.minImage(center_i - make_scalar3(bounds_j.x, bounds_j.y, bounds_j.z));
+                    Scalar reach = rmax + bounds_i.w + bounds_j.w;
+                    if (dot(dc, dc) > reach*reach)
+                        continue;
+
+                    const unsigned int *members_j = &m_cluster_members[cluster_j*NLIST_CLUSTER_SIZE];
+
+                    // test the individual particle pairs
+                    unsigned int mask = 0;
+                    for (unsigned int a = 0; a < NLIST_CLUSTER_SIZE; a++)
+                        {
+                        const unsigned int i = members_i[a];
+                        if (i >= N)
+                            continue;
+
+                        const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+                        const unsigned int body_i = h_body.data[i];
+                        const Scalar diam_i = h_diameter.data[i];
+
+                        // sorted exclusions of particle i
+                        const unsigned int *ex_begin = NULL;
+                        const unsigned int *ex_end = NULL;
+                        if (m_exclusions_set)
+                            {
+                            ex_begin = h_ex_list_csr.data + h_ex_head_idx.data[i];
+                            ex_end = h_ex_list_csr.data + h_ex_head_idx.data[i+1];
+                            }
+
+                        for (unsigned int b = 0; b < NLIST_CLUSTER_SIZE; b++)
+                            {
+                            const unsigned int j = members_j[b];
+                            if (j == CLUSTER_PADDING || i == j)
+                                continue;
+
+                            const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+                            Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i,type_j)];
+
+                            // skip inactive pairs and particles in the same body
+                            if (r_cut <= Scalar(0.0))
+                                continue;
+                            if (m_filter_body && body_i != NO_BODY && body_i == h_body.data[j])
+                                continue;
+
+                            Scalar3 dx = box.minImage(pos_i - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z));
+
+                            Scalar r_list = r_cut + m_r_buff;
+                            Scalar sqshift = Scalar(0.0);
+                            if (m_diameter_shift)
+                                {
+                                const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
+                                sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                                }
+
+                            Scalar dr_sq = dot(dx,dx);
+                            Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i,type_j)];
+                            if (dr_sq <= (r_listsq + sqshift) && (m_storage_mode == full || i < j)
+                                && !isExcludedIdx(ex_begin, ex_end, j))
+                                {
+                                mask |= 1u << (a*NLIST_CLUSTER_SIZE + b);
+                                }
+                            }
+                        }
+
+                    if (mask)
+                        m_cluster_pairs.push_back(make_uint2(cluster_j, mask));
+                    }
+                }
+            }
+        }
+    m_cluster_head[m_n_clusters] = (unsigned int)m_cluster_pairs.size();
+
+    m_particle_list_stale = true;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Lays out the head list with the exact number of neighbors of every particle, and fills in the neighbors.
+*/
+void NeighborListCluster::expandParticleList()
+    {
+    if (m_prof)
+        m_prof->push("expand");
+
+    const unsigned int N = m_pdata->getN();
+
+    unsigned int total = 0;
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::overwrite);
+
+        // count the neighbors of every particle
+        memset(h_n_neigh.data, 0, sizeof(unsigned int)*N);
+        for (unsigned int cluster_i = 0; cluster_i < m_n_clusters; cluster_i++)
+            {
+            const unsigned int *members_i = &m_cluster_members[cluster_i*NLIST_CLUSTER_SIZE];
+            for (unsigned int p = m_cluster_head[cluster_i]; p < m_cluster_head[cluster_i+1]; p++)
+                {
+                unsigned int mask = m_cluster_pairs[p].y;
+                for (unsigned int bit = 0; mask; bit++, mask >>= 1)
+                    {
+                    if (mask & 1)
+                        h_n_neigh.data[members_i[bit / NLIST_CLUSTER_SIZE]]++;
+                    }
+                }
+            }
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            h_head_list.data[i] = total;
+            total += h_n_neigh.data[i];
+            }
+        }
+
+    resizeNlist(total);
+
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+
+        // fill in the neighbors, counting again
+        memset(h_n_neigh.data, 0, sizeof(unsigned int)*N);
+        for (unsigned int cluster_i = 0; cluster_i < m_n_clusters; cluster_i++)
+            {
+            const unsigned int *members_i = &m_cluster_members[cluster_i*NLIST_CLUSTER_SIZE];
+            for (unsigned int p = m_cluster_head[cluster_i]; p < m_cluster_head[cluster_i+1]; p++)
+                {
+                const unsigned int *members_j = &m_cluster_members[m_cluster_pairs[p].x*NLIST_CLUSTER_SIZE];
+                unsigned int mask = m_cluster_pairs[p].y;
+                for (unsigned int bit = 0; mask; bit++, mask >>= 1)
+                    {
+                    if (mask & 1)
+                        {
+                        unsigned int i = members_i[bit / NLIST_CLUSTER_SIZE];
+                        h_nlist.data[h_head_list.data[i] + h_n_neigh.data[i]++] = members_j[bit % NLIST_CLUSTER_SIZE];
+                        }
+                    }
+                }
+            }
+        }
+
+    // the views are reordered in the expanded list
+    NeighborList::buildViews();
+
+    m_particle_list_stale = false;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void NeighborListCluster::printStats()
+    {
+    if (m_particle_list_stale)
+        expandParticleList();
+
+    NeighborList::printStats();
+
+    // return early if the notice level is less than 1
+    if (m_exec_conf->msg->getNoticeLevel() < 1)
+        return;
+
+    // count the particle pairs in the cluster pairs
+    unsigned int n_pairs = 0;
+    for (unsigned int p = 0; p < m_cluster_pairs.size(); p++)
+        {
+        unsigned int mask = m_cluster_pairs[p].y;
+        for (; mask; mask >>= 1)
+            n_pairs += mask & 1;
+        }
+
+    Scalar fill = m_cluster_pairs.size() ?
+        Scalar(n_pairs) / Scalar(m_cluster_pairs.size() * NLIST_CLUSTER_SIZE * NLIST_CLUSTER_SIZE) : Scalar(0.0);
+    m_exec_conf->msg->notice(1) << "clusters: " << m_n_clusters << " / cluster pairs: " << m_cluster_pairs.size()
+        << " / fraction of interacting pairs: " << fill << endl;
+    }
+
+void export_NeighborListCluster(py::module& m)
+    {
+    py::class_<NeighborListCluster, std::shared_ptr<NeighborListCluster> >(m, "NeighborListCluster", py::base<NeighborListBinned>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, Scalar, std::shared_ptr<CellList> >())
+    .def("getNClusters", &NeighborListCluster::getNClusters)
+    ;
+    }
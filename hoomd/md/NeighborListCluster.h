@@ -0,0 +1,136 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborListBinned.h"
+#include <vector>
+
+/*! \file NeighborListCluster.h
+    \brief Declares the NeighborListCluster class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTCLUSTER_H__
+#define __NEIGHBORLISTCLUSTER_H__
+
+//! Number of particles in a cluster of NeighborListCluster
+const unsigned int NLIST_CLUSTER_SIZE = 4;
+
+//! Cluster pair neighbor list on the CPU
+/*! NeighborListCluster groups spatially close particles into clusters of NLIST_CLUSTER_SIZE particles, and lists
+    the pairs of clusters that have at least one particle pair within the neighbor list cutoff, together with a mask of
+    the particle pairs that interact.
+
+    \b Clusters
+
+    The particles of every cell of the cell list are divided into columns along x and y, such that a cluster is
+    approximately cubic, and sorted along z within each column. Every column is then cut into clusters. The last
+    cluster of a column is padded with CLUSTER_PADDING entries. The members of all clusters are stored in
+    getClusterMembers(), with NLIST_CLUSTER_SIZE entries per cluster. Clusters may contain both local and ghost
+    particles.
+
+    \b Cluster pairs
+
+    Every cluster acts as i-cluster. Its pairs are stored in getClusterPairs() between the offsets getClusterHeadList()
+    [i] and [i+1]. Every pair is stored as a uint2, with the index of the j-cluster in x and the interaction mask in y.
+    Bit a*NLIST_CLUSTER_SIZE+b of the mask is set if member a of the i-cluster and member b of the j-cluster are
+    neighbors according to the same rules as the other neighbor lists: member a is a local particle, the pair is
+    within r_list, and it is not excluded. In half storage mode, the bit is only set for the particle with the lower
+    index, so that every pair occurs once. Pairs of clusters are only tested for individual particles if the bounding
+    spheres of the clusters are within r_list.
+
+    Compared with the per-particle list, one uint2 holds up to NLIST_CLUSTER_SIZE^2 pairs, and the members of a
+    j-cluster are read together. Consumers that support cluster pairs, like PotentialPair and AnisoPotentialPair, call
+    computeClusters() and loop over the cluster pairs. When compute() is called, the usual per-particle list is
+    expanded from the cluster pairs after every build for all other consumers. It is never allocated if all consumers
+    support cluster pairs.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListCluster : public NeighborListBinned
+    {
+    public:
+        //! Value of the padding entries in the cluster members
+        static const unsigned int CLUSTER_PADDING = 0xffffffff;
+
+        //! Constructs the compute
+        NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef,
+                            Scalar r_cut,
+                            Scalar r_buff,
+                            std::shared_ptr<CellList> cl = std::shared_ptr<CellList>());
+
+        //! Destructor
+        virtual ~NeighborListCluster();
+
+        //! Update the cluster pairs and the per-particle neighbor list
+        virtual void compute(unsigned int timestep);
+
+        //! Update only the cluster pairs
+        void computeClusters(unsigned int timestep)
+            {
+            NeighborList::compute(timestep);
+            }
+
+        //! Get the number of clusters
+        unsigned int getNClusters() const
+            {
+            return m_n_clusters;
+            }
+
+        //! Get the members of all clusters, NLIST_CLUSTER_SIZE per cluster
+        const std::vector<unsigned int>& getClusterMembers() const
+            {
+            return m_cluster_members;
+            }
+
+        //! Get the offsets of the pairs of every i-cluster
+        const std::vector<unsigned int>& getClusterHeadList() const
+            {
+            return m_cluster_head;
+            }
+
+        //! Get the cluster pairs (j-cluster, interaction mask)
+        const std::vector<uint2>& getClusterPairs() const
+            {
+            return m_cluster_pairs;
+            }
+
+        //! Print statistics on the cluster pairs
+        virtual void printStats();
+
+    protected:
+        unsigned int m_n_clusters;                  //!< Number of clusters
+        std::vector<unsigned int> m_cluster_members;//!< Members of all clusters
+        std::vector<Scalar4> m_cluster_bounds;      //!< Center (xyz) and radius (w) of the bounding sphere of every cluster
+        std::vector<unsigned int> m_cell_clusters;  //!< Offsets of the clusters of every cell
+        std::vector<unsigned int> m_cluster_head;   //!< Offsets of the pairs of every i-cluster
+        std::vector<uint2> m_cluster_pairs;         //!< Cluster pairs
+        bool m_particle_list_stale;                 //!< True if the per-particle list needs to be expanded
+
+        //! Builds the cluster pairs
+        virtual void buildNlist(unsigned int timestep);
+
+        //! The per-particle list is laid out by expandParticleList()
+        virtual void buildHeadList() { }
+
+        //! The views are built by expandParticleList()
+        virtual void buildViews()
+            {
+            m_views_built = false;
+            }
+
+        //! Group the particles of every cell into clusters
+        void buildClusters();
+
+        //! Fill the per-particle neighbor list from the cluster pairs
+        void expandParticleList();
+    };
+
+//! Exports NeighborListCluster to python
+void export_NeighborListCluster(pybind11::module& m);
+
+#endif
@@ -58,6 +58,9 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
             m_storage_mode = full;
             m_checkn = 1;
 
+            // excluded pairs are removed by the filter kernel after the build
+            m_filter_in_build = false;
+
             // flag to say how big to resize
             GlobalArray<unsigned int> req_size_nlist(1,m_exec_conf);
             std::swap(m_req_size_nlist,req_size_nlist);
@@ -80,6 +80,17 @@ void NeighborListGPUBinned::setRCut(Scalar r_cut, Scalar r_buff)
     m_cl->setNominalWidth(rmax);
     }
 
+void NeighborListGPUBinned::setRBuff(Scalar r_buff)
+    {
+    NeighborListGPU::setRBuff(r_buff);
+
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
 void NeighborListGPUBinned::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut)
     {
     NeighborListGPU::setRCutPair(typ1,typ2,r_cut);
@@ -111,6 +111,27 @@ void NeighborListGPUStencil::setRCut(Scalar r_cut, Scalar r_buff)
         }
     }
 
+/*! \param r_buff New buffer radius
+
+    The cell width follows the buffer radius, and the stencils are rebuilt at the next build. This is also how a
+    buffer radius found by the online tuning is applied.
+*/
+void NeighborListGPUStencil::setRBuff(Scalar r_buff)
+    {
+    NeighborListGPU::setRBuff(r_buff);
+
+    if (!m_override_cell_width)
+        {
+        Scalar rmin = getMinRCut() + m_r_buff;
+        if (m_diameter_shift)
+            rmin += m_d_max - Scalar(1.0);
+
+        m_cl->setNominalWidth(rmin);
+        }
+
+    m_needs_restencil = true;
+    }
+
 void NeighborListGPUStencil::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut)
     {
     NeighborListGPU::setRCutPair(typ1,typ2,r_cut);
@@ -45,6 +45,9 @@ class PYBIND11_EXPORT NeighborListGPUStencil : public NeighborListGPU
         //! Change the cutoff radius for all pairs
         virtual void setRCut(Scalar r_cut, Scalar r_buff);
 
+        //! Change the global buffer radius
+        virtual void setRBuff(Scalar r_buff);
+
         //! Change the cutoff radius by pair type
         virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
 
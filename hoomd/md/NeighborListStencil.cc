@@ -74,6 +74,27 @@ void NeighborListStencil::setRCut(Scalar r_cut, Scalar r_buff)
         }
     }
 
+/*! \param r_buff New buffer radius
+
+    The cell width follows the buffer radius, and the stencils are rebuilt at the next build. This is also how a
+    buffer radius found by the online tuning is applied.
+*/
+void NeighborListStencil::setRBuff(Scalar r_buff)
+    {
+    NeighborList::setRBuff(r_buff);
+
+    if (!m_override_cell_width)
+        {
+        Scalar rmin = getMinRCut() + m_r_buff;
+        if (m_diameter_shift)
+            rmin += m_d_max - Scalar(1.0);
+
+        m_cl->setNominalWidth(rmin);
+        }
+
+    m_needs_restencil = true;
+    }
+
 void NeighborListStencil::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut)
     {
     NeighborList::setRCutPair(typ1,typ2,r_cut);
@@ -174,6 +195,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
     // access the cell list data arrays
     ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start(m_cl->getCellStartArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_cell_tdb(m_cl->getTDBArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_stencil(m_cls->getStencils(), access_location::host, access_mode::read);
@@ -187,9 +209,12 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // excluded pairs are skipped as they are found
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_csr(m_ex_list_csr, access_location::host, access_mode::read);
+
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
 
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
@@ -206,6 +231,15 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int head_idx_i = h_head_list.data[i];
 
+        // sorted exclusions of particle i
+        const unsigned int *ex_begin = NULL;
+        const unsigned int *ex_end = NULL;
+        if (m_exclusions_set)
+            {
+            ex_begin = h_ex_list_csr.data + h_ex_head_idx.data[i];
+            ex_end = h_ex_list_csr.data + h_ex_head_idx.data[i+1];
+            }
+
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos,ghost_width);
         int ib = (unsigned int)(f.x * dim.x);
@@ -273,10 +307,11 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
+            const unsigned int start = h_cell_start.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
                 // read in the particle type (diameter and body as well while we've got the Scalar4 in)
-                const Scalar4& neigh_tdb = h_cell_tdb.data[cli(cur_offset, neigh_cell)];
+                const Scalar4& neigh_tdb = h_cell_tdb.data[start + cur_offset];
                 const unsigned int type_j = __scalar_as_int(neigh_tdb.x);
                 const Scalar diam_j = neigh_tdb.y;
                 const unsigned int body_j = __scalar_as_int(neigh_tdb.z);
@@ -304,7 +339,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
                 if (cell_dist2 > r_listsq) continue;
 
                 // only load in the particle position and id if distance check is satisfied
-                const Scalar4& neigh_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                const Scalar4& neigh_xyzf = h_cell_xyzf.data[start + cur_offset];
                 unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
 
                 // a particle cannot neighbor itself
@@ -318,7 +353,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
                 if (dr_sq <= r_listsq)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    if ((m_storage_mode == full || i < (int)cur_neigh) && !isExcludedIdx(ex_begin, ex_end, cur_neigh))
                         {
                         // local neighbor
                         if (cur_n_neigh < Nmax_i)
@@ -43,6 +43,9 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
         //! Change the cutoff radius for all pairs
         virtual void setRCut(Scalar r_cut, Scalar r_buff);
 
+        //! Change the global buffer radius
+        virtual void setRBuff(Scalar r_buff);
+
         //! Set the cutoff radius by pair type
         virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
 
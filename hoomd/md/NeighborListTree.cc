@@ -275,6 +275,10 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // excluded pairs are skipped as they are found
+    ArrayHandle<unsigned int> h_ex_head_idx(m_ex_head_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_csr(m_ex_list_csr, access_location::host, access_mode::read);
+
     // Loop over all particles
     for (unsigned int i=0; i < m_pdata->getN(); ++i)
         {
@@ -288,6 +292,15 @@ void NeighborListTree::traverseTree()
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const unsigned int nlist_head_i = h_head_list.data[i];
 
+        // sorted exclusions of particle i
+        const unsigned int *ex_begin = NULL;
+        const unsigned int *ex_end = NULL;
+        if (m_exclusions_set)
+            {
+            ex_begin = h_ex_list_csr.data + h_ex_head_idx.data[i];
+            ex_end = h_ex_list_csr.data + h_ex_head_idx.data[i+1];
+            }
+
         unsigned int n_neigh_i = 0;
         for (unsigned int cur_pair_type=0; cur_pair_type < m_pdata->getNTypes(); ++cur_pair_type) // loop on pair types
             {
@@ -358,7 +371,7 @@ void NeighborListTree::traverseTree()
 
                                     if (dr_sq <= (r_cutsq_i + sqshift))
                                         {
-                                        if (m_storage_mode == full || i < j)
+                                        if ((m_storage_mode == full || i < j) && !isExcludedIdx(ex_begin, ex_end, j))
                                             {
                                             if (n_neigh_i < Nmax_i)
                                                 h_nlist.data[nlist_head_i + n_neigh_i] = j;
@@ -17,9 +17,11 @@ namespace py = pybind11;
 using namespace std;
 
 /*! \param sysdef System to compute bond forces on
+    \param log_suffix Name given to this instance of the force
 */
-OPLSDihedralForceComputeGPU::OPLSDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef)
-    : OPLSDihedralForceCompute(sysdef)
+OPLSDihedralForceComputeGPU::OPLSDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                         const std::string& log_suffix)
+    : PotentialDihedralOPLS(sysdef, log_suffix)
     {
     // can't run on the GPU if there aren't any GPUs in the execution configuration
     if (!m_exec_conf->isCUDAEnabled())
@@ -79,7 +81,7 @@ void OPLSDihedralForceComputeGPU::computeForces(unsigned int timestep)
 
 void export_OPLSDihedralForceComputeGPU(py::module& m)
     {
-    py::class_<OPLSDihedralForceComputeGPU, std::shared_ptr<OPLSDihedralForceComputeGPU> >(m, "OPLSDihedralForceComputeGPU", py::base<OPLSDihedralForceCompute>())
-    .def(py::init< std::shared_ptr<SystemDefinition> >())
+    py::class_<OPLSDihedralForceComputeGPU, std::shared_ptr<OPLSDihedralForceComputeGPU> >(m, "OPLSDihedralForceComputeGPU", py::base<PotentialDihedralOPLS>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string& >())
     ;
     }
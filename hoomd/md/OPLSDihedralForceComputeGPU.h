@@ -4,7 +4,7 @@
 
 // Maintainer: ksil
 
-#include "OPLSDihedralForceCompute.h"
+#include "AllDihedralPotentials.h"
 #include "OPLSDihedralForceGPU.cuh"
 #include "hoomd/Autotuner.h"
 
@@ -27,11 +27,11 @@
     The GPU kernel for calculating this can be found in OPLSDihedralForceComputeGPU.cu
     \ingroup computes
 */
-class PYBIND11_EXPORT OPLSDihedralForceComputeGPU : public OPLSDihedralForceCompute
+class PYBIND11_EXPORT OPLSDihedralForceComputeGPU : public PotentialDihedralOPLS
     {
     public:
         //! Constructs the compute
-        OPLSDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef);
+        OPLSDihedralForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef, const std::string& log_suffix="");
 
         //! Destructor
         virtual ~OPLSDihedralForceComputeGPU() { }
@@ -42,7 +42,7 @@ class PYBIND11_EXPORT OPLSDihedralForceComputeGPU : public OPLSDihedralForceComp
         */
         virtual void setAutotunerParams(bool enable, unsigned int period)
             {
-            OPLSDihedralForceCompute::setAutotunerParams(enable, period);
+            PotentialDihedralOPLS::setAutotunerParams(enable, period);
             m_tuner->setPeriod(period);
             m_tuner->setEnabled(enable);
             }
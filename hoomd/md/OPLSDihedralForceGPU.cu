@@ -19,7 +19,7 @@
     \param virial_pitch pitch of 2D virial array
     \param N number of particles
     \param d_pos particle positions on the device
-    \param d_params Array of OPLS parameters k1/2, k2/2, k3/2, and k4/2
+    \param d_params Array of OPLS parameters k1, k2, k3, and k4
     \param box Box dimensions for periodic boundary condition handling
     \param tlist Dihedral data to use in calculating the forces
     \param dihedral_ABCD List of relative atom positions in the dihedrals
@@ -155,12 +155,11 @@ void gpu_compute_opls_dihedral_forces_kernel(Scalar4* d_force,
         if (c < -1.0) c = -1.0;
 
         // get values for k1/2 through k4/2 (MEM TRANSFER: 16 bytes)
-        // ----- The 1/2 factor is already stored in the parameters --------
         Scalar4 params = __ldg(d_params + cur_dihedral_type);
-        Scalar k1 = params.x;
-        Scalar k2 = params.y;
-        Scalar k3 = params.z;
-        Scalar k4 = params.w;
+        Scalar k1 = Scalar(0.5)*params.x;
+        Scalar k2 = Scalar(0.5)*params.y;
+        Scalar k3 = Scalar(0.5)*params.z;
+        Scalar k4 = Scalar(0.5)*params.w;
 
         // calculate the potential p = sum (i=1,4) k_i * (1 + (-1)**(i+1)*cos(i*phi) )
         // and df = dp/dc
@@ -295,7 +294,7 @@ void gpu_compute_opls_dihedral_forces_kernel(Scalar4* d_force,
     \param dihedral_ABCD List of relative atom positions in the dihedrals
     \param pitch Pitch of 2D dihedral list
     \param n_dihedrals_list List of numbers of dihedrals per atom
-    \param d_params Array of OPLS parameters k1/2, k2/2, k3/2, and k4/2
+    \param d_params Array of OPLS parameters k1, k2, k3, and k4
     \param n_dihedral_types Number of dihedral types in d_params
     \param block_size Block size to use when performing calculations
     \param compute_capability Compute capability of the device (200, 300, 350, ...)
@@ -0,0 +1,189 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PPPMDispersionForceCompute.h"
+#include "EvaluatorPairLJPME.h"
+
+namespace py = pybind11;
+
+/*! \file PPPMDispersionForceCompute.cc
+    \brief Contains code for the PPPMDispersionForceCompute class
+*/
+
+//! Evaluate the dimensionless Fourier transform of the long-ranged dispersion
+/*! \param b Wave number in units of twice the splitting parameter
+*/
+inline Scalar dispersion_kernel(Scalar b)
+    {
+    Scalar bsq = b*b;
+    return (Scalar(1.0)/Scalar(3.0))*((Scalar(1.0) - Scalar(2.0)*bsq)*exp(-bsq)
+        + Scalar(2.0)*sqrt(Scalar(M_PI))*bsq*b*erfc(b));
+    }
+
+/*! \param sysdef The system definition
+    \param nlist Neighbor list
+    \param group Group of particles that carry dispersion coefficients
+ */
+PPPMDispersionForceCompute::PPPMDispersionForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<NeighborList> nlist,
+    std::shared_ptr<ParticleGroup> group)
+    : PPPMForceCompute(sysdef, nlist, group)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PPPMDispersionForceCompute" << std::endl;
+
+    m_log_names[0] = "pppm_lj_energy";
+    }
+
+PPPMDispersionForceCompute::~PPPMDispersionForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PPPMDispersionForceCompute" << std::endl;
+    }
+
+/*! \param type Particle type
+    \param c Dispersion coefficient, such that the dispersion between types i and j is -c_i c_j / r^6
+*/
+void PPPMDispersionForceCompute::setCoefficient(unsigned int type, Scalar c)
+    {
+    if (type >= m_pdata->getNTypes())
+        {
+        m_exec_conf->msg->error() << "dispersion.pppm: Trying to set coefficient for a non existent type! "
+                  << type << std::endl;
+        throw std::runtime_error("Error setting parameters in PPPMDispersionForceCompute");
+        }
+
+    if (m_type_coeff.size() < m_pdata->getNTypes())
+        m_type_coeff.resize(m_pdata->getNTypes(), Scalar(0.0));
+
+    if (m_type_coeff[type] != c)
+        {
+        m_type_coeff[type] = c;
+
+        // recompute the sums of the coefficients and the body self energies
+        m_body_type_energy.clear();
+        m_need_initialize = true;
+        }
+    }
+
+void PPPMDispersionForceCompute::updateSources()
+    {
+    unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+    if (m_sources.getNumElements() < n)
+        {
+        GlobalArray<Scalar> sources(n, m_exec_conf);
+        m_sources.swap(sources);
+        }
+
+    if (m_type_coeff.size() < m_pdata->getNTypes())
+        m_type_coeff.resize(m_pdata->getNTypes(), Scalar(0.0));
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_sources(m_sources, access_location::host, access_mode::overwrite);
+
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        h_sources.data[i] = m_type_coeff[__scalar_as_int(h_postype.data[i].w)];
+        }
+    }
+
+void PPPMDispersionForceCompute::computeForces(unsigned int timestep)
+    {
+    // the particles may have been sorted or communicated since the last step
+    updateSources();
+
+    PPPMForceCompute::computeForces(timestep);
+    }
+
+/*! The dispersion is always attractive, and there is no Coulomb-like accuracy estimate, so only the relative
+    magnitude of the short-ranged part at the cutoff is reported.
+*/
+void PPPMDispersionForceCompute::setupCoeffs()
+    {
+    computeSourceSums();
+
+    Scalar y = m_kappa*m_kappa*m_rcut*m_rcut;
+    Scalar cutoff_error = Scalar(1.0) - lj_pme_long_range_fraction(y);
+    m_exec_conf->msg->notice(2) << "dispersion.pppm: relative real space dispersion at the cutoff: "
+        << cutoff_error << std::endl;
+
+    // initialize coefficients for the assignment of the sources
+    compute_rho_coeff();
+
+    // initialize coefficients for Green's function
+    compute_gf_denom();
+    }
+
+/*! \param ksq Squared wave number
+    \returns The Fourier transform of \f$ -[1 - g(\beta r)]/r^6 \f$
+*/
+Scalar PPPMDispersionForceCompute::evalGreensFunction(Scalar ksq) const
+    {
+    Scalar b = sqrt(ksq)/(Scalar(2.0)*m_kappa);
+    return -pow(Scalar(M_PI), Scalar(1.5))*m_kappa*m_kappa*m_kappa*dispersion_kernel(b);
+    }
+
+/*! \param ksq Squared wave number
+*/
+Scalar PPPMDispersionForceCompute::evalVirialFactor(Scalar ksq) const
+    {
+    Scalar b = sqrt(ksq)/(Scalar(2.0)*m_kappa);
+    Scalar f = dispersion_kernel(b);
+
+    // the mode does not contribute if the kernel underflows
+    if (f == Scalar(0.0))
+        return Scalar(0.0);
+
+    return (sqrt(Scalar(M_PI))*b*erfc(b) - exp(-b*b))/(Scalar(2.0)*m_kappa*m_kappa*f);
+    }
+
+/*! \param rsq Squared distance between the particles
+    \param pair_eng Energy per unit product of the coefficients (output)
+    \param force_divr Force divided by r per unit product of the coefficients (output)
+*/
+void PPPMDispersionForceCompute::evalRealSpace(Scalar rsq, Scalar& pair_eng, Scalar& force_divr) const
+    {
+    Scalar beta2 = m_kappa*m_kappa;
+    Scalar y = beta2*rsq;
+    Scalar long_range = lj_pme_long_range_fraction(y);
+
+    Scalar r2inv = Scalar(1.0)/rsq;
+    Scalar r6inv = r2inv*r2inv*r2inv;
+
+    pair_eng = -long_range*r6inv;
+    force_divr = beta2*beta2*beta2*exp(-y)*r2inv - Scalar(6.0)*long_range*r6inv*r2inv;
+    }
+
+/*! The mesh sum includes the interaction of every source with itself, \f$ -\beta^6/6 \f$ per unit coefficient
+    squared, which is removed. The k=0 mode is excluded from the mesh sum by the mode weights and is added here.
+*/
+Scalar PPPMDispersionForceCompute::computeSelfEnergy()
+    {
+    Scalar beta2 = m_kappa*m_kappa;
+    Scalar V = m_pdata->getGlobalBox().getVolume();
+
+    return m_q2*beta2*beta2*beta2/Scalar(12.0) + Scalar(0.5)*evalGreensFunction(Scalar(0.0))*m_q*m_q/V;
+    }
+
+/*! The energy of the k=0 mode scales with the inverse volume and adds to the diagonal of the virial.
+*/
+void PPPMDispersionForceCompute::computeVirial()
+    {
+    PPPMForceCompute::computeVirial();
+
+    if (m_exec_conf->getRank() == 0)
+        {
+        Scalar V = m_pdata->getGlobalBox().getVolume();
+        Scalar energy_k0 = Scalar(0.5)*evalGreensFunction(Scalar(0.0))*m_q*m_q/V;
+
+        m_external_virial[0] += energy_k0;
+        m_external_virial[3] += energy_k0;
+        m_external_virial[5] += energy_k0;
+        }
+    }
+
+void export_PPPMDispersionForceCompute(py::module& m)
+    {
+    py::class_<PPPMDispersionForceCompute, std::shared_ptr<PPPMDispersionForceCompute> >(m, "PPPMDispersionForceCompute", py::base<PPPMForceCompute>())
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, std::shared_ptr<ParticleGroup> >())
+        .def("setCoefficient", &PPPMDispersionForceCompute::setCoefficient)
+        ;
+    }
@@ -0,0 +1,99 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PPPM_DISPERSION_FORCE_COMPUTE_H__
+#define __PPPM_DISPERSION_FORCE_COMPUTE_H__
+
+#include "PPPMForceCompute.h"
+
+#include <vector>
+
+/*! \file PPPMDispersionForceCompute.h
+    \brief Declares a class computing the long-ranged part of the r^-6 dispersion on a mesh
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Compute the long-ranged part of the r^-6 dispersion with the PPPM method (LJ-PME)
+/*! The dispersion between particles i and j is approximated by the geometric combination \f$ -c_i c_j / r^6 \f$ of
+    per-type coefficients, which makes the interaction a sum over products of per-particle sources just like the
+    Coulomb interaction. It is split into a short-ranged part \f$ -c_i c_j g(\beta r)/r^6 \f$, with
+    \f$ g(x) = e^{-x^2} (1 + x^2 + x^4/2) \f$, that is computed by PotentialPairLJPME, and a long-ranged part that is
+    computed here.
+
+    The coefficients are spread onto the same mesh as the charges in PPPMForceCompute and transformed with the same
+    FFT backends and ghost cell communication. Only the Green's function of the interaction, its real space form (for
+    exclusions and rigid bodies) and the self energy differ. Unlike the Coulomb interaction, the k=0 mode contributes
+    to the energy and the pressure, and it is added analytically.
+
+    The splitting parameter \f$ \beta \f$ is stored as kappa in the base class.
+*/
+class PYBIND11_EXPORT PPPMDispersionForceCompute : public PPPMForceCompute
+    {
+    public:
+        //! Constructor
+        PPPMDispersionForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+            std::shared_ptr<NeighborList> nlist,
+            std::shared_ptr<ParticleGroup> group);
+        virtual ~PPPMDispersionForceCompute();
+
+        //! Set the dispersion coefficient of a particle type
+        void setCoefficient(unsigned int type, Scalar c);
+
+        //! Compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+        #ifdef ENABLE_MPI
+        //! Get ghost particle fields requested by this force
+        /*! \param timestep Current time step
+        */
+        virtual CommFlags getRequestedCommFlags(unsigned int timestep)
+            {
+            CommFlags flags = PPPMForceCompute::getRequestedCommFlags(timestep);
+
+            // the coefficients of the ghost particles are looked up by type
+            flags[comm_flag::charge] = 0;
+
+            return flags;
+            }
+        #endif
+
+    protected:
+        //! Get the per-particle dispersion coefficients
+        virtual const GlobalArray<Scalar>& getSources()
+            {
+            return m_sources;
+            }
+
+        //! Evaluate the Fourier transform of the long-ranged part of the dispersion
+        virtual Scalar evalGreensFunction(Scalar ksq) const;
+
+        //! Evaluate 2 d ln G(k) / d k^2 of the Green's function, which enters the virial
+        virtual Scalar evalVirialFactor(Scalar ksq) const;
+
+        //! Evaluate the long-ranged part of the dispersion in real space
+        virtual void evalRealSpace(Scalar rsq, Scalar& pair_eng, Scalar& force_divr) const;
+
+        //! Compute the self energy of the sources and the energy of the k=0 mode
+        virtual Scalar computeSelfEnergy();
+
+        //! Compute the virial, including the k=0 mode
+        virtual void computeVirial();
+
+        //! Setup coefficients
+        virtual void setupCoeffs();
+
+    private:
+        std::vector<Scalar> m_type_coeff;       //!< Dispersion coefficient per type
+        GlobalArray<Scalar> m_sources;          //!< Dispersion coefficient per local and ghost particle
+
+        //! Look up the coefficients of the local and ghost particles
+        void updateSources();
+    };
+
+//! Export the PPPMDispersionForceCompute class to python
+void export_PPPMDispersionForceCompute(pybind11::module& m);
+
+#endif // __PPPM_DISPERSION_FORCE_COMPUTE_H__
@@ -0,0 +1,372 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file PPPMFFTBackend.cc
+    \brief Defines the FFT backends used by PPPMForceCompute on the CPU
+*/
+
+#include "PPPMFFTBackend.h"
+
+#include <algorithm>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \param exec_conf The execution configuration
+    \param dim Dimensions of the real space mesh
+*/
+PPPMLocalFFT::PPPMLocalFFT(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint3 dim)
+    : m_exec_conf(exec_conf), m_dim(dim), m_nx_half(dim.x/2+1)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PPPMLocalFFT (" << dim.x << "x" << dim.y << "x" << dim.z << ")"
+        << std::endl;
+
+    m_fft_x = kiss_fft_alloc(m_dim.x, 0, NULL, NULL);
+    m_fft_y = kiss_fft_alloc(m_dim.y, 0, NULL, NULL);
+    m_fft_z = kiss_fft_alloc(m_dim.z, 0, NULL, NULL);
+    m_ifft_x = kiss_fft_alloc(m_dim.x, 1, NULL, NULL);
+    m_ifft_y = kiss_fft_alloc(m_dim.y, 1, NULL, NULL);
+    m_ifft_z = kiss_fft_alloc(m_dim.z, 1, NULL, NULL);
+
+    m_work.resize(getNumModes());
+    }
+
+PPPMLocalFFT::~PPPMLocalFFT()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PPPMLocalFFT" << std::endl;
+
+    kiss_fft_free(m_fft_x);
+    kiss_fft_free(m_fft_y);
+    kiss_fft_free(m_fft_z);
+    kiss_fft_free(m_ifft_x);
+    kiss_fft_free(m_ifft_y);
+    kiss_fft_free(m_ifft_z);
+    kiss_fft_cleanup();
+    }
+
+/*! \param idx Index of the mode in the half spectrum
+
+    Every mode with 0 < k_x < n_x/2 stands for itself and its complex conjugate at -k.
+*/
+Scalar PPPMLocalFFT::getModeWeight(unsigned int idx) const
+    {
+    if (idx == 0)
+        return Scalar(0.0);
+
+    unsigned int kx = idx % m_nx_half;
+    if (kx == 0 || (m_dim.x % 2 == 0 && kx == m_dim.x/2))
+        return Scalar(1.0);
+
+    return Scalar(2.0);
+    }
+
+/*! \param in Real space mesh (real part only) with m_dim.x*m_dim.y*m_dim.z cells
+    \param out Half spectrum with getNumModes() modes
+*/
+void PPPMLocalFFT::forward(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    const unsigned int nx = m_dim.x;
+    const unsigned int ny = m_dim.y;
+    const unsigned int nz = m_dim.z;
+    const unsigned int nxh = m_nx_half;
+
+    // transform pairs of real lines along x as one complex line, and separate their spectra
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, nz, [&](unsigned int k)
+    #else
+    for (unsigned int k = 0; k < nz; ++k)
+    #endif
+        {
+        std::vector<kiss_fft_cpx> line_in(nx);
+        std::vector<kiss_fft_cpx> line_out(nx);
+
+        for (unsigned int j = 0; j < ny; j += 2)
+            {
+            const kiss_fft_cpx *a = in + nx*(j + ny*k);
+            bool pair = (j + 1 < ny);
+
+            for (unsigned int i = 0; i < nx; ++i)
+                {
+                line_in[i].r = a[i].r;
+                line_in[i].i = pair ? a[i+nx].r : kiss_fft_scalar(0.0);
+                }
+
+            kiss_fft(m_fft_x, &line_in.front(), &line_out.front());
+
+            kiss_fft_cpx *f = out + nxh*(j + ny*k);
+            for (unsigned int i = 0; i < nxh; ++i)
+                {
+                kiss_fft_cpx z = line_out[i];
+                kiss_fft_cpx zc = line_out[(nx - i) % nx];
+
+                // the even part is the spectrum of the first line
+                f[i].r = kiss_fft_scalar(0.5)*(z.r + zc.r);
+                f[i].i = kiss_fft_scalar(0.5)*(z.i - zc.i);
+
+                // the odd part is the spectrum of the second line
+                if (pair)
+                    {
+                    f[i+nxh].r = kiss_fft_scalar(0.5)*(z.i + zc.i);
+                    f[i+nxh].i = kiss_fft_scalar(0.5)*(zc.r - z.r);
+                    }
+                }
+            }
+        }
+    #ifdef ENABLE_TBB
+        );
+    #endif
+
+    transformY(m_fft_y, out);
+    transformZ(m_fft_z, out, out);
+    }
+
+/*! \param in Half spectrum with getNumModes() modes
+    \param out Real space mesh with m_dim.x*m_dim.y*m_dim.z cells
+
+    The imaginary parts of the self-conjugate modes along x are discarded, so the result is the real part of the
+    full complex transform.
+*/
+void PPPMLocalFFT::inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    const unsigned int nx = m_dim.x;
+    const unsigned int ny = m_dim.y;
+    const unsigned int nz = m_dim.z;
+    const unsigned int nxh = m_nx_half;
+
+    kiss_fft_cpx *work = &m_work.front();
+    transformZ(m_ifft_z, in, work);
+    transformY(m_ifft_y, work);
+
+    // combine the half spectra of two lines into one complex line and transform it to two real lines
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, nz, [&](unsigned int k)
+    #else
+    for (unsigned int k = 0; k < nz; ++k)
+    #endif
+        {
+        std::vector<kiss_fft_cpx> line_in(nx);
+        std::vector<kiss_fft_cpx> line_out(nx);
+
+        kiss_fft_cpx zero;
+        zero.r = zero.i = kiss_fft_scalar(0.0);
+
+        for (unsigned int j = 0; j < ny; j += 2)
+            {
+            const kiss_fft_cpx *f = work + nxh*(j + ny*k);
+            bool pair = (j + 1 < ny);
+
+            for (unsigned int i = 0; i < nx; ++i)
+                {
+                kiss_fft_cpx a, b;
+                if (i < nxh)
+                    {
+                    a = f[i];
+                    b = pair ? f[i+nxh] : zero;
+                    if (i == 0 || 2*i == nx)
+                        {
+                        a.i = kiss_fft_scalar(0.0);
+                        b.i = kiss_fft_scalar(0.0);
+                        }
+                    }
+                else
+                    {
+                    a = f[nx-i];
+                    b = pair ? f[nx-i+nxh] : zero;
+                    a.i = -a.i;
+                    b.i = -b.i;
+                    }
+
+                line_in[i].r = a.r - b.i;
+                line_in[i].i = a.i + b.r;
+                }
+
+            kiss_fft(m_ifft_x, &line_in.front(), &line_out.front());
+
+            kiss_fft_cpx *r = out + nx*(j + ny*k);
+            for (unsigned int i = 0; i < nx; ++i)
+                {
+                r[i].r = line_out[i].r;
+                r[i].i = kiss_fft_scalar(0.0);
+                }
+
+            if (pair)
+                {
+                for (unsigned int i = 0; i < nx; ++i)
+                    {
+                    r[i+nx].r = line_out[i].i;
+                    r[i+nx].i = kiss_fft_scalar(0.0);
+                    }
+                }
+            }
+        }
+    #ifdef ENABLE_TBB
+        );
+    #endif
+    }
+
+/*! \param cfg The 1D transform along y
+    \param data Half spectrum to transform
+*/
+void PPPMLocalFFT::transformY(kiss_fft_cfg cfg, kiss_fft_cpx *data)
+    {
+    const unsigned int ny = m_dim.y;
+    const unsigned int nxh = m_nx_half;
+
+    if (ny == 1)
+        return;
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, m_dim.z, [&](unsigned int k)
+    #else
+    for (unsigned int k = 0; k < m_dim.z; ++k)
+    #endif
+        {
+        std::vector<kiss_fft_cpx> line_in(ny);
+        std::vector<kiss_fft_cpx> line_out(ny);
+
+        kiss_fft_cpx *plane = data + nxh*ny*k;
+        for (unsigned int i = 0; i < nxh; ++i)
+            {
+            for (unsigned int j = 0; j < ny; ++j)
+                line_in[j] = plane[i + nxh*j];
+
+            kiss_fft(cfg, &line_in.front(), &line_out.front());
+
+            for (unsigned int j = 0; j < ny; ++j)
+                plane[i + nxh*j] = line_out[j];
+            }
+        }
+    #ifdef ENABLE_TBB
+        );
+    #endif
+    }
+
+/*! \param cfg The 1D transform along z
+    \param in Half spectrum to transform
+    \param out Transformed half spectrum (may be equal to \a in)
+*/
+void PPPMLocalFFT::transformZ(kiss_fft_cfg cfg, const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    const unsigned int nz = m_dim.z;
+    const unsigned int stride = m_nx_half*m_dim.y;
+
+    if (nz == 1)
+        {
+        if (in != out)
+            std::copy(in, in + getNumModes(), out);
+        return;
+        }
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, m_dim.y, [&](unsigned int j)
+    #else
+    for (unsigned int j = 0; j < m_dim.y; ++j)
+    #endif
+        {
+        std::vector<kiss_fft_cpx> line_in(nz);
+        std::vector<kiss_fft_cpx> line_out(nz);
+
+        for (unsigned int i = 0; i < m_nx_half; ++i)
+            {
+            unsigned int offset = i + m_nx_half*j;
+            for (unsigned int k = 0; k < nz; ++k)
+                line_in[k] = in[offset + stride*k];
+
+            kiss_fft(cfg, &line_in.front(), &line_out.front());
+
+            for (unsigned int k = 0; k < nz; ++k)
+                out[offset + stride*k] = line_out[k];
+            }
+        }
+    #ifdef ENABLE_TBB
+        );
+    #endif
+    }
+
+#ifdef ENABLE_MPI
+/*! \param exec_conf The execution configuration
+    \param decomposition The domain decomposition
+    \param mesh_points Number of inner cells on this rank
+    \param n_ghost_cells Number of ghost cells on either side along every axis
+*/
+PPPMDistributedFFT::PPPMDistributedFFT(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+    std::shared_ptr<DomainDecomposition> decomposition,
+    uint3 mesh_points,
+    uint3 n_ghost_cells)
+    : m_exec_conf(exec_conf), m_mesh_points(mesh_points)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PPPMDistributedFFT" << std::endl;
+
+    const Index3D& decomp_idx = decomposition->getDomainIndexer();
+    m_pdim = make_uint3(decomp_idx.getW(), decomp_idx.getH(), decomp_idx.getD());
+    m_pidx = decomposition->getGridPos();
+
+    int gdim[3];
+    int pdim[3];
+    pdim[0] = m_pdim.z;
+    pdim[1] = m_pdim.y;
+    pdim[2] = m_pdim.x;
+    gdim[0] = m_mesh_points.z*pdim[0];
+    gdim[1] = m_mesh_points.y*pdim[1];
+    gdim[2] = m_mesh_points.x*pdim[2];
+    int embed[3];
+    embed[0] = m_mesh_points.z+2*n_ghost_cells.z;
+    embed[1] = m_mesh_points.y+2*n_ghost_cells.y;
+    embed[2] = m_mesh_points.x+2*n_ghost_cells.x;
+    m_ghost_offset = (n_ghost_cells.z*embed[1]+n_ghost_cells.y)*embed[2]+n_ghost_cells.x;
+    int pidx[3];
+    pidx[0] = m_pidx.z;
+    pidx[1] = m_pidx.y;
+    pidx[2] = m_pidx.x;
+    int row_m = 0; /* both local grid and proc grid are row major, no transposition necessary */
+    ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+    dfft_create_plan(&m_dfft_plan_forward, 3, gdim, embed, NULL, pdim, pidx,
+        row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
+    dfft_create_plan(&m_dfft_plan_inverse, 3, gdim, NULL, embed, pdim, pidx,
+        row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
+    }
+
+PPPMDistributedFFT::~PPPMDistributedFFT()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PPPMDistributedFFT" << std::endl;
+
+    dfft_destroy_plan(m_dfft_plan_forward);
+    dfft_destroy_plan(m_dfft_plan_inverse);
+    }
+
+/*! \param in Real space mesh including the ghost cells
+    \param out Local Fourier modes
+*/
+void PPPMDistributedFFT::forward(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    dfft_execute((cpx_t *)(in+m_ghost_offset), (cpx_t *)out, 0, m_dfft_plan_forward);
+    }
+
+/*! \param in Local Fourier modes
+    \param out Real space mesh including the ghost cells
+*/
+void PPPMDistributedFFT::inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out)
+    {
+    dfft_execute((cpx_t *)in, (cpx_t *)(out+m_ghost_offset), 1, m_dfft_plan_inverse);
+    }
+
+/*! \param idx Index of the local mode
+
+    The modes are distributed cyclically over the processor grid.
+*/
+uint3 PPPMDistributedFFT::getWaveIndex(unsigned int idx) const
+    {
+    // local layout: row major
+    unsigned int nx = m_mesh_points.x;
+    unsigned int ny = m_mesh_points.y;
+    unsigned int n_local = idx/ny/nx;
+    unsigned int m_local = (idx-n_local*ny*nx)/nx;
+    unsigned int l_local = idx % nx;
+
+    // cyclic distribution
+    return make_uint3(l_local*m_pdim.x + m_pidx.x,
+                      m_local*m_pdim.y + m_pidx.y,
+                      n_local*m_pdim.z + m_pidx.z);
+    }
+#endif // ENABLE_MPI
@@ -0,0 +1,176 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PPPM_FFT_BACKEND_H__
+#define __PPPM_FFT_BACKEND_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ExecutionConfiguration.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/DomainDecomposition.h"
+#include "hoomd/extern/dfftlib/src/dfft_host.h"
+#endif
+
+#include "hoomd/extern/kiss_fft.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file PPPMFFTBackend.h
+    \brief Declares the FFT backends used by PPPMForceCompute on the CPU
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Interface of a three-dimensional FFT of the PPPM charge mesh
+/*! The real space meshes are stored as kiss_fft_cpx in row major order (x fastest), and only their real part is
+    used. A backend stores the Fourier modes in a layout of its own choosing. It reports how many modes are local
+    to this rank, which wave vector every mode corresponds to, and how often the mode has to be counted in a sum
+    over the full spectrum.
+
+    The transforms are not normalized, i.e. a forward followed by an inverse transform multiplies the mesh by the
+    number of global mesh points.
+*/
+class PPPMFFTBackend
+    {
+    public:
+        //! Destructor
+        virtual ~PPPMFFTBackend() { }
+
+        //! Transform the real space mesh \a in to Fourier space
+        virtual void forward(const kiss_fft_cpx *in, kiss_fft_cpx *out) = 0;
+
+        //! Transform the Fourier modes \a in back to a real space mesh
+        virtual void inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out) = 0;
+
+        //! Get the number of Fourier modes stored on this rank
+        virtual unsigned int getNumModes() const = 0;
+
+        //! Get the global wave index of a locally stored mode
+        virtual uint3 getWaveIndex(unsigned int idx) const = 0;
+
+        //! Get the multiplicity of a locally stored mode in a sum over all modes
+        /*! The weight is zero for the k=0 mode, which does not contribute to the energy and the virial.
+         */
+        virtual Scalar getModeWeight(unsigned int idx) const = 0;
+    };
+
+//! Threaded real-to-complex FFT of a mesh that is local to this rank
+/*! Since the charge mesh is real, its spectrum is Hermitian, and only the modes with
+    0 <= k_x <= n_x/2 are computed and stored. The transform along x processes two real lines at a time as the real
+    and the imaginary part of one complex FFT, and the transforms along y and z only operate on the half spectrum.
+    This halves both the work and the memory traffic compared to a complex-to-complex transform.
+
+    The one-dimensional transforms along every axis are independent and are distributed over the TBB threads.
+*/
+class PPPMLocalFFT : public PPPMFFTBackend
+    {
+    public:
+        //! Constructor
+        PPPMLocalFFT(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint3 dim);
+
+        //! Destructor
+        virtual ~PPPMLocalFFT();
+
+        //! Transform the real space mesh \a in to Fourier space
+        virtual void forward(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+        //! Transform the Fourier modes \a in back to a real space mesh
+        virtual void inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+        //! Get the number of Fourier modes stored on this rank
+        virtual unsigned int getNumModes() const
+            {
+            return m_nx_half*m_dim.y*m_dim.z;
+            }
+
+        //! Get the global wave index of a locally stored mode
+        virtual uint3 getWaveIndex(unsigned int idx) const
+            {
+            return make_uint3(idx % m_nx_half, (idx / m_nx_half) % m_dim.y, idx / (m_nx_half*m_dim.y));
+            }
+
+        //! Get the multiplicity of a locally stored mode in a sum over all modes
+        virtual Scalar getModeWeight(unsigned int idx) const;
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+        uint3 m_dim;                            //!< Dimensions of the real space mesh
+        unsigned int m_nx_half;                 //!< Number of stored modes along x
+
+        kiss_fft_cfg m_fft_x;                   //!< Forward transform along x
+        kiss_fft_cfg m_fft_y;                   //!< Forward transform along y
+        kiss_fft_cfg m_fft_z;                   //!< Forward transform along z
+        kiss_fft_cfg m_ifft_x;                  //!< Inverse transform along x
+        kiss_fft_cfg m_ifft_y;                  //!< Inverse transform along y
+        kiss_fft_cfg m_ifft_z;                  //!< Inverse transform along z
+
+        std::vector<kiss_fft_cpx> m_work;       //!< Half spectrum of the inverse transform
+
+        //! Transform all lines along y of the half spectrum in place
+        void transformY(kiss_fft_cfg cfg, kiss_fft_cpx *data);
+
+        //! Transform all lines along z of the half spectrum from \a in to \a out
+        void transformZ(kiss_fft_cfg cfg, const kiss_fft_cpx *in, kiss_fft_cpx *out);
+    };
+
+#ifdef ENABLE_MPI
+//! Distributed complex-to-complex FFT using dfftlib
+/*! The inner cells of the local meshes are transformed with a distributed FFT over the processor grid of the
+    domain decomposition. The Fourier modes are distributed cyclically over the ranks.
+*/
+class PPPMDistributedFFT : public PPPMFFTBackend
+    {
+    public:
+        //! Constructor
+        PPPMDistributedFFT(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+            std::shared_ptr<DomainDecomposition> decomposition,
+            uint3 mesh_points,
+            uint3 n_ghost_cells);
+
+        //! Destructor
+        virtual ~PPPMDistributedFFT();
+
+        //! Transform the real space mesh \a in to Fourier space
+        virtual void forward(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+        //! Transform the Fourier modes \a in back to a real space mesh
+        virtual void inverse(const kiss_fft_cpx *in, kiss_fft_cpx *out);
+
+        //! Get the number of Fourier modes stored on this rank
+        virtual unsigned int getNumModes() const
+            {
+            return m_mesh_points.x*m_mesh_points.y*m_mesh_points.z;
+            }
+
+        //! Get the global wave index of a locally stored mode
+        virtual uint3 getWaveIndex(unsigned int idx) const;
+
+        //! Get the multiplicity of a locally stored mode in a sum over all modes
+        virtual Scalar getModeWeight(unsigned int idx) const
+            {
+            return (idx == 0 && !m_pidx.x && !m_pidx.y && !m_pidx.z) ? Scalar(0.0) : Scalar(1.0);
+            }
+
+        //! Get the offset of the first inner cell in the real space meshes
+        unsigned int getGhostOffset() const
+            {
+            return m_ghost_offset;
+            }
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+        uint3 m_mesh_points;                    //!< Number of inner cells on this rank
+        uint3 m_pdim;                           //!< Dimensions of the processor grid
+        uint3 m_pidx;                           //!< Position of this rank in the processor grid
+        unsigned int m_ghost_offset;            //!< Offset of the first inner cell in the real space meshes
+
+        dfft_plan m_dfft_plan_forward;          //!< Distributed FFT for forward transform
+        dfft_plan m_dfft_plan_inverse;          //!< Distributed FFT for inverse transform
+    };
+#endif // ENABLE_MPI
+
+#endif // __PPPM_FFT_BACKEND_H__
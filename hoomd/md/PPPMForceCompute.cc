@@ -4,6 +4,10 @@
 #include "PPPMForceCompute.h"
 #include <map>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 namespace py = pybind11;
 
 bool is_pow2(unsigned int n)
@@ -37,15 +41,14 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_n_cells(0),
       m_radius(1),
       m_n_inner_cells(0),
+      m_n_fourier_cells(0),
       m_need_initialize(true),
       m_params_set(false),
       m_box_changed(false),
       m_q(0.0),
       m_q2(0.0),
       m_body_energy(0.0),
-      m_ptls_added_removed(false),
-      m_kiss_fft_initialized(false),
-      m_dfft_initialized(false)
+      m_ptls_added_removed(false)
     {
 
     m_pdata->getBoxChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
@@ -63,6 +66,8 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
     m_alpha = Scalar(0.0);
 
     m_pdata->getGlobalParticleNumberChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
+
+    m_mixed_precision_supported = true;
     }
 
 void PPPMForceCompute::setParams(unsigned int nx, unsigned int ny, unsigned int nz,
@@ -91,6 +96,12 @@ void PPPMForceCompute::setParams(unsigned int nx, unsigned int ny, unsigned int
         {
         const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
 
+        if (m_pdata->getDomainDecomposition()->isStaggered())
+            {
+            m_exec_conf->msg->error() << "charge.pppm: staggered domain decompositions are not supported" << std::endl;
+            throw std::runtime_error("Error initializing charge.pppm");
+            }
+
         if (!is_pow2(m_mesh_points.x) || !is_pow2(m_mesh_points.y) || !is_pow2(m_mesh_points.z))
             {
             m_exec_conf->msg->error()
@@ -137,6 +148,9 @@ void PPPMForceCompute::setParams(unsigned int nx, unsigned int ny, unsigned int
     GlobalArray<Scalar> n_rho_coeff(order*(2*order+1), m_exec_conf);
     m_rho_coeff.swap(n_rho_coeff);
 
+    // the body self energies depend on kappa and alpha
+    m_body_type_energy.clear();
+
     m_need_initialize = true;
     m_params_set = true;
     }
@@ -145,19 +159,6 @@ PPPMForceCompute::~PPPMForceCompute()
     {
     m_pdata->getGlobalParticleNumberChangeSignal().disconnect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
 
-    if (m_kiss_fft_initialized)
-        {
-        free(m_kiss_fft);
-        free(m_kiss_ifft);
-        kiss_fft_cleanup();
-        }
-    #ifdef ENABLE_MPI
-    if (m_dfft_initialized)
-        {
-        dfft_destroy_plan(m_dfft_plan_forward);
-        dfft_destroy_plan(m_dfft_plan_inverse);
-        }
-    #endif
     m_pdata->getBoxChangeSignal().disconnect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
     }
 
@@ -287,9 +288,9 @@ Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms)
     return value;
     }
 
-void PPPMForceCompute::setupCoeffs()
+void PPPMForceCompute::computeSourceSums()
     {
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getSources(), access_location::host, access_mode::read);
 
     // get system charge
     m_q = Scalar(0.0);
@@ -322,6 +323,11 @@ void PPPMForceCompute::setupCoeffs()
                       m_exec_conf->getMPICommunicator());
         }
     #endif
+    }
+
+void PPPMForceCompute::setupCoeffs()
+    {
+    computeSourceSums();
 
     if (fabs(m_q) > 1e-5 && m_alpha==Scalar(0.0))
         {
@@ -380,17 +386,20 @@ void PPPMForceCompute::setupMesh()
     m_n_cells = m_grid_dim.x*m_grid_dim.y*m_grid_dim.z;
     m_n_inner_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
 
+    // the FFT backend may store fewer modes than there are inner cells
+    m_n_fourier_cells = m_n_inner_cells;
+
+    initializeFFT();
+
     // allocate memory for influence function and k values
-    GlobalArray<Scalar> inf_f(m_n_inner_cells, m_exec_conf);
+    GlobalArray<Scalar> inf_f(m_n_fourier_cells, m_exec_conf);
     m_inf_f.swap(inf_f);
 
-    GlobalArray<Scalar3> k(m_n_inner_cells, m_exec_conf);
+    GlobalArray<Scalar3> k(m_n_fourier_cells, m_exec_conf);
     m_k.swap(k);
 
-    GlobalArray<Scalar> virial_mesh(6*m_n_inner_cells, m_exec_conf);
+    GlobalArray<Scalar> virial_mesh(6*m_n_fourier_cells, m_exec_conf);
     m_virial_mesh.swap(virial_mesh);
-
-    initializeFFT();
     }
 
 uint3 PPPMForceCompute::computeGhostCellNum()
@@ -427,12 +436,11 @@ uint3 PPPMForceCompute::computeGhostCellNum()
 
 void PPPMForceCompute::initializeFFT()
     {
-    bool local_fft = true;
+    // release the previous plans before allocating new ones
+    m_fft.reset();
 
     #ifdef ENABLE_MPI
-    local_fft = !m_pdata->getDomainDecomposition();
-
-    if (! local_fft)
+    if (m_pdata->getDomainDecomposition())
         {
         // ghost cell communicator for charge interpolation
         m_grid_comm_forward = std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> >(
@@ -449,65 +457,37 @@ void PPPMForceCompute::initializeFFT()
                m_n_ghost_cells,
                false));
         // set up distributed FFTs
-        int gdim[3];
-        int pdim[3];
-        Index3D decomp_idx = m_pdata->getDomainDecomposition()->getDomainIndexer();
-        pdim[0] = decomp_idx.getD();
-        pdim[1] = decomp_idx.getH();
-        pdim[2] = decomp_idx.getW();
-        gdim[0] = m_mesh_points.z*pdim[0];
-        gdim[1] = m_mesh_points.y*pdim[1];
-        gdim[2] = m_mesh_points.x*pdim[2];
-        int embed[3];
-        embed[0] = m_mesh_points.z+2*m_n_ghost_cells.z;
-        embed[1] = m_mesh_points.y+2*m_n_ghost_cells.y;
-        embed[2] = m_mesh_points.x+2*m_n_ghost_cells.x;
-        m_ghost_offset = (m_n_ghost_cells.z*embed[1]+m_n_ghost_cells.y)*embed[2]+m_n_ghost_cells.x;
-        uint3 pcoord = m_pdata->getDomainDecomposition()->getGridPos();
-        int pidx[3];
-        pidx[0] = pcoord.z;
-        pidx[1] = pcoord.y;
-        pidx[2] = pcoord.x;
-        int row_m = 0; /* both local grid and proc grid are row major, no transposition necessary */
-        ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
-            access_location::host, access_mode::read);
-        dfft_create_plan(&m_dfft_plan_forward, 3, gdim, embed, NULL, pdim, pidx,
-            row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
-        dfft_create_plan(&m_dfft_plan_inverse, 3, gdim, NULL, embed, pdim, pidx,
-            row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
-        m_dfft_initialized = true;
+        std::unique_ptr<PPPMDistributedFFT> dfft(new PPPMDistributedFFT(m_exec_conf,
+            m_pdata->getDomainDecomposition(), m_mesh_points, m_n_ghost_cells));
+        m_ghost_offset = dfft->getGhostOffset();
+        m_fft = std::move(dfft);
         }
     #endif // ENABLE_MPI
 
-    if (local_fft)
+    if (! m_fft)
         {
-        int dims[3];
-        dims[0] = m_mesh_points.z;
-        dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
-
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
-
-        m_kiss_fft_initialized = true;
+        // threaded real-to-complex transform of the local mesh
+        m_fft = std::unique_ptr<PPPMFFTBackend>(new PPPMLocalFFT(m_exec_conf, m_mesh_points));
         }
 
+    m_n_fourier_cells = m_fft->getNumModes();
+
     // allocate mesh and transformed mesh
 
     // pad with offset
     GlobalArray<kiss_fft_cpx> mesh(m_n_cells + m_ghost_offset,m_exec_conf);
     m_mesh.swap(mesh);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh.swap(fourier_mesh);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_x.swap(fourier_mesh_G_x);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_y.swap(fourier_mesh_G_y);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_z.swap(fourier_mesh_G_z);
 
     // pad with offset
@@ -567,19 +547,6 @@ void PPPMForceCompute::computeInfluenceFunction()
     Scalar3 b2 = Scalar(2.0*M_PI)*make_scalar3(a3.y*a1.z-a3.z*a1.y, a3.z*a1.x-a3.x*a1.z, a3.x*a1.y-a3.y*a1.x)/V_box;
     Scalar3 b3 = Scalar(2.0*M_PI)*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x)/V_box;
 
-    #ifdef ENABLE_MPI
-    bool local_fft = m_kiss_fft_initialized;
-
-    uint3 pdim=make_uint3(0,0,0);
-    uint3 pidx=make_uint3(0,0,0);
-    if (m_pdata->getDomainDecomposition())
-        {
-        const Index3D &didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
-        pidx = m_pdata->getDomainDecomposition()->getGridPos();
-        pdim = make_uint3(didx.getW(), didx.getH(), didx.getD());
-        }
-    #endif
-
     Scalar3 kH = Scalar(2.0*M_PI)*make_scalar3(Scalar(1.0)/(Scalar)m_global_dim.x,
                                                Scalar(1.0)/(Scalar)m_global_dim.y,
                                                Scalar(1.0)/(Scalar)m_global_dim.z);
@@ -598,31 +565,10 @@ void PPPMForceCompute::computeInfluenceFunction()
                    pow(-log(EPS_HOC),0.25)));
     int nbz = (int)temp;
 
-    for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+    for (unsigned int cell_idx = 0; cell_idx < m_n_fourier_cells; ++cell_idx)
         {
-        uint3 wave_idx;
-        #ifdef ENABLE_MPI
-        if (! local_fft)
-           {
-           // local layout: row major
-           int ny = m_mesh_points.y;
-           int nx = m_mesh_points.x;
-           int n_local = cell_idx/ny/nx;
-           int m_local = (cell_idx-n_local*ny*nx)/nx;
-           int l_local = cell_idx % nx;
-           // cyclic distribution
-           wave_idx.x = l_local*pdim.x + pidx.x;
-           wave_idx.y = m_local*pdim.y + pidx.y;
-           wave_idx.z = n_local*pdim.z + pidx.z;
-           }
-        else
-        #endif
-            {
-            // kiss FFT expects data in row major format
-            wave_idx.z = cell_idx / (m_mesh_points.y * m_mesh_points.x);
-            wave_idx.y = (cell_idx - wave_idx.z * m_mesh_points.x * m_mesh_points.y)/ m_mesh_points.x;
-            wave_idx.x = cell_idx % m_mesh_points.x;
-            }
+        // the layout of the modes is defined by the FFT backend
+        uint3 wave_idx = m_fft->getWaveIndex(cell_idx);
 
         int3 n = make_int3(wave_idx.x,wave_idx.y,wave_idx.z);
 
@@ -643,7 +589,7 @@ void PPPMForceCompute::computeInfluenceFunction()
         if (n.x != 0 || n.y != 0 || n.z != 0)
             {
             Scalar sum1(0.0);
-            Scalar numerator = Scalar(4.0*M_PI)/dot(k,k);
+            Scalar numerator = Scalar(1.0)/dot(k,k);
 
             Scalar denominator = gf_denom(snx*snx, sny*sny, snz*snz);
 
@@ -688,12 +634,8 @@ void PPPMForceCompute::computeInfluenceFunction()
 
                         Scalar3 kn = knx + kny + knz;
                         Scalar dot1 = dot(kn, k);
-                        Scalar dot2 = dot(kn, kn)+m_alpha*m_alpha;
-
-                        Scalar arg_gauss = Scalar(0.25)*dot2/m_kappa/m_kappa;
-                        Scalar gauss = exp(-arg_gauss);
 
-                        sum1 += (dot1/dot2) * gauss * wx * wx * wy * wy * wz * wz;
+                        sum1 += dot1 * evalGreensFunction(dot(kn, kn)) * wx * wx * wy * wy * wz * wz;
                         }
                     }
                 }
@@ -710,177 +652,234 @@ void PPPMForceCompute::computeInfluenceFunction()
     if (m_prof) m_prof->pop();
     }
 
-//! Assignment of particles to mesh using variable order interpolation scheme
-void PPPMForceCompute::assignParticles()
+/*! \param h_postype Particle positions
+    \param idx Index of the particle
+    \param box The local box
+    \returns The position of the particle, rounded to single precision relative to the box origin in mixed precision
+*/
+Scalar3 PPPMForceCompute::getMeshPosition(const Scalar4 *h_postype, unsigned int idx, const BoxDim& box) const
     {
-    if (m_prof) m_prof->push("assign");
+    if (m_mixed_precision)
+        {
+        const float4& p = m_pos_mixed[idx];
+        return box.getLo() + make_scalar3(p.x, p.y, p.z);
+        }
 
-    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    return make_scalar3(h_postype[idx].x, h_postype[idx].y, h_postype[idx].z);
+    }
 
-    ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff,access_location::host, access_mode::read);
+/*! \param box The local box
+    \param pos Position of the particle
+    \param cell Cell of the mesh (including the ghost layer) the stencil is centered on (output)
+    \param d Distance of the particle to the center of the stencil in units of the mesh size (output)
+    \returns false if the particle should be ignored
+*/
+bool PPPMForceCompute::getStencilCell(const BoxDim& box, const Scalar3& pos, int3& cell, Scalar3& d) const
+    {
+    // ignore if NaN
+    if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+        {
+        return false;
+        }
 
-    const BoxDim& box = m_pdata->getBox();
+    // compute coordinates in units of the mesh size
+    Scalar3 f = box.makeFraction(pos);
+    Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
+                                       f.y * (Scalar) m_mesh_points.y,
+                                       f.z * (Scalar) m_mesh_points.z);
 
-    // set mesh to zero
-    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx)*m_mesh.getNumElements());
+    reduced_pos.x += (Scalar) m_n_ghost_cells.x;
+    reduced_pos.y += (Scalar) m_n_ghost_cells.y;
+    reduced_pos.z += (Scalar) m_n_ghost_cells.z;
 
-    Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
+    Scalar shift, shiftone;
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    if (m_order % 2)
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
-
-        Scalar4 postype = h_postype.data[idx];
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
-            {
-            continue;
-            }
-
-        Scalar qi = h_charge.data[idx];
+        shift =0.5;
+        shiftone = 0.0;
+        }
+    else
+        {
+        shift = 0.0;
+        shiftone = 0.5;
+        }
 
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
-                                           f.y * (Scalar) m_mesh_points.y,
-                                           f.z * (Scalar) m_mesh_points.z);
+    // find cell of the mesh the particle is in
+    int ix = (reduced_pos.x + shift);
+    int iy = (reduced_pos.y + shift);
+    int iz = (reduced_pos.z + shift);
+
+    d.x = shiftone+(Scalar)ix-reduced_pos.x;
+    d.y = shiftone+(Scalar)iy-reduced_pos.y;
+    d.z = shiftone+(Scalar)iz-reduced_pos.z;
+
+    // handle particles on the boundary
+    if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
+        ix = 0;
+    if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
+        iy = 0;
+    if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
+        iz = 0;
+
+    if (ix < 0 || ix >= (int)m_grid_dim.x ||
+        iy < 0 || iy >= (int)m_grid_dim.y ||
+        iz < 0 || iz >= (int)m_grid_dim.z)
+        {
+        // ignore, error will be thrown elsewhere (in CellList)
+        return false;
+        }
 
-        reduced_pos.x += (Scalar) m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar) m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar) m_n_ghost_cells.z;
+    cell = make_int3(ix, iy, iz);
+    return true;
+    }
 
-        Scalar shift, shiftone;
+//! Evaluate the assignment function along one axis and wrap the cell indices
+static inline void compute_stencil_axis(int order, const Scalar *rho_coeff, Scalar d, int cell, int dim,
+    bool wrap, Scalar *W, unsigned int *idx)
+    {
+    int mult_fact = 2*order+1;
+    int nlower = -(order-1)/2;
 
-        if (m_order % 2)
+    for (int i = 0; i < order; ++i)
+        {
+        Scalar w(0.0);
+        for (int iorder = order-1; iorder >= 0; iorder--)
             {
-            shift =0.5;
-            shiftone = 0.0;
+            w = rho_coeff[i + iorder*mult_fact] + w * d;
             }
-        else
+        W[i] = w;
+
+        int neigh = cell + nlower + i;
+        if (wrap)
             {
-            shift = 0.0;
-            shiftone = 0.5;
+            if (neigh >= dim)
+                neigh -= dim;
+            else if (neigh < 0)
+                neigh += dim;
             }
+        idx[i] = neigh;
+        }
+    }
 
-        // find cell of the mesh the particle is in
-        int ix = (reduced_pos.x + shift);
-        int iy = (reduced_pos.y + shift);
-        int iz = (reduced_pos.z + shift);
-
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
+/*! \param cell Cell returned by getStencilCell()
+    \param d Distance returned by getStencilCell()
+    \param rho_coeff Coefficients of the assignment function
+    \param stencil The weights and cells along every axis (output)
 
+    The weights are evaluated once per axis, so spreading and interpolation only need one multiplication per
+    stencil point.
+*/
+void PPPMForceCompute::computeStencil(const int3& cell, const Scalar3& d, const Scalar *rho_coeff,
+    PPPMStencil& stencil) const
+    {
+    compute_stencil_axis(m_order, rho_coeff, d.x, cell.x, m_grid_dim.x, !m_n_ghost_cells.x, stencil.Wx, stencil.ix);
+    compute_stencil_axis(m_order, rho_coeff, d.y, cell.y, m_grid_dim.y, !m_n_ghost_cells.y, stencil.Wy, stencil.iy);
+    compute_stencil_axis(m_order, rho_coeff, d.z, cell.z, m_grid_dim.z, !m_n_ghost_cells.z, stencil.Wz, stencil.iz);
+    }
 
-        // handle particles on the boundary
-        if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
+//! Assignment of particles to mesh using variable order interpolation scheme
+/*! With TBB, the particles are binned into slabs along z that are at least as wide as the assignment stencil.
+    Particles in every other slab never write to the same mesh cells, so the even and the odd slabs are each spread
+    concurrently. The slabs inherit the memory order of the particles, which the SFCPackUpdater keeps spatially
+    coherent.
+*/
+void PPPMForceCompute::assignParticles()
+    {
+    if (m_prof) m_prof->push("assign");
 
-        if (ix < 0 || ix >= (int)m_grid_dim.x ||
-            iy < 0 || iy >= (int)m_grid_dim.y ||
-            iz < 0 || iz >= (int)m_grid_dim.z)
-            {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_charge(getSources(), access_location::host, access_mode::read);
 
-        int mult_fact = 2*m_order+1;
-        Scalar Wx, Wy, Wz;
+    ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff,access_location::host, access_mode::read);
 
-        int nlower = -(m_order-1)/2;
-        int nupper = m_order/2;
+    const BoxDim& box = m_pdata->getBox();
 
-        for (int i = nlower; i <= nupper ; ++i)
-            {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order-1; iorder >= 0; iorder--)
-                {
-                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
-                }
+    // set mesh to zero
+    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx)*m_mesh.getNumElements());
 
-            int neighi = (int)ix + i;
+    Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
 
-            if (! m_n_ghost_cells.x)
-                {
-                if (neighi >= (int)m_grid_dim.x)
-                    neighi -= m_grid_dim.x;
-                else if (neighi < 0)
-                    neighi += m_grid_dim.x;
-                }
+    // spread the charge of one particle
+    auto spread = [&](unsigned int idx, const int3& cell, const Scalar3& d)
+        {
+        PPPMStencil stencil;
+        computeStencil(cell, d, h_rho_coeff.data, stencil);
 
+        Scalar qi = h_charge.data[idx]/V_cell;
 
-            for (int j = nlower; j <= nupper; ++j)
+        for (int k = 0; k < m_order; ++k)
+            {
+            for (int j = 0; j < m_order; ++j)
                 {
-                Wy = Scalar(0.0);
-                for (int iorder = m_order-1; iorder >= 0; iorder--)
+                // store in row major order
+                kiss_fft_cpx *row = h_mesh.data + m_grid_dim.x * (stencil.iy[j] + m_grid_dim.y*stencil.iz[k]);
+                Scalar qW = qi*stencil.Wy[j]*stencil.Wz[k];
+
+                for (int i = 0; i < m_order; ++i)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
+                    row[stencil.ix[i]].r += qW*stencil.Wx[i];
                     }
+                }
+            }
+        };
 
-                int neighj = (int)iy + j;
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+    unsigned int group_size = m_group->getNumMembers();
 
-                if (! m_n_ghost_cells.y)
-                    {
-                    if (neighj >= (int)m_grid_dim.y)
-                        neighj -= m_grid_dim.y;
-                    else if (neighj < 0)
-                        neighj += m_grid_dim.y;
-                    }
+    #ifdef ENABLE_TBB
+    // slabs of at least m_order cells, and an even number of them if the first and last slab are periodic images
+    unsigned int n_slabs = m_grid_dim.z / m_order;
+    if (! m_n_ghost_cells.z && n_slabs % 2)
+        n_slabs--;
+    if (n_slabs < 2)
+        n_slabs = 1;
 
-                for (int k = nlower; k <= nupper; ++k)
-                    {
-                    Wz = Scalar(0.0);
-                    for (int iorder = m_order-1; iorder >= 0; iorder--)
-                        {
-                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
-                        }
+    std::vector< std::vector<unsigned int> > slab_members(n_slabs);
+    std::vector<int3> cells(group_size);
+    std::vector<Scalar3> dists(group_size);
 
-                    int neighk = (int)iz + k;
-                    if (! m_n_ghost_cells.z)
-                        {
-                        if (neighk >= (int)m_grid_dim.z)
-                            neighk -= m_grid_dim.z;
-                        else if (neighk < 0)
-                            neighk += m_grid_dim.z;
-                        }
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = h_index.data[group_idx];
+        Scalar3 pos = getMeshPosition(h_postype.data, idx, box);
 
-                    Scalar W = Wx*Wy*Wz;
+        if (! getStencilCell(box, pos, cells[group_idx], dists[group_idx]))
+            continue;
 
-                    // store in row major order
-                    unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
+        unsigned int slab = (unsigned int)cells[group_idx].z * n_slabs / m_grid_dim.z;
+        slab_members[slab].push_back(group_idx);
+        }
 
-                    h_mesh.data[neigh_idx].r += qi*W/V_cell;
-                    }
+    for (unsigned int color = 0; color < 2; ++color)
+        {
+        tbb::parallel_for(color, n_slabs, (unsigned int) 2, [&](unsigned int slab)
+            {
+            for (unsigned int group_idx : slab_members[slab])
+                {
+                spread(h_index.data[group_idx], cells[group_idx], dists[group_idx]);
                 }
-            }
+            });
+        }
+    #else
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = h_index.data[group_idx];
+        Scalar3 pos = getMeshPosition(h_postype.data, idx, box);
+
+        int3 cell;
+        Scalar3 d;
+        if (getStencilCell(box, pos, cell, d))
+            spread(idx, cell, d);
         } // end loop over particles
+    #endif
 
     if (m_prof) m_prof->pop();
     }
 
 void PPPMForceCompute::updateMeshes()
     {
-    if (m_kiss_fft_initialized)
-        {
-        if (m_prof) m_prof->push("FFT");
-        // transform the particle mesh locally (forward transform)
-        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
-
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
-        if (m_prof) m_prof->pop();
-        }
-
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -889,18 +888,20 @@ void PPPMForceCompute::updateMeshes()
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
         m_grid_comm_forward->communicate(m_mesh);
         if (m_prof) m_prof->pop();
+        }
+    #endif
 
-        // perform a distributed FFT
-        m_exec_conf->msg->notice(8) << "charge.pppm: Distributed FFT mesh" << std::endl;
+        {
+        // forward transform of the particle mesh
+        m_exec_conf->msg->notice(8) << "charge.pppm: FFT mesh" << std::endl;
 
         if (m_prof) m_prof->push("FFT");
         ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
 
-        dfft_execute((cpx_t *)(h_mesh.data+m_ghost_offset), (cpx_t *)h_fourier_mesh.data, 0,m_dfft_plan_forward);
+        m_fft->forward(h_mesh.data, h_fourier_mesh.data);
         if (m_prof) m_prof->pop();
         }
-    #endif
 
     if (m_prof) m_prof->push("update");
 
@@ -915,7 +916,7 @@ void PPPMForceCompute::updateMeshes()
         unsigned int NNN = m_global_dim.x*m_global_dim.y*m_global_dim.z;
 
         // multiply with influence function and I*k
-        for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+        for (unsigned int k = 0; k < m_n_fourier_cells; ++k)
             {
             kiss_fft_cpx f = h_fourier_mesh.data[k];
 
@@ -936,28 +937,10 @@ void PPPMForceCompute::updateMeshes()
 
     if (m_prof) m_prof->pop();
 
-    if (m_kiss_fft_initialized)
         {
         if (m_prof) m_prof->push("FFT");
-        // do a local inverse transform of the force mesh
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
-        if (m_prof) m_prof->pop();
-        }
-
-    #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        if (m_prof) m_prof->push("FFT");
-        // Distributed inverse transform force on mesh points
-        m_exec_conf->msg->notice(8) << "charge.pppm: Distributed iFFT" << std::endl;
+        // inverse transform of the force mesh
+        m_exec_conf->msg->notice(8) << "charge.pppm: iFFT" << std::endl;
 
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::read);
@@ -966,12 +949,11 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
 
-        dfft_execute((cpx_t *)h_fourier_mesh_G_x.data, (cpx_t *)(h_inv_fourier_mesh_x.data+m_ghost_offset), 1,m_dfft_plan_inverse);
-        dfft_execute((cpx_t *)h_fourier_mesh_G_y.data, (cpx_t *)(h_inv_fourier_mesh_y.data+m_ghost_offset), 1,m_dfft_plan_inverse);
-        dfft_execute((cpx_t *)h_fourier_mesh_G_z.data, (cpx_t *)(h_inv_fourier_mesh_z.data+m_ghost_offset), 1,m_dfft_plan_inverse);
+        m_fft->inverse(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
+        m_fft->inverse(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+        m_fft->inverse(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
         if (m_prof) m_prof->pop();
         }
-    #endif
 
     // potential optimization: combine vector components into Scalar3
 
@@ -995,7 +977,7 @@ void PPPMForceCompute::interpolateForces()
 
     // access particle data
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getSources(), access_location::host, access_mode::read);
 
     // access inverse Fourier transform mesh
     ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::read);
@@ -1012,150 +994,55 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
+    // loop over group, every particle only writes its own force
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
     unsigned int group_size = m_group->getNumMembers();
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, group_size, [&](unsigned int group_idx)
+    #else
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    #endif
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
-        Scalar4 postype = h_postype.data[idx];
-
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
-            {
-            continue;
-            }
-
-        Scalar qi = h_charge.data[idx];
-
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
-                                           f.y * (Scalar) m_mesh_points.y,
-                                           f.z * (Scalar) m_mesh_points.z);
-        reduced_pos.x += (Scalar) m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar) m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar) m_n_ghost_cells.z;
-
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift =0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
-
-        // find cell of the force mesh the particle is in
-        int ix = (reduced_pos.x + shift);
-        int iy = (reduced_pos.y + shift);
-        int iz = (reduced_pos.z + shift);
-
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
+        unsigned int idx = h_index.data[group_idx];
+        Scalar3 pos = getMeshPosition(h_postype.data, idx, box);
 
-        // handle particles on the boundary
-        if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
-
-        if (ix < 0 || ix >= (int)m_grid_dim.x ||
-            iy < 0 || iy >= (int)m_grid_dim.y ||
-            iz < 0 || iz >= (int)m_grid_dim.z)
+        int3 cell;
+        Scalar3 d;
+        if (getStencilCell(box, pos, cell, d))
             {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
-
-        Scalar3 force = make_scalar3(0.0,0.0,0.0);
+            PPPMStencil stencil;
+            computeStencil(cell, d, h_rho_coeff.data, stencil);
 
-        int mult_fact = 2*m_order+1;
-        Scalar Wx, Wy, Wz;
+            Scalar qi = h_charge.data[idx];
+            Scalar3 force = make_scalar3(0.0,0.0,0.0);
 
-        int nlower = -(m_order-1)/2;
-        int nupper = m_order/2;
-
-        for (int i = nlower; i <= nupper ; ++i)
-            {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order-1; iorder >= 0; iorder--)
-                {
-                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
-                }
-
-            int neighi = (int)ix + i;
-
-            if (! m_n_ghost_cells.x)
-                {
-                if (neighi >= (int)m_grid_dim.x)
-                    neighi -= m_grid_dim.x;
-                else if (neighi < 0)
-                    neighi += m_grid_dim.x;
-                }
-
-
-            for (int j = nlower; j <= nupper; ++j)
+            for (int k = 0; k < m_order; ++k)
                 {
-                Wy = Scalar(0.0);
-                for (int iorder = m_order-1; iorder >= 0; iorder--)
+                for (int j = 0; j < m_order; ++j)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
-                    }
-
-                int neighj = (int)iy + j;
+                    unsigned int row = m_grid_dim.x * (stencil.iy[j] + m_grid_dim.y*stencil.iz[k]);
+                    Scalar Wyz = stencil.Wy[j]*stencil.Wz[k];
 
-                if (! m_n_ghost_cells.y)
-                    {
-                    if (neighj >= (int)m_grid_dim.y)
-                        neighj -= m_grid_dim.y;
-                    else if (neighj < 0)
-                        neighj += m_grid_dim.y;
-                    }
-
-
-                for (int k = nlower; k <= nupper; ++k)
-                    {
-                    Wz = Scalar(0.0);
-                    for (int iorder = m_order-1; iorder >= 0; iorder--)
+                    Scalar3 row_force = make_scalar3(0.0,0.0,0.0);
+                    for (int i = 0; i < m_order; ++i)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
+                        unsigned int neigh_idx = row + stencil.ix[i];
+                        Scalar Wx = stencil.Wx[i];
+                        row_force.x += Wx*h_inv_fourier_mesh_x.data[neigh_idx].r;
+                        row_force.y += Wx*h_inv_fourier_mesh_y.data[neigh_idx].r;
+                        row_force.z += Wx*h_inv_fourier_mesh_z.data[neigh_idx].r;
                         }
 
-                    int neighk = (int)iz + k;
-                    if (! m_n_ghost_cells.z)
-                        {
-                        if (neighk >= (int)m_grid_dim.z)
-                            neighk -= m_grid_dim.z;
-                        else if (neighk < 0)
-                            neighk += m_grid_dim.z;
-                        }
-
-                    unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
-
-                    kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
-                    kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
-                    kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
-
-                    Scalar W = Wx * Wy * Wz;
-                    force.x += qi*W*E_x.r;
-                    force.y += qi*W*E_y.r;
-                    force.z += qi*W*E_z.r;
+                    force += Wyz*row_force;
                     }
                 }
-            }
 
-        h_force.data[idx] = make_scalar4(force.x,force.y,force.z,0.0);
+            h_force.data[idx] = make_scalar4(qi*force.x,qi*force.y,qi*force.z,0.0);
+            }
         }  // end of loop over particles
+    #ifdef ENABLE_TBB
+        );
+    #endif
 
     if (m_prof) m_prof->pop();
     }
@@ -1169,25 +1056,14 @@ Scalar PPPMForceCompute::computePE()
 
     Scalar sum(0.0);
 
-    bool exclude_dc = true;
-    #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
+    // the weight excludes the DC bin and counts the modes omitted by a real-to-complex transform
+    for (unsigned int k = 0; k < m_n_fourier_cells; ++k)
         {
-        uint3 my_pos = m_pdata->getDomainDecomposition()->getGridPos();
-        exclude_dc = !my_pos.x && !my_pos.y && !my_pos.z;
-        }
-    #endif
-
-    for (unsigned int k = 0; k < m_n_inner_cells; ++k)
-        {
-        bool exclude = false;
-        if (exclude_dc)
-            // exclude DC bin
-            exclude = (k == 0);
+        Scalar weight = m_fft->getModeWeight(k);
 
-        if (! exclude)
+        if (weight != Scalar(0.0))
             {
-            sum += (h_fourier_mesh.data[k].r * h_fourier_mesh.data[k].r
+            sum += weight*(h_fourier_mesh.data[k].r * h_fourier_mesh.data[k].r
                 + h_fourier_mesh.data[k].i * h_fourier_mesh.data[k].i)*h_inf_f.data[k];
             }
         }
@@ -1200,12 +1076,7 @@ Scalar PPPMForceCompute::computePE()
 
     if (m_exec_conf->getRank()==0)
         {
-        // subtract self-energy on rank 0 (see Frenkel and Smit, and Salin and Caillol)
-        sum -= m_q2 * (m_kappa/sqrt(Scalar(M_PI))*exp(-m_alpha*m_alpha/(Scalar(4.0)*m_kappa*m_kappa))
-            - Scalar(0.5)*m_alpha*erfc(m_alpha/(Scalar(2.0)*m_kappa)));
-
-        // k = 0 term already accounted for by exclude_dc
-        //sum -= Scalar(0.5*M_PI)*m_q*m_q / (m_kappa*m_kappa* V);
+        sum += computeSelfEnergy();
         }
 
     // apply rigid body correction
@@ -1259,7 +1130,7 @@ void PPPMForceCompute::computeForces(unsigned int timestep)
 
         if (m_nlist->getFilterBody())
             {
-            m_exec_conf->msg->notice(2) << "PPPM: calculating rigid body correction (N^2)" << std::endl;
+            m_exec_conf->msg->notice(2) << "PPPM: calculating rigid body correction" << std::endl;
             computeBodyCorrection();
             }
 
@@ -1283,6 +1154,10 @@ void PPPMForceCompute::computeForces(unsigned int timestep)
         m_box_changed = false;
         }
 
+    // read the positions in single precision relative to the box origin if requested
+    if (m_mixed_precision)
+        updateMixedPositions();
+
     assignParticles();
 
     updateMeshes();
@@ -1328,23 +1203,12 @@ void PPPMForceCompute::computeVirial()
     for (unsigned int i = 0; i < 6; ++i)
         virial[i] = Scalar(0.0);
 
-    bool exclude_dc = true;
-    #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        uint3 my_pos = m_pdata->getDomainDecomposition()->getGridPos();
-        exclude_dc = !my_pos.x && !my_pos.y && !my_pos.z;
-        }
-    #endif
-
-    for (unsigned int kidx = 0; kidx < m_n_inner_cells; ++kidx)
+    for (unsigned int kidx = 0; kidx < m_n_fourier_cells; ++kidx)
         {
-        bool exclude = false;
-        if (exclude_dc)
-            // exclude DC bin
-            exclude = (kidx == 0);
+        // the weight excludes the DC bin and counts the modes omitted by a real-to-complex transform
+        Scalar weight = m_fft->getModeWeight(kidx);
 
-        if (! exclude)
+        if (weight != Scalar(0.0))
             {
             // non-zero wave vector
             kiss_fft_cpx fourier = h_fourier_mesh.data[kidx];
@@ -1352,9 +1216,9 @@ void PPPMForceCompute::computeVirial()
             Scalar3 k = h_k.data[kidx];
             Scalar ksq = dot(k,k);
 
-            Scalar rhog = (fourier.r * fourier.r + fourier.i * fourier.i)*h_inf_f.data[kidx];
+            Scalar rhog = weight*(fourier.r * fourier.r + fourier.i * fourier.i)*h_inf_f.data[kidx];
 
-            Scalar vterm = -Scalar(2.0)*(Scalar(1.0)/ksq + Scalar(0.25)/(m_kappa*m_kappa));
+            Scalar vterm = evalVirialFactor(ksq);
             virial[0] += rhog*(Scalar(1.0) + vterm*k.x*k.x); // xx
             virial[1] += rhog*(              vterm*k.x*k.y); // xy
             virial[2] += rhog*(              vterm*k.x*k.z); // xz
@@ -1392,109 +1256,218 @@ inline void eval_pppm_real_space(Scalar alpha, Scalar kappa, Scalar rsq, Scalar
         - Scalar(0.5)*alpha*(expfac*::erfc(arg1)+fast::exp(alpha*r)*::erfc(arg2)) - erffac)/rsq;
     }
 
+/*! \param ksq Squared wave number
+    \returns The Fourier transform of the screened Coulomb interaction, multiplied by the Gaussian that splits off
+     the long-ranged part
+*/
+Scalar PPPMForceCompute::evalGreensFunction(Scalar ksq) const
+    {
+    Scalar ksq_screened = ksq + m_alpha*m_alpha;
+    return Scalar(4.0*M_PI)*exp(-Scalar(0.25)*ksq_screened/(m_kappa*m_kappa))/ksq_screened;
+    }
+
+/*! \param ksq Squared wave number (non-zero)
+*/
+Scalar PPPMForceCompute::evalVirialFactor(Scalar ksq) const
+    {
+    return -Scalar(2.0)*(Scalar(1.0)/ksq + Scalar(0.25)/(m_kappa*m_kappa));
+    }
+
+/*! \param rsq Squared distance between the particles
+    \param pair_eng Energy per unit product of the charges (output)
+    \param force_divr Force divided by r per unit product of the charges (output)
+*/
+void PPPMForceCompute::evalRealSpace(Scalar rsq, Scalar& pair_eng, Scalar& force_divr) const
+    {
+    eval_pppm_real_space(m_alpha, m_kappa, rsq, pair_eng, force_divr);
+    }
+
+/*! The k=0 term is omitted, since the mode weights exclude it from the mesh sum.
+*/
+Scalar PPPMForceCompute::computeSelfEnergy()
+    {
+    // subtract self-energy (see Frenkel and Smit, and Salin and Caillol)
+    return -m_q2 * (m_kappa/sqrt(Scalar(M_PI))*exp(-m_alpha*m_alpha/(Scalar(4.0)*m_kappa*m_kappa))
+        - Scalar(0.5)*m_alpha*erfc(m_alpha/(Scalar(2.0)*m_kappa)));
+    }
+
+/*! The long-range self energy of a rigid body only depends on the relative positions and charges of its
+    constituents, which are the same for all bodies with the same central particle type. The energy is therefore
+    evaluated once per body type from a representative body, and the correction is the sum over body types of the
+    number of bodies times the cached energy. Body types that were seen before are not recomputed when bodies are
+    added or removed, so the cost is O(N) plus O(n_constituent^2) for every new body type.
+
+    The cache is invalidated when the parameters of the PPPM change.
+*/
 void PPPMForceCompute::computeBodyCorrection()
     {
     if (m_prof) m_prof->push("rigid body correction");
 
-    // do an N^2 search over particles in a body, subtracting the real-space long-range part from the PPPM energy
+    unsigned int ntypes = m_pdata->getNTypes();
+
+    // count the local rigid bodies of every type by their central particles
+    std::vector<unsigned int> body_count(ntypes, 0);
+    std::vector<unsigned int> rep_body(ntypes, UINT_MAX);
+    unsigned int n_floppy = 0;
 
-    // have a global view of all particles on rank 0
-    SnapshotParticleData<Scalar> snap;
-    m_pdata->takeSnapshot(snap);
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
-    unsigned int nptl = snap.size;
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            {
+            unsigned int body = h_body.data[i];
+            if (body == NO_BODY)
+                continue;
 
-    m_body_energy = Scalar(0.0);
+            if (body >= MIN_FLOPPY)
+                {
+                n_floppy++;
+                continue;
+                }
+
+            if (body == h_tag.data[i])
+                {
+                unsigned int type = __scalar_as_int(h_postype.data[i].w);
+                body_count[type]++;
 
-    std::multimap<unsigned int, unsigned int> body_map;
-    std::map<unsigned int, Scalar> body_type;
-    const BoxDim& box = m_pdata->getGlobalBox();
+                // the central particle with the lowest tag represents its body type
+                if (!m_body_type_energy.count(type))
+                    rep_body[type] = std::min(rep_body[type], body);
+                }
+            }
+        }
 
     bool is_rank_zero = true;
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
         is_rank_zero = !m_exec_conf->getRank();
+
+        MPI_Allreduce(MPI_IN_PLACE, &body_count.front(), ntypes, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &rep_body.front(), ntypes, MPI_UNSIGNED, MPI_MIN, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &n_floppy, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
         }
     #endif
 
-    if (is_rank_zero)
+    if (n_floppy)
         {
-        std::multimap<unsigned int, unsigned> body_map;
-        std::map<unsigned int, Scalar> body_type;
+        m_exec_conf->msg->warning() << "charge.pppm: No self-energy correction is applied to floppy bodies." << std::endl;
+        }
 
-        if (m_group->getNumMembers() != nptl)
-            {
-            m_exec_conf->msg->warning() << "charge.pppm: Operating on a group which is not group.all(). Body self-energies may be wrong." << std::endl;
-            }
+    if (m_group->getNumMembersGlobal() != m_pdata->getNGlobal())
+        {
+        m_exec_conf->msg->warning() << "charge.pppm: Operating on a group which is not group.all(). Body self-energies may be wrong." << std::endl;
+        }
 
-        // save references to each body's constituent particles
-        for (unsigned int i = 0; i < nptl; ++i)
-            {
-            unsigned int ibody = snap.body[i];
-            if (ibody != NO_BODY) body_map.insert(std::make_pair(ibody,i));
-            }
+    // map the representative bodies to their types
+    std::map<unsigned int, unsigned int> new_body_types;
+    for (unsigned int type = 0; type < ntypes; ++type)
+        {
+        if (rep_body[type] != UINT_MAX)
+            new_body_types.insert(std::make_pair(rep_body[type], type));
+        }
+
+    if (!new_body_types.empty())
+        {
+        // collect the unwrapped positions and charges of the constituents of the representative bodies
+        std::vector< std::pair<unsigned int, Scalar4> > constituents;
 
-        // iterate over unique bodies
-        for (auto it = body_map.begin(); it != body_map.end(); it = body_map.upper_bound(it->first))
             {
-            auto body_end = body_map.upper_bound(it->first);
+            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_charge(getSources(), access_location::host, access_mode::read);
+            ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
 
-            unsigned int type = snap.type[it->second];
-            auto energy_it = body_type.find(type);
+            const BoxDim& global_box = m_pdata->getGlobalBox();
 
-            if (energy_it != body_type.end())
+            for (unsigned int i = 0; i < m_pdata->getN(); ++i)
                 {
-                // use cached result
-                m_body_energy += energy_it->second;
-                continue;
+                unsigned int body = h_body.data[i];
+                Scalar qi = h_charge.data[i];
+                if (qi == Scalar(0.0) || !new_body_types.count(body))
+                    continue;
+
+                Scalar4 postype = h_postype.data[i];
+                Scalar3 pos = global_box.shift(make_scalar3(postype.x, postype.y, postype.z), h_image.data[i]);
+                constituents.push_back(std::make_pair(body, make_scalar4(pos.x, pos.y, pos.z, qi)));
                 }
+            }
 
-            Scalar body_energy(0.0);
-            for (auto iti = it; iti != body_end; ++iti)
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            std::vector< std::vector< std::pair<unsigned int, Scalar4> > > constituents_proc;
+            gather_v(constituents, constituents_proc, 0, m_exec_conf->getMPICommunicator());
+
+            if (is_rank_zero)
                 {
-                unsigned int i = iti->second;
+                constituents.clear();
+                for (auto it = constituents_proc.begin(); it != constituents_proc.end(); ++it)
+                    constituents.insert(constituents.end(), it->begin(), it->end());
+                }
+            }
+        #endif
 
-                vec3<Scalar> posi(snap.pos[i]);
-                Scalar qi(snap.charge[i]);
-                int3 img_i = snap.image[i];
+        if (is_rank_zero)
+            {
+            // group the charged constituents by body
+            std::multimap<unsigned int, Scalar4> body_map(constituents.begin(), constituents.end());
 
-                for (auto itj = it; itj != body_end; ++itj)
-                    {
-                    unsigned int j = itj->second;
-                    vec3<Scalar> posj(snap.pos[j]);
-                    Scalar qj(snap.charge[j]);
+            for (auto it = new_body_types.begin(); it != new_body_types.end(); ++it)
+                {
+                auto range = body_map.equal_range(it->first);
 
-                    Scalar qiqj = qi*qj;
+                Scalar body_energy(0.0);
+                for (auto iti = range.first; iti != range.second; ++iti)
+                    {
+                    Scalar4 pos_q_i = iti->second;
 
-                    if (qiqj != Scalar(0.0) && i != j)
+                    // the pair energy is symmetric, only visit every pair once
+                    auto itj = iti;
+                    for (++itj; itj != range.second; ++itj)
                         {
-                        // account for self-interactions by shifting into the body reference frame
-                        int3 img_j = snap.image[j];
-                        int3 delta_img = img_j - img_i;
-                        Scalar3 pos_j_shift = box.shift(vec_to_scalar3(posj),delta_img);
-                        Scalar3 dx = pos_j_shift - vec_to_scalar3(posi);
+                        Scalar4 pos_q_j = itj->second;
+
+                        Scalar3 dx = make_scalar3(pos_q_j.x - pos_q_i.x, pos_q_j.y - pos_q_i.y, pos_q_j.z - pos_q_i.z);
                         Scalar rsq = dot(dx,dx);
 
                         Scalar force_divr(0.0);
                         Scalar pair_eng(0.0);
 
                         // compute correction
-                        eval_pppm_real_space(m_alpha, m_kappa, rsq, pair_eng, force_divr);
+                        evalRealSpace(rsq, pair_eng, force_divr);
 
                         // subtract long range self-energy
-                        body_energy -= Scalar(0.5)*qiqj*pair_eng;
+                        body_energy -= pos_q_i.w*pos_q_j.w*pair_eng;
                         }
                     }
+
+                m_body_type_energy[it->second] = body_energy;
                 }
+            }
 
-            m_body_energy += body_energy;
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            bcast(m_body_type_energy, 0, m_exec_conf->getMPICommunicator());
+            }
+        #endif
+        }
 
-            // store precalculated body type
-            body_type.insert(std::make_pair(type, body_energy));
+    // the correction is added to the energy on rank 0 only
+    m_body_energy = Scalar(0.0);
+    if (is_rank_zero)
+        {
+        for (unsigned int type = 0; type < ntypes; ++type)
+            {
+            if (body_count[type])
+                m_body_energy += Scalar(body_count[type])*m_body_type_energy[type];
             }
         }
-        if (m_prof) m_prof->pop();
+
+    if (m_prof) m_prof->pop();
     }
 
 void PPPMForceCompute::fixExclusions()
@@ -1519,12 +1492,11 @@ void PPPMForceCompute::fixExclusions()
 
     ArrayHandle< unsigned int > d_group_members(m_group->getIndexArray(), access_location::host, access_mode::read);
     const BoxDim& box = m_pdata->getBox();
-    ArrayHandle<unsigned int> d_exlist(m_nlist->getExListArray(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> d_n_ex(m_nlist->getNExArray(), access_location::host, access_mode::read);
-    Index2D nex = m_nlist->getExListIndexer();
+    ArrayHandle<unsigned int> h_ex_head(m_nlist->getExHeadArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list(m_nlist->getExListCSRArray(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getSources(), access_location::host, access_mode::read);
 
     for(unsigned int i = 0; i < group_size; i++)
         {
@@ -1539,12 +1511,12 @@ void PPPMForceCompute::fixExclusions()
         posi.z = h_pos.data[idx].z;
         Scalar qi = h_charge.data[idx];
 
-        unsigned int n_neigh = d_n_ex.data[idx];
+        unsigned int ex_end = h_ex_head.data[idx+1];
         unsigned int cur_j = 0;
 
-        for (unsigned int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
+        for (unsigned int ex_idx = h_ex_head.data[idx]; ex_idx < ex_end; ex_idx++)
             {
-            cur_j = d_exlist.data[nex(idx, neigh_idx)];
+            cur_j = h_ex_list.data[ex_idx];
 
             // get the neighbor's position
             Scalar3 posj;
@@ -1566,7 +1538,7 @@ void PPPMForceCompute::fixExclusions()
             if (qiqj != Scalar(0.0))
                 {
                 // evaluate the long-range pair potential
-                eval_pppm_real_space(m_alpha, m_kappa, rsq, pair_eng, force_divr);
+                evalRealSpace(rsq, pair_eng, force_divr);
 
                 // subtract long-range part of pair-interaction
                 force_divr = -qiqj * force_divr;
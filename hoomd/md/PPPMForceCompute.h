@@ -10,18 +10,29 @@
 
 #ifdef ENABLE_MPI
 #include "CommunicatorGrid.h"
-#include "hoomd/extern/dfftlib/src/dfft_host.h"
 #endif
 
-#include "hoomd/extern/kiss_fftnd.h"
+#include "PPPMFFTBackend.h"
 
 #include <memory>
+#include <map>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 const Scalar EPS_HOC(1.0e-7);
 
 const unsigned int PPPM_MAX_ORDER = 7;
 
+//! Assignment weights and mesh cells of a particle along every axis
+struct PPPMStencil
+    {
+    Scalar Wx[PPPM_MAX_ORDER];          //!< Weights along x
+    Scalar Wy[PPPM_MAX_ORDER];          //!< Weights along y
+    Scalar Wz[PPPM_MAX_ORDER];          //!< Weights along z
+    unsigned int ix[PPPM_MAX_ORDER];    //!< Mesh cells along x
+    unsigned int iy[PPPM_MAX_ORDER];    //!< Mesh cells along y
+    unsigned int iz[PPPM_MAX_ORDER];    //!< Mesh cells along z
+    };
+
 /*! Compute the long-ranged part of the particle-particle particle-mesh Ewald sum (PPPM)
  */
 class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
@@ -109,6 +120,7 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         unsigned int m_n_cells;             //!< Total number of inner cells
         unsigned int m_radius;              //!< Stencil radius (in units of mesh size)
         unsigned int m_n_inner_cells;       //!< Number of inner mesh points (without ghost cells)
+        unsigned int m_n_fourier_cells;     //!< Number of Fourier modes stored on this rank
         GlobalArray<Scalar> m_inf_f;           //!< Fourier representation of the influence function (real part)
         GlobalArray<Scalar3> m_k;              //!< Mesh of k values
         Scalar m_qstarsq;                   //!< Short wave length cut-off squared for density harmonics
@@ -130,6 +142,7 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         GlobalArray<Scalar> m_gf_b;            //!< Green function coefficients
 
         Scalar m_body_energy;                      //!< Energy correction due to rigid body exclusions
+        std::map<unsigned int, Scalar> m_body_type_energy; //!< Cached self energy per type of central particle
         bool m_ptls_added_removed;          //!< True if global particle number changed
 
         //! Helper function to be called when particle number changes
@@ -177,19 +190,45 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Compute rigid body correction
         virtual void computeBodyCorrection();
 
+        //! Sum the sources and their squares over the group
+        void computeSourceSums();
+
+        //! Get the per-particle strengths of the sources that are spread onto the mesh
+        /*! These are the charges for electrostatics. The array has to be valid for the local and the ghost particles.
+         */
+        virtual const GlobalArray<Scalar>& getSources()
+            {
+            return m_pdata->getCharges();
+            }
+
+        //! Evaluate the Fourier transform of the long-ranged part of the pair interaction
+        virtual Scalar evalGreensFunction(Scalar ksq) const;
+
+        //! Evaluate 2 d ln G(k) / d k^2 of the Green's function, which enters the virial
+        virtual Scalar evalVirialFactor(Scalar ksq) const;
+
+        //! Evaluate the long-ranged part of the pair interaction in real space
+        virtual void evalRealSpace(Scalar rsq, Scalar& pair_eng, Scalar& force_divr) const;
+
+        //! Compute the self energy of the sources and the energy of the k=0 mode, added on rank 0
+        virtual Scalar computeSelfEnergy();
+
+        //! computes coefficients for assigning charges to grid points
+        void compute_rho_coeff();
+
+        //! computes auxiliary table for optimized influence function
+        void compute_gf_denom();
+
+        std::vector<std::string> m_log_names;           //!< Name of the log quantity
+
     private:
-        kiss_fftnd_cfg m_kiss_fft;         //!< The FFT configuration
-        kiss_fftnd_cfg m_kiss_ifft;        //!< Inverse FFT configuration
+        std::unique_ptr<PPPMFFTBackend> m_fft;     //!< The (local or distributed) FFT of the meshes
 
         #ifdef ENABLE_MPI
-        dfft_plan m_dfft_plan_forward;     //!< Distributed FFT for forward transform
-        dfft_plan m_dfft_plan_inverse;     //!< Distributed FFT for inverse transform
         std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> > m_grid_comm_forward; //!< Communicator for charge mesh
         std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> > m_grid_comm_reverse; //!< Communicator for inv fourier mesh
         #endif
 
-        bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
-
         GlobalArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh_G_x;   //!< Fourier transformed mesh times the influence function, x-component
@@ -199,24 +238,23 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         GlobalArray<kiss_fft_cpx> m_inv_fourier_mesh_y;   //!< Fourier transformed mesh times the influence function, y-component
         GlobalArray<kiss_fft_cpx> m_inv_fourier_mesh_z;   //!< Fourier transformed mesh times the influence function, z-component
 
-        std::vector<std::string> m_log_names;           //!< Name of the log quantity
-
-        bool m_dfft_initialized;                   //! True if host dfft has been initialized
-
         //! Compute virial on mesh
         void computeVirialMesh();
 
         //! Compute number of ghost cellso
         uint3 computeGhostCellNum();
 
-        //! root mean square error in force calculation
-        Scalar rms(Scalar h, Scalar prd, Scalar natoms);
+        //! Position of a particle for the assignment to the mesh
+        Scalar3 getMeshPosition(const Scalar4 *h_postype, unsigned int idx, const BoxDim& box) const;
 
-        //! computes coefficients for assigning charges to grid points
-        void compute_rho_coeff();
+        //! Find the mesh cell of a particle and its distance to the cell center
+        bool getStencilCell(const BoxDim& box, const Scalar3& pos, int3& cell, Scalar3& d) const;
 
-        //! computes auxiliary table for optimized influence function
-        void compute_gf_denom();
+        //! Evaluate the assignment weights of a particle and the mesh cells they apply to
+        void computeStencil(const int3& cell, const Scalar3& d, const Scalar *rho_coeff, PPPMStencil& stencil) const;
+
+        //! root mean square error in force calculation
+        Scalar rms(Scalar h, Scalar prd, Scalar natoms);
 
         //! computes coefficients for the Green's function
         Scalar gf_denom(Scalar x, Scalar y, Scalar z);
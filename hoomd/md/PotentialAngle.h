@@ -0,0 +1,345 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include <memory>
+#include "hoomd/ForceCompute.h"
+#include "hoomd/GPUArray.h"
+
+#include "ThreadedForceScatter.h"
+
+/*! \file PotentialAngle.h
+    \brief Declares PotentialAngle
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __POTENTIALANGLE_H__
+#define __POTENTIALANGLE_H__
+
+/*! Angle potential with evaluator support
+
+    PotentialAngle computes the geometry of every angle a-b-c (the separation vectors, the cosine of the angle and
+    their derivatives) and leaves the functional form to the evaluator. The evaluator is constructed from the cosine
+    of the angle and the per type parameters, and returns the derivative of the energy with respect to the cosine
+    and the energy of the angle. See EvaluatorAngleHarmonic for the interface.
+
+    In TBB builds, the loop over the angles runs in parallel threads. Because the forces of an angle are scattered
+    to its three members, every thread accumulates into its own force and virial arrays, which are summed up
+    afterwards by ThreadedForceScatter, so no atomic operations are needed.
+
+    \ingroup computes
+*/
+template < class evaluator >
+class PotentialAngle : public ForceCompute
+    {
+    public:
+        //! Param type from evaluator
+        typedef typename evaluator::param_type param_type;
+
+        //! Constructs the compute
+        PotentialAngle(std::shared_ptr<SystemDefinition> sysdef,
+                       const std::string& log_suffix="");
+
+        //! Destructor
+        virtual ~PotentialAngle();
+
+        //! Set the parameters
+        virtual void setParams(unsigned int type, const param_type &param);
+
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+        #ifdef ENABLE_MPI
+        //! Get ghost particle fields requested by this angle potential
+        virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+        #endif
+
+    protected:
+        GPUArray<param_type> m_params;              //!< Angle parameters per type
+        std::shared_ptr<AngleData> m_angle_data;    //!< Angle data to use in computing angles
+        std::string m_log_name;                     //!< Cached log name
+        std::string m_prof_name;                    //!< Cached profiler name
+
+        ThreadedForceScatter m_force_scatter;       //!< Accumulates the scattered forces over the threads
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+    };
+
+/*! \param sysdef System to compute forces on
+    \param log_suffix Name given to this instance of the force
+*/
+template< class evaluator >
+PotentialAngle< evaluator >::PotentialAngle(std::shared_ptr<SystemDefinition> sysdef,
+                      const std::string& log_suffix)
+    : ForceCompute(sysdef)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PotentialAngle<" << evaluator::getName() << ">" << std::endl;
+    assert(m_pdata);
+
+    // access the angle data for later use
+    m_angle_data = m_sysdef->getAngleData();
+    m_log_name = std::string("angle_") + evaluator::getName() + std::string("_energy") + log_suffix;
+    m_prof_name = std::string("Angle ") + evaluator::getName();
+
+    // allocate the parameters
+    GPUArray<param_type> params(m_angle_data->getNTypes(), m_exec_conf);
+    m_params.swap(params);
+
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+    }
+
+template< class evaluator >
+PotentialAngle< evaluator >::~PotentialAngle()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PotentialAngle<" << evaluator::getName() << ">" << std::endl;
+    }
+
+/*! \param type Type of the angle to set parameters for
+    \param param Parameter to set
+
+    Sets the parameters for the potential of a particular angle type
+*/
+template<class evaluator >
+void PotentialAngle< evaluator >::setParams(unsigned int type, const param_type& param)
+    {
+    // make sure the type is valid
+    if (type >= m_angle_data->getNTypes())
+        {
+        this->m_exec_conf->msg->error() << "angle." << evaluator::getName() << ": Invalid angle type specified" << std::endl;
+        throw std::runtime_error("Error setting parameters in PotentialAngle");
+        }
+
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::readwrite);
+    h_params.data[type] = param;
+    }
+
+/*! PotentialAngle provides
+    - \c angle_"name"_energy
+*/
+template< class evaluator >
+std::vector< std::string > PotentialAngle< evaluator >::getProvidedLogQuantities()
+    {
+    std::vector<std::string> list;
+    list.push_back(m_log_name);
+    return list;
+    }
+
+/*! \param quantity Name of the log value to get
+    \param timestep Current timestep of the simulation
+*/
+template< class evaluator >
+Scalar PotentialAngle< evaluator >::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == m_log_name)
+        {
+        compute(timestep);
+        return calcEnergySum();
+        }
+    else
+        {
+        this->m_exec_conf->msg->error() << "angle." << evaluator::getName() << ": " << quantity << " is not a valid log quantity" << std::endl;
+        throw std::runtime_error("Error getting log value");
+        }
+    }
+
+/*! Actually perform the force computation
+    \param timestep Current time step
+ */
+template< class evaluator >
+void PotentialAngle< evaluator >::computeForces(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push(m_prof_name);
+
+    assert(m_pdata);
+
+    // access the particle data arrays
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    // access the parameters
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+
+    // there are enough other checks on the input data: but it doesn't hurt to be safe
+    assert(h_force.data);
+    assert(h_virial.data);
+    assert(h_pos.data);
+    assert(h_rtag.data);
+
+    // Zero data for force calculation
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    // we are using the minimum image of the global box here
+    // to ensure that ghosts are always correctly wrapped (even if an angle exceeds half the domain length)
+    const BoxDim& box = m_pdata->getGlobalBox();
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+    ArrayHandle<typename AngleData::members_t> h_angles(m_angle_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    const unsigned int N = m_pdata->getN();
+
+    // compute a single angle, and add its forces on the local members to the given arrays
+    auto compute_angle = [&](unsigned int i, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+        {
+        // lookup the tag of each of the particles participating in the angle
+        const typename AngleData::members_t& angle = h_angles.data[i];
+        assert(angle.tag[0] <= m_pdata->getMaximumTag());
+        assert(angle.tag[1] <= m_pdata->getMaximumTag());
+        assert(angle.tag[2] <= m_pdata->getMaximumTag());
+
+        // transform a, b, and c into indices into the particle data arrays
+        unsigned int idx_a = h_rtag.data[angle.tag[0]];
+        unsigned int idx_b = h_rtag.data[angle.tag[1]];
+        unsigned int idx_c = h_rtag.data[angle.tag[2]];
+
+        // throw an error if this angle is incomplete
+        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
+            {
+            this->m_exec_conf->msg->error() << "angle." << evaluator::getName() << ": angle " <<
+                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << std::endl << std::endl;
+            throw std::runtime_error("Error in angle calculation");
+            }
+
+        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
+
+        // calculate d\vec{r}
+        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+        Scalar3 posc = make_scalar3(h_pos.data[idx_c].x, h_pos.data[idx_c].y, h_pos.data[idx_c].z);
+
+        // apply minimum image conventions to both vectors
+        Scalar3 dab = box.minImage(posa - posb);
+        Scalar3 dcb = box.minImage(posc - posb);
+
+        Scalar rsqab = dot(dab, dab);
+        Scalar rab = sqrt(rsqab);
+        Scalar rsqcb = dot(dcb, dcb);
+        Scalar rcb = sqrt(rsqcb);
+
+        Scalar c_abbc = dot(dab, dcb);
+        c_abbc /= rab*rcb;
+
+        if (c_abbc > Scalar(1.0)) c_abbc = Scalar(1.0);
+        if (c_abbc < -Scalar(1.0)) c_abbc = -Scalar(1.0);
+
+        // compute the derivative of the energy with respect to the cosine, and the energy
+        Scalar dU_dcos = Scalar(0.0);
+        Scalar angle_eng = Scalar(0.0);
+        evaluator eval(c_abbc, h_params.data[h_typeval.data[i].type]);
+        eval.evalForceAndEnergy(dU_dcos, angle_eng);
+
+        Scalar a11 = dU_dcos*c_abbc/rsqab;
+        Scalar a12 = -dU_dcos/(rab*rcb);
+        Scalar a22 = dU_dcos*c_abbc/rsqcb;
+
+        Scalar3 fab = a11*dab + a12*dcb;
+        Scalar3 fcb = a22*dcb + a12*dab;
+
+        // compute 1/3 of the energy, 1/3 for each atom in the angle
+        angle_eng *= Scalar(1.0/3.0);
+
+        // compute 1/3 of the virial, 1/3 for each atom in the angle
+        // upper triangular version of virial tensor
+        Scalar angle_virial[6];
+        if (compute_virial)
+            {
+            angle_virial[0] = Scalar(1./3.) * ( dab.x*fab.x + dcb.x*fcb.x );
+            angle_virial[1] = Scalar(1./3.) * ( dab.y*fab.x + dcb.y*fcb.x );
+            angle_virial[2] = Scalar(1./3.) * ( dab.z*fab.x + dcb.z*fcb.x );
+            angle_virial[3] = Scalar(1./3.) * ( dab.y*fab.y + dcb.y*fcb.y );
+            angle_virial[4] = Scalar(1./3.) * ( dab.z*fab.y + dcb.z*fcb.y );
+            angle_virial[5] = Scalar(1./3.) * ( dab.z*fab.z + dcb.z*fcb.z );
+            }
+
+        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
+        // do not update ghost particles
+        if (idx_a < N)
+            {
+            force[idx_a].x += fab.x;
+            force[idx_a].y += fab.y;
+            force[idx_a].z += fab.z;
+            force[idx_a].w += angle_eng;
+            if (compute_virial)
+                for (unsigned int j = 0; j < 6; j++)
+                    virial[j*virial_pitch+idx_a] += angle_virial[j];
+            }
+
+        if (idx_b < N)
+            {
+            force[idx_b].x -= fab.x + fcb.x;
+            force[idx_b].y -= fab.y + fcb.y;
+            force[idx_b].z -= fab.z + fcb.z;
+            force[idx_b].w += angle_eng;
+            if (compute_virial)
+                for (unsigned int j = 0; j < 6; j++)
+                    virial[j*virial_pitch+idx_b] += angle_virial[j];
+            }
+
+        if (idx_c < N)
+            {
+            force[idx_c].x += fcb.x;
+            force[idx_c].y += fcb.y;
+            force[idx_c].z += fcb.z;
+            force[idx_c].w += angle_eng;
+            if (compute_virial)
+                for (unsigned int j = 0; j < 6; j++)
+                    virial[j*virial_pitch+idx_c] += angle_virial[j];
+            }
+        };
+
+    // for each of the angles
+    const unsigned int size = (unsigned int)m_angle_data->getN();
+
+    // the forces of an angle are scattered to its members, so the threads accumulate into their own arrays
+    m_force_scatter.scatter(size, N, compute_virial, compute_angle, h_force.data, h_virial.data, m_virial_pitch);
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+template < class evaluator >
+CommFlags PotentialAngle< evaluator >::getRequestedCommFlags(unsigned int timestep)
+    {
+    CommFlags flags = CommFlags(0);
+
+    flags[comm_flag::tag] = 1;
+
+    flags |= ForceCompute::getRequestedCommFlags(timestep);
+
+    return flags;
+    }
+#endif
+
+//! Exports the PotentialAngle class to python
+/*! \param name Name of the class in the exported python module
+    \tparam T class type to export. \b Must be an instantiated PotentialAngle class template.
+*/
+template < class T > void export_PotentialAngle(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<T, std::shared_ptr<T> >(m, name.c_str(),pybind11::base<ForceCompute>())
+        .def(pybind11::init< std::shared_ptr<SystemDefinition>, const std::string& > ())
+        .def("setParams", &T::setParams)
+        ;
+    }
+
+#endif
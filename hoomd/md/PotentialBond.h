@@ -81,6 +81,12 @@ PotentialBond< evaluator >::PotentialBond(std::shared_ptr<SystemDefinition> sysd
     // allocate the parameters
     GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+
+    m_mixed_precision_supported = true;
     }
 
 template< class evaluator >
@@ -147,6 +153,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     assert(m_pdata);
 
+    // read the positions in single precision relative to the box origin if requested
+    const bool mixed = m_mixed_precision;
+    if (mixed)
+        updateMixedPositions();
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
@@ -211,10 +222,19 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
-
-        Scalar3 dx = posb - posa;
+        Scalar3 dx;
+        if (mixed)
+            {
+            const float4& posa = m_pos_mixed[idx_a];
+            const float4& posb = m_pos_mixed[idx_b];
+            dx = make_scalar3(posb.x - posa.x, posb.y - posa.y, posb.z - posa.z);
+            }
+        else
+            {
+            Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+            Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+            dx = posb - posa;
+            }
 
         // access diameter (if needed)
         Scalar diameter_a = Scalar(0.0);
@@ -0,0 +1,357 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include <memory>
+#include "hoomd/ForceCompute.h"
+#include "hoomd/GPUArray.h"
+
+#include "ThreadedForceScatter.h"
+
+/*! \file PotentialDihedral.h
+    \brief Declares PotentialDihedral
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __POTENTIALDIHEDRAL_H__
+#define __POTENTIALDIHEDRAL_H__
+
+/*! Dihedral potential with evaluator support
+
+    PotentialDihedral computes the geometry of every dihedral a-b-c-d (the separation vectors, the cosine and the sine
+    of the dihedral angle phi and their derivatives) and leaves the functional form to the evaluator. The evaluator is
+    constructed from the cosine and the sine of phi and the per type parameters, and returns -dU/dphi and the energy of
+    the dihedral. See EvaluatorDihedralHarmonic for the interface.
+
+    In TBB builds, the loop over the dihedrals runs in parallel threads. Every thread accumulates into its own force
+    and virial arrays, which are summed up afterwards by ThreadedForceScatter, so no atomic operations are needed.
+
+    \ingroup computes
+*/
+template < class evaluator >
+class PotentialDihedral : public ForceCompute
+    {
+    public:
+        //! Param type from evaluator
+        typedef typename evaluator::param_type param_type;
+
+        //! Constructs the compute
+        PotentialDihedral(std::shared_ptr<SystemDefinition> sysdef,
+                       const std::string& log_suffix="");
+
+        //! Destructor
+        virtual ~PotentialDihedral();
+
+        //! Set the parameters
+        virtual void setParams(unsigned int type, const param_type &param);
+
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+        #ifdef ENABLE_MPI
+        //! Get ghost particle fields requested by this dihedral potential
+        virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+        #endif
+
+    protected:
+        GPUArray<param_type> m_params;              //!< Dihedral parameters per type
+        std::shared_ptr<DihedralData> m_dihedral_data;    //!< Dihedral data to use in computing dihedrals
+        std::string m_log_name;                     //!< Cached log name
+        std::string m_prof_name;                    //!< Cached profiler name
+
+        ThreadedForceScatter m_force_scatter;       //!< Accumulates the scattered forces over the threads
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+    };
+
+/*! \param sysdef System to compute forces on
+    \param log_suffix Name given to this instance of the force
+*/
+template< class evaluator >
+PotentialDihedral< evaluator >::PotentialDihedral(std::shared_ptr<SystemDefinition> sysdef,
+                      const std::string& log_suffix)
+    : ForceCompute(sysdef)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PotentialDihedral<" << evaluator::getName() << ">" << std::endl;
+    assert(m_pdata);
+
+    // access the dihedral data for later use
+    m_dihedral_data = m_sysdef->getDihedralData();
+    m_log_name = std::string("dihedral_") + evaluator::getName() + std::string("_energy") + log_suffix;
+    m_prof_name = std::string("Dihedral ") + evaluator::getName();
+
+    // allocate the parameters
+    GPUArray<param_type> params(m_dihedral_data->getNTypes(), m_exec_conf);
+    m_params.swap(params);
+
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+    }
+
+template< class evaluator >
+PotentialDihedral< evaluator >::~PotentialDihedral()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PotentialDihedral<" << evaluator::getName() << ">" << std::endl;
+    }
+
+/*! \param type Type of the dihedral to set parameters for
+    \param param Parameter to set
+
+    Sets the parameters for the potential of a particular dihedral type
+*/
+template<class evaluator >
+void PotentialDihedral< evaluator >::setParams(unsigned int type, const param_type& param)
+    {
+    // make sure the type is valid
+    if (type >= m_dihedral_data->getNTypes())
+        {
+        this->m_exec_conf->msg->error() << "dihedral." << evaluator::getName() << ": Invalid dihedral type specified" << std::endl;
+        throw std::runtime_error("Error setting parameters in PotentialDihedral");
+        }
+
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::readwrite);
+    h_params.data[type] = param;
+    }
+
+/*! PotentialDihedral provides
+    - \c dihedral_"name"_energy
+*/
+template< class evaluator >
+std::vector< std::string > PotentialDihedral< evaluator >::getProvidedLogQuantities()
+    {
+    std::vector<std::string> list;
+    list.push_back(m_log_name);
+    return list;
+    }
+
+/*! \param quantity Name of the log value to get
+    \param timestep Current timestep of the simulation
+*/
+template< class evaluator >
+Scalar PotentialDihedral< evaluator >::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == m_log_name)
+        {
+        compute(timestep);
+        return calcEnergySum();
+        }
+    else
+        {
+        this->m_exec_conf->msg->error() << "dihedral." << evaluator::getName() << ": " << quantity << " is not a valid log quantity" << std::endl;
+        throw std::runtime_error("Error getting log value");
+        }
+    }
+
+/*! Actually perform the force computation
+    \param timestep Current time step
+ */
+template< class evaluator >
+void PotentialDihedral< evaluator >::computeForces(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push(m_prof_name);
+
+    assert(m_pdata);
+
+    // access the particle data arrays
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    // access the parameters
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+
+    // there are enough other checks on the input data: but it doesn't hurt to be safe
+    assert(h_force.data);
+    assert(h_virial.data);
+    assert(h_pos.data);
+    assert(h_rtag.data);
+
+    // Zero data for force calculation
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    // we are using the minimum image of the global box here
+    // to ensure that ghosts are always correctly wrapped (even if a dihedral exceeds half the domain length)
+    const BoxDim& box = m_pdata->getGlobalBox();
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+    ArrayHandle<typename DihedralData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    // the forces are applied to ghost particles, too
+    const unsigned int n_all = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // compute a single dihedral, and add its forces to the given arrays
+    auto compute_dihedral = [&](unsigned int i, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+        {
+        // lookup the tag of each of the particles participating in the dihedral
+        const typename DihedralData::members_t& dihedral = h_dihedrals.data[i];
+        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
+
+        // transform a, b, c, and d into indices into the particle data arrays
+        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
+        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
+        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
+        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
+
+        // throw an error if this dihedral is incomplete
+        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
+            {
+            this->m_exec_conf->msg->error() << "dihedral." << evaluator::getName() << ": dihedral " <<
+                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+                << " incomplete." << std::endl << std::endl;
+            throw std::runtime_error("Error in dihedral calculation");
+            }
+
+        assert(idx_a < n_all);
+        assert(idx_b < n_all);
+        assert(idx_c < n_all);
+        assert(idx_d < n_all);
+
+        // calculate d\vec{r}
+        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+        Scalar3 posc = make_scalar3(h_pos.data[idx_c].x, h_pos.data[idx_c].y, h_pos.data[idx_c].z);
+        Scalar3 posd = make_scalar3(h_pos.data[idx_d].x, h_pos.data[idx_d].y, h_pos.data[idx_d].z);
+
+        // apply periodic boundary conditions
+        Scalar3 dab = box.minImage(posa - posb);
+        Scalar3 dcb = box.minImage(posc - posb);
+        Scalar3 ddc = box.minImage(posd - posc);
+        Scalar3 dcbm = -dcb;
+
+        // normals of the planes abc and bcd
+        Scalar3 aa = make_scalar3(dab.y*dcbm.z - dab.z*dcbm.y,
+                                  dab.z*dcbm.x - dab.x*dcbm.z,
+                                  dab.x*dcbm.y - dab.y*dcbm.x);
+        Scalar3 bb = make_scalar3(ddc.y*dcbm.z - ddc.z*dcbm.y,
+                                  ddc.z*dcbm.x - ddc.x*dcbm.z,
+                                  ddc.x*dcbm.y - ddc.y*dcbm.x);
+
+        Scalar raasq = dot(aa, aa);
+        Scalar rbbsq = dot(bb, bb);
+        Scalar rgsq = dot(dcbm, dcbm);
+        Scalar rg = sqrt(rgsq);
+
+        Scalar rginv, raa2inv, rbb2inv;
+        rginv = raa2inv = rbb2inv = Scalar(0.0);
+        if (rg > Scalar(0.0)) rginv = Scalar(1.0)/rg;
+        if (raasq > Scalar(0.0)) raa2inv = Scalar(1.0)/raasq;
+        if (rbbsq > Scalar(0.0)) rbb2inv = Scalar(1.0)/rbbsq;
+        Scalar rabinv = sqrt(raa2inv*rbb2inv);
+
+        Scalar c_abcd = dot(aa, bb)*rabinv;
+        Scalar s_abcd = rg*rabinv*dot(aa, ddc);
+
+        if (c_abcd > Scalar(1.0)) c_abcd = Scalar(1.0);
+        if (c_abcd < -Scalar(1.0)) c_abcd = -Scalar(1.0);
+
+        // compute -dU/dphi and the energy
+        Scalar df = Scalar(0.0);
+        Scalar dihedral_eng = Scalar(0.0);
+        evaluator eval(c_abcd, s_abcd, h_params.data[h_typeval.data[i].type]);
+        eval.evalForceAndEnergy(df, dihedral_eng);
+
+        // derivatives of phi with respect to the separation vectors
+        Scalar fg = dot(dab, dcbm);
+        Scalar hg = dot(ddc, dcbm);
+        Scalar fga = fg*raa2inv*rginv;
+        Scalar hgb = hg*rbb2inv*rginv;
+        Scalar gaa = -raa2inv*rg;
+        Scalar gbb = rbb2inv*rg;
+
+        Scalar3 dtf = gaa*aa;
+        Scalar3 dtg = fga*aa - hgb*bb;
+        Scalar3 dth = gbb*bb;
+
+        Scalar3 s2 = df*dtg;
+        Scalar3 ffa = df*dtf;
+        Scalar3 ffb = s2 - ffa;
+        Scalar3 ffd = df*dth;
+        Scalar3 ffc = -s2 - ffd;
+
+        // compute 1/4 of the energy, 1/4 for each atom in the dihedral
+        dihedral_eng *= Scalar(0.25);
+
+        // compute 1/4 of the virial, 1/4 for each atom in the dihedral
+        // upper triangular version of virial tensor
+        Scalar dihedral_virial[6];
+        if (compute_virial)
+            {
+            dihedral_virial[0] = Scalar(0.25)*(dab.x*ffa.x + dcb.x*ffc.x + (ddc.x+dcb.x)*ffd.x);
+            dihedral_virial[1] = Scalar(0.25)*(dab.y*ffa.x + dcb.y*ffc.x + (ddc.y+dcb.y)*ffd.x);
+            dihedral_virial[2] = Scalar(0.25)*(dab.z*ffa.x + dcb.z*ffc.x + (ddc.z+dcb.z)*ffd.x);
+            dihedral_virial[3] = Scalar(0.25)*(dab.y*ffa.y + dcb.y*ffc.y + (ddc.y+dcb.y)*ffd.y);
+            dihedral_virial[4] = Scalar(0.25)*(dab.z*ffa.y + dcb.z*ffc.y + (ddc.z+dcb.z)*ffd.y);
+            dihedral_virial[5] = Scalar(0.25)*(dab.z*ffa.z + dcb.z*ffc.z + (ddc.z+dcb.z)*ffd.z);
+            }
+
+        // Now, apply the force to each individual atom a,b,c,d, and accumulate the energy/virial
+        const unsigned int idx[4] = {idx_a, idx_b, idx_c, idx_d};
+        const Scalar3 f[4] = {ffa, ffb, ffc, ffd};
+        for (unsigned int m = 0; m < 4; m++)
+            {
+            force[idx[m]].x += f[m].x;
+            force[idx[m]].y += f[m].y;
+            force[idx[m]].z += f[m].z;
+            force[idx[m]].w += dihedral_eng;
+            if (compute_virial)
+                for (unsigned int k = 0; k < 6; k++)
+                    virial[k*virial_pitch+idx[m]] += dihedral_virial[k];
+            }
+        };
+
+    // for each of the dihedrals
+    const unsigned int size = (unsigned int)m_dihedral_data->getN();
+
+    // the forces of a dihedral are scattered to its members, including ghosts
+    m_force_scatter.scatter(size, n_all, compute_virial, compute_dihedral, h_force.data, h_virial.data, m_virial_pitch);
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+template < class evaluator >
+CommFlags PotentialDihedral< evaluator >::getRequestedCommFlags(unsigned int timestep)
+    {
+    CommFlags flags = CommFlags(0);
+
+    flags[comm_flag::tag] = 1;
+
+    flags |= ForceCompute::getRequestedCommFlags(timestep);
+
+    return flags;
+    }
+#endif
+
+//! Exports the PotentialDihedral class to python
+/*! \param name Name of the class in the exported python module
+    \tparam T class type to export. \b Must be an instantiated PotentialDihedral class template.
+*/
+template < class T > void export_PotentialDihedral(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<T, std::shared_ptr<T> >(m, name.c_str(),pybind11::base<ForceCompute>())
+        .def(pybind11::init< std::shared_ptr<SystemDefinition>, const std::string& > ())
+        .def("setParams", &T::setParams)
+        ;
+    }
+
+#endif
@@ -69,6 +69,7 @@ class PotentialExternal: public ForceCompute
             // reallocate parameter array
             GPUArray<param_type> params(m_pdata->getNTypes(), m_exec_conf);
             m_params.swap(params);
+            TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
             }
    };
 
@@ -89,6 +90,11 @@ PotentialExternal<evaluator>::PotentialExternal(std::shared_ptr<SystemDefinition
     GPUArray<field_type> field(1, m_exec_conf);
     m_field.swap(field);
 
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_field, m_log_name);
+
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_pdata->getNumTypesChangeSignal().template connect<PotentialExternal<evaluator>, &PotentialExternal<evaluator>::slotNumTypesChange>(this);
     }
@@ -18,6 +18,7 @@
 #include "hoomd/GlobalArray.h"
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
+#include "NeighborListCluster.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 
 #ifdef ENABLE_CUDA
@@ -78,6 +79,16 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    On the CPU, every PotentialPair registers a view of the neighbor list with its own cutoffs (see NeighborList), so
+    that a short ranged potential sharing the list with a long ranged one only loops over its nearest neighbors.
+
+    When the neighbor list is a NeighborListCluster, the forces are computed directly from its cluster pairs, and the
+    per-particle neighbor list is never expanded.
+
+    With ForceCompute::setMixedPrecision(), the pair separations are computed in single precision from positions
+    relative to the local box origin. The evaluator and the accumulation of forces, energies and virials remain in
+    Scalar.
+
     For profiling and logging, PotentialPair needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -158,6 +169,10 @@ class PotentialPair : public ForceCompute
 
     protected:
         std::shared_ptr<NeighborList> m_nlist;    //!< The neighborlist to use for the computation
+        std::shared_ptr<NeighborListCluster> m_nlist_cluster; //!< m_nlist if it provides cluster pairs
+        unsigned int m_nlist_view;                  //!< View of m_nlist with the cutoffs of this potential
+        bool m_has_nlist_view;                      //!< True if m_nlist_view was registered
+        std::vector<Scalar4> m_cluster_pos;         //!< Positions of the cluster members, in cluster order
         energyShiftMode m_shift_mode;               //!< Store the mode with which to handle the energy shift at r_cut
         Index2D m_typpair_idx;                      //!< Helper class for indexing per type pair arrays
         GlobalArray<Scalar> m_rcutsq;                  //!< Cutoff radius squared per type pair
@@ -169,6 +184,22 @@ class PotentialPair : public ForceCompute
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces from the cluster pairs of m_nlist_cluster
+        void computeForcesCluster(unsigned int timestep);
+
+        //! Evaluate a single pair, including the energy shift and XPLOR smoothing
+        inline bool evalPair(Scalar rsq,
+                             unsigned int typpair_idx,
+                             Scalar di,
+                             Scalar dj,
+                             Scalar qi,
+                             Scalar qj,
+                             const param_type *params,
+                             const Scalar *rcutsq_list,
+                             const Scalar *ronsq_list,
+                             Scalar& force_divr,
+                             Scalar& pair_eng);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -188,6 +219,9 @@ class PotentialPair : public ForceCompute
             m_ronsq.swap(ronsq);
             GlobalArray<param_type> params(m_typpair_idx.getNumElements(), m_exec_conf);
             m_params.swap(params);
+            TAG_ALLOCATION_INSTANCE(m_rcutsq, m_log_name);
+            TAG_ALLOCATION_INSTANCE(m_ronsq, m_log_name);
+            TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
 
             #ifdef ENABLE_CUDA
             if (m_pdata->getExecConf()->isCUDAEnabled() && m_pdata->getExecConf()->allConcurrentManagedAccess())
@@ -227,6 +261,18 @@ PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysd
     assert(m_pdata);
     assert(m_nlist);
 
+    m_nlist_cluster = std::dynamic_pointer_cast<NeighborListCluster>(m_nlist);
+    m_mixed_precision_supported = true;
+
+    // only loop over the neighbors within our own cutoffs when the list is shared with longer ranged forces
+    m_nlist_view = 0;
+    m_has_nlist_view = false;
+    if (!m_exec_conf->isCUDAEnabled() && !m_nlist_cluster)
+        {
+        m_nlist_view = m_nlist->addView();
+        m_has_nlist_view = true;
+        }
+
     GlobalArray<Scalar> rcutsq(m_typpair_idx.getNumElements(), m_exec_conf);
     m_rcutsq.swap(rcutsq);
     GlobalArray<Scalar> ronsq(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -258,6 +304,12 @@ PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysd
     m_prof_name = std::string("Pair ") + evaluator::getName();
     m_log_name = std::string("pair_") + evaluator::getName() + std::string("_energy") + log_suffix;
 
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_rcutsq, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_ronsq, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_pdata->getNumTypesChangeSignal().template connect<PotentialPair<evaluator>, &PotentialPair<evaluator>::slotNumTypesChange>(this);
     }
@@ -268,6 +320,9 @@ PotentialPair< evaluator >::~PotentialPair()
     m_exec_conf->msg->notice(5) << "Destroying PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
     m_pdata->getNumTypesChangeSignal().template disconnect<PotentialPair<evaluator>, &PotentialPair<evaluator>::slotNumTypesChange>(this);
+
+    if (m_has_nlist_view)
+        m_nlist->removeView(m_nlist_view);
     }
 
 /*! \param typ1 First type index in the pair
@@ -310,6 +365,9 @@ void PotentialPair< evaluator >::setRcut(unsigned int typ1, unsigned int typ2, S
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
     h_rcutsq.data[m_typpair_idx(typ1, typ2)] = rcut * rcut;
     h_rcutsq.data[m_typpair_idx(typ2, typ1)] = rcut * rcut;
+
+    if (m_has_nlist_view)
+        m_nlist->setViewRCutPair(m_nlist_view, typ1, typ2, rcut);
     }
 
 /*! \param typ1 First type index in the pair
@@ -390,12 +448,27 @@ Scalar PotentialPair< evaluator >::getLogValue(const std::string& quantity, unsi
 template< class evaluator >
 void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     {
+    // the cluster pair neighbor list has its own kernel
+    if (m_nlist_cluster)
+        {
+        computeForcesCluster(timestep);
+        return;
+        }
+
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
+    // number of neighbors within our own cutoffs, if the list maintains views
+    const unsigned int *view_n_neigh = m_has_nlist_view ? m_nlist->getViewNNeigh(m_nlist_view) : NULL;
+
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    // read the positions in single precision relative to the box origin if requested
+    const bool mixed = m_mixed_precision;
+    if (mixed)
+        updateMixedPositions();
+
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -434,6 +507,7 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        float4 pi_mixed = mixed ? m_pos_mixed[i] : make_float4(0, 0, 0, 0);
 
         // sanity check
         assert(typei < m_pdata->getNTypes());
@@ -458,19 +532,28 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
         // loop over all of the neighbors of this particle
         const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int size = view_n_neigh ? view_n_neigh[i] : (unsigned int)h_n_neigh.data[i];
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int j = h_nlist.data[myHead + k];
             assert(j < m_pdata->getN() + m_pdata->getNGhosts());
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            // calculate dr_ji and access the type of the neighbor particle (MEM TRANSFER: 4 scalars / FLOPS: 3)
+            Scalar3 dx;
+            unsigned int typej;
+            if (mixed)
+                {
+                const float4& pj = m_pos_mixed[j];
+                dx = make_scalar3(pi_mixed.x - pj.x, pi_mixed.y - pj.y, pi_mixed.z - pj.z);
+                typej = __float_as_int(pj.w);
+                }
+            else
+                {
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                dx = pi - pj;
+                typej = __scalar_as_int(h_pos.data[j].w);
+                }
             assert(typej < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
@@ -487,65 +570,14 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             // calculate r_ij squared (FLOPS: 5)
             Scalar rsq = dot(dx, dx);
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
-                {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
-
             // compute the force and potential energy
             Scalar force_divr = Scalar(0.0);
             Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            bool evaluated = evalPair(rsq, m_typpair_idx(typei, typej), di, dj, qi, qj,
+                                      h_params.data, h_rcutsq.data, h_ronsq.data, force_divr, pair_eng);
 
             if (evaluated)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
-
                 Scalar force_div2r = force_divr * Scalar(0.5);
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
@@ -603,6 +635,277 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     if (m_prof) m_prof->pop();
     }
 
+/*! \param rsq Squared distance between the particles
+    \param typpair_idx Index of the type pair
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+    \param params Parameters of all type pairs
+    \param rcutsq_list Squared cutoffs of all type pairs
+    \param ronsq_list Squared XPLOR onset radii of all type pairs
+    \param force_divr Output: force divided by r
+    \param pair_eng Output: pair energy
+
+    \returns True if the pair is within the cutoff
+*/
+template< class evaluator >
+inline bool PotentialPair< evaluator >::evalPair(Scalar rsq,
+                                                 unsigned int typpair_idx,
+                                                 Scalar di,
+                                                 Scalar dj,
+                                                 Scalar qi,
+                                                 Scalar qj,
+                                                 const param_type *params,
+                                                 const Scalar *rcutsq_list,
+                                                 const Scalar *ronsq_list,
+                                                 Scalar& force_divr,
+                                                 Scalar& pair_eng)
+    {
+    // get parameters for this type pair
+    param_type param = params[typpair_idx];
+    Scalar rcutsq = rcutsq_list[typpair_idx];
+    Scalar ronsq = Scalar(0.0);
+    if (m_shift_mode == xplor)
+        ronsq = ronsq_list[typpair_idx];
+
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (m_shift_mode == shift)
+        energy_shift = true;
+    else if (m_shift_mode == xplor)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    // compute the force and potential energy
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    if (evaluated)
+        {
+        // modify the potential for xplor shifting
+        if (m_shift_mode == xplor)
+            {
+            if (rsq >= ronsq && rsq < rcutsq)
+                {
+                // Implement XPLOR smoothing (FLOPS: 16)
+                Scalar old_pair_eng = pair_eng;
+                Scalar old_force_divr = force_divr;
+
+                // calculate 1.0 / (xplor denominator)
+                Scalar xplor_denom_inv =
+                    Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                           (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                // make modifications to the old pair energy and force
+                pair_eng = old_pair_eng * s;
+                // note: I'm not sure why the minus sign needs to be there: my notes have a +
+                // But this is verified correct via plotting
+                force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                }
+            }
+        }
+
+    return evaluated;
+    }
+
+/*! Loops over the cluster pairs of a NeighborListCluster. The positions of the members of all clusters are gathered
+    in cluster order first, so that the four members of a j-cluster are read from consecutive memory. The forces on
+    the members of the i-cluster are accumulated in registers over all of its cluster pairs.
+
+    \param timestep specifies the current time step of the simulation
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeForcesCluster(unsigned int timestep)
+    {
+    // start by updating the cluster pairs
+    m_nlist_cluster->computeClusters(timestep);
+
+    // start the profile for this compute
+    if (m_prof) m_prof->push(m_prof_name);
+
+    // read the positions in single precision relative to the box origin if requested
+    const bool mixed = m_mixed_precision;
+    if (mixed)
+        updateMixedPositions();
+
+    bool third_law = m_nlist_cluster->getStorageMode() == NeighborList::half;
+
+    const std::vector<unsigned int>& members = m_nlist_cluster->getClusterMembers();
+    const std::vector<unsigned int>& cluster_head = m_nlist_cluster->getClusterHeadList();
+    const std::vector<uint2>& cluster_pairs = m_nlist_cluster->getClusterPairs();
+    const unsigned int n_clusters = m_nlist_cluster->getNClusters();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    //force arrays
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    // gather the positions of the cluster members, padding entries are never read
+    m_cluster_pos.resize(members.size());
+    for (unsigned int k = 0; k < members.size(); k++)
+        {
+        if (members[k] == NeighborListCluster::CLUSTER_PADDING)
+            continue;
+
+        if (mixed)
+            {
+            const float4& p = m_pos_mixed[members[k]];
+            m_cluster_pos[k] = make_scalar4(p.x, p.y, p.z, h_pos.data[members[k]].w);
+            }
+        else
+            m_cluster_pos[k] = h_pos.data[members[k]];
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    for (unsigned int cluster_i = 0; cluster_i < n_clusters; cluster_i++)
+        {
+        const unsigned int *members_i = &members[cluster_i*NLIST_CLUSTER_SIZE];
+        const Scalar4 *pos_i = &m_cluster_pos[cluster_i*NLIST_CLUSTER_SIZE];
+
+        // initialize the force, potential energy, and virial of the members to 0
+        Scalar3 fi[NLIST_CLUSTER_SIZE];
+        Scalar pei[NLIST_CLUSTER_SIZE];
+        Scalar virial_i[NLIST_CLUSTER_SIZE][6];
+        for (unsigned int a = 0; a < NLIST_CLUSTER_SIZE; a++)
+            {
+            fi[a] = make_scalar3(0, 0, 0);
+            pei[a] = Scalar(0.0);
+            for (unsigned int l = 0; l < 6; l++)
+                virial_i[a][l] = Scalar(0.0);
+            }
+
+        // loop over all cluster pairs of this cluster
+        for (unsigned int p = cluster_head[cluster_i]; p < cluster_head[cluster_i+1]; p++)
+            {
+            const unsigned int *members_j = &members[cluster_pairs[p].x*NLIST_CLUSTER_SIZE];
+            const Scalar4 *pos_j = &m_cluster_pos[cluster_pairs[p].x*NLIST_CLUSTER_SIZE];
+
+            // loop over the interacting particle pairs
+            unsigned int mask = cluster_pairs[p].y;
+            for (unsigned int bit = 0; mask; bit++, mask >>= 1)
+                {
+                if (!(mask & 1))
+                    continue;
+
+                const unsigned int a = bit / NLIST_CLUSTER_SIZE;
+                const unsigned int b = bit % NLIST_CLUSTER_SIZE;
+                const unsigned int i = members_i[a];
+                const unsigned int j = members_j[b];
+
+                Scalar3 dx = make_scalar3(pos_i[a].x - pos_j[b].x, pos_i[a].y - pos_j[b].y, pos_i[a].z - pos_j[b].z);
+                dx = box.minImage(dx);
+                Scalar rsq = dot(dx, dx);
+
+                unsigned int typei = __scalar_as_int(pos_i[a].w);
+                unsigned int typej = __scalar_as_int(pos_j[b].w);
+
+                // access diameter and charge (if needed)
+                Scalar di = Scalar(0.0);
+                Scalar dj = Scalar(0.0);
+                Scalar qi = Scalar(0.0);
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    {
+                    di = h_diameter.data[i];
+                    dj = h_diameter.data[j];
+                    }
+                if (evaluator::needsCharge())
+                    {
+                    qi = h_charge.data[i];
+                    qj = h_charge.data[j];
+                    }
+
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                if (!evalPair(rsq, m_typpair_idx(typei, typej), di, dj, qi, qj,
+                              h_params.data, h_rcutsq.data, h_ronsq.data, force_divr, pair_eng))
+                    continue;
+
+                Scalar force_div2r = force_divr * Scalar(0.5);
+                fi[a] += dx*force_divr;
+                pei[a] += pair_eng * Scalar(0.5);
+                if (compute_virial)
+                    {
+                    virial_i[a][0] += force_div2r*dx.x*dx.x;
+                    virial_i[a][1] += force_div2r*dx.x*dx.y;
+                    virial_i[a][2] += force_div2r*dx.x*dx.z;
+                    virial_i[a][3] += force_div2r*dx.y*dx.y;
+                    virial_i[a][4] += force_div2r*dx.y*dx.z;
+                    virial_i[a][5] += force_div2r*dx.z*dx.z;
+                    }
+
+                // add the force to particle j if we are using the third law, only for local particles
+                if (third_law && j < N)
+                    {
+                    h_force.data[j].x -= dx.x*force_divr;
+                    h_force.data[j].y -= dx.y*force_divr;
+                    h_force.data[j].z -= dx.z*force_divr;
+                    h_force.data[j].w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        {
+                        h_virial.data[0*m_virial_pitch+j] += force_div2r*dx.x*dx.x;
+                        h_virial.data[1*m_virial_pitch+j] += force_div2r*dx.x*dx.y;
+                        h_virial.data[2*m_virial_pitch+j] += force_div2r*dx.x*dx.z;
+                        h_virial.data[3*m_virial_pitch+j] += force_div2r*dx.y*dx.y;
+                        h_virial.data[4*m_virial_pitch+j] += force_div2r*dx.y*dx.z;
+                        h_virial.data[5*m_virial_pitch+j] += force_div2r*dx.z*dx.z;
+                        }
+                    }
+                }
+            }
+
+        // finally, increment the force, potential energy and virial of the local members
+        for (unsigned int a = 0; a < NLIST_CLUSTER_SIZE; a++)
+            {
+            const unsigned int i = members_i[a];
+            if (i >= N)
+                continue;
+
+            h_force.data[i].x += fi[a].x;
+            h_force.data[i].y += fi[a].y;
+            h_force.data[i].z += fi[a].z;
+            h_force.data[i].w += pei[a];
+            if (compute_virial)
+                {
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial.data[l*m_virial_pitch+i] += virial_i[a][l];
+                }
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 #ifdef ENABLE_MPI
 /*! \param timestep Current time step
  */
@@ -84,6 +84,15 @@ PotentialPairDPDThermo< evaluator >::PotentialPairDPDThermo(std::shared_ptr<Syst
                                                 const std::string& log_suffix)
     : PotentialPair<evaluator>(sysdef,nlist, log_suffix)
     {
+    // the thermostat kernel reads the positions in Scalar
+    this->m_mixed_precision_supported = false;
+
+    // computeForces() loops over the whole list, so a view would only cost a reordering on every build
+    if (this->m_has_nlist_view)
+        {
+        this->m_nlist->removeView(this->m_nlist_view);
+        this->m_has_nlist_view = false;
+        }
     }
 
 /*! \param seed Stored seed for PRNG
@@ -84,6 +84,10 @@ PotentialSpecialPair< evaluator >::PotentialSpecialPair(std::shared_ptr<SystemDe
     // allocate the parameters
     GPUArray<param_type> params(m_pair_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
     }
 
 template< class evaluator >
@@ -15,7 +15,11 @@
 #include "hoomd/GPUArray.h"
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
+#include "ThreadedForceScatter.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 /*! \file PotentialTersoff.h
     \brief Defines the template class for standard three-body potentials
@@ -62,6 +66,11 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    The separation vectors of all neighbor pairs are computed once per step and cached in a buffer aligned to the
+    neighbor list, so the chi and the ik force loops over the triplets only read them. In TBB builds, the loop over
+    particles runs in parallel threads. Because the forces on j and k are scattered to other particles, every thread
+    accumulates them in its own force and virial arrays, which ThreadedForceScatter sums up at the end.
+
     For profiling and logging, PotentialTersoff needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -107,6 +116,9 @@ class PotentialTersoff : public ForceCompute
         GPUArray<param_type> m_params;   //!< Pair parameters per type pair
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
+        std::vector<Scalar4> m_pair_cache;          //!< Separation vector and its square for every neighbor list entry
+
+        ThreadedForceScatter m_force_scatter;       //!< Accumulates the scattered forces over the threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -129,6 +141,9 @@ class PotentialTersoff : public ForceCompute
             m_ronsq.swap(ronsq);
             GPUArray<param_type> params(m_typpair_idx.getNumElements(), m_exec_conf);
             m_params.swap(params);
+            TAG_ALLOCATION_INSTANCE(m_rcutsq, m_log_name);
+            TAG_ALLOCATION_INSTANCE(m_ronsq, m_log_name);
+            TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
             }
     };
 
@@ -158,6 +173,12 @@ PotentialTersoff< evaluator >::PotentialTersoff(std::shared_ptr<SystemDefinition
     m_prof_name = std::string("Triplet ") + evaluator::getName();
     m_log_name = std::string("pair_") + evaluator::getName() + std::string("_energy") + log_suffix;
 
+    // tell the arrays of the instances of this template apart in the memory accounting
+    tagForceAllocations(m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_rcutsq, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_ronsq, m_log_name);
+    TAG_ALLOCATION_INSTANCE(m_params, m_log_name);
+
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_pdata->getNumTypesChangeSignal().template connect<PotentialTersoff<evaluator>, &PotentialTersoff<evaluator>::slotNumTypesChange>(this);
     }
@@ -311,12 +332,48 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
     memset(h_virial.data, 0, sizeof(Scalar)*6*m_virial_pitch);
 
     unsigned int ntypes = m_pdata->getNTypes();
-
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_all = N + m_pdata->getNGhosts();
+
+    // cache the separation vector and its square for every entry of the neighbor list
+    if (m_pair_cache.size() < m_nlist->getNListArray().getNumElements())
+        m_pair_cache.resize(m_nlist->getNListArray().getNumElements());
+
+    #ifdef ENABLE_TBB
+    tbb::parallel_for((unsigned int)0, N, [&](unsigned int i)
+    #else
+    for (unsigned int i = 0; i < N; i++)
+    #endif
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int head_i = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+
+        for (unsigned int j = 0; j < size; j++)
+            {
+            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+            unsigned int jj = h_nlist.data[head_i + j];
+            assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+
+            // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
+            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+            Scalar3 dxij = posi - posj;
+
+            // apply periodic boundary conditions
+            dxij = box.minImage(dxij);
+
+            // compute rij_sq (FLOPS: 5)
+            m_pair_cache[head_i + j] = make_scalar4(dxij.x, dxij.y, dxij.z, dot(dxij, dxij));
+            }
+        }
+    #ifdef ENABLE_TBB
+        );
+    #endif
+
+    // compute the forces of the triplets centered on particle i, and add them to the given force and virial arrays
+    auto compute_particle = [&](unsigned int i, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+        {
+        // access the particle's type (MEM TRANSFER: 1 scalar)
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
         const unsigned int head_i = h_head_list.data[i];
         // sanity check
@@ -347,23 +404,13 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
             {
             for (unsigned int j = 0; j < size; j++)
                 {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+                // access the index and type of neighbor j
                 unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
                 unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
                 assert(typej < m_pdata->getNTypes());
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+                // get rij_sq from the cache
+                Scalar rij_sq = m_pair_cache[head_i + j].w;
 
                 // get parameters for this type pair
                 unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -391,12 +438,8 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
         // loop over all of the neighbors of this particle
         for (unsigned int j = 0; j < size; j++)
             {
-            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+            // access the index and type of neighbor j (MEM TRANSFER: 2 scalars)
             unsigned int jj = h_nlist.data[head_i + j];
-            assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // access the position and type of particle j
-            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
             unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
             assert(typej < m_pdata->getNTypes());
 
@@ -404,14 +447,10 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
             Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
             Scalar pej = 0.0;
 
-            // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 dxij = posi - posj;
-
-            // apply periodic boundary conditions
-            dxij = box.minImage(dxij);
-
-            // compute rij_sq (FLOPS: 5)
-            Scalar rij_sq = dot(dxij, dxij);
+            // get dr_ij and rij_sq from the cache (MEM TRANSFER: 4 scalars)
+            Scalar4 cache_ij = m_pair_cache[head_i + j];
+            Scalar3 dxij = make_scalar3(cache_ij.x, cache_ij.y, cache_ij.z);
+            Scalar rij_sq = cache_ij.w;
 
             // get parameters for this type pair
             unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -439,12 +478,8 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                     {
                     for (unsigned int k = 0; k < size; k++)
                         {
-                        // access the index of neighbor k
+                        // access the index and type of neighbor k
                         unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
                         unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
                         assert(typek < m_pdata->getNTypes());
 
@@ -457,14 +492,10 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
                         if (kk != jj && temp_evaluated)
                             {
-                            // compute drik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply periodic boundary conditions
-                            dxik = box.minImage(dxik);
-
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            // get dr_ik and rik_sq from the cache
+                            Scalar4 cache_ik = m_pair_cache[head_i + k];
+                            Scalar3 dxik = make_scalar3(cache_ik.x, cache_ik.y, cache_ik.z);
+                            Scalar rik_sq = cache_ik.w;
 
                             // compute the bond angle (if needed)
                             Scalar cos_th = Scalar(0.0);
@@ -524,12 +555,8 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                     // evaluate the force from the ik interactions
                     for (unsigned int k = 0; k < size; k++)
                         {
-                        // access the index of neighbor k
+                        // access the index and type of neighbor k
                         unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
                         unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
                         assert(typek < m_pdata->getNTypes());
 
@@ -545,14 +572,10 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                             // create variable for the force on k
                             Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                            // compute dr_ik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply periodic boundary conditions
-                            dxik = box.minImage(dxik);
-
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            // get dr_ik and rik_sq from the cache
+                            Scalar4 cache_ik = m_pair_cache[head_i + k];
+                            Scalar3 dxik = make_scalar3(cache_ik.x, cache_ik.y, cache_ik.z);
+                            Scalar rik_sq = cache_ik.w;
 
                             // compute the bond angle (if needed)
                             Scalar cos_th = Scalar(0.0);
@@ -613,20 +636,20 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
                             // increment the force for particle k
                             unsigned int mem_idx = kk;
-                            h_force.data[mem_idx].x += fk.x;
-                            h_force.data[mem_idx].y += fk.y;
-                            h_force.data[mem_idx].z += fk.z;
+                            force[mem_idx].x += fk.x;
+                            force[mem_idx].y += fk.y;
+                            force[mem_idx].z += fk.z;
 
                             if (compute_virial)
                                 {
                                 Scalar force_div2r_ij = Scalar(0.5)*force_divr_ij.z;
                                 Scalar force_div2r_ik = Scalar(0.5)*force_divr_ik.z;
-                                h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
-                                h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
-                                h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
-                                h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
-                                h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
-                                h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
+                                virial[0*virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.x + force_div2r_ik*dxik.x*dxik.x;
+                                virial[1*virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.y + force_div2r_ik*dxik.x*dxik.y;
+                                virial[2*virial_pitch+mem_idx] += force_div2r_ij*dxij.x*dxij.z + force_div2r_ik*dxik.x*dxik.z;
+                                virial[3*virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.y + force_div2r_ik*dxik.y*dxik.y;
+                                virial[4*virial_pitch+mem_idx] += force_div2r_ij*dxij.y*dxij.z + force_div2r_ik*dxik.y*dxik.z;
+                                virial[5*virial_pitch+mem_idx] += force_div2r_ij*dxij.z*dxij.z + force_div2r_ik*dxik.z*dxik.z;
                                 }
                             }
                         }
@@ -634,38 +657,41 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                 }
             // increment the force and potential energy for particle j
             unsigned int mem_idx = jj;
-            h_force.data[mem_idx].x += fj.x;
-            h_force.data[mem_idx].y += fj.y;
-            h_force.data[mem_idx].z += fj.z;
-            h_force.data[mem_idx].w += pej;
+            force[mem_idx].x += fj.x;
+            force[mem_idx].y += fj.y;
+            force[mem_idx].z += fj.z;
+            force[mem_idx].w += pej;
 
             if (compute_virial)
                 {
-                h_virial.data[0*m_virial_pitch+mem_idx] += virialj_xx;
-                h_virial.data[1*m_virial_pitch+mem_idx] += virialj_xy;
-                h_virial.data[2*m_virial_pitch+mem_idx] += virialj_xz;
-                h_virial.data[3*m_virial_pitch+mem_idx] += virialj_yy;
-                h_virial.data[4*m_virial_pitch+mem_idx] += virialj_yz;
-                h_virial.data[5*m_virial_pitch+mem_idx] += virialj_zz;
+                virial[0*virial_pitch+mem_idx] += virialj_xx;
+                virial[1*virial_pitch+mem_idx] += virialj_xy;
+                virial[2*virial_pitch+mem_idx] += virialj_xz;
+                virial[3*virial_pitch+mem_idx] += virialj_yy;
+                virial[4*virial_pitch+mem_idx] += virialj_yz;
+                virial[5*virial_pitch+mem_idx] += virialj_zz;
                 }
             }
         // finally, increment the force and potential energy for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
 
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += viriali_xx;
-            h_virial.data[1*m_virial_pitch+mem_idx] += viriali_xy;
-            h_virial.data[2*m_virial_pitch+mem_idx] += viriali_xz;
-            h_virial.data[3*m_virial_pitch+mem_idx] += viriali_yy;
-            h_virial.data[4*m_virial_pitch+mem_idx] += viriali_yz;
-            h_virial.data[5*m_virial_pitch+mem_idx] += viriali_zz;
+            virial[0*virial_pitch+mem_idx] += viriali_xx;
+            virial[1*virial_pitch+mem_idx] += viriali_xy;
+            virial[2*virial_pitch+mem_idx] += viriali_xz;
+            virial[3*virial_pitch+mem_idx] += viriali_yy;
+            virial[4*virial_pitch+mem_idx] += viriali_yz;
+            virial[5*virial_pitch+mem_idx] += viriali_zz;
             }
-        }
+        };
+
+    // the forces on j and k are scattered, including to ghosts, so the threads accumulate into their own arrays
+    m_force_scatter.scatter(N, n_all, compute_virial, compute_particle, h_force.data, h_virial.data, m_virial_pitch);
 
     if (m_prof) m_prof->pop();
     }
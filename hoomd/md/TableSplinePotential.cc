@@ -0,0 +1,638 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TableSplinePotential.h"
+#include "hoomd/extern/gsd.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#if defined(__SSE__) && !defined(NVCC)
+#include <immintrin.h>
+#endif
+
+#include <stdexcept>
+#include <cstring>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \file TableSplinePotential.cc
+    \brief Defines the TableSplinePotential class
+*/
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighborlist to use for computing the forces
+    \param log_suffix Name given to this instance of the table potential
+*/
+TableSplinePotential::TableSplinePotential(std::shared_ptr<SystemDefinition> sysdef,
+                                           std::shared_ptr<NeighborList> nlist,
+                                           const std::string& log_suffix)
+        : ForceCompute(sysdef), m_nlist(nlist), m_coeffs(m_exec_conf)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing TableSplinePotential" << endl;
+
+    // sanity checks
+    assert(m_pdata);
+    assert(m_nlist);
+
+    // initialize the number of types value
+    m_ntypes = m_pdata->getNTypes();
+    assert(m_ntypes > 0);
+
+    // allocate storage for the parameters, unset tables have no points
+    Index2DUpperTriangular table_index(m_ntypes);
+    GlobalArray<Scalar4> params(table_index.getNumElements(), m_exec_conf);
+    m_params.swap(params);
+    TAG_ALLOCATION(m_params);
+    m_pair_coeffs.resize(table_index.getNumElements());
+    packTables();
+
+    m_log_name = std::string("pair_table_spline_energy") + log_suffix;
+
+    // connect to the ParticleData to receive notifications when the number of types changes
+    m_pdata->getNumTypesChangeSignal().connect<TableSplinePotential, &TableSplinePotential::slotNumTypesChange>(this);
+    }
+
+TableSplinePotential::~TableSplinePotential()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying TableSplinePotential" << endl;
+
+    m_pdata->getNumTypesChangeSignal().disconnect<TableSplinePotential, &TableSplinePotential::slotNumTypesChange>(this);
+    }
+
+void TableSplinePotential::slotNumTypesChange()
+    {
+    // initialize the number of types value
+    m_ntypes = m_pdata->getNTypes();
+    assert(m_ntypes > 0);
+
+    // skip the reallocation if the number of types does not change
+    // this keeps old parameters when restoring a snapshot
+    // it will result in invalid coefficients if the snapshot has a different type id -> name mapping
+    if (m_ntypes*(m_ntypes+1)/2 == m_params.getNumElements())
+        return;
+
+    // allocate storage for the parameters
+    Index2DUpperTriangular table_index(m_ntypes);
+    GlobalArray<Scalar4> params(table_index.getNumElements(), m_exec_conf);
+    m_params.swap(params);
+    TAG_ALLOCATION(m_params);
+
+    m_pair_coeffs.clear();
+    m_pair_coeffs.resize(table_index.getNumElements());
+    packTables();
+    }
+
+/*! \param typ1 First particle type index in the pair to set
+    \param typ2 Second particle type index in the pair to set
+    \param V Table for the potential V
+    \param F Table for the force F (must be - dV / dr)
+    \param rmin Minimum r in the potential
+    \param rmax Maximum r in the potential
+
+    V and F are given at the points \f$ r_i = \sqrt{r_{min}^2 + i (r_{max}^2 - r_{min}^2)/(n-1)} \f$, where n is the
+    number of points in the tables, which may differ between type pairs.
+    \note There is no need to call this again for typ2,typ1
+*/
+void TableSplinePotential::setTable(unsigned int typ1,
+                                    unsigned int typ2,
+                                    const std::vector<Scalar> &V,
+                                    const std::vector<Scalar> &F,
+                                    Scalar rmin,
+                                    Scalar rmax)
+    {
+    if (typ1 >= m_ntypes || typ2 >= m_ntypes)
+        {
+        m_exec_conf->msg->error() << "pair.table_spline: Invalid particle type specified" << endl;
+        throw runtime_error("Error setting parameters in TableSplinePotential");
+        }
+
+    // range check on the parameters
+    if (rmin < 0 || rmax < 0 || rmax <= rmin)
+        {
+        m_exec_conf->msg->error() << "pair.table_spline rmin, rmax (" << rmin << "," << rmax
+             << ") is invalid" << endl;
+        throw runtime_error("Error initializing TableSplinePotential");
+        }
+
+    const unsigned int n = (unsigned int)V.size();
+    if (n < 2 || F.size() != n)
+        {
+        m_exec_conf->msg->error() << "pair.table_spline: V and F must have the same number of points, at least 2" << endl;
+        throw runtime_error("Error initializing TableSplinePotential");
+        }
+
+    Scalar smin = rmin*rmin;
+    Scalar smax = rmax*rmax;
+    Scalar ds = (smax - smin) / Scalar(n - 1);
+
+    // derivative dV/ds at the grid points, times the interval width
+    std::vector<Scalar> m(n);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        Scalar r = sqrt(smin + ds*Scalar(i));
+        if (r > Scalar(0.0))
+            m[i] = -F[i] / (Scalar(2.0)*r) * ds;
+        else
+            m[i] = V[1] - V[0];
+        }
+
+    // cubic Hermite polynomial on every interval, plus a linear extension as padding
+    unsigned int cur_table_index = Index2DUpperTriangular(m_ntypes)(typ1, typ2);
+    std::vector<Scalar4>& coeffs = m_pair_coeffs[cur_table_index];
+    coeffs.resize(n);
+    for (unsigned int i = 0; i < n-1; i++)
+        {
+        Scalar dV = V[i+1] - V[i];
+        coeffs[i] = make_scalar4(V[i],
+                                 m[i],
+                                 Scalar(3.0)*dV - Scalar(2.0)*m[i] - m[i+1],
+                                 -Scalar(2.0)*dV + m[i] + m[i+1]);
+        }
+    coeffs[n-1] = make_scalar4(V[n-1], m[n-1], Scalar(0.0), Scalar(0.0));
+
+    {
+    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::readwrite);
+    h_params.data[cur_table_index].x = smin;
+    h_params.data[cur_table_index].y = smax;
+    h_params.data[cur_table_index].z = Scalar(1.0) / ds;
+    }
+
+    packTables();
+    }
+
+/*! Every table is placed right after the previous one. The first entry of m_coeffs is a zero padding entry, which
+    the unset tables and the neighbors outside of the tables point to.
+*/
+void TableSplinePotential::packTables()
+    {
+    unsigned int total = 1;
+    for (unsigned int cur = 0; cur < m_pair_coeffs.size(); cur++)
+        total += (unsigned int)m_pair_coeffs[cur].size();
+
+    m_coeffs.resize(total);
+
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::readwrite);
+
+    h_coeffs.data[0] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+    unsigned int offset = 1;
+    for (unsigned int cur = 0; cur < m_pair_coeffs.size(); cur++)
+        {
+        const std::vector<Scalar4>& coeffs = m_pair_coeffs[cur];
+        if (coeffs.size() == 0)
+            {
+            // no pair is within the range of an unset table
+            h_params.data[cur] = make_scalar4(0.0, 0.0, 0.0, __int_as_scalar(0));
+            continue;
+            }
+
+        std::copy(coeffs.begin(), coeffs.end(), h_coeffs.data + offset);
+        h_params.data[cur].w = __int_as_scalar(offset);
+        offset += (unsigned int)coeffs.size();
+        }
+    }
+
+/*! \param typ1 First particle type index in the pair
+    \param typ2 Second particle type index in the pair
+    \returns rmin and rmax of the table
+*/
+Scalar2 TableSplinePotential::getRange(unsigned int typ1, unsigned int typ2)
+    {
+    if (typ1 >= m_ntypes || typ2 >= m_ntypes)
+        {
+        m_exec_conf->msg->error() << "pair.table_spline: Invalid particle type specified" << endl;
+        throw runtime_error("Error getting table range");
+        }
+
+    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+    Scalar4 params = h_params.data[Index2DUpperTriangular(m_ntypes)(typ1, typ2)];
+    return make_scalar2(sqrt(params.x), sqrt(params.y));
+    }
+
+//! Helper function to read a table chunk of floating point values from a GSD file
+/*! \param handle Open GSD file
+    \param name Name of the chunk
+    \param data Output values
+    \returns true if the chunk is present in frame 0
+*/
+static bool read_table_chunk(gsd_handle& handle, const std::string& name, std::vector<double>& data)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&handle, 0, name.c_str());
+    if (entry == NULL)
+        return false;
+
+    size_t n = entry->N * entry->M;
+    data.resize(n);
+    int retval;
+    if (entry->type == GSD_TYPE_DOUBLE)
+        {
+        retval = gsd_read_chunk(&handle, data.data(), entry);
+        }
+    else if (entry->type == GSD_TYPE_FLOAT)
+        {
+        std::vector<float> buf(n);
+        retval = gsd_read_chunk(&handle, buf.data(), entry);
+        std::copy(buf.begin(), buf.end(), data.begin());
+        }
+    else
+        {
+        throw runtime_error("Table chunk " + name + " is not of floating point type");
+        }
+
+    if (retval != 0)
+        throw runtime_error("Error reading table chunk " + name);
+
+    return true;
+    }
+
+/*! \param filename Name of the GSD file
+
+    For every type pair (A,B), frame 0 of the file may contain the chunks
+    - \c table/A,B/r with rmin and rmax
+    - \c table/A,B/V with the values of V
+    - \c table/A,B/F with the values of F
+    at the grid points described in setTable(). The chunks may also be named \c table/B,A/.... Type pairs that are
+    not present keep their current table. The file is read on the root rank.
+*/
+void TableSplinePotential::readTables(const std::string& filename)
+    {
+    Index2DUpperTriangular table_index(m_ntypes);
+    std::vector< std::vector<double> > V(table_index.getNumElements());
+    std::vector< std::vector<double> > F(table_index.getNumElements());
+    std::vector< std::vector<double> > range(table_index.getNumElements());
+
+    bool root = true;
+    #ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+    #endif
+
+    if (root)
+        {
+        gsd_handle handle;
+        int retval = gsd_open(&handle, filename.c_str(), GSD_OPEN_READONLY);
+        if (retval != 0)
+            {
+            m_exec_conf->msg->error() << "pair.table_spline: Unable to open " << filename << endl;
+            throw runtime_error("Error reading table file");
+            }
+
+        try
+            {
+            for (unsigned int i = 0; i < m_ntypes; i++)
+                for (unsigned int j = i; j < m_ntypes; j++)
+                    {
+                    unsigned int cur = table_index(i,j);
+                    std::string prefix = "table/" + m_pdata->getNameByType(i) + "," + m_pdata->getNameByType(j) + "/";
+                    if (!read_table_chunk(handle, prefix + "r", range[cur]))
+                        {
+                        prefix = "table/" + m_pdata->getNameByType(j) + "," + m_pdata->getNameByType(i) + "/";
+                        if (!read_table_chunk(handle, prefix + "r", range[cur]))
+                            continue;
+                        }
+
+                    if (range[cur].size() != 2 ||
+                        !read_table_chunk(handle, prefix + "V", V[cur]) ||
+                        !read_table_chunk(handle, prefix + "F", F[cur]))
+                        {
+                        throw runtime_error("Incomplete table " + prefix);
+                        }
+                    }
+            }
+        catch (const std::runtime_error& e)
+            {
+            gsd_close(&handle);
+            m_exec_conf->msg->error() << "pair.table_spline: " << e.what() << " in " << filename << endl;
+            throw runtime_error("Error reading table file");
+            }
+
+        gsd_close(&handle);
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        bcast(V, 0, m_exec_conf->getMPICommunicator());
+        bcast(F, 0, m_exec_conf->getMPICommunicator());
+        bcast(range, 0, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    for (unsigned int i = 0; i < m_ntypes; i++)
+        for (unsigned int j = i; j < m_ntypes; j++)
+            {
+            unsigned int cur = table_index(i,j);
+            if (range[cur].size() == 0)
+                continue;
+
+            m_exec_conf->msg->notice(5) << "pair.table_spline: read table " << m_pdata->getNameByType(i) << ","
+                << m_pdata->getNameByType(j) << " with " << V[cur].size() << " points" << endl;
+            setTable(i, j, std::vector<Scalar>(V[cur].begin(), V[cur].end()),
+                std::vector<Scalar>(F[cur].begin(), F[cur].end()), range[cur][0], range[cur][1]);
+            }
+    }
+
+/*! TableSplinePotential provides
+    - \c pair_table_spline_energy
+*/
+std::vector< std::string > TableSplinePotential::getProvidedLogQuantities()
+    {
+    vector<string> list;
+    list.push_back(m_log_name);
+    return list;
+    }
+
+Scalar TableSplinePotential::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == m_log_name)
+        {
+        compute(timestep);
+        return calcEnergySum();
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "pair.table_spline: " << quantity << " is not a valid log quantity for TableSplinePotential" << endl;
+        throw runtime_error("Error getting log value");
+        }
+    }
+
+//! Evaluate the splines of a block of neighbors
+/*! \param coeffs Spline coefficients of all tables
+    \param idx Index of the interval of every neighbor
+    \param f Fractional position in the interval
+    \param scale -2/ds for neighbors within the table, zero otherwise
+    \param V Output energies, zero outside of the table
+    \param force_divr Output force divided by r
+*/
+static inline void eval_spline_block(const Scalar4 *coeffs, const unsigned int *idx, const Scalar *f,
+    const Scalar *scale, Scalar *V, Scalar *force_divr)
+    {
+    #if defined(__AVX__) && !defined(SINGLE_PRECISION)
+    // load the coefficients of the four neighbors, and transpose them to (a0..a3), (b0..b3), ...
+    __m256d r0 = _mm256_loadu_pd(&coeffs[idx[0]].x);
+    __m256d r1 = _mm256_loadu_pd(&coeffs[idx[1]].x);
+    __m256d r2 = _mm256_loadu_pd(&coeffs[idx[2]].x);
+    __m256d r3 = _mm256_loadu_pd(&coeffs[idx[3]].x);
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    __m256d a = _mm256_permute2f128_pd(t0, t2, 0x20);
+    __m256d b = _mm256_permute2f128_pd(t1, t3, 0x20);
+    __m256d c = _mm256_permute2f128_pd(t0, t2, 0x31);
+    __m256d d = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    __m256d vf = _mm256_loadu_pd(f);
+    __m256d vs = _mm256_loadu_pd(scale);
+
+    // V = a + f (b + f (c + f d)), dV/df = b + f (2 c + 3 f d)
+    __m256d v = _mm256_add_pd(a, _mm256_mul_pd(vf, _mm256_add_pd(b, _mm256_mul_pd(vf, _mm256_add_pd(c,
+        _mm256_mul_pd(vf, d))))));
+    __m256d dv = _mm256_add_pd(b, _mm256_mul_pd(vf, _mm256_add_pd(_mm256_add_pd(c, c),
+        _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(3.0), vf), d))));
+
+    // mask out the neighbors outside of the table
+    __m256d mask = _mm256_cmp_pd(vs, _mm256_setzero_pd(), _CMP_NEQ_OQ);
+    _mm256_storeu_pd(V, _mm256_and_pd(v, mask));
+    _mm256_storeu_pd(force_divr, _mm256_mul_pd(dv, vs));
+
+    #elif defined(__SSE__) && defined(SINGLE_PRECISION)
+    __m128 a = _mm_loadu_ps(&coeffs[idx[0]].x);
+    __m128 b = _mm_loadu_ps(&coeffs[idx[1]].x);
+    __m128 c = _mm_loadu_ps(&coeffs[idx[2]].x);
+    __m128 d = _mm_loadu_ps(&coeffs[idx[3]].x);
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+
+    __m128 vf = _mm_loadu_ps(f);
+    __m128 vs = _mm_loadu_ps(scale);
+
+    // V = a + f (b + f (c + f d)), dV/df = b + f (2 c + 3 f d)
+    __m128 v = _mm_add_ps(a, _mm_mul_ps(vf, _mm_add_ps(b, _mm_mul_ps(vf, _mm_add_ps(c, _mm_mul_ps(vf, d))))));
+    __m128 dv = _mm_add_ps(b, _mm_mul_ps(vf, _mm_add_ps(_mm_add_ps(c, c),
+        _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(3.0f), vf), d))));
+
+    // mask out the neighbors outside of the table
+    __m128 mask = _mm_cmpneq_ps(vs, _mm_setzero_ps());
+    _mm_storeu_ps(V, _mm_and_ps(v, mask));
+    _mm_storeu_ps(force_divr, _mm_mul_ps(dv, vs));
+
+    #else
+    for (unsigned int l = 0; l < TABLE_SPLINE_BLOCK; l++)
+        {
+        Scalar4 c = coeffs[idx[l]];
+        Scalar v = c.x + f[l]*(c.y + f[l]*(c.z + f[l]*c.w));
+        Scalar dv = c.y + f[l]*(Scalar(2.0)*c.z + Scalar(3.0)*f[l]*c.w);
+        V[l] = (scale[l] != Scalar(0.0)) ? v : Scalar(0.0);
+        force_divr[l] = dv*scale[l];
+        }
+    #endif
+    }
+
+/*! \post The table based forces are computed for the given timestep. The neighborlist's
+compute method is called to ensure that it is up to date.
+
+\param timestep specifies the current time step of the simulation
+*/
+void TableSplinePotential::computeForces(unsigned int timestep)
+    {
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
+
+    // start the profile for this compute
+    if (m_prof) m_prof->push("Table spline pair");
+
+    // depending on the neighborlist settings, we can take advantage of newton's third law
+    // to reduce computations at the cost of memory access complexity: set that flag now
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    // access the neighbor list
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    // access the particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    // there are enough other checks on the input data: but it doesn't hurt to be safe
+    assert(h_force.data);
+    assert(h_virial.data);
+    assert(h_pos.data);
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    // get a local copy of the simulation box too
+    const BoxDim& box = m_pdata->getBox();
+
+    // access the table data
+    ArrayHandle<Scalar4> h_coeffs(m_coeffs, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+
+    // index calculation helpers
+    Index2DUpperTriangular table_index(m_ntypes);
+
+    const unsigned int N = m_pdata->getN();
+
+    auto compute_particle = [&](unsigned int i)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        const unsigned int head_i = h_head_list.data[i];
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        // initialize current particle force, potential energy, and virial to 0
+        Scalar3 fi = make_scalar3(0,0,0);
+        Scalar pei = 0.0;
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        // loop over all of the neighbors of this particle in blocks
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        for (unsigned int j0 = 0; j0 < size; j0 += TABLE_SPLINE_BLOCK)
+            {
+            Scalar3 dx[TABLE_SPLINE_BLOCK];
+            unsigned int neigh[TABLE_SPLINE_BLOCK];
+            unsigned int idx[TABLE_SPLINE_BLOCK];
+            Scalar f[TABLE_SPLINE_BLOCK];
+            Scalar scale[TABLE_SPLINE_BLOCK];
+            Scalar V[TABLE_SPLINE_BLOCK];
+            Scalar force_divr[TABLE_SPLINE_BLOCK];
+
+            // gather the intervals of the neighbors in this block
+            for (unsigned int l = 0; l < TABLE_SPLINE_BLOCK; l++)
+                {
+                // pad the last block with entries that do not contribute
+                idx[l] = 0;
+                f[l] = Scalar(0.0);
+                scale[l] = Scalar(0.0);
+                dx[l] = make_scalar3(0,0,0);
+                neigh[l] = NOT_LOCAL;
+                if (j0 + l >= size)
+                    continue;
+
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j0 + l];
+                // sanity check
+                assert(k < m_pdata->getN() + m_pdata->getNGhosts());
+                neigh[l] = k;
+
+                // calculate dr and apply periodic boundary conditions
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                dx[l] = box.minImage(pi - pk);
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // access needed parameters
+                Scalar4 params = h_params.data[table_index(typei, typej)];
+                Scalar rsq = dot(dx[l], dx[l]);
+
+                // only compute the force if the particles are within the region defined by V
+                if (rsq < params.y && rsq >= params.x)
+                    {
+                    Scalar value_f = (rsq - params.x) * params.z;
+                    unsigned int value_i = (unsigned int)value_f;
+                    idx[l] = __scalar_as_int(params.w) + value_i;
+                    f[l] = value_f - Scalar(value_i);
+                    scale[l] = -Scalar(2.0) * params.z;
+                    }
+                }
+
+            // evaluate the splines
+            eval_spline_block(h_coeffs.data, idx, f, scale, V, force_divr);
+
+            for (unsigned int l = 0; l < TABLE_SPLINE_BLOCK; l++)
+                {
+                if (scale[l] == Scalar(0.0))
+                    continue;
+
+                Scalar pair_eng = Scalar(0.5) * V[l];
+
+                // compute the virial
+                Scalar forcemag_div2r = Scalar(0.5) * force_divr[l];
+                virialxxi += forcemag_div2r*dx[l].x*dx[l].x;
+                virialxyi += forcemag_div2r*dx[l].x*dx[l].y;
+                virialxzi += forcemag_div2r*dx[l].x*dx[l].z;
+                virialyyi += forcemag_div2r*dx[l].y*dx[l].y;
+                virialyzi += forcemag_div2r*dx[l].y*dx[l].z;
+                virialzzi += forcemag_div2r*dx[l].z*dx[l].z;
+
+                // add the force, potential energy and virial to the particle i
+                fi += dx[l]*force_divr[l];
+                pei += pair_eng;
+
+                // add the force to particle j if we are using the third law
+                // only add force to local particles
+                unsigned int k = neigh[l];
+                if (third_law && k < N)
+                    {
+                    unsigned int mem_idx = k;
+                    h_force.data[mem_idx].x -= dx[l].x*force_divr[l];
+                    h_force.data[mem_idx].y -= dx[l].y*force_divr[l];
+                    h_force.data[mem_idx].z -= dx[l].z*force_divr[l];
+                    h_force.data[mem_idx].w += pair_eng;
+                    h_virial.data[0*m_virial_pitch+mem_idx] += forcemag_div2r * dx[l].x * dx[l].x;
+                    h_virial.data[1*m_virial_pitch+mem_idx] += forcemag_div2r * dx[l].x * dx[l].y;
+                    h_virial.data[2*m_virial_pitch+mem_idx] += forcemag_div2r * dx[l].x * dx[l].z;
+                    h_virial.data[3*m_virial_pitch+mem_idx] += forcemag_div2r * dx[l].y * dx[l].y;
+                    h_virial.data[4*m_virial_pitch+mem_idx] += forcemag_div2r * dx[l].y * dx[l].z;
+                    h_virial.data[5*m_virial_pitch+mem_idx] += forcemag_div2r * dx[l].z * dx[l].z;
+                    }
+                }
+            }
+
+        // finally, increment the force, potential energy and virial for particle i
+        unsigned int mem_idx = i;
+        h_force.data[mem_idx].x += fi.x;
+        h_force.data[mem_idx].y += fi.y;
+        h_force.data[mem_idx].z += fi.z;
+        h_force.data[mem_idx].w += pei;
+        h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
+        h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
+        h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
+        h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
+        h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
+        h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+        };
+
+    // with a full neighbor list, every particle only writes to itself
+    #ifdef ENABLE_TBB
+    if (! third_law)
+        tbb::parallel_for((unsigned int)0, N, compute_particle);
+    else
+    #endif
+    for (unsigned int i = 0; i < N; i++)
+        compute_particle(i);
+
+    if (m_prof) m_prof->pop();
+    }
+
+//! Exports the TableSplinePotential class to python
+void export_TableSplinePotential(py::module& m)
+    {
+    py::class_<TableSplinePotential, std::shared_ptr<TableSplinePotential> >(m, "TableSplinePotential", py::base<ForceCompute>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, const std::string& >())
+    .def("setTable", &TableSplinePotential::setTable)
+    .def("readTables", &TableSplinePotential::readTables)
+    .def("getRange", &TableSplinePotential::getRange)
+    ;
+    }
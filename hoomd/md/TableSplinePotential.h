@@ -0,0 +1,113 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/ForceCompute.h"
+#include "NeighborList.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/GPUVector.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file TableSplinePotential.h
+    \brief Declares the TableSplinePotential class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __TABLESPLINEPOTENTIAL_H__
+#define __TABLESPLINEPOTENTIAL_H__
+
+//! Number of neighbors that are evaluated together in TableSplinePotential
+const unsigned int TABLE_SPLINE_BLOCK = 4;
+
+//! Computes tabulated pair forces with cubic splines on a grid uniform in r^2
+/*! \b Overview
+
+    Like TablePotential, TableSplinePotential evaluates pair potentials given as tables of V(r) and F(r) = -dV/dr
+    between \a rmin and \a rmax, and zero outside. The tables are interpolated with a cubic Hermite spline of V as a
+    function of \f$ s = r^2 \f$, which matches both V and F at the grid points. Because the grid is uniform in s, the
+    interval that contains a pair follows directly from rsq, and the force follows from the analytic derivative of the
+    spline, \f$ F/r = -2 dV/ds \f$, so no square root is needed. The spline is fourth order accurate, so it needs far
+    fewer grid points than the linear interpolation of TablePotential for the same accuracy, which keeps the tables
+    of fine coarse-grained potentials in cache.
+
+    \b Table memory layout
+
+    The table of every type pair has its own number of points n. Its n-1 intervals are stored as the polynomial
+    coefficients (a,b,c,d) of \f$ V(f) = a + b f + c f^2 + d f^3 \f$ in one Scalar4 each, where f is the fractional
+    position in the interval, followed by one padding entry that extends the last interval linearly, so that
+    round-off at \a rmax never reads past the table. The tables of all type pairs are stored back to back in a single
+    array. The parameters of every type pair, indexed by Index2DUpperTriangular, are stored in a Scalar4 with
+    x = rmin^2, y = rmax^2, z = 1/ds, and w = the offset of the first interval (stored with __int_as_scalar).
+
+    \b Evaluation
+
+    The neighbors of a particle are processed in blocks of TABLE_SPLINE_BLOCK. The separations, the interval indices
+    and the fractional positions of a block are gathered first, and the splines are then evaluated for the whole
+    block without branches. With AVX (double precision) or SSE (single precision), the four coefficients of the four
+    neighbors of a block are loaded and transposed in registers, and the polynomials are evaluated in vector
+    registers.
+
+    In TBB builds and with a full neighbor list, the loop over particles runs in parallel threads.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT TableSplinePotential : public ForceCompute
+    {
+    public:
+        //! Constructs the compute
+        TableSplinePotential(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<NeighborList> nlist,
+                             const std::string& log_suffix="");
+
+        //! Destructor
+        virtual ~TableSplinePotential();
+
+        //! Set the table for a given type pair
+        virtual void setTable(unsigned int typ1,
+                              unsigned int typ2,
+                              const std::vector<Scalar> &V,
+                              const std::vector<Scalar> &F,
+                              Scalar rmin,
+                              Scalar rmax);
+
+        //! Read the tables of all type pairs that are present in a GSD file
+        virtual void readTables(const std::string& filename);
+
+        //! Get rmin and rmax of the table of a type pair
+        Scalar2 getRange(unsigned int typ1, unsigned int typ2);
+
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+    protected:
+        std::shared_ptr<NeighborList> m_nlist;      //!< The neighborlist to use for the computation
+        unsigned int m_ntypes;                      //!< Store the number of particle types
+        GPUVector<Scalar4> m_coeffs;                //!< Spline coefficients of all tables
+        GlobalArray<Scalar4> m_params;              //!< Parameters stored for each table
+        std::vector< std::vector<Scalar4> > m_pair_coeffs; //!< Spline coefficients of every type pair
+        std::string m_log_name;                     //!< Cached log name
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+        //! Method to be called when number of types changes
+        virtual void slotNumTypesChange();
+
+        //! Copy the coefficients of all type pairs into m_coeffs
+        void packTables();
+    };
+
+//! Exports the TableSplinePotential class to python
+void export_TableSplinePotential(pybind11::module& m);
+
+#endif
@@ -0,0 +1,128 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \file ThreadedForceScatter.h
+    \brief Declares ThreadedForceScatter
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __THREADED_FORCE_SCATTER_H__
+#define __THREADED_FORCE_SCATTER_H__
+
+//! Accumulates forces that are scattered to several particles per work item
+/*! Angles, dihedrals and the Tersoff triplets add the force of one work item to several particles, so the items
+    cannot be distributed over threads with a plain parallel loop. With TBB, every thread adds into its own force
+    and virial arrays, which are summed into the output afterwards. A thread zeroes its arrays the first time it
+    runs an item in a call to scatter(), and threads that did not run any item are left out of the sum. Without TBB,
+    the items are added to the output directly.
+
+    The kernel is called as kernel(i, force, virial, virial_pitch) and adds the contributions of item \a i to
+    \a force[idx] and \a virial[k*virial_pitch + idx] for the indices idx < n it writes.
+
+    \ingroup computes
+*/
+class ThreadedForceScatter
+    {
+    public:
+        //! Constructor
+        ThreadedForceScatter()
+            #ifdef ENABLE_TBB
+            : m_call(0)
+            #endif
+            { }
+
+        //! Computes all items and stores the summed forces and virials of the first n particles
+        /*! \param n_items Number of work items
+            \param n Number of entries of the force array the kernel writes to
+            \param compute_virial True if the virial is computed
+            \param kernel Computes a single item
+            \param force Output force array, the first \a n entries are overwritten with TBB and added to without
+            \param virial Output virial array with pitch \a virial_pitch
+            \param virial_pitch Pitch of the output virial array
+        */
+        template<class Kernel>
+        void scatter(unsigned int n_items, unsigned int n, bool compute_virial, const Kernel& kernel,
+                     Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+            {
+            #ifdef ENABLE_TBB
+            // mark the buffers of the previous call as stale
+            const unsigned int call = ++m_call;
+
+            tbb::parallel_for((unsigned int)0, n_items, [&](unsigned int i)
+                {
+                Buffer& buf = m_buffers.local();
+                if (buf.call != call)
+                    {
+                    buf.force.assign(n, make_scalar4(0.0, 0.0, 0.0, 0.0));
+                    buf.virial.assign(compute_virial ? 6*n : 0, Scalar(0.0));
+                    buf.call = call;
+                    }
+
+                kernel(i, buf.force.data(), compute_virial ? buf.virial.data() : NULL, n);
+                });
+
+            // sum up only the buffers of the threads that ran an item
+            std::vector<const Buffer *> used;
+            for (auto& buf : m_buffers)
+                if (buf.call == call)
+                    used.push_back(&buf);
+
+            tbb::parallel_for((unsigned int)0, n, [&](unsigned int idx)
+                {
+                Scalar4 f = make_scalar4(0.0, 0.0, 0.0, 0.0);
+                for (const Buffer *buf : used)
+                    {
+                    const Scalar4& bf = buf->force[idx];
+                    f.x += bf.x;
+                    f.y += bf.y;
+                    f.z += bf.z;
+                    f.w += bf.w;
+                    }
+                force[idx] = f;
+
+                if (compute_virial)
+                    {
+                    for (unsigned int k = 0; k < 6; ++k)
+                        {
+                        Scalar v(0.0);
+                        for (const Buffer *buf : used)
+                            v += buf->virial[k*n + idx];
+                        virial[k*virial_pitch + idx] = v;
+                        }
+                    }
+                });
+            #else
+            for (unsigned int i = 0; i < n_items; i++)
+                kernel(i, force, virial, virial_pitch);
+            #endif
+            }
+
+    #ifdef ENABLE_TBB
+    private:
+        //! Force and virial accumulators of one thread
+        struct Buffer
+            {
+            Buffer() : call(0) { }
+
+            std::vector<Scalar4> force;  //!< Per-particle forces
+            std::vector<Scalar> virial;  //!< Per-particle virials, 6*n entries
+            unsigned int call;           //!< Last call to scatter() that this buffer was zeroed in
+            };
+
+        tbb::enumerable_thread_specific<Buffer> m_buffers;  //!< Accumulators per thread
+        unsigned int m_call;                                //!< Counts the calls to scatter()
+    #endif
+    };
+
+#endif // __THREADED_FORCE_SCATTER_H__
@@ -0,0 +1,651 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TreeCodeForceCompute.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#include <algorithm>
+
+namespace py = pybind11;
+
+using namespace hpmc::detail;
+
+/*! \file TreeCodeForceCompute.cc
+    \brief Contains code for the TreeCodeForceCompute class
+*/
+
+//! Add the multipole expansion of a child node to the expansion of its parent
+/*! \param parent Expansion of the parent node about its center
+    \param child Expansion of the child node about its center
+*/
+inline void tree_add_multipole(TreeMultipole& parent, const TreeMultipole& child)
+    {
+    vec3<Scalar> d = child.center - parent.center;
+    Scalar q = child.charge;
+    const vec3<Scalar>& p = child.dipole;
+    Scalar pd = dot(p,d);
+    Scalar dsq = dot(d,d);
+
+    parent.charge += q;
+    parent.dipole += p + q*d;
+
+    parent.quad[0] += child.quad[0] + Scalar(6.0)*p.x*d.x - Scalar(2.0)*pd + q*(Scalar(3.0)*d.x*d.x - dsq);
+    parent.quad[1] += child.quad[1] + Scalar(3.0)*(p.x*d.y + d.x*p.y) + Scalar(3.0)*q*d.x*d.y;
+    parent.quad[2] += child.quad[2] + Scalar(3.0)*(p.x*d.z + d.x*p.z) + Scalar(3.0)*q*d.x*d.z;
+    parent.quad[3] += child.quad[3] + Scalar(6.0)*p.y*d.y - Scalar(2.0)*pd + q*(Scalar(3.0)*d.y*d.y - dsq);
+    parent.quad[4] += child.quad[4] + Scalar(3.0)*(p.y*d.z + d.y*p.z) + Scalar(3.0)*q*d.y*d.z;
+    parent.quad[5] += child.quad[5] + Scalar(6.0)*p.z*d.z - Scalar(2.0)*pd + q*(Scalar(3.0)*d.z*d.z - dsq);
+    }
+
+//! Evaluate the potential and the field of a multipole expansion
+/*! \param mp The multipole expansion
+    \param r Position relative to the expansion center
+    \param order Order of the expansion (0: charge, 1: dipole, 2: quadrupole)
+    \param phi Potential (incremented)
+    \param field Electric field (incremented)
+*/
+inline void tree_eval_multipole(const TreeMultipole& mp, const vec3<Scalar>& r, unsigned int order,
+    Scalar& phi, vec3<Scalar>& field)
+    {
+    Scalar r2inv = Scalar(1.0)/dot(r,r);
+    Scalar rinv = sqrt(r2inv);
+    Scalar r3inv = rinv*r2inv;
+
+    phi += mp.charge*rinv;
+    field += (mp.charge*r3inv)*r;
+
+    if (order >= 1)
+        {
+        Scalar pr = dot(mp.dipole, r);
+        phi += pr*r3inv;
+        field += (Scalar(3.0)*pr*r2inv*r3inv)*r - r3inv*mp.dipole;
+        }
+
+    if (order >= 2)
+        {
+        vec3<Scalar> qr(mp.quad[0]*r.x + mp.quad[1]*r.y + mp.quad[2]*r.z,
+                        mp.quad[1]*r.x + mp.quad[3]*r.y + mp.quad[4]*r.z,
+                        mp.quad[2]*r.x + mp.quad[4]*r.y + mp.quad[5]*r.z);
+        Scalar rqr = dot(r, qr);
+        Scalar r5inv = r3inv*r2inv;
+        phi += Scalar(0.5)*rqr*r5inv;
+        field += (Scalar(2.5)*rqr*r5inv*r2inv)*r - r5inv*qr;
+        }
+    }
+
+/*! \param sysdef The system definition
+    \param nlist Neighbor list, which provides the exclusions
+    \param group Group of charged particles
+ */
+TreeCodeForceCompute::TreeCodeForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<NeighborList> nlist,
+    std::shared_ptr<ParticleGroup> group)
+    : ForceCompute(sysdef),
+      m_nlist(nlist),
+      m_group(group),
+      m_tol(0.0),
+      m_order(0),
+      m_boundary(isolated),
+      m_n_images(0),
+      m_params_set(false),
+      m_source_offset(0),
+      m_aabbs(m_exec_conf),
+      m_image_radius(0.0),
+      m_charge_warned(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing TreeCodeForceCompute" << std::endl;
+
+    for (unsigned int p = 0; p <= TREE_MAX_ORDER; ++p)
+        m_mac[p] = Scalar(0.0);
+
+    // the per-particle virial is not computed, the virial is stored as external virial
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    memset(h_virial.data, 0, sizeof(Scalar)*m_virial.getNumElements());
+    }
+
+TreeCodeForceCompute::~TreeCodeForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying TreeCodeForceCompute" << std::endl;
+    }
+
+/*! \param tol Largest accepted truncation error estimate (b/d)^(p+1) of a multipole expansion of order p
+    \param order Maximum order of the multipole expansions
+    \param boundary Boundary conditions
+    \param n_images Radius of the image sum in units of the largest box length
+*/
+void TreeCodeForceCompute::setParams(Scalar tol, unsigned int order, boundaryMode boundary, unsigned int n_images)
+    {
+    if (tol <= Scalar(0.0) || tol >= Scalar(1.0))
+        {
+        m_exec_conf->msg->error() << "charge.tree: The tolerance must be between 0 and 1" << std::endl;
+        throw std::runtime_error("Error initializing TreeCodeForceCompute");
+        }
+
+    if (order > TREE_MAX_ORDER)
+        {
+        m_exec_conf->msg->error() << "charge.tree: Maximum supported multipole order is " << TREE_MAX_ORDER
+            << std::endl;
+        throw std::runtime_error("Error initializing TreeCodeForceCompute");
+        }
+
+    if (boundary == periodic && m_sysdef->getNDimensions() != 3)
+        {
+        m_exec_conf->msg->error() << "charge.tree: Periodic boundaries require a 3D system" << std::endl;
+        throw std::runtime_error("Error initializing TreeCodeForceCompute");
+        }
+
+    m_tol = tol;
+    m_order = order;
+    m_boundary = boundary;
+    m_n_images = n_images;
+
+    // a node is accepted for an expansion of order p if (b/d)^2 < tol^(2/(p+1))
+    for (unsigned int p = 0; p <= TREE_MAX_ORDER; ++p)
+        m_mac[p] = pow(tol, Scalar(2.0)/Scalar(p+1));
+
+    m_charge_warned = false;
+    m_params_set = true;
+    }
+
+/*! Particle positions are unwrapped along the directions without periodic boundaries.
+*/
+void TreeCodeForceCompute::gatherSources()
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    Scalar3 a3 = box.getLatticeVector(2);
+
+    unsigned int group_size = m_group->getNumMembers();
+    std::vector<Scalar4> local(group_size);
+
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+    for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+        {
+        unsigned int idx = h_index.data[group_idx];
+        Scalar4 postype = h_postype.data[idx];
+        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+        int3 image = h_image.data[idx];
+
+        if (m_boundary == isolated)
+            {
+            pos = box.shift(pos, image);
+            }
+        else if (m_boundary == slab)
+            {
+            pos += Scalar(image.z)*a3;
+            }
+
+        local[group_idx] = make_scalar4(pos.x, pos.y, pos.z, h_charge.data[idx]);
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // every rank needs all sources to build the tree
+        std::vector< std::vector<Scalar4> > all_sources;
+        all_gather_v(local, all_sources, m_exec_conf->getMPICommunicator());
+
+        m_sources.clear();
+        for (unsigned int rank = 0; rank < all_sources.size(); ++rank)
+            {
+            if (rank == m_exec_conf->getRank())
+                m_source_offset = m_sources.size();
+
+            m_sources.insert(m_sources.end(), all_sources[rank].begin(), all_sources[rank].end());
+            }
+        }
+    else
+    #endif
+        {
+        m_sources.swap(local);
+        m_source_offset = 0;
+        }
+    }
+
+/*! The nodes of the tree are stored in depth-first order, with the children of a node after the node itself. The
+    multipole expansions are therefore computed in a single reverse sweep over the nodes.
+*/
+void TreeCodeForceCompute::buildTree()
+    {
+    if (m_prof) m_prof->push("build tree");
+
+    unsigned int n_sources = m_sources.size();
+    m_aabbs.resize(n_sources);
+
+        {
+        ArrayHandle<AABB> h_aabbs(m_aabbs, access_location::host, access_mode::overwrite);
+        for (unsigned int j = 0; j < n_sources; ++j)
+            {
+            Scalar4 source = m_sources[j];
+            h_aabbs.data[j] = AABB(vec3<Scalar>(source.x, source.y, source.z), j);
+            }
+
+        m_tree.buildTree(h_aabbs.data, n_sources);
+        }
+
+    unsigned int n_nodes = m_tree.getNumNodes();
+    m_multipoles.resize(n_nodes);
+
+    for (unsigned int node = n_nodes; node-- > 0;)
+        {
+        TreeMultipole& mp = m_multipoles[node];
+        const AABB& aabb = m_tree.getNodeAABB(node);
+
+        mp.center = aabb.getPosition();
+        vec3<Scalar> half = Scalar(0.5)*(aabb.getUpper() - aabb.getLower());
+        mp.radius_sq = dot(half, half);
+
+        mp.charge = Scalar(0.0);
+        mp.dipole = vec3<Scalar>(0.0, 0.0, 0.0);
+        for (unsigned int k = 0; k < 6; ++k)
+            mp.quad[k] = Scalar(0.0);
+
+        if (m_tree.isNodeLeaf(node))
+            {
+            for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); ++j)
+                {
+                Scalar4 source = m_sources[m_tree.getNodeParticle(node, j)];
+                Scalar q = source.w;
+                vec3<Scalar> y = vec3<Scalar>(source.x, source.y, source.z) - mp.center;
+                Scalar ysq = dot(y,y);
+
+                mp.charge += q;
+                mp.dipole += q*y;
+                mp.quad[0] += q*(Scalar(3.0)*y.x*y.x - ysq);
+                mp.quad[1] += q*Scalar(3.0)*y.x*y.y;
+                mp.quad[2] += q*Scalar(3.0)*y.x*y.z;
+                mp.quad[3] += q*(Scalar(3.0)*y.y*y.y - ysq);
+                mp.quad[4] += q*Scalar(3.0)*y.y*y.z;
+                mp.quad[5] += q*(Scalar(3.0)*y.z*y.z - ysq);
+                }
+            }
+        else
+            {
+            tree_add_multipole(mp, m_multipoles[m_tree.getNodeLeft(node)]);
+            tree_add_multipole(mp, m_multipoles[m_tree.getNode(node).right]);
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! The first entry is always the zero vector of the simulation box itself.
+*/
+void TreeCodeForceCompute::computeImageShifts()
+    {
+    m_shifts.clear();
+    m_shifts.push_back(vec3<Scalar>(0.0, 0.0, 0.0));
+    m_image_radius = Scalar(0.0);
+
+    if (m_boundary == isolated || m_n_images == 0)
+        return;
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    Scalar3 L = box.getL();
+    Scalar L_max = std::max(L.x, L.y);
+    if (m_boundary == periodic)
+        L_max = std::max(L_max, L.z);
+
+    m_image_radius = Scalar(m_n_images)*L_max;
+    Scalar rsq_max = m_image_radius*m_image_radius;
+
+    Scalar3 npd = box.getNearestPlaneDistance();
+    int nx = (int)ceil(m_image_radius/npd.x);
+    int ny = (int)ceil(m_image_radius/npd.y);
+    int nz = (m_boundary == periodic) ? (int)ceil(m_image_radius/npd.z) : 0;
+
+    vec3<Scalar> a1(box.getLatticeVector(0));
+    vec3<Scalar> a2(box.getLatticeVector(1));
+    vec3<Scalar> a3(box.getLatticeVector(2));
+
+    for (int i = -nx; i <= nx; ++i)
+        for (int j = -ny; j <= ny; ++j)
+            for (int k = -nz; k <= nz; ++k)
+                {
+                if (i == 0 && j == 0 && k == 0)
+                    continue;
+
+                vec3<Scalar> s = Scalar(i)*a1 + Scalar(j)*a2 + Scalar(k)*a3;
+                if (dot(s,s) <= rsq_max)
+                    m_shifts.push_back(s);
+                }
+    }
+
+/*! \param x Position at which to evaluate the potential and the field
+    \param self Index of a source to leave out, or INVALID_NODE
+    \param phi Potential (incremented)
+    \param field Electric field (incremented)
+*/
+void TreeCodeForceCompute::evaluateField(const vec3<Scalar>& x, unsigned int self, Scalar& phi,
+    vec3<Scalar>& field) const
+    {
+    unsigned int n_nodes = m_tree.getNumNodes();
+
+    // stackless traversal, the skip index of a node jumps over all of its children
+    for (unsigned int node = 0; node < n_nodes; ++node)
+        {
+        const TreeMultipole& mp = m_multipoles[node];
+        vec3<Scalar> r = x - mp.center;
+        Scalar rsq = dot(r,r);
+
+        // find the lowest expansion order that meets the tolerance
+        unsigned int order = 0;
+        while (order <= m_order && !(mp.radius_sq < m_mac[order]*rsq))
+            order++;
+
+        if (order <= m_order)
+            {
+            tree_eval_multipole(mp, r, order, phi, field);
+            node += m_tree.getNodeSkip(node);
+            }
+        else if (m_tree.isNodeLeaf(node))
+            {
+            for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); ++j)
+                {
+                unsigned int src = m_tree.getNodeParticle(node, j);
+                if (src == self)
+                    continue;
+
+                Scalar4 source = m_sources[src];
+                vec3<Scalar> dx = x - vec3<Scalar>(source.x, source.y, source.z);
+                Scalar dxsq = dot(dx,dx);
+                if (dxsq == Scalar(0.0))
+                    continue;
+
+                Scalar rinv = Scalar(1.0)/sqrt(dxsq);
+                phi += source.w*rinv;
+                field += (source.w*rinv*rinv*rinv)*dx;
+                }
+            }
+        }
+    }
+
+void TreeCodeForceCompute::computeForces(unsigned int timestep)
+    {
+    if (!m_params_set)
+        {
+        m_exec_conf->msg->error() << "charge.tree: set_params() must be called before run()" << std::endl;
+        throw std::runtime_error("Error computing tree code forces");
+        }
+
+    if (m_prof) m_prof->push("Tree code");
+
+    gatherSources();
+
+    if (m_sources.size() == 0)
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        memset(h_force.data, 0, sizeof(Scalar4)*m_pdata->getN());
+
+        for (unsigned int k = 0; k < 6; ++k)
+            m_external_virial[k] = Scalar(0.0);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
+    buildTree();
+    computeImageShifts();
+
+    // total charge and dipole moment of the sources
+    Scalar Q(0.0);
+    vec3<Scalar> M(0.0, 0.0, 0.0);
+    for (unsigned int j = 0; j < m_sources.size(); ++j)
+        {
+        Scalar4 source = m_sources[j];
+        Q += source.w;
+        M += source.w*vec3<Scalar>(source.x, source.y, source.z);
+        }
+
+    if (m_boundary != isolated && fabs(Q) > Scalar(1e-5) && !m_charge_warned)
+        {
+        m_exec_conf->msg->warning() << "charge.tree: the system is not charge neutral, the sum over periodic images "
+            << "does not converge" << std::endl;
+        m_charge_warned = true;
+        }
+
+    // uniform field that corrects the conditionally convergent image sum
+    vec3<Scalar> field_corr(0.0, 0.0, 0.0);
+    Scalar virial_corr[6];
+    for (unsigned int k = 0; k < 6; ++k)
+        virial_corr[k] = Scalar(0.0);
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    if (m_boundary == periodic)
+        {
+        // conducting instead of vacuum boundary conditions of the spherical sum
+        Scalar V = global_box.getVolume();
+        field_corr = (Scalar(4.0*M_PI)/(Scalar(3.0)*V))*M;
+
+        Scalar a = Scalar(8.0*M_PI)/(Scalar(15.0)*V);
+        Scalar b = Scalar(2.0*M_PI)/(Scalar(5.0)*V)*dot(M,M);
+        virial_corr[0] = a*M.x*M.x - b;
+        virial_corr[1] = a*M.x*M.y;
+        virial_corr[2] = a*M.x*M.z;
+        virial_corr[3] = a*M.y*M.y - b;
+        virial_corr[4] = a*M.y*M.z;
+        virial_corr[5] = a*M.z*M.z - b;
+        }
+    else if (m_boundary == slab && m_image_radius > Scalar(0.0))
+        {
+        // field of the polarized sheet formed by the images outside of the summation disk
+        Scalar3 L = global_box.getL();
+        Scalar A = L.x*L.y;
+        Scalar c = Scalar(M_PI)/(m_image_radius*A);
+        field_corr = c*vec3<Scalar>(M.x, M.y, Scalar(-2.0)*M.z);
+
+        Scalar Mpsq = M.x*M.x + M.y*M.y;
+        Scalar Msq = Mpsq + M.z*M.z;
+        Scalar diag = Scalar(-3.0)*Msq + Scalar(3.75)*Mpsq;
+        virial_corr[0] = M.x*field_corr.x - Scalar(0.5)*c*(diag + Scalar(1.5)*M.x*M.x);
+        virial_corr[1] = M.x*field_corr.y - Scalar(0.5)*c*Scalar(1.5)*M.x*M.y;
+        virial_corr[2] = M.x*field_corr.z + Scalar(3.0)*c*M.x*M.z;
+        virial_corr[3] = M.y*field_corr.y - Scalar(0.5)*c*(diag + Scalar(1.5)*M.y*M.y);
+        virial_corr[4] = M.y*field_corr.z + Scalar(3.0)*c*M.y*M.z;
+        virial_corr[5] = M.z*field_corr.z;
+        }
+
+    unsigned int group_size = m_group->getNumMembers();
+    m_virial_buf.resize(6*group_size);
+
+        {
+        if (m_prof) m_prof->push("traverse");
+
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        memset(h_force.data, 0, sizeof(Scalar4)*m_pdata->getN());
+        ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+        // loop over group, every particle only writes its own force
+        #ifdef ENABLE_TBB
+        tbb::parallel_for((unsigned int)0, group_size, [&](unsigned int group_idx)
+        #else
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        #endif
+            {
+            unsigned int idx = h_index.data[group_idx];
+            unsigned int src = m_source_offset + group_idx;
+            Scalar4 source = m_sources[src];
+            vec3<Scalar> x(source.x, source.y, source.z);
+            Scalar qi = source.w;
+
+            Scalar phi(0.0);
+            vec3<Scalar> force(0.0, 0.0, 0.0);
+            Scalar *virial = &m_virial_buf[6*group_idx];
+            for (unsigned int k = 0; k < 6; ++k)
+                virial[k] = Scalar(0.0);
+
+            for (unsigned int n = 0; n < m_shifts.size(); ++n)
+                {
+                const vec3<Scalar>& s = m_shifts[n];
+
+                // the sources of image s act on the particle like the original sources on x - s
+                Scalar phi_s(0.0);
+                vec3<Scalar> field_s(0.0, 0.0, 0.0);
+                evaluateField(x - s, n == 0 ? src : INVALID_NODE, phi_s, field_s);
+
+                vec3<Scalar> f = qi*field_s;
+                phi += phi_s;
+                force += f;
+
+                virial[0] -= Scalar(0.5)*s.x*f.x;
+                virial[1] -= Scalar(0.5)*s.x*f.y;
+                virial[2] -= Scalar(0.5)*s.x*f.z;
+                virial[3] -= Scalar(0.5)*s.y*f.y;
+                virial[4] -= Scalar(0.5)*s.y*f.z;
+                virial[5] -= Scalar(0.5)*s.z*f.z;
+                }
+
+            virial[0] += x.x*force.x;
+            virial[1] += x.x*force.y;
+            virial[2] += x.x*force.z;
+            virial[3] += x.y*force.y;
+            virial[4] += x.y*force.z;
+            virial[5] += x.z*force.z;
+
+            // the correction is a uniform field
+            force += qi*field_corr;
+            phi -= dot(field_corr, x);
+
+            h_force.data[idx] = make_scalar4(force.x, force.y, force.z, Scalar(0.5)*qi*phi);
+            }
+        #ifdef ENABLE_TBB
+            );
+        #endif
+
+        if (m_prof) m_prof->pop();
+        }
+
+    Scalar virial[6];
+    for (unsigned int k = 0; k < 6; ++k)
+        virial[k] = (m_exec_conf->getRank() == 0) ? virial_corr[k] : Scalar(0.0);
+
+    for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+        for (unsigned int k = 0; k < 6; ++k)
+            virial[k] += m_virial_buf[6*group_idx + k];
+
+    // If there are exclusions, remove the interaction of the excluded pairs
+    if (m_nlist->getExclusionsSet())
+        {
+        fixExclusions(virial);
+        }
+
+    // store this rank's contribution in m_external_virial
+    for (unsigned int k = 0; k < 6; ++k)
+        m_external_virial[k] = virial[k];
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param virial Virial of this rank (incremented)
+
+    The tree sums the interactions between all charges, and the direct interaction between excluded pairs at the
+    minimum image distance is removed here.
+*/
+void TreeCodeForceCompute::fixExclusions(Scalar *virial)
+    {
+    if (m_prof) m_prof->push("fix exclusions");
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head(m_nlist->getExHeadArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list(m_nlist->getExListCSRArray(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+        {
+        unsigned int idx = h_index.data[group_idx];
+        Scalar3 posi = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
+        Scalar qi = h_charge.data[idx];
+
+        Scalar4 force = make_scalar4(0.0, 0.0, 0.0, 0.0);
+
+        unsigned int ex_end = h_ex_head.data[idx+1];
+        for (unsigned int ex_idx = h_ex_head.data[idx]; ex_idx < ex_end; ++ex_idx)
+            {
+            unsigned int j = h_ex_list.data[ex_idx];
+            Scalar3 posj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar qiqj = qi*h_charge.data[j];
+
+            if (qiqj == Scalar(0.0))
+                continue;
+
+            Scalar3 dx = box.minImage(posi - posj);
+            Scalar rsq = dot(dx, dx);
+            Scalar rinv = Scalar(1.0)/sqrt(rsq);
+            Scalar force_divr = qiqj*rinv*rinv*rinv;
+
+            force.x -= force_divr*dx.x;
+            force.y -= force_divr*dx.y;
+            force.z -= force_divr*dx.z;
+            force.w -= Scalar(0.5)*qiqj*rinv;
+
+            virial[0] -= Scalar(0.5)*force_divr*dx.x*dx.x;
+            virial[1] -= Scalar(0.5)*force_divr*dx.x*dx.y;
+            virial[2] -= Scalar(0.5)*force_divr*dx.x*dx.z;
+            virial[3] -= Scalar(0.5)*force_divr*dx.y*dx.y;
+            virial[4] -= Scalar(0.5)*force_divr*dx.y*dx.z;
+            virial[5] -= Scalar(0.5)*force_divr*dx.z*dx.z;
+            }
+
+        h_force.data[idx].x += force.x;
+        h_force.data[idx].y += force.y;
+        h_force.data[idx].z += force.z;
+        h_force.data[idx].w += force.w;
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+std::vector< std::string > TreeCodeForceCompute::getProvidedLogQuantities()
+    {
+    std::vector<std::string> list;
+    list.push_back("tree_energy");
+    return list;
+    }
+
+/*! \param quantity Name of the log value to get
+    \param timestep Current timestep of the simulation
+*/
+Scalar TreeCodeForceCompute::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "tree_energy")
+        {
+        compute(timestep);
+        return calcEnergySum();
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "charge.tree: " << quantity << " is not a valid log quantity" << std::endl;
+        throw std::runtime_error("Error getting log value");
+        }
+    }
+
+void export_TreeCodeForceCompute(py::module& m)
+    {
+    py::class_<TreeCodeForceCompute, std::shared_ptr<TreeCodeForceCompute> > tree(m, "TreeCodeForceCompute", py::base<ForceCompute>());
+    tree.def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>, std::shared_ptr<ParticleGroup> >())
+        .def("setParams", &TreeCodeForceCompute::setParams)
+        ;
+
+    py::enum_<TreeCodeForceCompute::boundaryMode>(tree, "boundaryMode")
+        .value("isolated", TreeCodeForceCompute::boundaryMode::isolated)
+        .value("slab", TreeCodeForceCompute::boundaryMode::slab)
+        .value("periodic", TreeCodeForceCompute::boundaryMode::periodic)
+        .export_values()
+        ;
+    }
@@ -0,0 +1,150 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __TREE_CODE_FORCE_COMPUTE_H__
+#define __TREE_CODE_FORCE_COMPUTE_H__
+
+#include "hoomd/ForceCompute.h"
+#include "hoomd/ParticleGroup.h"
+#include "hoomd/AABBTree.h"
+#include "hoomd/GPUVector.h"
+#include "NeighborList.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file TreeCodeForceCompute.h
+    \brief Declares a class computing Coulomb interactions with a hierarchical tree code
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Maximum order of the multipole expansion of a tree node (quadrupole)
+const unsigned int TREE_MAX_ORDER = 2;
+
+//! Multipole expansion of the charges in a node of the tree
+struct TreeMultipole
+    {
+    vec3<Scalar> center;    //!< Expansion center (center of the node's bounding box)
+    Scalar radius_sq;       //!< Squared radius of a sphere around the center that encloses all charges of the node
+    Scalar charge;          //!< Total charge
+    vec3<Scalar> dipole;    //!< Dipole moment about the center
+    Scalar quad[6];         //!< Traceless quadrupole moment about the center (xx, xy, xz, yy, yz, zz)
+    };
+
+//! Compute the full Coulomb interaction between charged particles with a Barnes-Hut tree code
+/*! Unlike PPPMForceCompute, which requires a fully periodic box, TreeCodeForceCompute sums the bare Coulomb
+    interaction directly, so it supports isolated systems (free boundaries), systems that are periodic in the x and y
+    directions only (slab), and fully periodic systems.
+
+    The charges of the group are stored in point AABBs of an hpmc::detail::AABBTree. Every node of the tree carries a
+    multipole expansion (charge, dipole and traceless quadrupole) about the center of its bounding box, which is
+    computed bottom-up from the expansions of its children. For every particle, the tree is traversed without a stack
+    using the skip indices of the tree. A node of radius b at distance d is accepted if the truncation error estimate
+    (b/d)^(p+1) of an expansion of order p <= max_order is below the tolerance, and the lowest such order is used.
+    Otherwise, the node is opened, and leaf nodes are summed directly.
+
+    Periodic images are included by traversing the tree once per lattice vector s of the images that lie within a
+    sphere (periodic) or a disk (slab) of radius R = n_images times the largest box length. The image sums converge
+    conditionally, and are corrected analytically:
+    - periodic: spherical summation yields the Ewald sum in vacuum, which differs from the conducting (tin-foil)
+      boundary conditions of PPPMForceCompute by \f$ 2 \pi M^2/3V \f$, with M the dipole moment of the box.
+      The correction is subtracted.
+    - slab: the dipole moments of the images outside the disk act like a polarized sheet, whose uniform field
+      \f$ \pi (M_x, M_y, -2 M_z)/(R A) \f$ is added, with A the area of the box in the periodic directions.
+
+    The virial follows from \f$ W = \sum_i \vec{x}_i \otimes \vec{F}_i - \frac{1}{2} \sum_s \vec{s} \otimes
+    \vec{F}^{(s)} \f$, where \f$ \vec{F}^{(s)} \f$ is the total force exerted by the image s, plus the analytic
+    contributions of the corrections. It is stored as the external virial.
+
+    In MPI simulations, the positions and charges of the group are gathered on every rank, and every rank builds the
+    same tree and computes the forces on its local particles.
+*/
+class PYBIND11_EXPORT TreeCodeForceCompute : public ForceCompute
+    {
+    public:
+        //! Boundary conditions of the electrostatic interaction
+        enum boundaryMode
+            {
+            isolated = 0,   //!< Free boundaries, particle positions are unwrapped
+            slab,           //!< Periodic in x and y, isolated in z
+            periodic        //!< Periodic in all directions, with conducting boundary conditions
+            };
+
+        //! Constructor
+        TreeCodeForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+            std::shared_ptr<NeighborList> nlist,
+            std::shared_ptr<ParticleGroup> group);
+        virtual ~TreeCodeForceCompute();
+
+        //! Set the parameters
+        void setParams(Scalar tol, unsigned int order, boundaryMode boundary, unsigned int n_images);
+
+        //! Returns a list of log quantities this compute calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+        #ifdef ENABLE_MPI
+        //! Get ghost particle fields requested by this force
+        /*! \param timestep Current time step
+        */
+        virtual CommFlags getRequestedCommFlags(unsigned int timestep)
+            {
+            CommFlags flags = ForceCompute::getRequestedCommFlags(timestep);
+
+            // the charges of excluded ghost particles are needed to remove their interaction
+            if (m_nlist->getExclusionsSet())
+                flags[comm_flag::charge] = 1;
+
+            return flags;
+            }
+        #endif
+
+    protected:
+        std::shared_ptr<NeighborList> m_nlist;  //!< The neighbor list, which provides the exclusions
+        std::shared_ptr<ParticleGroup> m_group; //!< Group of charged particles
+
+        Scalar m_tol;                           //!< Tolerance of the multipole truncation error
+        unsigned int m_order;                   //!< Maximum order of the multipole expansions
+        boundaryMode m_boundary;                //!< Boundary conditions
+        unsigned int m_n_images;                //!< Radius of the image sum, in units of the largest box length
+        bool m_params_set;                      //!< True if parameters are set
+        Scalar m_mac[TREE_MAX_ORDER+1];         //!< Largest accepted (b/d)^2 of a node for every expansion order
+
+        std::vector<Scalar4> m_sources;         //!< Positions and charges of all particles in the group
+        unsigned int m_source_offset;           //!< Index of the first local group member in m_sources
+        GPUVector<hpmc::detail::AABB> m_aabbs;  //!< Point AABBs of the sources
+        hpmc::detail::AABBTree m_tree;          //!< Tree over the sources
+        std::vector<TreeMultipole> m_multipoles;//!< Multipole expansion of every node of the tree
+        std::vector<vec3<Scalar> > m_shifts;    //!< Lattice vectors of the periodic images
+        std::vector<Scalar> m_virial_buf;       //!< Virial contribution of every group member
+        Scalar m_image_radius;                  //!< Radius of the image sum
+        bool m_charge_warned;                   //!< True if the warning about a net charge has been issued
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+        //! Gather the positions and charges of the group
+        void gatherSources();
+
+        //! Build the tree and compute the multipole expansions of its nodes
+        void buildTree();
+
+        //! Enumerate the lattice vectors of the periodic images
+        void computeImageShifts();
+
+        //! Compute the potential and the field at a position due to all sources in the tree
+        void evaluateField(const vec3<Scalar>& x, unsigned int self, Scalar& phi, vec3<Scalar>& field) const;
+
+        //! Remove the interactions between excluded particles
+        void fixExclusions(Scalar *virial);
+    };
+
+//! Exports the TreeCodeForceCompute class to python
+void export_TreeCodeForceCompute(pybind11::module& m);
+
+#endif // __TREE_CODE_FORCE_COMPUTE_H__
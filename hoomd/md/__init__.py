@@ -17,6 +17,7 @@ from hoomd.md import bond
 from hoomd.md import charge
 from hoomd.md import constrain
 from hoomd.md import dihedral
+from hoomd.md import dispersion
 from hoomd.md import external
 from hoomd.md import force
 from hoomd.md import improper
@@ -230,9 +230,9 @@ class harmonic(force._force):
 
         # create the c++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
-            self.cpp_force = _md.HarmonicAngleForceCompute(hoomd.context.current.system_definition);
+            self.cpp_force = _md.PotentialAngleHarmonic(hoomd.context.current.system_definition, self.name);
         else:
-            self.cpp_force = _md.HarmonicAngleForceComputeGPU(hoomd.context.current.system_definition);
+            self.cpp_force = _md.HarmonicAngleForceComputeGPU(hoomd.context.current.system_definition, self.name);
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
@@ -259,7 +259,7 @@ class harmonic(force._force):
             for name in coeff_list:
                 coeff_dict[name] = self.angle_coeff.get(type_list[i], name);
 
-            self.cpp_force.setParams(i, coeff_dict['k'], coeff_dict['t0']);
+            self.cpp_force.setParams(i, _hoomd.make_scalar2(coeff_dict['k'], coeff_dict['t0']));
 
     ## \internal
     # \brief Get metadata
@@ -320,11 +320,11 @@ class cosinesq(force._force):
 
         # create the c++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
-            self.cpp_force = _md.CosineSqAngleForceCompute(
-                    hoomd.context.current.system_definition);
+            self.cpp_force = _md.PotentialAngleCosineSq(
+                    hoomd.context.current.system_definition, self.name);
         else:
             self.cpp_force = _md.CosineSqAngleForceComputeGPU(
-                    hoomd.context.current.system_definition);
+                    hoomd.context.current.system_definition, self.name);
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
@@ -352,7 +352,7 @@ class cosinesq(force._force):
             for name in coeff_list:
                 coeff_dict[name] = self.angle_coeff.get(type_list[i], name);
 
-            self.cpp_force.setParams(i, coeff_dict['k'], coeff_dict['t0']);
+            self.cpp_force.setParams(i, _hoomd.make_scalar2(coeff_dict['k'], coeff_dict['t0']));
 
     ## \internal
     # \brief Get metadata
@@ -228,6 +228,130 @@ class pppm(force._force):
         if self.nlist.cpp_nlist.getDiameterShift():
             hoomd.context.msg.warning("Neighbor diameter shifting is enabled, PPPM may not correct for all excluded interactions\n");
 
+class tree(force._force):
+    R""" Electrostatics with free, slab or periodic boundaries computed with a tree code.
+
+    Args:
+        group (:py:mod:`hoomd.group`): Group of charged particles
+        nlist (:py:mod:`hoomd.md.nlist`): Neighbor list, which provides the excluded pairs
+
+    :py:class:`tree` computes the full Coulomb interaction
+
+    .. math::
+
+        U = \frac{1}{2} \sum_{i \neq j} \frac{q_i q_j}{|\vec{r}_i - \vec{r}_j|}
+
+    between all particles in the group with the Barnes-Hut method, so no short ranged pair potential is needed. The
+    charges are sorted into a tree of bounding boxes. The interaction with a distant node of the tree is computed from
+    a multipole expansion (charge, dipole or quadrupole) of the charges in the node. A node of radius :math:`b` at
+    distance :math:`d` is accepted if the truncation error estimate :math:`(b/d)^{p+1}` of an expansion of order
+    :math:`p` is smaller than the tolerance, and the lowest such order is used. Nodes that do not meet the tolerance
+    are opened, and nearby charges interact directly. The cost scales as :math:`N \log N`.
+
+    Unlike :py:class:`pppm`, :py:class:`tree` does not require a fully periodic box. It supports the boundary
+    conditions:
+
+    - ``free`` - isolated system, e.g. a nanoparticle in vacuum. The box only needs to contain the particles, and
+      particles that cross the box boundaries are unwrapped.
+    - ``slab`` - periodic in x and y and isolated in z, e.g. a confined electrolyte. Use walls to confine the particles
+      in z.
+    - ``periodic`` - periodic in all directions with conducting boundary conditions, like :py:class:`pppm`.
+
+    Periodic images within a sphere (``periodic``) or a disk (``slab``) of radius *n_images* times the largest box
+    length are summed explicitly, and the conditionally convergent image sum is corrected analytically. The system
+    must be charge neutral for these boundary conditions. For bulk systems, :py:class:`pppm` is usually faster.
+
+    The interactions between excluded pairs of particles (e.g. bonded neighbors) in the neighbor list are removed.
+
+    :py:meth:`set_params()` must be called before any :py:func:`hoomd.run()` can take place.
+
+    Note:
+        :py:class:`tree` is only available on the CPU. In MPI simulations, the positions and charges of the group are
+        gathered on every rank.
+
+    Note:
+        The energy is logged as ``tree_energy``.
+
+    Example::
+
+        charged = group.charged();
+        nl = md.nlist.cell()
+        c = charge.tree(group=charged, nlist=nl)
+        c.set_params(tol=1e-3, boundary='slab', n_images=4)
+
+    """
+    def __init__(self, group, nlist):
+        hoomd.util.print_status_line();
+
+        # initialize the base class
+        force._force.__init__(self);
+
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("charge.tree is not supported on the GPU\n");
+            raise RuntimeError("Error initializing charge.tree");
+
+        # the tree code doesn't need neighbors, only the exclusions, so subscribe call back as None
+        self.nlist = nlist
+        self.nlist.subscribe(lambda : None)
+        self.nlist.update_rcut()
+
+        # create the c++ mirror class
+        self.cpp_force = _md.TreeCodeForceCompute(hoomd.context.current.system_definition, self.nlist.cpp_nlist, group.cpp_group);
+
+        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
+
+        # error check flag - must be set to true by set_params in order for the run() to commence
+        self.params_set = False;
+
+    def set_params(self, tol=1e-2, order=2, boundary='free', n_images=4):
+        """ Sets the tree code parameters.
+
+        Args:
+            tol (float): Largest accepted truncation error estimate of a multipole expansion
+            order (int): Maximum order of the multipole expansions (0: charge, 1: dipole, 2: quadrupole)
+            boundary (str): Boundary conditions, one of ``free``, ``slab`` or ``periodic``
+            n_images (int): Radius of the sum over periodic images in units of the largest box length in the periodic
+                            directions
+
+        Examples::
+
+            c.set_params(tol=1e-3)
+            c.set_params(boundary='slab', n_images=8)
+
+        """
+        hoomd.util.print_status_line();
+
+        if tol <= 0.0 or tol >= 1.0:
+            hoomd.context.msg.error("charge.tree: tol must be between 0 and 1\n");
+            raise ValueError("tol must be between 0 and 1");
+
+        if order < 0 or order > 2:
+            hoomd.context.msg.error("charge.tree: order must be 0, 1 or 2\n");
+            raise ValueError("order must be 0, 1 or 2");
+
+        if n_images < 0:
+            hoomd.context.msg.error("charge.tree: n_images must not be negative\n");
+            raise ValueError("n_images must not be negative");
+
+        if boundary == 'free':
+            cpp_boundary = _md.TreeCodeForceCompute.boundaryMode.isolated;
+        elif boundary == 'slab':
+            cpp_boundary = _md.TreeCodeForceCompute.boundaryMode.slab;
+        elif boundary == 'periodic':
+            cpp_boundary = _md.TreeCodeForceCompute.boundaryMode.periodic;
+        else:
+            hoomd.context.msg.error("charge.tree: invalid boundary conditions " + str(boundary) + "\n");
+            raise ValueError("boundary must be free, slab or periodic");
+
+        self.params_set = True;
+
+        self.cpp_force.setParams(float(tol), int(order), cpp_boundary, int(n_images));
+
+    def update_coeffs(self):
+        if not self.params_set:
+            hoomd.context.msg.error("Parameters for charge.tree are not set. Call set_params prior to run()\n");
+            raise RuntimeError("Error initializing run");
+
 def diffpr(hx, hy, hz, xprd, yprd, zprd, N, order, kappa, q2, rcut):
     lprx = rms(hx, xprd, N, order, kappa, q2)
     lpry = rms(hy, yprd, N, order, kappa, q2)
@@ -244,9 +244,9 @@ class harmonic(force._force):
 
         # create the c++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
-            self.cpp_force = _md.HarmonicDihedralForceCompute(hoomd.context.current.system_definition);
+            self.cpp_force = _md.PotentialDihedralHarmonic(hoomd.context.current.system_definition, self.name);
         else:
-            self.cpp_force = _md.HarmonicDihedralForceComputeGPU(hoomd.context.current.system_definition);
+            self.cpp_force = _md.HarmonicDihedralForceComputeGPU(hoomd.context.current.system_definition, self.name);
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
@@ -274,7 +274,7 @@ class harmonic(force._force):
             for name in coeff_list:
                 coeff_dict[name] = self.dihedral_coeff.get(type_list[i], name);
 
-            self.cpp_force.setParams(i, coeff_dict['k'], coeff_dict['d'], coeff_dict['n'], coeff_dict['phi_0']);
+            self.cpp_force.setParams(i, _hoomd.make_scalar4(coeff_dict['k'], coeff_dict['d'], coeff_dict['n'], coeff_dict['phi_0']));
 
     ## \internal
     # \brief Get metadata
@@ -517,9 +517,9 @@ class opls(force._force):
 
         # create the c++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
-            self.cpp_force = _md.OPLSDihedralForceCompute(hoomd.context.current.system_definition);
+            self.cpp_force = _md.PotentialDihedralOPLS(hoomd.context.current.system_definition, self.name);
         else:
-            self.cpp_force = _md.OPLSDihedralForceComputeGPU(hoomd.context.current.system_definition);
+            self.cpp_force = _md.OPLSDihedralForceComputeGPU(hoomd.context.current.system_definition, self.name);
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
@@ -546,7 +546,7 @@ class opls(force._force):
             for name in coeff_list:
                 coeff_dict[name] = self.dihedral_coeff.get(type_list[i], name);
 
-            self.cpp_force.setParams(i, coeff_dict['k1'], coeff_dict['k2'], coeff_dict['k3'], coeff_dict['k4']);
+            self.cpp_force.setParams(i, _hoomd.make_scalar4(coeff_dict['k1'], coeff_dict['k2'], coeff_dict['k3'], coeff_dict['k4']));
 
     ## \internal
     # \brief Get metadata
@@ -0,0 +1,227 @@
+# Copyright (c) 2009-2019 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+# Maintainer: joaander / All Developers are free to add commands for new features
+
+R""" Long-ranged dispersion potentials.
+
+The :math:`r^{-6}` dispersion of Lennard-Jones interactions decays slowly enough that truncating it at a short cutoff
+changes the thermodynamics of a system, and tail corrections do not apply to inhomogeneous systems such as interfaces.
+Like the electrostatics in :py:mod:`hoomd.md.charge`, the dispersion can be split into a short-ranged part computed in
+real space and a long-ranged part computed in Fourier space. The commands in this module automatically initialize and
+configure both parts.
+"""
+
+from hoomd.md import force;
+from hoomd.md import _md
+from hoomd.md import pair;
+import hoomd;
+
+import math;
+
+class pppm(force._force):
+    R""" Long-range Lennard-Jones dispersion computed with the PPPM method (LJ-PME).
+
+    Args:
+        group (:py:mod:`hoomd.group`): Group on which to apply long range dispersion forces. The short range part is
+                                       always applied between all particles.
+        nlist (:py:mod:`hoomd.md.nlist`): Neighbor list
+
+    :py:class:`pppm` computes Lennard-Jones interactions between all particles in the simulation, without truncating
+    the dispersion at the cutoff. The dispersion between particles of types :math:`i` and :math:`j` is split into
+
+    .. math::
+        :nowrap:
+
+        \begin{eqnarray*}
+        -\frac{C_{ij}}{r^6} = & -\frac{C_{ij} g(\kappa r)}{r^6} - \frac{C_{ij} \left[1 - g(\kappa r)\right]}{r^6} \\
+        g(x) = & e^{-x^2} \left(1 + x^2 + \frac{x^4}{2} \right)
+        \end{eqnarray*}
+
+    The second, long-ranged part is computed on a mesh with the same particle-particle particle-mesh method as
+    :py:class:`hoomd.md.charge.pppm`. The mesh requires the geometric combining rule
+    :math:`C_{ij} = c_i c_j` with :math:`c_i = \sqrt{4 \varepsilon_{ii} \sigma_{ii}^6}`, which is computed from the
+    parameters of the like-type pairs. The repulsion, the short-ranged part of the dispersion, and the difference
+    between the actual and the geometric :math:`C_{ij}` for pairs of unlike types are computed in real space by a
+    :py:class:`hoomd.md.pair.lj_pme` that :py:class:`pppm` creates and configures, so do not specify an additional
+    one.
+
+    Because the short-ranged dispersion decays like a Gaussian, the real space cutoff can be much shorter than
+    for a truncated Lennard-Jones potential.
+
+    Use :py:meth:`pair_coeff.set <hoomd.md.pair.coeff.set>` to set the Lennard-Jones coefficients:
+
+    - :math:`\varepsilon` - *epsilon* (in energy units)
+    - :math:`\sigma` - *sigma* (in distance units)
+
+    They must be set for every pair of like types. Pairs of unlike types that are not set use the geometric combining
+    rule :math:`\varepsilon_{ij} = \sqrt{\varepsilon_{ii} \varepsilon_{jj}}`,
+    :math:`\sigma_{ij} = \sqrt{\sigma_{ii} \sigma_{jj}}`.
+
+    The mesh parameters Nx, Ny, Nz, order and :math:`r_{\mathrm{cut}}` must be set using :py:meth:`set_params()`
+    before any :py:func:`hoomd.run()` can take place.
+
+    Note:
+        :py:class:`pppm` is only available on the CPU.
+
+    .. important::
+        In MPI simulations, the number of grid point along every dimensions must be a power of two.
+
+    Example::
+
+        nl = md.nlist.cell()
+        lj = md.dispersion.pppm(group=group.all(), nlist=nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        lj.set_params(Nx=32, Ny=32, Nz=32, order=5, rcut=1.2)
+
+    """
+    def __init__(self, group, nlist):
+        hoomd.util.print_status_line();
+
+        # initialize the base class
+        force._force.__init__(self);
+
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("dispersion.pppm is not supported on the GPU\n");
+            raise RuntimeError("Error initializing dispersion.pppm");
+
+        # PPPM itself doesn't really need a neighbor list, so subscribe call back as None
+        self.nlist = nlist
+        self.nlist.subscribe(lambda : None)
+        self.nlist.update_rcut()
+
+        # create the c++ mirror class
+        self.cpp_force = _md.PPPMDispersionForceCompute(hoomd.context.current.system_definition, self.nlist.cpp_nlist, group.cpp_group);
+
+        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
+
+        # error check flag - must be set to true by set_params in order for the run() to commence
+        self.params_set = False;
+
+        # initialize the short range part of the dispersion
+        hoomd.util.quiet_status();
+        self.lj = pair.lj_pme(r_cut = False, nlist = self.nlist);
+        hoomd.util.unquiet_status();
+
+        # the user sets the Lennard-Jones parameters of the short range part
+        self.pair_coeff = self.lj.pair_coeff;
+
+    # override disable and enable to work with both of the forces
+    def disable(self, log=False):
+        hoomd.util.print_status_line();
+
+        hoomd.util.quiet_status();
+        force._force.disable(self, log);
+        self.lj.disable(log);
+        hoomd.util.unquiet_status();
+
+    def enable(self):
+        hoomd.util.print_status_line();
+
+        hoomd.util.quiet_status();
+        force._force.enable(self);
+        self.lj.enable();
+        hoomd.util.unquiet_status();
+
+    def set_params(self, Nx, Ny, Nz, order, rcut, rtol=1e-3):
+        """ Sets PPPM parameters.
+
+        Args:
+            Nx (int): Number of grid points in x direction
+            Ny (int): Number of grid points in y direction
+            Nz (int): Number of grid points in z direction
+            order (int): Number of grid points in each direction to assign dispersion coefficients to
+            rcut  (float): Cutoff for the short-ranged part of the dispersion
+            rtol (float): Fraction of the dispersion at the cutoff that is computed in real space, which determines
+                          the splitting parameter :math:`\\kappa`
+
+        Examples::
+
+            lj.set_params(Nx=32, Ny=32, Nz=32, order=5, rcut=1.2)
+
+        Note that the Fourier transforms are much faster for number of grid points of the form 2^N.
+        """
+        hoomd.util.print_status_line();
+
+        if hoomd.context.current.system_definition.getNDimensions() != 3:
+            hoomd.context.msg.error("System must be 3 dimensional\n");
+            raise RuntimeError("Cannot compute dispersion PPPM");
+
+        if rtol <= 0.0 or rtol >= 1.0:
+            hoomd.context.msg.error("dispersion.pppm: rtol must be between 0 and 1\n");
+            raise ValueError("rtol must be between 0 and 1");
+
+        # solve g(kappa*rcut) = rtol, g decreases monotonically from 1 to 0
+        x_lo = 0.0
+        x_hi = 20.0
+        while x_hi - x_lo > 1e-10:
+            x = 0.5*(x_lo + x_hi)
+            if _short_range_fraction(x) > rtol:
+                x_lo = x
+            else:
+                x_hi = x
+        kappa = 0.5*(x_lo + x_hi)/rcut
+
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        hoomd.util.quiet_status();
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                self.pair_coeff.set(type_list[i], type_list[j], kappa = kappa, r_cut=rcut)
+        hoomd.util.unquiet_status();
+
+        self.params_set = True;
+
+        # set the parameters for the appropriate type
+        self.cpp_force.setParams(Nx, Ny, Nz, order, kappa, rcut, 0.0);
+
+    def update_coeffs(self):
+        if not self.params_set:
+            hoomd.context.msg.error("Coefficients for dispersion.pppm are not set. Call set_params prior to run()\n");
+            raise RuntimeError("Error initializing run");
+
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        # the dispersion coefficients of the mesh follow from the like-type parameters
+        epsilon = [];
+        sigma = [];
+        for t in type_list:
+            epsilon.append(self.pair_coeff.get(t, t, 'epsilon'));
+            sigma.append(self.pair_coeff.get(t, t, 'sigma'));
+            if epsilon[-1] is None or sigma[-1] is None:
+                hoomd.context.msg.error("dispersion.pppm: epsilon and sigma must be set for type pair " + str((t,t)) + "\n");
+                raise RuntimeError("Error initializing run");
+
+        c = [math.sqrt(4.0 * max(epsilon[i], 0.0) * math.pow(sigma[i], 6.0)) for i in range(0,ntypes)];
+        for i in range(0,ntypes):
+            self.cpp_force.setCoefficient(i, c[i]);
+
+        hoomd.util.quiet_status();
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                a = type_list[i];
+                b = type_list[j];
+
+                # apply the geometric combining rule to unset pairs of unlike types
+                if self.pair_coeff.get(a, b, 'epsilon') is None:
+                    self.pair_coeff.set(a, b, epsilon = math.sqrt(epsilon[i]*epsilon[j]));
+                if self.pair_coeff.get(a, b, 'sigma') is None:
+                    self.pair_coeff.set(a, b, sigma = math.sqrt(sigma[i]*sigma[j]));
+
+                self.pair_coeff.set(a, b, c6_mesh = c[i]*c[j]);
+        hoomd.util.unquiet_status();
+
+        if self.nlist.cpp_nlist.getDiameterShift():
+            hoomd.context.msg.warning("Neighbor diameter shifting is enabled, dispersion.pppm may not correct for all excluded interactions\n");
+
+## \internal
+# \brief Fraction g(x) of the dispersion that is computed in real space
+def _short_range_fraction(x):
+    y = x*x
+    return math.exp(-y)*(1.0 + y + 0.5*y*y)
@@ -139,6 +139,27 @@ class _force(hoomd.meta._metadata):
         self.enabled = True;
         self.log = True;
 
+    def set_mixed_precision(self, enable=True):
+        R""" Compute the force in mixed precision.
+
+        Args:
+            enable (bool): Set to True to read the particle positions in single precision, relative to the
+                           origin of the local box, and False to read them in full precision.
+
+        In mixed precision, the forces, energies and virials are still accumulated in full precision, and the
+        integration is not affected. Pair potentials, bond potentials and :py:class:`hoomd.md.charge.pppm` support
+        mixed precision on the CPU.
+
+        Examples::
+
+            lj.set_mixed_precision()
+            harmonic.set_mixed_precision(False)
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        self.cpp_force.setMixedPrecision(enable);
+
     def get_energy(self,group):
         R""" Get the energy of a particle group.
 
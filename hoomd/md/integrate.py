@@ -98,6 +98,9 @@ class mode_standard(_integrator):
         self.cpp_integrator = _md.IntegratorTwoStep(hoomd.context.current.system_definition, dt);
         self.supports_methods = True;
 
+        # evaluation periods of multiple time step forces
+        self.force_periods = {};
+
         hoomd.context.current.system.setIntegrator(self.cpp_integrator);
 
         hoomd.util.quiet_status();
@@ -159,6 +162,58 @@ class mode_standard(_integrator):
         self.check_initialization();
         self.cpp_integrator.initializeIntegrationMethods();
 
+    def set_force_period(self, force, period):
+        R""" Evaluate a slowly varying force only every *period* time steps.
+
+        Args:
+            force: The force to set the period for, e.g. a :py:class:`hoomd.md.charge.pppm` instance.
+            period (int): Number of time steps between evaluations of *force*.
+
+        :py:class:`mode_standard` integrates *force* with the impulse form of the reversible reference system
+        propagator algorithm (r-RESPA). The force is evaluated on every time step that is a multiple of *period*,
+        and is applied as an impulse :math:`\mathrm{period} \cdot \vec{F}` in the velocity half steps around it.
+        All other forces are evaluated on every step. This is a good approximation when *force* varies slowly on the
+        time scale *period* * *dt*, such as the long-range part of the electrostatics.
+
+        On the time steps in between, *force* is only evaluated when a logger or an integration method needs the
+        potential energy or the virial, so that logged quantities remain correct. Integration methods that need the
+        pressure on every step (:py:class:`npt` and :py:class:`nph`) therefore evaluate it on every step.
+
+        Set *period* to 1 to evaluate *force* on every step again. Multiple time step integration is only supported
+        on the CPU.
+
+        Examples::
+
+            pppm = charge.pppm(group=charged, nlist=nl)
+            integrator_mode.set_force_period(pppm, period=4)
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        period = int(period);
+        if period < 1:
+            hoomd.context.msg.error("integrate.mode_standard: the period of a force must be at least 1.\n");
+            raise ValueError("Error setting force period");
+
+        if period > 1 and hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("integrate.mode_standard: multiple time step integration is not supported on the GPU.\n");
+            raise RuntimeError("Error setting force period");
+
+        if period == 1:
+            self.force_periods.pop(force, None);
+        else:
+            self.force_periods[force] = period;
+
+    ## \internal
+    # \brief Updates the forces in the reflected c++ class and assigns their evaluation periods
+    def update_forces(self):
+        _integrator.update_forces(self);
+
+        for f, period in self.force_periods.items():
+            if f.enabled:
+                self.cpp_integrator.setForcePeriod(f.cpp_force, period);
+
 
 class nvt(_integration_method):
     R""" NVT Integration via the Nosé-Hoover thermostat.
@@ -5,8 +5,10 @@
 // Maintainer: joaander All developers are free to add the calls needed to export their modules
 
 #include "ActiveForceCompute.h"
+#include "AllAnglePotentials.h"
 #include "AllAnisoPairPotentials.h"
 #include "AllBondPotentials.h"
+#include "AllDihedralPotentials.h"
 #include "AllExternalPotentials.h"
 #include "AllPairPotentials.h"
 #include "AllTripletPotentials.h"
@@ -23,29 +25,29 @@
 #include "FIREEnergyMinimizer.h"
 #include "ForceComposite.h"
 #include "ForceDistanceConstraint.h"
-#include "HarmonicAngleForceCompute.h"
-#include "CosineSqAngleForceCompute.h"
-#include "HarmonicDihedralForceCompute.h"
 #include "HarmonicImproperForceCompute.h"
 #include "IntegrationMethodTwoStep.h"
 #include "IntegratorTwoStep.h"
 #include "MolecularForceCompute.h"
 #include "NeighborListBinned.h"
+#include "NeighborListCluster.h"
 #include "NeighborList.h"
 #include "NeighborListStencil.h"
 #include "NeighborListTree.h"
-#include "OPLSDihedralForceCompute.h"
 #include "PotentialBond.h"
 #include "PotentialExternal.h"
 #include "PotentialPairDPDThermo.h"
 #include "PotentialPair.h"
 #include "PotentialTersoff.h"
+#include "PPPMDispersionForceCompute.h"
 #include "PPPMForceCompute.h"
 #include "QuaternionMath.h"
 #include "TableAngleForceCompute.h"
 #include "TableDihedralForceCompute.h"
 #include "TablePotential.h"
+#include "TableSplinePotential.h"
 #include "TempRescaleUpdater.h"
+#include "TreeCodeForceCompute.h"
 #include "TwoStepBD.h"
 #include "TwoStepBerendsen.h"
 #include "TwoStepLangevinBase.h"
@@ -243,14 +245,11 @@ PYBIND11_MODULE(_md, m)
     {
     export_ActiveForceCompute(m);
     export_ConstExternalFieldDipoleForceCompute(m);
-    export_HarmonicAngleForceCompute(m);
-    export_CosineSqAngleForceCompute(m);
     export_TableAngleForceCompute(m);
-    export_HarmonicDihedralForceCompute(m);
-    export_OPLSDihedralForceCompute(m);
     export_TableDihedralForceCompute(m);
     export_HarmonicImproperForceCompute(m);
     export_TablePotential(m);
+    export_TableSplinePotential(m);
     export_BondTablePotential(m);
     export_PotentialPair<PotentialPairBuckingham>(m, "PotentialPairBuckingham");
     export_PotentialPair<PotentialPairLJ>(m, "PotentialPairLJ");
@@ -269,6 +268,7 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPair<PotentialPairReactionField>(m, "PotentialPairReactionField");
     export_PotentialPair<PotentialPairDLVO>(m, "PotentialPairDLVO");
     export_PotentialPair<PotentialPairFourier>(m, "PotentialPairFourier");
+    export_PotentialPair<PotentialPairLJPME>(m, "PotentialPairLJPME");
     export_tersoff_params(m);
     export_pair_params(m);
     export_AnisoPotentialPair<AnisoPotentialPairGB>(m, "AnisoPotentialPairGB");
@@ -279,10 +279,15 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPairDPDThermo<PotentialPairDPDLJThermoDPD, PotentialPairDPDLJ>(m, "PotentialPairDPDLJThermoDPD");
     export_PotentialBond<PotentialBondHarmonic>(m, "PotentialBondHarmonic");
     export_PotentialBond<PotentialBondFENE>(m, "PotentialBondFENE");
+    export_PotentialAngle<PotentialAngleHarmonic>(m, "PotentialAngleHarmonic");
+    export_PotentialAngle<PotentialAngleCosineSq>(m, "PotentialAngleCosineSq");
+    export_PotentialDihedral<PotentialDihedralHarmonic>(m, "PotentialDihedralHarmonic");
+    export_PotentialDihedral<PotentialDihedralOPLS>(m, "PotentialDihedralOPLS");
     export_PotentialSpecialPair<PotentialSpecialPairLJ>(m, "PotentialSpecialPairLJ");
     export_PotentialSpecialPair<PotentialSpecialPairCoulomb>(m, "PotentialSpecialPairCoulomb");
     export_NeighborList(m);
     export_NeighborListBinned(m);
+    export_NeighborListCluster(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
     export_ConstraintSphere(m);
@@ -291,6 +296,8 @@ PYBIND11_MODULE(_md, m)
     export_ForceDistanceConstraint(m);
     export_ForceComposite(m);
     export_PPPMForceCompute(m);
+    export_PPPMDispersionForceCompute(m);
+    export_TreeCodeForceCompute(m);
     py::class_< wall_type, std::shared_ptr<wall_type> >(m, "wall_type")
         .def(py::init<>());
     m.def("make_wall_field_params", &make_wall_field_params);
@@ -319,6 +326,7 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPairGPU<PotentialPairReactionFieldGPU, PotentialPairReactionField>(m, "PotentialPairReactionFieldGPU");
     export_PotentialPairGPU<PotentialPairDLVOGPU, PotentialPairDLVO>(m, "PotentialPairDLVOGPU");
     export_PotentialPairGPU<PotentialPairFourierGPU, PotentialPairFourier>(m, "PotentialPairFourierGPU");
+    export_PotentialPairGPU<PotentialPairLJPMEGPU, PotentialPairLJPME>(m, "PotentialPairLJPMEGPU");
     export_PotentialPairGPU<PotentialPairEwaldGPU, PotentialPairEwald>(m, "PotentialPairEwaldGPU");
     export_PotentialPairGPU<PotentialPairMorseGPU, PotentialPairMorse>(m, "PotentialPairMorseGPU");
     export_PotentialPairGPU<PotentialPairDPDGPU, PotentialPairDPD>(m, "PotentialPairDPDGPU");
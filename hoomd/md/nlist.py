@@ -443,6 +443,39 @@ class nlist:
         # return the results to the script
         return (fastest_r_buff, self.query_update_period());
 
+    def autotune(self, enable=True, period=1000, r_min=0.05, r_max=1.0):
+        R""" Tune *r_buff* and *check_period* while the simulation runs.
+
+        Args:
+            enable (bool): Set to False to disable the tuning and keep the current values.
+            period (int): Minimum number of time steps over which each *r_buff* value is timed.
+            r_min (float): Smallest value of *r_buff* to choose.
+            r_max (float): Largest value of *r_buff* to choose.
+
+        Unlike :py:meth:`tune()`, :py:meth:`autotune()` does not run separate benchmarks. During every following
+        :py:func:`hoomd.run()`, the neighbor list measures the time per step, including the neighbor list builds and
+        the pair forces, over windows of at least *period* steps. After every window, it tries a new *r_buff*, keeps it
+        if the simulation became faster and goes back otherwise, with smaller and smaller changes. It keeps adjusting
+        *r_buff* as the density and temperature change. *check_period* is set to half of the shortest interval between
+        builds, and to 1 after a dangerous build. Values set with :py:meth:`set_params()` are the starting point for
+        the tuning. The *check_period* is only tuned when *dist_check* is enabled.
+
+        The current values are printed in the neighbor list statistics at the end of a :py:func:`hoomd.run()`.
+
+        Examples::
+
+            nl.autotune()
+            nl.autotune(period=500, r_min=0.2, r_max=0.8)
+            nl.autotune(enable=False)
+        """
+        hoomd.util.print_status_line();
+
+        if self.cpp_nlist is None:
+            hoomd.context.msg.error('Bug in hoomd: cpp_nlist not set, please report\n');
+            raise RuntimeError('Error tuning neighbor list');
+
+        self.cpp_nlist.setAutotune(enable, int(period), float(r_min), float(r_max));
+
 ## \internal
 # \brief %nlist r_cut matrix
 # \details
@@ -560,6 +593,8 @@ class cell(nlist):
         dist_check (bool): Flag to enable / disable distance checking.
         name (str): Optional name for this neighbor list instance.
         deterministic (bool): When True, enable deterministic runs on the GPU by sorting the cell list.
+        compact (bool): When True, store the members of all cells back to back instead of padding every cell to the
+            size of the largest one (CPU only).
 
     :py:class:`cell` creates a cell list based neighbor list object to which pair potentials can be attached for computing
     non-bonded pairwise interactions. Cell listing allows for *O(N)* construction of the neighbor list. Particles are first
@@ -583,7 +618,7 @@ class cell(nlist):
         is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
         significantly degraded performance or incorrect results.
     """
-    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, deterministic=False):
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, deterministic=False, compact=False):
         hoomd.util.print_status_line()
 
         nlist.__init__(self)
@@ -597,10 +632,12 @@ class cell(nlist):
         # create the C++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
             self.cpp_cl = _hoomd.CellList(hoomd.context.current.system_definition)
+            self.cpp_cl.setCompact(compact)
             hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
             self.cpp_nlist = _md.NeighborListBinned(hoomd.context.current.system_definition, 0.0, r_buff, self.cpp_cl )
         else:
             self.cpp_cl  = _hoomd.CellListGPU(hoomd.context.current.system_definition)
+            self.cpp_cl.setCompact(compact)
             hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
             self.cpp_nlist = _md.NeighborListGPUBinned(hoomd.context.current.system_definition, 0.0, r_buff, self.cpp_cl )
 
@@ -619,6 +656,77 @@ class cell(nlist):
 
 cell.cur_id = 0
 
+class cluster(nlist):
+    R""" Cluster pair neighbor list
+
+    Args:
+        r_buff (float):  Buffer width.
+        check_period (int): How often to attempt to rebuild the neighbor list.
+        d_max (float): The maximum diameter a particle will achieve, only used in conjunction with slj diameter shifting.
+        dist_check (bool): Flag to enable / disable distance checking.
+        name (str): Optional name for this neighbor list instance.
+        compact (bool): When True, store the members of all cells back to back instead of padding every cell to the
+            size of the largest one (CPU only).
+
+    :py:class:`cluster` groups spatially close particles into clusters of 4 and lists the pairs of clusters that
+    interact, instead of the neighbors of every particle. The clusters are built from the same cell list as
+    :py:class:`cell`, and every cluster pair stores a mask of the particle pairs within the cutoff. Standard and
+    anisotropic pair potentials attached to this neighbor list loop directly over the cluster pairs, which needs less
+    memory and accesses the particle data in larger contiguous chunks. All other forces that use the neighbor list
+    receive the usual per-particle list. The set of interacting pairs is identical to :py:class:`cell`.
+
+    Use base class methods to change parameters (:py:meth:`set_params <nlist.set_params>`), reset the exclusion list
+    (:py:meth:`reset_exclusions <nlist.reset_exclusions>`) or tune *r_buff* (:py:meth:`tune <nlist.tune>`).
+
+    Examples::
+
+        nl_cl = nlist.cluster(check_period = 1)
+        nl_cl.set_params(r_buff=0.5)
+        lj = md.pair.lj(r_cut=2.5, nlist=nl_cl)
+
+    Note:
+        :py:class:`cluster` is only available on the CPU.
+
+    Note:
+        *d_max* should only be set when slj diameter shifting is required by a pair potential. Currently, slj
+        is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
+        significantly degraded performance or incorrect results.
+    """
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, compact=False):
+        hoomd.util.print_status_line()
+
+        nlist.__init__(self)
+
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("nlist.cluster is not supported on the GPU\n");
+            raise RuntimeError("Error initializing nlist.cluster");
+
+        if name is None:
+            self.name = "cluster_nlist_%d" % cluster.cur_id
+            cluster.cur_id += 1
+        else:
+            self.name = name
+
+        # create the C++ mirror class
+        self.cpp_cl = _hoomd.CellList(hoomd.context.current.system_definition)
+        self.cpp_cl.setCompact(compact)
+        hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
+        self.cpp_nlist = _md.NeighborListCluster(hoomd.context.current.system_definition, 0.0, r_buff, self.cpp_cl )
+
+        self.cpp_nlist.setEvery(check_period, dist_check)
+
+        hoomd.context.current.system.addCompute(self.cpp_nlist, self.name)
+
+        # register this neighbor list with the context
+        hoomd.context.current.neighbor_lists += [self]
+
+        # save the user defined parameters
+        hoomd.util.quiet_status()
+        self.set_params(r_buff, check_period, d_max, dist_check)
+        hoomd.util.unquiet_status()
+
+cluster.cur_id = 0
+
 class stencil(nlist):
     R""" Cell list based neighbor list using stencils
 
@@ -630,6 +738,8 @@ class stencil(nlist):
         cell_width (float): The underlying stencil bin width for the cell list
         name (str): Optional name for this neighbor list instance.
         deterministic (bool): When True, enable deterministic runs on the GPU by sorting the cell list.
+        compact (bool): When True, store the members of all cells back to back instead of padding every cell to the
+            size of the largest one (CPU only).
 
     :py:class:`stencil` creates a cell list based neighbor list object to which pair potentials can be attached for computing
     non-bonded pairwise interactions. Cell listing allows for O(N) construction of the neighbor list. Particles are first
@@ -665,7 +775,7 @@ class stencil(nlist):
         is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
         significantly degraded performance or incorrect results.
     """
-    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, cell_width=None, name=None, deterministic=False):
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, cell_width=None, name=None, deterministic=False, compact=False):
         hoomd.util.print_status_line()
 
         # register the citation
@@ -692,12 +802,14 @@ class stencil(nlist):
         # create the C++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
             self.cpp_cl = _hoomd.CellList(hoomd.context.current.system_definition)
+            self.cpp_cl.setCompact(compact)
             hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
             cls = _hoomd.CellListStencil(hoomd.context.current.system_definition, self.cpp_cl)
             hoomd.context.current.system.addCompute(cls, self.name + "_cls")
             self.cpp_nlist = _md.NeighborListStencil(hoomd.context.current.system_definition, 0.0, r_buff, self.cpp_cl, cls)
         else:
             self.cpp_cl  = _hoomd.CellListGPU(hoomd.context.current.system_definition)
+            self.cpp_cl.setCompact(compact)
             hoomd.context.current.system.addCompute(self.cpp_cl , self.name + "_cl")
             cls = _hoomd.CellListStencil(hoomd.context.current.system_definition, self.cpp_cl)
             hoomd.context.current.system.addCompute(cls, self.name + "_cls")
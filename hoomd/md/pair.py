@@ -971,6 +971,80 @@ class ewald(pair):
         raise RuntimeError('Not implemented for DPD Conservative');
         return;
 
+class lj_pme(pair):
+    R""" Short-ranged part of the Lennard-Jones pair potential with mesh dispersion.
+
+    Args:
+        r_cut (float): Default cutoff radius (in distance units).
+        nlist (:py:mod:`hoomd.md.nlist`): Neighbor list
+        name (str): Name of the force instance.
+
+    :py:class:`lj_pme` specifies that the part of a Lennard-Jones pair potential that is not computed on the mesh by
+    :py:class:`hoomd.md.dispersion.pppm` should be applied between every non-excluded particle pair in the simulation.
+
+    .. math::
+        :nowrap:
+
+        \begin{eqnarray*}
+        V(r)  = & 4 \varepsilon \left[ \left( \frac{\sigma}{r} \right)^{12} -
+                  \left( \frac{\sigma}{r} \right)^{6} \right]
+                  + C_{\mathrm{mesh}} \frac{1 - g(\kappa r)}{r^6} & r < r_{\mathrm{cut}} \\
+              = & 0 & r \ge r_{\mathrm{cut}} \\
+        g(x)  = & e^{-x^2} \left(1 + x^2 + \frac{x^4}{2} \right)
+        \end{eqnarray*}
+
+    See :py:class:`pair` for details on how forces are calculated and the available energy shifting and smoothing modes.
+    Use :py:meth:`pair_coeff.set <coeff.set>` to set potential coefficients.
+
+    The following coefficients must be set per unique pair of particle types:
+
+    - :math:`\varepsilon` - *epsilon* (in energy units)
+    - :math:`\sigma` - *sigma* (in distance units)
+    - :math:`\kappa` - *kappa* (Splitting parameter, in 1/distance units)
+    - :math:`C_{\mathrm{mesh}}` - *c6_mesh* (Coefficient of the dispersion computed on the mesh, in energy
+      times distance^6 units)
+    - :math:`r_{\mathrm{cut}}` - *r_cut* (in distance units)
+      - *optional*: defaults to the global r_cut specified in the pair command
+    - :math:`r_{\mathrm{on}}`- *r_on* (in distance units)
+      - *optional*: defaults to the global r_cut specified in the pair command
+
+    Warning:
+        **DO NOT** use in conjunction with :py:class:`hoomd.md.dispersion.pppm`. It automatically creates and
+        configures :py:class:`lj_pme` for you.
+
+    """
+    def __init__(self, r_cut, nlist, name=None):
+        hoomd.util.print_status_line();
+
+        # tell the base class how we operate
+
+        # initialize the base class
+        pair.__init__(self, r_cut, nlist, name);
+
+        # create the c++ mirror class
+        if not hoomd.context.exec_conf.isCUDAEnabled():
+            self.cpp_force = _md.PotentialPairLJPME(hoomd.context.current.system_definition, self.nlist.cpp_nlist, self.name);
+            self.cpp_class = _md.PotentialPairLJPME;
+        else:
+            self.nlist.cpp_nlist.setStorageMode(_md.NeighborList.storageMode.full);
+            self.cpp_force = _md.PotentialPairLJPMEGPU(hoomd.context.current.system_definition, self.nlist.cpp_nlist, self.name);
+            self.cpp_class = _md.PotentialPairLJPMEGPU;
+
+        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
+
+        # setup the coefficient options
+        self.required_coeffs = ['epsilon', 'sigma', 'kappa', 'c6_mesh'];
+
+    def process_coeff(self, coeff):
+        epsilon = coeff['epsilon'];
+        sigma = coeff['sigma'];
+        kappa = coeff['kappa'];
+        c6_mesh = coeff['c6_mesh'];
+
+        lj1 = 4.0 * epsilon * math.pow(sigma, 12.0);
+        lj2 = 4.0 * epsilon * math.pow(sigma, 6.0);
+        return _hoomd.make_scalar4(lj1, lj2, c6_mesh, kappa);
+
 def _table_eval(r, rmin, rmax, V, F, width):
     dr = (rmax - rmin) / float(width-1);
     i = int(round((r - rmin)/dr))
@@ -1240,6 +1314,198 @@ class table(force._force):
         self.pair_coeff.set(a, b, func=_table_eval, rmin=rmin_table, rmax=rmax_table, coeff=dict(V=V_table, F=F_table, width=self.width))
         hoomd.util.unquiet_status();
 
+class table_spline(force._force):
+    R""" Tabulated pair potential with cubic spline interpolation.
+
+    Args:
+        width (int): Number of points to use to interpolate V and F.
+        nlist (:py:mod:`hoomd.md.nlist`): Neighbor list
+        name (str): Name of the force instance
+
+    :py:class:`table_spline` applies a tabulated pair potential between every non-excluded particle pair in the
+    simulation, with the same force and potential as :py:class:`table`.
+
+    Unlike :py:class:`table`, :math:`F_{\mathrm{user}}(r)` and :math:`V_{\mathrm{user}}(r)` are evaluated on *width*
+    grid points equally spaced in :math:`r^2`, :math:`r_i^2 = r_{\mathrm{min}}^2 + i (r_{\mathrm{max}}^2 -
+    r_{\mathrm{min}}^2)/(\mathrm{width}-1)`, and V is interpolated with cubic Hermite splines that match both V and F
+    at the grid points. The force is the derivative of the interpolated V, so energy is conserved to the accuracy of
+    the integrator. The spline needs far fewer grid points than the linear interpolation of :py:class:`table`
+    for the same accuracy, and the lookup needs no square root. For correctness, you must specify the force defined
+    by: :math:`F = -\frac{\partial V}{\partial r}`.
+
+    The following coefficients must be set per unique pair of particle types:
+
+    - :math:`V_{\mathrm{user}}(r)` and :math:`F_{\mathrm{user}}(r)` - evaluated by ``func`` (see example)
+    - coefficients passed to ``func`` - *coeff* (see example)
+    - :math:`r_{\mathrm{min}}` - *rmin* (in distance units)
+    - :math:`r_{\mathrm{max}}` - *rmax* (in distance units)
+
+    Example::
+
+        def lj(r, rmin, rmax, epsilon, sigma):
+            V = 4 * epsilon * ( (sigma / r)**12 - (sigma / r)**6);
+            F = 4 * epsilon / r * ( 12 * (sigma / r)**12 - 6 * (sigma / r)**6);
+            return (V, F)
+
+        nl = nlist.cell()
+        table = pair.table_spline(width=200, nlist=nl)
+        table.pair_coeff.set('A', 'A', func=lj, rmin=0.8, rmax=3.0, coeff=dict(epsilon=1.5, sigma=1.0))
+
+    .. rubric:: Set tables from a GSD file
+
+    :py:meth:`set_from_gsd()` reads the tables of all type pairs from frame 0 of a GSD file. For every type pair
+    *A*, *B*, the chunk ``table/A,B/r`` holds *rmin* and *rmax*, and the chunks ``table/A,B/V`` and
+    ``table/A,B/F`` hold V and F at the grid points above. Tables can have a different number of points for
+    every type pair::
+
+        table = pair.table_spline(width=200, nlist=nl)
+        table.set_from_gsd('tables.gsd')
+
+    Note:
+        :py:class:`table_spline` is not supported on the GPU.
+
+    """
+    def __init__(self, width, nlist, name=None):
+        hoomd.util.print_status_line();
+
+        # initialize the base class
+        force._force.__init__(self, name);
+
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("pair.table_spline is not supported on the GPU\n");
+            raise RuntimeError("Error initializing pair.table_spline");
+
+        if width < 2:
+            hoomd.context.msg.error("pair.table_spline: width must be at least 2\n");
+            raise ValueError("Error initializing pair.table_spline");
+
+        # setup the coefficient matrix
+        self.pair_coeff = coeff();
+
+        self.nlist = nlist
+        self.nlist.subscribe(lambda:self.get_rcut())
+        self.nlist.update_rcut()
+
+        # create the c++ mirror class
+        self.cpp_force = _md.TableSplinePotential(hoomd.context.current.system_definition, self.nlist.cpp_nlist, self.name);
+
+        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
+
+        # stash the width for later use
+        self.width = width;
+
+    def update_pair_table(self, typei, typej, func, rmin, rmax, coeff):
+        # allocate arrays to store V and F
+        Vtable = _hoomd.std_vector_scalar();
+        Ftable = _hoomd.std_vector_scalar();
+
+        # the grid is uniform in r^2
+        ds = (rmax*rmax - rmin*rmin) / float(self.width-1);
+
+        # evaluate each point of the function
+        for i in range(0, self.width):
+            r = math.sqrt(rmin*rmin + ds * i);
+            (V,F) = func(r, rmin, rmax, **coeff);
+
+            # fill out the tables
+            Vtable.append(V);
+            Ftable.append(F);
+
+        # pass the tables on to the underlying cpp compute
+        self.cpp_force.setTable(typei, typej, Vtable, Ftable, rmin, rmax);
+
+    ## \internal
+    # \brief Get the r_cut pair dictionary
+    # \returns rcut(i,j) dict if logging is on, and None otherwise
+    def get_rcut(self):
+        if not self.log:
+            return None
+
+        # go through the list of only the active particle types in the sim
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        # update the rcut by pair type
+        r_cut_dict = nl.rcut();
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                # get the r_cut value
+                rmax = self.pair_coeff.get(type_list[i], type_list[j], 'rmax');
+                r_cut_dict.set_pair(type_list[i],type_list[j], rmax);
+
+        return r_cut_dict;
+
+    def get_max_rcut(self):
+        # loop only over current particle types
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        # find the maximum rmax to update the neighbor list with
+        maxrmax = 0.0;
+
+        # loop through all of the unique type pairs and find the maximum rmax
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                rmax = self.pair_coeff.get(type_list[i], type_list[j], "rmax");
+                maxrmax = max(maxrmax, rmax);
+
+        return maxrmax;
+
+    def update_coeffs(self):
+        # check that the pair coefficients are valid
+        if not self.pair_coeff.verify(["func", "rmin", "rmax", "coeff"]):
+            hoomd.context.msg.error("Not all pair coefficients are set for pair.table_spline\n");
+            raise RuntimeError("Error updating pair coefficients");
+
+        # set all the params
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        # loop through all of the unique type pairs and evaluate the table
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                func = self.pair_coeff.get(type_list[i], type_list[j], "func");
+
+                # tables read by set_from_gsd are already set in the cpp compute
+                if func is None:
+                    continue;
+
+                rmin = self.pair_coeff.get(type_list[i], type_list[j], "rmin");
+                rmax = self.pair_coeff.get(type_list[i], type_list[j], "rmax");
+                coeff = self.pair_coeff.get(type_list[i], type_list[j], "coeff");
+
+                self.update_pair_table(i, j, func, rmin, rmax, coeff);
+
+    def set_from_gsd(self, filename):
+        R""" Set the pair interactions from a GSD file.
+
+        Args:
+            filename (str): Name of the file to read
+
+        Reads the tables of all type pairs that are present in frame 0 of the file. See :py:class:`table_spline`
+        for the layout of the chunks. Type pairs that are not present in the file keep their current coefficients.
+        """
+        hoomd.util.print_status_line();
+
+        self.cpp_force.readTables(filename);
+
+        # record the ranges for the neighbor list
+        pdata = hoomd.context.current.system_definition.getParticleData();
+        ntypes = pdata.getNTypes();
+        hoomd.util.quiet_status();
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                r = self.cpp_force.getRange(i, j);
+                if r.y > 0:
+                    self.pair_coeff.set(pdata.getNameByType(i), pdata.getNameByType(j), func=None, rmin=r.x, rmax=r.y, coeff=dict());
+        hoomd.util.unquiet_status();
+
 class morse(pair):
     R""" Morse pair potential.
 
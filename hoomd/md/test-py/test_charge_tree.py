@@ -0,0 +1,171 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md
+import unittest
+import os
+import math
+
+context.initialize()
+
+# charge.tree
+class charge_tree_tests (unittest.TestCase):
+    def setUp(self):
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]);
+
+        for i in range(0,50):
+            self.s.particles[i].charge = -1;
+
+        for i in range(50,100):
+            self.s.particles[i].charge = 1;
+
+    # basic test of creation and param setting
+    def test(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        c.set_params(tol=1e-2, order=2, boundary='free');
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(all);
+        run(100);
+
+        c.set_params(tol=1e-2, order=2, boundary='periodic', n_images=2);
+        run(10);
+
+        c.set_params(tol=1e-2, order=1, boundary='slab', n_images=2);
+        run(10);
+
+        del all
+        del c
+
+    # test missing parameters
+    def test_set_missing_params(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(all);
+        self.assertRaises(RuntimeError, run, 1);
+
+        del all
+        del c
+
+    # test invalid parameters
+    def test_invalid_params(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        self.assertRaises(ValueError, c.set_params, tol=0.0);
+        self.assertRaises(ValueError, c.set_params, order=3);
+        self.assertRaises(ValueError, c.set_params, boundary='open');
+
+        del all
+        del c
+
+    def tearDown(self):
+        del self.s
+        context.initialize()
+
+# charge.tree compared to the Coulomb interaction of two particles
+class charge_tree_twoparticle_tests (unittest.TestCase):
+    def setUp(self):
+        snap = data.make_snapshot(N=2, particle_types=[u'A'], box = data.boxdim(L=10))
+
+        if comm.get_rank() == 0:
+            snap.particles.position[0] = (0,0,0)
+            snap.particles.position[1] = (1.1,0,0)
+            snap.particles.charge[0] = 1.0
+            snap.particles.charge[1] = -1.0
+
+        self.s = init.read_snapshot(snap);
+
+    # with free boundaries, the particles only interact directly
+    def test_free(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        c.set_params(boundary='free');
+        log = analyze.log(quantities = ['tree_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        run(1);
+
+        self.assertAlmostEqual(log.query('tree_energy'), -1.0/1.1, 5)
+        self.assertAlmostEqual(c.forces[0].force[0], 1.0/1.1**2, 5)
+        self.assertAlmostEqual(c.forces[1].force[0], -1.0/1.1**2, 5)
+        self.assertAlmostEqual(c.forces[0].force[1], 0, 5)
+
+        del all
+        del c
+        del log
+
+    # free boundaries unwrap particles that cross the box boundary
+    def test_free_unwrap(self):
+        self.s.particles[1].position = (-4.5,0,0)
+        self.s.particles[1].image = (1,0,0)
+
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        c.set_params(boundary='free');
+        log = analyze.log(quantities = ['tree_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        run(1);
+
+        self.assertAlmostEqual(log.query('tree_energy'), -1.0/5.5, 5)
+        self.assertAlmostEqual(c.forces[0].force[0], 1.0/5.5**2, 5)
+
+        del all
+        del c
+        del log
+
+    # with periodic boundaries, the result matches the Ewald sum with conducting boundary conditions
+    def test_periodic(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        c.set_params(boundary='periodic', n_images=4);
+        log = analyze.log(quantities = ['tree_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        run(1);
+
+        # reference values from an Ewald sum
+        self.assertAlmostEqual(log.query('tree_energy'), -0.9116708, 4)
+        self.assertAlmostEqual(c.forces[0].force[0], 0.8216725, 4)
+        self.assertAlmostEqual(c.forces[1].force[0], -0.8216725, 4)
+
+        del all
+        del c
+        del log
+
+    # with slab boundaries, the result matches the Ewald sum with a vacuum layer and a dipole correction
+    def test_slab(self):
+        self.s.particles[0].position = (0,0,-1)
+        self.s.particles[1].position = (0,0,1)
+
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.tree(all, nlist = nl);
+        c.set_params(boundary='slab', n_images=8);
+        log = analyze.log(quantities = ['tree_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        run(1);
+
+        self.assertAlmostEqual(log.query('tree_energy'), -0.4822296, 4)
+        self.assertAlmostEqual(c.forces[0].force[2], 0.2674818, 4)
+        self.assertAlmostEqual(c.forces[1].force[2], -0.2674818, 4)
+        self.assertAlmostEqual(c.forces[0].force[0], 0, 5)
+
+        del all
+        del c
+        del log
+
+    def tearDown(self):
+        del self.s
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
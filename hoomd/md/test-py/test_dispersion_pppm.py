@@ -0,0 +1,90 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md
+import unittest
+import os
+import math
+
+context.initialize()
+
+# dispersion.pppm
+class dispersion_pppm_tests (unittest.TestCase):
+    def setUp(self):
+        self.s = init.create_lattice(lattice.sc(a=1.5),n=[5,5,4]);
+
+    # basic test of creation and param setting
+    def test(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        d = md.dispersion.pppm(all, nlist = nl);
+        d.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        d.set_params(Nx=16, Ny=16, Nz=16, order=5, rcut=2.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(all);
+        run(100);
+
+        del all
+        del d
+
+    def tearDown(self):
+        del self.s
+        context.initialize()
+
+# dispersion.pppm compared to a direct lattice sum
+class dispersion_pppm_twoparticle_tests (unittest.TestCase):
+    def setUp(self):
+        snap = data.make_snapshot(N=2, particle_types=[u'A'], box = data.boxdim(L=10))
+
+        if comm.get_rank() == 0:
+            snap.particles.position[0] = (0,0,0)
+            snap.particles.position[1] = (1.1,0,0)
+
+        self.s = init.read_snapshot(snap);
+
+    # the mesh and the short range part sum to the untruncated Lennard-Jones interaction
+    def test(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        d = md.dispersion.pppm(all, nlist = nl);
+        d.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        d.set_params(Nx=64, Ny=64, Nz=64, order=5, rcut=3.0);
+        log = analyze.log(quantities = ['pppm_lj_energy', 'pair_lj_pme_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        nl.set_params(r_buff=0.1)
+        run(1);
+
+        # the dispersion coefficient is 4 epsilon sigma^6, and the repulsion only acts between the nearest images
+        L = 10.0
+        c6 = 4.0
+        energy = 4.0/math.pow(1.1, 12.0)
+        force = -48.0/math.pow(1.1, 13.0)
+        for nx in range(-4,5):
+            for ny in range(-4,5):
+                for nz in range(-4,5):
+                    dx = 1.1 + nx*L
+                    r = math.sqrt(dx*dx + (ny*L)**2 + (nz*L)**2)
+                    energy -= c6/math.pow(r, 6.0)
+                    force += 6.0*c6/math.pow(r, 7.0)*dx/r
+
+                    # interaction of both particles with their own images
+                    if nx != 0 or ny != 0 or nz != 0:
+                        r0 = L*math.sqrt(nx*nx + ny*ny + nz*nz)
+                        energy -= c6/math.pow(r0, 6.0)
+
+        self.assertAlmostEqual(log.query('pppm_lj_energy') + log.query('pair_lj_pme_energy'), energy, 3)
+        self.assertAlmostEqual(d.forces[0].force[0] + d.lj.forces[0].force[0], force, 3)
+        self.assertAlmostEqual(d.forces[1].force[0] + d.lj.forces[1].force[0], -force, 3)
+        self.assertAlmostEqual(d.forces[0].force[1] + d.lj.forces[0].force[1], 0, 3)
+
+        del all
+        del d
+        del log
+
+    def tearDown(self):
+        del self.s
+        context.initialize()
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
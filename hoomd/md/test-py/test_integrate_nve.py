@@ -6,13 +6,14 @@ from hoomd import md;
 context.initialize()
 import unittest
 import os
+import numpy
 
 # unit tests for md.integrate.nve
 class integrate_nve_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
-        md.force.constant(fx=0.1, fy=0.1, fz=0.1)
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.f = md.force.constant(fx=0.1, fy=0.1, fz=0.1)
 
         context.current.sorter.set_params(grid=8)
 
@@ -65,6 +66,27 @@ class integrate_nve_tests (unittest.TestCase):
         # second call does nothing
         nve.enable()
 
+    # test multiple time step integration of a force
+    def test_force_period(self):
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+
+        with self.assertRaises(ValueError):
+            mode.set_force_period(self.f, period=0);
+
+        if context.exec_conf.isCUDAEnabled():
+            with self.assertRaises(RuntimeError):
+                mode.set_force_period(self.f, period=4);
+            return;
+
+        mode.set_force_period(self.f, period=4);
+        run(8);
+
+        # after every outer step, the impulses of a constant force add up to the same velocity as a force on every step
+        snap = self.s.take_snapshot();
+        if comm.get_rank() == 0:
+            numpy.testing.assert_allclose(snap.particles.velocity, 8*0.005*0.1, rtol=1e-4);
+
     def tearDown(self):
         context.initialize();
 
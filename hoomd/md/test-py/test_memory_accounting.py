@@ -0,0 +1,86 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+import hoomd;
+import hoomd.md;
+from hoomd import *
+hoomd.context.initialize()
+import unittest
+
+# unit tests for the memory accounting
+class memory_accounting_tests (unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]);
+        self.nl = md.nlist.cell()
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+    # the log quantities report the memory of the arrays
+    def test_log_quantities(self):
+        logger = analyze.log(filename=None, quantities=['memory_allocated', 'memory_peak'], period=1)
+        run(1)
+
+        allocated = logger.query('memory_allocated')
+        peak = logger.query('memory_peak')
+        self.assertGreater(allocated, 0)
+        self.assertGreaterEqual(peak, allocated)
+
+        # memory_allocated is the maximum over all ranks
+        usage = context.memory_usage()
+        self.assertGreaterEqual(allocated, sum(usage.values())/1024.0/1024.0 * (1 - 1e-6))
+
+        # the peak does not decrease
+        lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
+        lj.pair_coeff.set('A', 'A', sigma=1.0, epsilon=1.0)
+        run(1)
+        self.assertGreaterEqual(logger.query('memory_peak'), peak)
+        self.assertGreaterEqual(logger.query('memory_peak'), logger.query('memory_allocated'))
+
+    # memory_usage() lists the arrays by their tags
+    def test_memory_usage(self):
+        usage = context.memory_usage()
+        self.assertIn('ParticleData::m_pos', usage)
+        self.assertGreaterEqual(usage['ParticleData::m_pos'], self.system.particles.pdata.getN()*4*4)
+        for nbytes in usage.values():
+            self.assertGreater(nbytes, 0)
+
+    # the arrays of two instances of the same potential are accounted separately
+    def test_instance_tags(self):
+        lj1 = md.pair.lj(r_cut=3.0, nlist = self.nl, name='first');
+        lj1.pair_coeff.set('A', 'A', sigma=1.0, epsilon=1.0)
+        lj2 = md.pair.lj(r_cut=2.5, nlist = self.nl, name='second');
+        lj2.pair_coeff.set('A', 'A', sigma=1.0, epsilon=0.5)
+        run(1)
+
+        usage = context.memory_usage()
+        for name in ['pair_lj_energy_first', 'pair_lj_energy_second']:
+            self.assertIn('ForceCompute::m_force [' + name + ']', usage)
+            self.assertTrue(any(tag.endswith('::m_params [' + name + ']') for tag in usage))
+
+        self.assertEqual(usage['ForceCompute::m_force [pair_lj_energy_first]'],
+                         usage['ForceCompute::m_force [pair_lj_energy_second]'])
+
+    # the budget is set in MiB and only warns when it is exceeded
+    def test_memory_budget(self):
+        accounting = context.exec_conf.getMemoryAccounting()
+
+        context.set_memory_budget(1024)
+        self.assertEqual(accounting.getBudget(), 1024*1024*1024)
+
+        context.set_memory_budget(0.001)
+        self.assertEqual(accounting.getBudget(), int(0.001*1024*1024))
+        lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
+        lj.pair_coeff.set('A', 'A', sigma=1.0, epsilon=1.0)
+        run(10)
+
+        context.set_memory_budget(None)
+        self.assertEqual(accounting.getBudget(), 0)
+
+    def tearDown(self):
+        context.set_memory_budget(None)
+        del self.system
+        del self.nl
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -6,12 +6,13 @@ from hoomd import md;
 context.initialize()
 import unittest
 import os
+import numpy
 
 # md.nlist.cell testing
 class nlist_cell_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[10,10,10]); #target a packing fraction of 0.05
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[10,10,10]); #target a packing fraction of 0.05
 
         # directly create a neighbor list
         self.nl = md.nlist.cell()
@@ -46,6 +47,92 @@ class nlist_cell_tests (unittest.TestCase):
     def test_tune(self):
         self.nl.tune(warmup=100, r_min=0.1, r_max=0.25, jumps=10, steps=50)
 
+    # test online tuning
+    def test_autotune(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        self.nl.autotune(period=10, r_min=0.1, r_max=0.8)
+        run(200)
+        r_buff = self.nl.cpp_nlist.getRBuff()
+        self.assertGreaterEqual(r_buff, 0.1)
+        self.assertLessEqual(r_buff, 0.8)
+
+        self.nl.autotune(enable=False)
+        run(10)
+        self.assertEqual(self.nl.cpp_nlist.getRBuff(), r_buff)
+
+    # online tuning grows a buffer radius that is clearly too small for hot particles
+    def test_autotune_grow(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        nve = md.integrate.nve(group=group.all())
+        nve.randomize_velocities(kT=5.0, seed=12)
+
+        self.nl.set_params(r_buff=0.05)
+        self.nl.autotune(period=10, r_min=0.05, r_max=1.0)
+        run(1000)
+        self.assertGreater(self.nl.cpp_nlist.getRBuff(), 0.05)
+
+    # online tuning shrinks a buffer radius that is clearly too large for particles at rest
+    def test_autotune_shrink(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        self.nl.set_params(r_buff=2.5)
+        self.nl.autotune(period=10, r_min=0.1, r_max=2.5)
+        run(1000)
+        self.assertLess(self.nl.cpp_nlist.getRBuff(), 2.5)
+
+    # test online tuning error messages
+    def test_autotune_nowork(self):
+        self.assertRaises(RuntimeError, self.nl.autotune, r_min=0.5, r_max=0.2)
+        self.assertRaises(RuntimeError, self.nl.autotune, period=0)
+
+    # test the incremental sort over the cells of the neighbor list
+    @unittest.skipIf(context.exec_conf.isCUDAEnabled(), "incremental sorting is not supported on the GPU")
+    def test_sort_incremental(self):
+        # give every tag distinct data that the integration does not change
+        snap = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            N = snap.particles.N
+            snap.particles.mass[:] = 1.0 + 0.001*numpy.arange(N)
+            snap.particles.charge[:] = numpy.arange(N)
+            snap.particles.diameter[:] = 1.0 + 0.0001*numpy.arange(N)
+        self.s.restore_snapshot(snap)
+
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        nve = md.integrate.nve(group=group.all())
+
+        # hot particles cross the cells, and with MPI the domain boundaries, so the sorts follow migrations
+        nve.randomize_velocities(kT=5.0, seed=12)
+        context.current.sorter.set_params(incremental=True, nlist=self.nl)
+        context.current.sorter.set_period(10)
+        run(100)
+
+        snap2 = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            numpy.testing.assert_array_equal(snap.particles.mass, snap2.particles.mass)
+            numpy.testing.assert_array_equal(snap.particles.charge, snap2.particles.charge)
+            numpy.testing.assert_array_equal(snap.particles.diameter, snap2.particles.diameter)
+
+        # the forces on the sorted particles match a fresh neighbor list
+        nl2 = md.nlist.cell()
+        lj2 = md.pair.lj(r_cut = 2.5, nlist = nl2)
+        lj2.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        run(1)
+        self.assertAlmostEqual(lj.get_energy(group.all()) / lj2.get_energy(group.all()), 1.0, 5)
+
+        context.current.sorter.set_params(incremental=False)
+        run(10)
+
     # test multiple neighbor lists can coexist with different parameters
     def test_multi(self):
         self.nl.set_params(r_buff = 0.3)
@@ -70,8 +157,27 @@ class nlist_cell_tests (unittest.TestCase):
         self.assertAlmostEqual(self.nl.r_cut.get_pair('A','A'), 5.0)
         self.assertAlmostEqual(nl2.r_cut.get_pair('A','A'), 4.0)
 
+    # test that the compact cell list finds the same neighbors
+    def test_compact(self):
+        lj = md.pair.lj(r_cut = 3.0, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+
+        if context.exec_conf.isCUDAEnabled():
+            self.assertRaises(RuntimeError, md.nlist.cell, compact=True)
+            return
+
+        nl2 = md.nlist.cell(compact=True)
+        lj2 = md.pair.lj(r_cut = 3.0, nlist = nl2)
+        lj2.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(10)
+
+        self.assertAlmostEqual(lj.get_energy(group.all()), lj2.get_energy(group.all()), 5)
+
     def tearDown(self):
-        del self.nl
+        del self.nl, self.s
         context.initialize();
 
 if __name__ == '__main__':
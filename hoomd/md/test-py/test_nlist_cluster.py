@@ -0,0 +1,53 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+
+# md.nlist.cluster testing
+@unittest.skipIf(context.exec_conf.isCUDAEnabled(), "nlist.cluster is not supported on the GPU")
+class nlist_cluster_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[10,10,10]); #target a packing fraction of 0.05
+
+        # directly create a neighbor list
+        self.nl = md.nlist.cluster()
+
+        context.current.sorter.set_params(grid=8)
+
+    # test set_params
+    def test_set_params(self):
+        self.nl.set_params(r_buff=0.6);
+        self.nl.set_params(check_period = 20);
+        self.nl.set_params(d_max = 2.0, dist_check = False)
+
+    # test reset_exclusions
+    def test_reset_exclusions_works(self):
+        self.nl.reset_exclusions();
+        self.nl.reset_exclusions(exclusions = ['1-2']);
+        self.nl.reset_exclusions(exclusions = ['bond', 'angle']);
+
+    # test that the cluster pairs give the same energy as the cell list
+    def test_energy(self):
+        lj = md.pair.lj(r_cut = 3.0, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(10)
+
+        nl2 = md.nlist.cell()
+        lj2 = md.pair.lj(r_cut = 3.0, nlist = nl2)
+        lj2.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        run(1)
+
+        self.assertAlmostEqual(lj.get_energy(group.all()), lj2.get_energy(group.all()), 5)
+
+    def tearDown(self):
+        del self.nl
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
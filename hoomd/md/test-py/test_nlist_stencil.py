@@ -51,6 +51,25 @@ class nlist_stencil_tests (unittest.TestCase):
         self.nl.tune_cell_width(warmup=100, jumps=10, steps=50)
         self.nl.tune_cell_width(warmup=10, min_width=0.1, max_width=0.25, jumps=5, steps=5)
 
+    # test online tuning, the stencils follow the buffer radius it applies
+    def test_autotune(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        nve = md.integrate.nve(group=group.all())
+        nve.randomize_velocities(kT=5.0, seed=12)
+
+        self.nl.set_params(r_buff=0.05)
+        self.nl.autotune(period=10, r_min=0.05, r_max=1.0)
+        run(500)
+
+        # the forces match a fresh neighbor list
+        nl2 = md.nlist.cell()
+        lj2 = md.pair.lj(r_cut = 2.5, nlist = nl2)
+        lj2.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        run(1)
+        self.assertAlmostEqual(lj.get_energy(group.all()), lj2.get_energy(group.all()), 5)
+
     # test multiple neighbor lists can coexist with different parameters
     def test_multi(self):
         self.nl.set_params(r_buff = 0.3)
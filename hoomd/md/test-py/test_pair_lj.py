@@ -40,6 +40,52 @@ class pair_lj_tests (unittest.TestCase):
         lj.set_params(mode="xplor");
         self.assertRaises(RuntimeError, lj.set_params, mode="blah");
 
+    # test mixed precision
+    def test_mixed_precision(self):
+        lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
+        lj.pair_coeff.set('A', 'A', sigma=1.0, epsilon=1.0)
+        if context.exec_conf.isCUDAEnabled():
+            self.assertRaises(RuntimeError, lj.set_mixed_precision);
+            return;
+
+        # displace some particles off the lattice so the forces do not vanish
+        for i in range(0, 10):
+            p = self.s.particles[i]
+            x, y, z = p.position
+            p.position = (x + 0.1*(i % 3), y - 0.05*(i % 4), z + 0.02*i)
+
+        # evaluate both modes on the same configuration
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(0)
+        energy = lj.get_energy(group.all())
+        forces = [lj.forces[i].force for i in range(0, 10)]
+
+        lj.set_mixed_precision()
+        run(0)
+        self.assertAlmostEqual(lj.get_energy(group.all()) / energy, 1.0, 4)
+        for i in range(0, 10):
+            f = lj.forces[i].force
+            for j in range(0, 3):
+                self.assertAlmostEqual(f[j], forces[i][j], 3)
+        lj.set_mixed_precision(False)
+
+    # test that potentials sharing a neighbor list see the same neighbors as with their own list
+    def test_shared_nlist(self):
+        lj_short = md.pair.lj(r_cut=2.5, nlist = self.nl);
+        lj_short.pair_coeff.set('A', 'A', sigma=1.0, epsilon=1.0)
+        lj_long = md.pair.lj(r_cut=4.0, nlist = self.nl);
+        lj_long.pair_coeff.set('A', 'A', sigma=1.0, epsilon=0.5)
+
+        nl2 = md.nlist.cell()
+        lj_own = md.pair.lj(r_cut=2.5, nlist = nl2);
+        lj_own.pair_coeff.set('A', 'A', sigma=1.0, epsilon=1.0)
+
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(10)
+        self.assertAlmostEqual(lj_short.get_energy(group.all()), lj_own.get_energy(group.all()), 5)
+
     # test default coefficients
     def test_default_coeff(self):
         lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
@@ -0,0 +1,150 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+import tempfile
+import math
+import numpy
+
+try:
+    import gsd.fl
+    enable_gsd = True
+except ImportError:
+    enable_gsd = False
+
+def lj(r, rmin, rmax, epsilon, sigma):
+    V = 4 * epsilon * ( (sigma / r)**12 - (sigma / r)**6);
+    F = 4 * epsilon / r * ( 12 * (sigma / r)**12 - 6 * (sigma / r)**6);
+    return (V, F)
+
+# md.pair.table_spline
+@unittest.skipIf(context.exec_conf.isCUDAEnabled(), "pair.table_spline is not supported on the GPU")
+class pair_table_spline_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.nl = md.nlist.cell()
+        context.current.sorter.set_params(grid=8)
+
+    # basic test of creation
+    def test(self):
+        table = md.pair.table_spline(width=100, nlist = self.nl);
+        table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        table.update_coeffs();
+
+    # test missing coefficients
+    def test_set_missing_epsilon(self):
+        table = md.pair.table_spline(width=100, nlist = self.nl);
+        table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0);
+        self.assertRaises(RuntimeError, table.update_coeffs);
+
+    # test missing coefficients
+    def test_missing_AA(self):
+        table = md.pair.table_spline(width=100, nlist = self.nl);
+        self.assertRaises(RuntimeError, table.update_coeffs);
+
+    # test invalid width
+    def test_invalid_width(self):
+        self.assertRaises(ValueError, md.pair.table_spline, width=1, nlist = self.nl);
+
+    # test nlist subscribe
+    def test_nlist_subscribe(self):
+        table = md.pair.table_spline(width=100, nlist = self.nl);
+
+        table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        table.update_coeffs();
+        self.nl.update_rcut();
+        self.assertAlmostEqual(1.0, self.nl.r_cut.get_pair('A','A'));
+
+        table.pair_coeff.set('A', 'A', rmax = 2.5)
+        self.nl.update_rcut();
+        self.assertAlmostEqual(2.5, self.nl.r_cut.get_pair('A','A'));
+
+    # test adding types
+    def test_type_add(self):
+        table = md.pair.table_spline(width=100, nlist = self.nl);
+        table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        self.s.particles.types.add('B')
+        self.assertRaises(RuntimeError, table.update_coeffs);
+        table.pair_coeff.set('A', 'B', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        table.pair_coeff.set('B', 'B', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        table.update_coeffs();
+
+    def tearDown(self):
+        del self.s, self.nl
+        context.initialize();
+
+# md.pair.table_spline compared to the analytic Lennard-Jones potential
+@unittest.skipIf(context.exec_conf.isCUDAEnabled(), "pair.table_spline is not supported on the GPU")
+class pair_table_spline_twoparticle_tests (unittest.TestCase):
+    def setUp(self):
+        snap = data.make_snapshot(N=2, particle_types=[u'A'], box = data.boxdim(L=10))
+
+        if comm.get_rank() == 0:
+            snap.particles.position[0] = (0,0,0)
+            snap.particles.position[1] = (1.13,0,0)
+
+        self.s = init.read_snapshot(snap);
+        self.nl = md.nlist.cell()
+
+    def check_lj(self, table, r):
+        self.s.particles[1].position = (r,0,0)
+        log = analyze.log(quantities = ['pair_table_spline_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(group.all());
+        run(1);
+
+        (V, F) = lj(r, 0.8, 3.0, epsilon=1.5, sigma=1.0)
+        self.assertAlmostEqual(log.query('pair_table_spline_energy'), V, 4)
+        self.assertAlmostEqual(table.forces[0].force[0], -F, 3)
+        self.assertAlmostEqual(table.forces[1].force[0], F, 3)
+        self.assertAlmostEqual(table.forces[0].force[1], 0, 5)
+
+        # no interaction beyond rmax
+        self.s.particles[1].position = (3.1,0,0)
+        run(1);
+        self.assertAlmostEqual(log.query('pair_table_spline_energy'), 0, 5)
+        self.assertAlmostEqual(table.forces[0].force[0], 0, 5)
+
+    # tables evaluated in python
+    def test_lj(self):
+        table = md.pair.table_spline(width=400, nlist = self.nl);
+        table.pair_coeff.set('A', 'A', func=lj, rmin=0.8, rmax=3.0, coeff=dict(epsilon=1.5, sigma=1.0));
+        self.check_lj(table, 1.13)
+
+    # tables read from a GSD file
+    @unittest.skipIf(not enable_gsd, "no gsd module available.")
+    def test_lj_gsd(self):
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.gsd');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+        if comm.get_rank() == 0:
+            n = 400
+            s = numpy.linspace(0.8**2, 3.0**2, n)
+            V, F = lj(numpy.sqrt(s), 0.8, 3.0, epsilon=1.5, sigma=1.0)
+            with gsd.fl.open(name=self.tmp_file, mode='wb', application='test', schema='table', schema_version=[1,0]) as f:
+                f.write_chunk(name='table/A,A/r', data=numpy.array([0.8, 3.0], dtype=numpy.float64))
+                f.write_chunk(name='table/A,A/V', data=V.astype(numpy.float64))
+                f.write_chunk(name='table/A,A/F', data=F.astype(numpy.float32))
+                f.end_frame()
+
+        table = md.pair.table_spline(width=10, nlist = self.nl);
+        table.set_from_gsd(self.tmp_file);
+        self.assertAlmostEqual(table.pair_coeff.get('A', 'A', 'rmax'), 3.0, 5)
+        self.check_lj(table, 1.13)
+
+        if comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+
+    def tearDown(self):
+        del self.s, self.nl
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
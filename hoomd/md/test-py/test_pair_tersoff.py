@@ -0,0 +1,125 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import md;
+context.initialize()
+import unittest
+import math
+import numpy
+
+# Tersoff Si(B) parameters, with lambda3 from Si(C) so the h function is exercised
+si_params = dict(r_cut=3.0, cutoff_thickness=0.3, dimer_r=2.35, lambda1=2.4799, lambda2=1.7322,
+                 n=0.78734, gamma=1.1e-6, lambda3=1.3258, c=1.0039e5, d=16.217, m=-0.59825, alpha=3.0)
+si_params['C1'] = 1830.8*math.exp(-si_params['lambda1']*si_params['dimer_r'])
+si_params['C2'] = 471.18*math.exp(-si_params['lambda2']*si_params['dimer_r'])
+
+# distorted Si5 tetrahedron with a sixth atom in the cutoff shell of the second one
+s = 2.35/math.sqrt(3.0)
+si_cluster = numpy.array([[0, 0, 0], [s, s, s], [-s, -s, s], [-s, s, -s], [s, -s, -s], [s, s, s]], dtype=float)
+si_cluster[5] += numpy.array([1, 1, -1])/math.sqrt(3.0)*2.8
+si_cluster += numpy.array([[0.05, -0.03, 0.02], [0.1, 0, -0.05], [0, 0.08, 0], [-0.04, 0, 0.1],
+                           [0.02, -0.06, 0.03], [0.05, -0.02, 0.01]])
+
+# reference implementation of the Tersoff energy as parameterized in hoomd
+def tersoff_energy(pos, p):
+    def cutoff(r):
+        r_inner = p['r_cut'] - p['cutoff_thickness']
+        if r <= r_inner:
+            return 1.0
+        x3 = ((r - r_inner)/p['cutoff_thickness'])**3
+        return math.exp(p['alpha']*x3/(x3 - 1.0))
+
+    c2 = p['c']**2
+    d2 = p['d']**2
+    energy = 0.0
+    for i in range(len(pos)):
+        for j in range(len(pos)):
+            rij = numpy.linalg.norm(pos[i] - pos[j])
+            if i == j or rij >= p['r_cut']:
+                continue
+
+            chi = 0.0
+            for k in range(len(pos)):
+                rik = numpy.linalg.norm(pos[i] - pos[k])
+                if k == i or k == j or rik >= p['r_cut']:
+                    continue
+                cos_th = numpy.dot(pos[i] - pos[j], pos[i] - pos[k])/(rij*rik)
+                g = 1.0 + c2/d2 - c2/(d2 + (p['m'] - cos_th)**2)
+                h = math.exp(p['lambda3']**3*(rij - rik)**3)
+                chi += cutoff(rik)*g*h
+
+            bij = (1.0 + p['gamma']**p['n']*chi**p['n'])**(-0.5/p['n'])
+            fR = p['C1']*math.exp(p['lambda1']*(p['dimer_r'] - rij))
+            fA = p['C2']*math.exp(p['lambda2']*(p['dimer_r'] - rij))
+            energy += 0.5*cutoff(rij)*(fR - bij*fA)
+    return energy
+
+# reference forces from central differences of the reference energy
+def tersoff_forces(pos, p, h=1e-6):
+    forces = numpy.zeros(pos.shape)
+    for a in range(len(pos)):
+        for d in range(3):
+            pos_p = numpy.array(pos)
+            pos_p[a,d] += h
+            pos_m = numpy.array(pos)
+            pos_m[a,d] -= h
+            forces[a,d] = -(tersoff_energy(pos_p, p) - tersoff_energy(pos_m, p))/(2*h)
+    return forces
+
+# md.pair.tersoff
+class pair_tersoff_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        context.initialize()
+
+        # on two ranks, the domain boundary at x=0 cuts through the first cluster
+        comm.decomposition(nx=2, ny=1, nz=1)
+
+        # the second copy of the cluster straddles the periodic boundary in x
+        self.L = 20.0
+        self.n = len(si_cluster)
+        snap = data.make_snapshot(N=2*self.n, box=data.boxdim(L=self.L), particle_types=['A'])
+        if comm.get_rank() == 0:
+            snap.particles.position[:self.n] = si_cluster
+            pos = si_cluster + numpy.array([0.5*self.L - 0.2, 0, 0])
+            pos[:,0] -= self.L*(pos[:,0] >= 0.5*self.L)
+            snap.particles.position[self.n:] = pos
+        self.s = init.read_snapshot(snap)
+        self.nl = md.nlist.cell()
+
+    # basic test of creation
+    def test(self):
+        tersoff = md.pair.tersoff(r_cut=3.0, nlist = self.nl);
+        tersoff.pair_coeff.set('A', 'A', C1=1.0, C2=1.0)
+        tersoff.update_coeffs();
+
+    # energy and forces of a small Si cluster, also across domain and periodic boundaries
+    def test_si_cluster(self):
+        p = si_params
+        tersoff = md.pair.tersoff(r_cut=p['r_cut'], nlist = self.nl);
+        tersoff.pair_coeff.set('A', 'A', cutoff_thickness=p['cutoff_thickness'], C1=p['C1'], C2=p['C2'],
+                               lambda1=p['lambda1'], lambda2=p['lambda2'], dimer_r=p['dimer_r'], n=p['n'],
+                               gamma=p['gamma'], lambda3=p['lambda3'], c=p['c'], d=p['d'], m=p['m'],
+                               alpha=p['alpha'])
+
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(0)
+
+        energy = tersoff_energy(si_cluster, p)
+        forces = tersoff_forces(si_cluster, p)
+        self.assertLess(energy, 0)
+        self.assertAlmostEqual(tersoff.get_energy(group.all())/(2*energy), 1.0, 4)
+
+        for tag in range(0, 2*self.n):
+            f = tersoff.forces[tag].force
+            for j in range(0, 3):
+                self.assertAlmostEqual(f[j], forces[tag % self.n][j], 3)
+
+    def tearDown(self):
+        del self.s, self.nl
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
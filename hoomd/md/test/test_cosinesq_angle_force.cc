@@ -9,7 +9,7 @@
 
 #include <functional>
 
-#include "hoomd/md/CosineSqAngleForceCompute.h"
+#include "hoomd/md/AllAnglePotentials.h"
 #include "hoomd/ConstForceCompute.h"
 #ifdef ENABLE_CUDA
 #include "hoomd/md/CosineSqAngleForceComputeGPU.h"
@@ -27,7 +27,7 @@ using namespace std::placeholders;
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
-typedef std::function<std::shared_ptr<CosineSqAngleForceCompute>  (std::shared_ptr<SystemDefinition> sysdef)> angleforce_creator;
+typedef std::function<std::shared_ptr<PotentialAngleCosineSq>  (std::shared_ptr<SystemDefinition> sysdef)> angleforce_creator;
 
 //! Perform some simple functionality tests of any BondForceCompute
 void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -42,8 +42,8 @@ void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<Exec
     pdata_3->setPosition(2, make_scalar3(2.0, 0.0, 0.0));
 
     // create the angle force compute to check
-    std::shared_ptr<CosineSqAngleForceCompute> fc_3 = af_creator(sysdef_3);
-    fc_3->setParams(0, Scalar(1.0), Scalar(3.14159265359)); // type=0, K=1.0,theta_0=pi
+    std::shared_ptr<PotentialAngleCosineSq> fc_3 = af_creator(sysdef_3);
+    fc_3->setParams(0, make_scalar2(Scalar(1.0), Scalar(3.14159265359))); // type=0, K=1.0,theta_0=pi
 
     // compute the force and check the results
     fc_3->compute(0);
@@ -109,7 +109,7 @@ void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<Exec
     }
 
     // make sure the angle force is 0 if the angle is at equilibrium != pi
-    fc_3->setParams(0, Scalar(1.0), Scalar(1.57079632679)); // type=0, K=1.0,theta_0=pi/2
+    fc_3->setParams(0, make_scalar2(Scalar(1.0), Scalar(1.57079632679))); // type=0, K=1.0,theta_0=pi/2
     pdata_3->setPosition(0, make_scalar3(0.0, 0.0, 0.0));
     pdata_3->setPosition(1, make_scalar3(1.0, 0.0, 0.0));
     pdata_3->setPosition(2, make_scalar3(1.0, 1.0, 0.0));
@@ -135,7 +135,7 @@ void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<Exec
     pdata_3->setPosition(0, make_scalar3(0.0, 0.0, 0.0));
     pdata_3->setPosition(1, make_scalar3(1.0, 0.0, 0.0));
     pdata_3->setPosition(2, make_scalar3(2.0, 0.0, 0.0));
-    fc_3->setParams(0, Scalar(1.0), Scalar(3.14159265359)); // type=0, K=1.0,theta_0=pi
+    fc_3->setParams(0, make_scalar2(Scalar(1.0), Scalar(3.14159265359))); // type=0, K=1.0,theta_0=pi
 
     ArrayHandle<Scalar4> h_pos(
             pdata_3->getPositions(), access_location::host, access_mode::readwrite);
@@ -192,10 +192,10 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     snap->angle_data.type_mapping.push_back("A");
     std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
 
-    std::shared_ptr<CosineSqAngleForceCompute> fc1 = af_creator1(sysdef);
-    std::shared_ptr<CosineSqAngleForceCompute> fc2 = af_creator2(sysdef);
-    fc1->setParams(0, Scalar(1.0), Scalar(1.348));
-    fc2->setParams(0, Scalar(1.0), Scalar(1.348));
+    std::shared_ptr<PotentialAngleCosineSq> fc1 = af_creator1(sysdef);
+    std::shared_ptr<PotentialAngleCosineSq> fc2 = af_creator2(sysdef);
+    fc1->setParams(0, make_scalar2(Scalar(1.0), Scalar(1.348)));
+    fc2->setParams(0, make_scalar2(Scalar(1.0), Scalar(1.348)));
 
     // add angles
     for (unsigned int i = 0; i < N-2; i++)
@@ -252,17 +252,17 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     }
     }
 
-//! CosineSqAngleForceCompute creator for angle_force_basic_tests()
-std::shared_ptr<CosineSqAngleForceCompute> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
+//! PotentialAngleCosineSq creator for angle_force_basic_tests()
+std::shared_ptr<PotentialAngleCosineSq> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<CosineSqAngleForceCompute>(new CosineSqAngleForceCompute(sysdef));
+    return std::shared_ptr<PotentialAngleCosineSq>(new PotentialAngleCosineSq(sysdef));
     }
 
 #ifdef ENABLE_CUDA
 //! AngleForceCompute creator for bond_force_basic_tests()
-std::shared_ptr<CosineSqAngleForceCompute> gpu_af_creator(std::shared_ptr<SystemDefinition> sysdef)
+std::shared_ptr<PotentialAngleCosineSq> gpu_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<CosineSqAngleForceCompute>(new CosineSqAngleForceComputeGPU(sysdef));
+    return std::shared_ptr<PotentialAngleCosineSq>(new CosineSqAngleForceComputeGPU(sysdef));
     }
 #endif
 
@@ -9,7 +9,7 @@
 
 #include <functional>
 
-#include "hoomd/md/HarmonicAngleForceCompute.h"
+#include "hoomd/md/AllAnglePotentials.h"
 #include "hoomd/ConstForceCompute.h"
 #ifdef ENABLE_CUDA
 #include "hoomd/md/HarmonicAngleForceComputeGPU.h"
@@ -27,7 +27,7 @@ using namespace std::placeholders;
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
-typedef std::function<std::shared_ptr<HarmonicAngleForceCompute>  (std::shared_ptr<SystemDefinition> sysdef)> angleforce_creator;
+typedef std::function<std::shared_ptr<PotentialAngleHarmonic>  (std::shared_ptr<SystemDefinition> sysdef)> angleforce_creator;
 
 //! Perform some simple functionality tests of any BondForceCompute
 void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -47,8 +47,8 @@ void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<Exec
     //printf("\n");
 
     // create the angle force compute to check
-    std::shared_ptr<HarmonicAngleForceCompute> fc_3 = af_creator(sysdef_3);
-    fc_3->setParams(0, Scalar(1.0), Scalar(0.785398)); // type=0, K=1.0,theta_0=pi/4=0.785398
+    std::shared_ptr<PotentialAngleHarmonic> fc_3 = af_creator(sysdef_3);
+    fc_3->setParams(0, make_scalar2(Scalar(1.0), Scalar(0.785398))); // type=0, K=1.0,theta_0=pi/4=0.785398
 
     // compute the force and check the results
     fc_3->compute(0);
@@ -156,10 +156,10 @@ void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<Exec
     pdata_6->setPosition(4, make_scalar3(0.0,0.0,-29.6));
     pdata_6->setPosition(5, make_scalar3(0.0,0.0,29.6));
 
-    std::shared_ptr<HarmonicAngleForceCompute> fc_6 = af_creator(sysdef_6);
-    fc_6->setParams(0, Scalar(1.0), Scalar(0.785398));
-    fc_6->setParams(1, Scalar(2.0), Scalar(1.46));
-    //fc_6->setParams(2, 1.5, 1.68);
+    std::shared_ptr<PotentialAngleHarmonic> fc_6 = af_creator(sysdef_6);
+    fc_6->setParams(0, make_scalar2(Scalar(1.0), Scalar(0.785398)));
+    fc_6->setParams(1, make_scalar2(Scalar(2.0), Scalar(1.46)));
+    //fc_6->setParams(2, make_scalar2(1.5, 1.68));
 
     sysdef_6->getAngleData()->addBondedGroup(Angle(0, 0,1,2));
     sysdef_6->getAngleData()->addBondedGroup(Angle(1, 3,4,5));
@@ -257,8 +257,8 @@ void angle_force_basic_tests(angleforce_creator af_creator, std::shared_ptr<Exec
     }
 
     // build the bond force compute and try it out
-    std::shared_ptr<HarmonicAngleForceCompute> fc_4 = af_creator(sysdef_4);
-    fc_4->setParams(0, 1.5, 1.75);
+    std::shared_ptr<PotentialAngleHarmonic> fc_4 = af_creator(sysdef_4);
+    fc_4->setParams(0, make_scalar2(1.5, 1.75));
     // only add bonds on the left, top, and bottom of the square
     sysdef_4->getAngleData()->addBondedGroup(Angle(0, 0,1,2));
     sysdef_4->getAngleData()->addBondedGroup(Angle(0, 1,2,3));
@@ -328,10 +328,10 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     snap->angle_data.type_mapping.push_back("A");
     std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
 
-    std::shared_ptr<HarmonicAngleForceCompute> fc1 = af_creator1(sysdef);
-    std::shared_ptr<HarmonicAngleForceCompute> fc2 = af_creator2(sysdef);
-    fc1->setParams(0, Scalar(1.0), Scalar(1.348));
-    fc2->setParams(0, Scalar(1.0), Scalar(1.348));
+    std::shared_ptr<PotentialAngleHarmonic> fc1 = af_creator1(sysdef);
+    std::shared_ptr<PotentialAngleHarmonic> fc2 = af_creator2(sysdef);
+    fc1->setParams(0, make_scalar2(Scalar(1.0), Scalar(1.348)));
+    fc2->setParams(0, make_scalar2(Scalar(1.0), Scalar(1.348)));
 
     // add angles
     for (unsigned int i = 0; i < N-2; i++)
@@ -388,17 +388,17 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     }
     }
 
-//! HarmonicAngleForceCompute creator for angle_force_basic_tests()
-std::shared_ptr<HarmonicAngleForceCompute> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
+//! PotentialAngleHarmonic creator for angle_force_basic_tests()
+std::shared_ptr<PotentialAngleHarmonic> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<HarmonicAngleForceCompute>(new HarmonicAngleForceCompute(sysdef));
+    return std::shared_ptr<PotentialAngleHarmonic>(new PotentialAngleHarmonic(sysdef));
     }
 
 #ifdef ENABLE_CUDA
 //! AngleForceCompute creator for bond_force_basic_tests()
-std::shared_ptr<HarmonicAngleForceCompute> gpu_af_creator(std::shared_ptr<SystemDefinition> sysdef)
+std::shared_ptr<PotentialAngleHarmonic> gpu_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<HarmonicAngleForceCompute>(new HarmonicAngleForceComputeGPU(sysdef));
+    return std::shared_ptr<PotentialAngleHarmonic>(new HarmonicAngleForceComputeGPU(sysdef));
     }
 #endif
 
@@ -9,7 +9,7 @@
 
 #include <functional>
 
-#include "hoomd/md/HarmonicDihedralForceCompute.h"
+#include "hoomd/md/AllDihedralPotentials.h"
 #include "hoomd/ConstForceCompute.h"
 #ifdef ENABLE_CUDA
 #include "hoomd/md/HarmonicDihedralForceComputeGPU.h"
@@ -27,7 +27,7 @@ using namespace std::placeholders;
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
-typedef std::function<std::shared_ptr<HarmonicDihedralForceCompute>  (std::shared_ptr<SystemDefinition> sysdef)> dihedralforce_creator;
+typedef std::function<std::shared_ptr<PotentialDihedralHarmonic>  (std::shared_ptr<SystemDefinition> sysdef)> dihedralforce_creator;
 
 //! Perform some simple functionality tests of any BondForceCompute
 void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -51,8 +51,8 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
     */
 
     // create the dihedral force compute to check
-    std::shared_ptr<HarmonicDihedralForceCompute> fc_4 = tf_creator(sysdef_4);
-    fc_4->setParams(0, Scalar(30.0), -1, 3, Scalar(0)); // type=0, K=30.0,sign=-1,multiplicity=3, phaseoffset=0
+    std::shared_ptr<PotentialDihedralHarmonic> fc_4 = tf_creator(sysdef_4);
+    fc_4->setParams(0, make_scalar4(Scalar(30.0), -1, 3, Scalar(0))); // type=0, K=30.0,sign=-1,multiplicity=3, phaseoffset=0
 
     // compute the force and check the results
     fc_4->compute(0);
@@ -198,9 +198,9 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
     h_pos.data[7].x = 3; h_pos.data[7].y = 0; h_pos.data[7].z =  Scalar(31.0);
     }
 
-    std::shared_ptr<HarmonicDihedralForceCompute> fc_8 = tf_creator(sysdef_8);
-    fc_8->setParams(0, 50.0, -1, 3, 0.0);
-    fc_8->setParams(1, 30.0,  1, 4, 0.0);
+    std::shared_ptr<PotentialDihedralHarmonic> fc_8 = tf_creator(sysdef_8);
+    fc_8->setParams(0, make_scalar4(50.0, -1, 3, 0.0));
+    fc_8->setParams(1, make_scalar4(30.0,  1, 4, 0.0));
 
     sysdef_8->getDihedralData()->addBondedGroup(Dihedral(0, 0,1,2,3));
     sysdef_8->getDihedralData()->addBondedGroup(Dihedral(1, 4,5,6,7));
@@ -308,8 +308,8 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
     }
 
     // build the dihedral force compute and try it out
-    std::shared_ptr<HarmonicDihedralForceCompute> fc_5 = tf_creator(sysdef_5);
-    fc_5->setParams(0, 15.0, -1, 4, 0.0);
+    std::shared_ptr<PotentialDihedralHarmonic> fc_5 = tf_creator(sysdef_5);
+    fc_5->setParams(0, make_scalar4(15.0, -1, 4, 0.0));
 
     sysdef_5->getDihedralData()->addBondedGroup(Dihedral(0, 0,1,2,3));
     sysdef_5->getDihedralData()->addBondedGroup(Dihedral(0, 1,2,3,4));
@@ -379,8 +379,8 @@ void dihedral_force_phase_shift(dihedralforce_creator tf_creator, std::shared_pt
     pdata_4->setPosition(3,make_scalar3(0.0,0.0,1.0));
 
     // create the dihedral force compute to check
-    std::shared_ptr<HarmonicDihedralForceCompute> fc_4 = tf_creator(sysdef_4);
-    fc_4->setParams(0, Scalar(10.0), 1, 1, Scalar(0.5*M_PI)); // type=0, K=30.0,sign=-1,multiplicity=3, phaseoffset=0, i think the ref angle is 0.240454
+    std::shared_ptr<PotentialDihedralHarmonic> fc_4 = tf_creator(sysdef_4);
+    fc_4->setParams(0, make_scalar4(Scalar(10.0), 1, 1, Scalar(0.5*M_PI))); // type=0, K=30.0,sign=-1,multiplicity=3, phaseoffset=0, i think the ref angle is 0.240454
 
     // compute the force and check the results
     fc_4->compute(0);
@@ -480,10 +480,10 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     snap->dihedral_data.type_mapping.push_back("A");
     std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
 
-    std::shared_ptr<HarmonicDihedralForceCompute> fc1 = tf_creator1(sysdef);
-    std::shared_ptr<HarmonicDihedralForceCompute> fc2 = tf_creator2(sysdef);
-    fc1->setParams(0, Scalar(3.0), -1, 3, Scalar(0.0));
-    fc2->setParams(0, Scalar(3.0), -1, 3, Scalar(0.0));
+    std::shared_ptr<PotentialDihedralHarmonic> fc1 = tf_creator1(sysdef);
+    std::shared_ptr<PotentialDihedralHarmonic> fc2 = tf_creator2(sysdef);
+    fc1->setParams(0, make_scalar4(Scalar(3.0), -1, 3, Scalar(0.0)));
+    fc2->setParams(0, make_scalar4(Scalar(3.0), -1, 3, Scalar(0.0)));
 
     // add dihedrals
     for (unsigned int i = 0; i < N-3; i++)
@@ -542,17 +542,17 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     }
 
 
-//! HarmonicDihedralForceCompute creator for dihedral_force_basic_tests()
-std::shared_ptr<HarmonicDihedralForceCompute> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
+//! PotentialDihedralHarmonic creator for dihedral_force_basic_tests()
+std::shared_ptr<PotentialDihedralHarmonic> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<HarmonicDihedralForceCompute>(new HarmonicDihedralForceCompute(sysdef));
+    return std::shared_ptr<PotentialDihedralHarmonic>(new PotentialDihedralHarmonic(sysdef));
     }
 
 #ifdef ENABLE_CUDA
 //! DihedralForceCompute creator for bond_force_basic_tests()
-std::shared_ptr<HarmonicDihedralForceCompute> gpu_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
+std::shared_ptr<PotentialDihedralHarmonic> gpu_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<HarmonicDihedralForceCompute>(new HarmonicDihedralForceComputeGPU(sysdef));
+    return std::shared_ptr<PotentialDihedralHarmonic>(new HarmonicDihedralForceComputeGPU(sysdef));
     }
 #endif
 
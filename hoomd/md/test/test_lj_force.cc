@@ -14,6 +14,7 @@
 #include "hoomd/md/AllPairPotentials.h"
 
 #include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/NeighborListCluster.h"
 #include "hoomd/Initializers.h"
 
 #include <math.h>
@@ -531,6 +532,163 @@ void lj_force_shift_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionCo
     }
     }
 
+//! Unit test that the cluster pair kernel matches the per-particle kernel
+void lj_force_cluster_test(NeighborList::storageMode mode, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListBinned> nlist_ref(new NeighborListBinned(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::shared_ptr<NeighborListCluster> nlist_cluster(new NeighborListCluster(sysdef, Scalar(3.0), Scalar(0.8)));
+    nlist_ref->setStorageMode(mode);
+    nlist_cluster->setStorageMode(mode);
+
+    // exclusions must be honored by the cluster masks
+    for (unsigned int i = 0; i < N-1; i += 2)
+        {
+        nlist_ref->addExclusion(i, i+1);
+        nlist_cluster->addExclusion(i, i+1);
+        }
+
+    std::shared_ptr<PotentialPairLJ> fc1(new PotentialPairLJ(sysdef, nlist_ref));
+    std::shared_ptr<PotentialPairLJ> fc2(new PotentialPairLJ(sysdef, nlist_cluster));
+    fc1->setRcut(0, 0, Scalar(3.0));
+    fc2->setRcut(0, 0, Scalar(3.0));
+    fc1->setRon(0, 0, Scalar(2.0));
+    fc2->setRon(0, 0, Scalar(2.0));
+    fc1->setShiftMode(PotentialPairLJ::xplor);
+    fc2->setShiftMode(PotentialPairLJ::xplor);
+
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.0);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    fc1->setParams(0,0,make_scalar2(lj1,lj2));
+    fc2->setParams(0,0,make_scalar2(lj1,lj2));
+
+    // compute the forces
+    fc1->compute(0);
+    fc2->compute(0);
+
+    // every particle is in a cluster
+    UP_ASSERT(nlist_cluster->getNClusters() >= N / NLIST_CLUSTER_SIZE);
+
+    {
+    GlobalArray<Scalar4>& force_array_1 =  fc1->getForceArray();
+    GlobalArray<Scalar>& virial_array_1 =  fc1->getVirialArray();
+    unsigned int pitch = virial_array_1.getPitch();
+    ArrayHandle<Scalar4> h_force_1(force_array_1,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_1(virial_array_1,access_location::host,access_mode::read);
+    GlobalArray<Scalar4>& force_array_2 =  fc2->getForceArray();
+    GlobalArray<Scalar>& virial_array_2 =  fc2->getVirialArray();
+    ArrayHandle<Scalar4> h_force_2(force_array_2,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial_2(virial_array_2,access_location::host,access_mode::read);
+
+    // every particle sees the same pairs, only the summation order differs
+    double deltaf2 = 0.0;
+    double deltape2 = 0.0;
+    double deltav2[6];
+    for (unsigned int i = 0; i < 6; i++)
+        deltav2[i] = 0.0;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        deltaf2 += double(h_force_2.data[i].x - h_force_1.data[i].x) * double(h_force_2.data[i].x - h_force_1.data[i].x);
+        deltaf2 += double(h_force_2.data[i].y - h_force_1.data[i].y) * double(h_force_2.data[i].y - h_force_1.data[i].y);
+        deltaf2 += double(h_force_2.data[i].z - h_force_1.data[i].z) * double(h_force_2.data[i].z - h_force_1.data[i].z);
+        deltape2 += double(h_force_2.data[i].w - h_force_1.data[i].w) * double(h_force_2.data[i].w - h_force_1.data[i].w);
+        for (unsigned int j = 0; j < 6; j++)
+            deltav2[j] += double(h_virial_2.data[j*pitch+i] - h_virial_1.data[j*pitch+i]) * double(h_virial_2.data[j*pitch+i] - h_virial_1.data[j*pitch+i]);
+        }
+    deltaf2 /= double(pdata->getN());
+    deltape2 /= double(pdata->getN());
+    for (unsigned int j = 0; j < 6; j++)
+        deltav2[j] /= double(pdata->getN());
+    CHECK_SMALL(deltaf2, double(tol_small));
+    CHECK_SMALL(deltape2, double(tol_small));
+    for (unsigned int j = 0; j < 6; j++)
+        CHECK_SMALL(deltav2[j], double(tol_small));
+    }
+    }
+
+//! Compares the forces in mixed precision with the forces in full precision
+void lj_force_mixed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 2000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListBinned> nlist(new NeighborListBinned(sysdef, Scalar(3.0), Scalar(0.8)));
+
+    std::shared_ptr<PotentialPairLJ> fc1(new PotentialPairLJ(sysdef, nlist));
+    std::shared_ptr<PotentialPairLJ> fc2(new PotentialPairLJ(sysdef, nlist));
+    fc1->setRcut(0, 0, Scalar(3.0));
+    fc2->setRcut(0, 0, Scalar(3.0));
+    fc2->setMixedPrecision(true);
+    UP_ASSERT(fc2->getMixedPrecision());
+
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.0);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    fc1->setParams(0,0,make_scalar2(lj1,lj2));
+    fc2->setParams(0,0,make_scalar2(lj1,lj2));
+
+    // compute the forces
+    fc1->compute(0);
+    fc2->compute(0);
+
+    {
+    ArrayHandle<Scalar4> h_force_1(fc1->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_force_2(fc2->getForceArray(),access_location::host,access_mode::read);
+
+    // the separations are rounded to single precision, compare relative to the magnitude of the forces
+    double deltaf2 = 0.0;
+    double f2 = 0.0;
+    double deltape2 = 0.0;
+    double pe2 = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        deltaf2 += double(h_force_2.data[i].x - h_force_1.data[i].x) * double(h_force_2.data[i].x - h_force_1.data[i].x);
+        deltaf2 += double(h_force_2.data[i].y - h_force_1.data[i].y) * double(h_force_2.data[i].y - h_force_1.data[i].y);
+        deltaf2 += double(h_force_2.data[i].z - h_force_1.data[i].z) * double(h_force_2.data[i].z - h_force_1.data[i].z);
+        f2 += double(h_force_1.data[i].x) * double(h_force_1.data[i].x);
+        f2 += double(h_force_1.data[i].y) * double(h_force_1.data[i].y);
+        f2 += double(h_force_1.data[i].z) * double(h_force_1.data[i].z);
+        deltape2 += double(h_force_2.data[i].w - h_force_1.data[i].w) * double(h_force_2.data[i].w - h_force_1.data[i].w);
+        pe2 += double(h_force_1.data[i].w) * double(h_force_1.data[i].w);
+        }
+    UP_ASSERT(f2 > 0.0);
+    CHECK_SMALL(deltaf2 / f2, 1e-8);
+    CHECK_SMALL(deltape2 / pe2, 1e-8);
+    }
+
+    // switching back gives the full precision result
+    fc2->setMixedPrecision(false);
+    fc2->compute(1);
+
+    {
+    ArrayHandle<Scalar4> h_force_1(fc1->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_force_2(fc2->getForceArray(),access_location::host,access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        UP_ASSERT_EQUAL(h_force_2.data[i].x, h_force_1.data[i].x);
+        UP_ASSERT_EQUAL(h_force_2.data[i].w, h_force_1.data[i].w);
+        }
+    }
+    }
+
 //! LJForceCompute creator for unit tests
 std::shared_ptr<PotentialPairLJ> base_class_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                   std::shared_ptr<NeighborList> nlist)
@@ -570,6 +728,24 @@ UP_TEST( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the cluster pair kernel with a half neighbor list on CPU
+UP_TEST( PotentialPairLJ_cluster_half )
+    {
+    lj_force_cluster_test(NeighborList::half, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the cluster pair kernel with a full neighbor list on CPU
+UP_TEST( PotentialPairLJ_cluster_full )
+    {
+    lj_force_cluster_test(NeighborList::full, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for mixed precision on CPU
+UP_TEST( PotentialPairLJ_mixed )
+    {
+    lj_force_mixed_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
@@ -14,6 +14,7 @@
 #include "hoomd/md/NeighborListBinned.h"
 #include "hoomd/md/NeighborListStencil.h"
 #include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/NeighborListCluster.h"
 #include "hoomd/Initializers.h"
 
 #ifdef ENABLE_CUDA
@@ -708,6 +709,75 @@ void neighborlist_exclusion_tests(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! Test that the CPU exclusion list is packed sorted by index, with one particle that has many exclusions
+template <class NL>
+void neighborlist_exclusion_csr_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_12(new SystemDefinition(12, BoxDim(20.0, 40.0, 60.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_12 = sysdef_12->getParticleData();
+
+    // put all 12 particles on top of each other
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_12->getPositions(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < 12; i++)
+        h_pos.data[i] = make_scalar4(0,0,0,__int_as_scalar(0));
+    pdata_12->notifyParticleSort();
+    }
+
+    std::shared_ptr<NeighborList> nlist_12(new NL(sysdef_12, 3.0, 0.25));
+    nlist_12->setRCutPair(0,0,3.0);
+    nlist_12->setStorageMode(NeighborList::full);
+
+    // exclude 10 particles from particle 0, in reverse order, and one pair that does not involve it
+    for (unsigned int i = 10; i >= 1; i--)
+        nlist_12->addExclusion(0,i);
+    nlist_12->addExclusion(11,5);
+
+    nlist_12->compute(0);
+        {
+        ArrayHandle<unsigned int> h_ex_head(nlist_12->getExHeadArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list(nlist_12->getExListCSRArray(), access_location::host, access_mode::read);
+
+        CHECK_EQUAL_UINT(h_ex_head.data[0], 0);
+        CHECK_EQUAL_UINT(h_ex_head.data[1], 10);
+        for (unsigned int i = 0; i < 10; i++)
+            CHECK_EQUAL_UINT(h_ex_list.data[i], i+1);
+
+        // particle 5 is excluded from 0 and 11, all others from 0 only
+        CHECK_EQUAL_UINT(h_ex_head.data[6] - h_ex_head.data[5], 2);
+        CHECK_EQUAL_UINT(h_ex_list.data[h_ex_head.data[5]], 0);
+        CHECK_EQUAL_UINT(h_ex_list.data[h_ex_head.data[5]+1], 11);
+        CHECK_EQUAL_UINT(h_ex_head.data[12], 22);
+        }
+
+        {
+        ArrayHandle<unsigned int> h_n_neigh(nlist_12->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(nlist_12->getNListArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(nlist_12->getHeadList(), access_location::host, access_mode::read);
+
+        CHECK_EQUAL_UINT(h_n_neigh.data[0], 1);
+        CHECK_EQUAL_UINT(h_nlist.data[h_head_list.data[0] + 0], 11);
+
+        CHECK_EQUAL_UINT(h_n_neigh.data[1], 10);
+        CHECK_EQUAL_UINT(h_n_neigh.data[5], 9);
+        CHECK_EQUAL_UINT(h_n_neigh.data[11], 10);
+        for (unsigned int j = 0; j < h_n_neigh.data[11]; j++)
+            {
+            unsigned int k = h_nlist.data[h_head_list.data[11] + j];
+            UP_ASSERT(k != 0 && k != 5 && k != 11);
+            }
+        }
+
+    // clearing the exclusions restores all neighbors
+    nlist_12->clearExclusions();
+    nlist_12->compute(1);
+        {
+        ArrayHandle<unsigned int> h_n_neigh(nlist_12->getNNeighArray(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < 12; i++)
+            CHECK_EQUAL_UINT(h_n_neigh.data[i], 11);
+        }
+    }
+
 //! Tests the ability of the neighbor list to exclude particles from the same body
 template <class NL>
 void neighborlist_body_filter_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1250,6 +1320,138 @@ void neighborlist_2d_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
         }
     }
 
+//! Tests that the distance check detects a single particle that moved too far
+template <class NL>
+void neighborlist_dist_check_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // more particles than fit into one block of the check
+    const unsigned int n = 10;
+    const unsigned int N = n*n*n;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(40.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        h_pos.data[i].x = Scalar(-20.0) + Scalar(4.0) * (i % n);
+        h_pos.data[i].y = Scalar(-20.0) + Scalar(4.0) * ((i / n) % n);
+        h_pos.data[i].z = Scalar(-20.0) + Scalar(4.0) * (i / (n*n));
+        h_pos.data[i].w = 0.0;
+        }
+    pdata->notifyParticleSort();
+    }
+
+    // a particle may move r_buff/2 = 0.2 before the list is rebuilt
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, 1.0, 0.4));
+    nlist->setRCutPair(0,0,1.0);
+    nlist->setEvery(1, true);
+    nlist->compute(0);
+    unsigned int n_updates = nlist->getNumUpdates();
+
+    // move the last particle less than the threshold
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[N-1].x += Scalar(0.1);
+    }
+    nlist->compute(1);
+    UP_ASSERT_EQUAL(nlist->getNumUpdates(), n_updates);
+
+    // and beyond it
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[N-1].x += Scalar(0.2);
+    }
+    nlist->compute(2);
+    UP_ASSERT_EQUAL(nlist->getNumUpdates(), n_updates+1);
+
+    // the list was rebuilt at the new position
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].y += Scalar(0.1);
+    }
+    nlist->compute(3);
+    UP_ASSERT_EQUAL(nlist->getNumUpdates(), n_updates+1);
+    }
+
+//! Test that the views of the neighbor list hold the neighbors within their cutoffs first
+template <class NL>
+void neighborlist_views_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // a line of particles with spacing 0.5
+    const unsigned int N = 21;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(40.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        h_pos.data[i] = make_scalar4(Scalar(-5.0) + Scalar(0.5) * i, 0.0, 0.0, 0.0);
+        }
+    pdata->notifyParticleSort();
+    }
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, 3.0, 0.2));
+    nlist->setRCutPair(0,0,3.0);
+    nlist->setStorageMode(NeighborList::full);
+
+    // a single view is the whole list
+    unsigned int view_long = nlist->addView();
+    nlist->setViewRCutPair(view_long, 0, 0, 3.0);
+    nlist->compute(0);
+    UP_ASSERT(nlist->getViewNNeigh(view_long) == NULL);
+
+    unsigned int view_short = nlist->addView();
+    nlist->setViewRCutPair(view_short, 0, 0, 1.0);
+    nlist->compute(1);
+
+    const unsigned int *n_neigh_short = nlist->getViewNNeigh(view_short);
+    const unsigned int *n_neigh_long = nlist->getViewNNeigh(view_long);
+    UP_ASSERT(n_neigh_short != NULL);
+    UP_ASSERT(n_neigh_long != NULL);
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(), access_location::host, access_mode::read);
+
+    // the particle in the middle has 4 neighbors within 1.2 and 12 within 3.2
+    UP_ASSERT_EQUAL(n_neigh_short[10], (unsigned int)4);
+    UP_ASSERT_EQUAL(n_neigh_long[10], (unsigned int)12);
+    UP_ASSERT_EQUAL(h_n_neigh.data[10], (unsigned int)12);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        UP_ASSERT(n_neigh_short[i] <= n_neigh_long[i]);
+        UP_ASSERT_EQUAL(n_neigh_long[i], h_n_neigh.data[i]);
+
+        // the list still holds all neighbors, with the short ones first
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            unsigned int j = h_nlist.data[h_head_list.data[i] + k];
+            Scalar dx = fabs(h_pos.data[i].x - h_pos.data[j].x);
+            if (k < n_neigh_short[i])
+                UP_ASSERT(dx < Scalar(1.2));
+            else
+                UP_ASSERT(dx > Scalar(1.2));
+            }
+        }
+    }
+
+    // views with the same radii are the whole list, too
+    nlist->setViewRCutPair(view_short, 0, 0, 3.0);
+    nlist->compute(2);
+    UP_ASSERT(nlist->getViewNNeigh(view_short) == NULL);
+    UP_ASSERT(nlist->getViewNNeigh(view_long) == NULL);
+
+    // removing a view makes the remaining one the whole list again
+    nlist->removeView(view_short);
+    nlist->compute(3);
+    UP_ASSERT(nlist->getViewNNeigh(view_long) == NULL);
+    }
+
 ///////////////
 // BINNED CPU
 ///////////////
@@ -1258,6 +1460,16 @@ UP_TEST( NeighborListBinned_basic )
     {
     neighborlist_basic_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! distance check test case for binned class
+UP_TEST( NeighborListBinned_dist_check )
+    {
+    neighborlist_dist_check_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! view test case for binned class
+UP_TEST( NeighborListBinned_views )
+    {
+    neighborlist_views_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! exclusion test case for binned class
 UP_TEST( NeighborListBinned_exclusion )
     {
@@ -1268,6 +1480,11 @@ UP_TEST( NeighborListBinned_large_ex )
     {
     neighborlist_large_ex_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! sorted exclusion storage test case for binned class
+UP_TEST( NeighborListBinned_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! body filter test case for binned class
 UP_TEST( NeighborListBinned_body_filter)
     {
@@ -1323,6 +1540,11 @@ UP_TEST( NeighborListStencil_large_ex )
     {
     neighborlist_large_ex_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! sorted exclusion storage test case for stencil class
+UP_TEST( NeighborListStencil_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! body filter test case for stencil class
 UP_TEST( NeighborListStencil_body_filter)
     {
@@ -1372,6 +1594,16 @@ UP_TEST( NeighborListTree_basic )
     {
     neighborlist_basic_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! distance check test case for tree class
+UP_TEST( NeighborListTree_dist_check )
+    {
+    neighborlist_dist_check_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! view test case for tree class
+UP_TEST( NeighborListTree_views )
+    {
+    neighborlist_views_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! exclusion test case for tree class
 UP_TEST( NeighborListTree_exclusion )
     {
@@ -1382,6 +1614,11 @@ UP_TEST( NeighborListTree_large_ex )
     {
     neighborlist_large_ex_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! sorted exclusion storage test case for tree class
+UP_TEST( NeighborListTree_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! body filter test case for tree class
 UP_TEST( NeighborListTree_body_filter)
     {
@@ -1423,6 +1660,70 @@ UP_TEST( NeighborListTree_comparison )
     neighborlist_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+///////////////
+// CLUSTER CPU
+///////////////
+//! basic test case for cluster class
+UP_TEST( NeighborListCluster_basic )
+    {
+    neighborlist_basic_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! exclusion test case for cluster class
+UP_TEST( NeighborListCluster_exclusion )
+    {
+    neighborlist_exclusion_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! large exclusion test case for cluster class
+UP_TEST( NeighborListCluster_large_ex )
+    {
+    neighborlist_large_ex_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! sorted exclusion storage test case for cluster class
+UP_TEST( NeighborListCluster_exclusion_csr )
+    {
+    neighborlist_exclusion_csr_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! body filter test case for cluster class
+UP_TEST( NeighborListCluster_body_filter)
+    {
+    neighborlist_body_filter_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! diameter filter test case for cluster class
+UP_TEST( NeighborListCluster_diameter_shift )
+    {
+    neighborlist_diameter_shift_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! diameter filter test case across periodic boundaries for cluster class
+UP_TEST( NeighborListCluster_diameter_shift_periodic )
+    {
+    neighborlist_diameter_shift_periodic_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! particle asymmetry test case for cluster class
+UP_TEST( NeighborListCluster_particle_asymm )
+    {
+    neighborlist_particle_asymm_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! cutoff exclusion test case for cluster class
+UP_TEST( NeighborListCluster_cutoff_exclude )
+    {
+    neighborlist_cutoff_exclude_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! type test case for cluster class
+UP_TEST( NeighborListCluster_type )
+    {
+    neighborlist_type_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! 2d test case for cluster class
+UP_TEST( NeighborListCluster_2d )
+    {
+    neighborlist_2d_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! comparison test case for cluster class
+UP_TEST( NeighborListCluster_comparison )
+    {
+    neighborlist_comparison_test<NeighborListBinned, NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 ///////////////
 // BINNED GPU
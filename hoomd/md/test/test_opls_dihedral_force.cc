@@ -9,7 +9,7 @@
 
 #include <functional>
 
-#include "hoomd/md/OPLSDihedralForceCompute.h"
+#include "hoomd/md/AllDihedralPotentials.h"
 #include "hoomd/ConstForceCompute.h"
 #ifdef ENABLE_CUDA
 #include "hoomd/md/OPLSDihedralForceComputeGPU.h"
@@ -27,7 +27,7 @@ using namespace std::placeholders;
 HOOMD_UP_MAIN();
 
 //! Typedef to make using the std::function factory easier
-typedef std::function<std::shared_ptr<OPLSDihedralForceCompute>  (std::shared_ptr<SystemDefinition> sysdef)> dihedralforce_creator;
+typedef std::function<std::shared_ptr<PotentialDihedralOPLS>  (std::shared_ptr<SystemDefinition> sysdef)> dihedralforce_creator;
 
 //! Perform some simple functionality tests of any BondForceCompute
 void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -42,10 +42,10 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
     pdata_4->setPosition(3,make_scalar3(0,0.4,-0.6));
 
     // create the dihedral force compute to check
-    std::shared_ptr<OPLSDihedralForceCompute> fc_4 = tf_creator(sysdef_4);
+    std::shared_ptr<PotentialDihedralOPLS> fc_4 = tf_creator(sysdef_4);
 
     // k1 = 1.5, k2 = 6.2, k3 = 1.7, k4 = 3.0
-    fc_4->setParams(0, 1.5, 6.2, 1.7, 3.0);
+    fc_4->setParams(0, make_scalar4(1.5, 6.2, 1.7, 3.0));
 
     // compute the force (should be 0) and check the results
     fc_4->compute(0);
@@ -289,9 +289,9 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
     pdata_8->setPosition(6, make_scalar3(0.0,2.9,-1.7));
     pdata_8->setPosition(7, make_scalar3(-2.0,0.3,0.7));
 
-    std::shared_ptr<OPLSDihedralForceCompute> fc_8 = tf_creator(sysdef_8);
-    fc_8->setParams(0, 2.0, 3.0, 4.0, 5.0);
-    fc_8->setParams(1, 5.2, 4.2, 3.2, 1.2);
+    std::shared_ptr<PotentialDihedralOPLS> fc_8 = tf_creator(sysdef_8);
+    fc_8->setParams(0, make_scalar4(2.0, 3.0, 4.0, 5.0));
+    fc_8->setParams(1, make_scalar4(5.2, 4.2, 3.2, 1.2));
 
     sysdef_8->getDihedralData()->addBondedGroup(Dihedral(0, 0,1,2,3));
     sysdef_8->getDihedralData()->addBondedGroup(Dihedral(1, 4,5,6,7));
@@ -382,8 +382,8 @@ void dihedral_force_basic_tests(dihedralforce_creator tf_creator, std::shared_pt
     pdata_5->setPosition(4, make_scalar3(4.8,1.1,0.0));
 
     // build the dihedral force compute and try it out
-    std::shared_ptr<OPLSDihedralForceCompute> fc_5 = tf_creator(sysdef_5);
-    fc_5->setParams(0, 1.2, 3.3, 4.2, 6.4);
+    std::shared_ptr<PotentialDihedralOPLS> fc_5 = tf_creator(sysdef_5);
+    fc_5->setParams(0, make_scalar4(1.2, 3.3, 4.2, 6.4));
 
     sysdef_5->getDihedralData()->addBondedGroup(Dihedral(0, 0,1,2,3));
     sysdef_5->getDihedralData()->addBondedGroup(Dihedral(0, 1,2,3,4));
@@ -453,10 +453,10 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     snap->dihedral_data.type_mapping.push_back("A");
     std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
 
-    std::shared_ptr<OPLSDihedralForceCompute> fc1 = tf_creator1(sysdef);
-    std::shared_ptr<OPLSDihedralForceCompute> fc2 = tf_creator2(sysdef);
-    fc1->setParams(0, 1.1, 2.2, 4.5, 3.6);
-    fc2->setParams(0, 1.1, 2.2, 4.5, 3.6);
+    std::shared_ptr<PotentialDihedralOPLS> fc1 = tf_creator1(sysdef);
+    std::shared_ptr<PotentialDihedralOPLS> fc2 = tf_creator2(sysdef);
+    fc1->setParams(0, make_scalar4(1.1, 2.2, 4.5, 3.6));
+    fc2->setParams(0, make_scalar4(1.1, 2.2, 4.5, 3.6));
 
     // add dihedrals
     for (unsigned int i = 0; i < N-3; i++)
@@ -514,17 +514,17 @@ void dihedral_force_comparison_tests(dihedralforce_creator tf_creator1,
     }
     }
 
-//! OPLSDihedralForceCompute creator for dihedral_force_basic_tests()
-std::shared_ptr<OPLSDihedralForceCompute> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
+//! PotentialDihedralOPLS creator for dihedral_force_basic_tests()
+std::shared_ptr<PotentialDihedralOPLS> base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<OPLSDihedralForceCompute>(new OPLSDihedralForceCompute(sysdef));
+    return std::shared_ptr<PotentialDihedralOPLS>(new PotentialDihedralOPLS(sysdef));
     }
 
 #ifdef ENABLE_CUDA
 //! DihedralForceCompute creator for bond_force_basic_tests()
-std::shared_ptr<OPLSDihedralForceCompute> gpu_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
+std::shared_ptr<PotentialDihedralOPLS> gpu_tf_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
-    return std::shared_ptr<OPLSDihedralForceCompute>(new OPLSDihedralForceComputeGPU(sysdef));
+    return std::shared_ptr<PotentialDihedralOPLS>(new OPLSDihedralForceComputeGPU(sysdef));
     }
 #endif
 
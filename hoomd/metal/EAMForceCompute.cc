@@ -8,6 +8,10 @@
 
 #include <vector>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 
 #include <stdexcept>
@@ -23,7 +27,7 @@ namespace py = pybind11;
  \param type_of_file EAM/Alloy=0, EAM/FS=1
  */
 EAMForceCompute::EAMForceCompute(std::shared_ptr<SystemDefinition> sysdef, char *filename, int type_of_file) :
-        ForceCompute(sysdef)
+        ForceCompute(sysdef), m_P(m_pdata->getMaxN(), m_exec_conf), m_dFdP(m_pdata->getMaxN(), m_exec_conf)
     {
 
     m_exec_conf->msg->notice(5) << "Constructing EAMForceCompute" << endl;
@@ -38,12 +42,16 @@ EAMForceCompute::EAMForceCompute(std::shared_ptr<SystemDefinition> sysdef, char
 
     // connect to the ParticleData to receive notifications when the number of particle types changes
     m_pdata->getNumTypesChangeSignal().connect<EAMForceCompute, &EAMForceCompute::slotNumTypesChange>(this);
+
+    // the per-particle buffers follow the size of the particle data
+    m_pdata->getMaxParticleNumberChangeSignal().connect<EAMForceCompute, &EAMForceCompute::slotMaxNumChanged>(this);
     }
 
 EAMForceCompute::~EAMForceCompute()
     {
     m_exec_conf->msg->notice(5) << "Destroying EAMForceCompute" << endl;
     m_pdata->getNumTypesChangeSignal().disconnect<EAMForceCompute, &EAMForceCompute::slotNumTypesChange>(this);
+    m_pdata->getMaxParticleNumberChangeSignal().disconnect<EAMForceCompute, &EAMForceCompute::slotMaxNumChanged>(this);
     }
 
 void EAMForceCompute::loadFile(char *filename, int type_of_file)
@@ -343,13 +351,6 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
 
-    // index and remainder
-    Scalar position;  // look up position, scalar
-    unsigned int int_position;  // look up index for position, integer
-    unsigned int idxs; // look up index in F, rho, rphi array, considering shift, integer
-    Scalar remainder;  // look up remainder in array, integer
-    Scalar4 v, dv;  // value, d(value)
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -361,6 +362,8 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     assert(h_rphi.data);
     assert(h_drphi.data);
 
+    const unsigned int N = m_pdata->getN();
+
     // Zero data for force calculation.
     memset((void *) h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
     memset((void *) h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
@@ -373,101 +376,134 @@ void EAMForceCompute::computeForces(unsigned int timestep)
 
     // sum up the number of forces calculated
     int64_t n_calc = 0;
+    for (unsigned int i = 0; i < N; i++)
+        n_calc += h_n_neigh.data[i];
 
-    // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
     unsigned int ntypes = m_pdata->getNTypes();
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int head_i = h_head_list.data[i];
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+        // the electron density P of every particle, a half neighbor list also writes to ghosts
+        ArrayHandle<Scalar> h_P(m_P, access_location::host, access_mode::overwrite);
+        memset((void *) h_P.data, 0, sizeof(Scalar) * (N + m_pdata->getNGhosts()));
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int) h_n_neigh.data[i];
-
-        for (unsigned int j = 0; j < size; j++)
+        auto compute_density = [&](unsigned int i)
             {
-            // increment our calculation counter
-            n_calc++;
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int head_i = h_head_list.data[i];
 
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(typei < m_pdata->getNTypes());
 
-            // calculate dr
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            Scalar Pi = Scalar(0.0);
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int) h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
+                {
+                // access the index of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                // sanity check
+                assert(k < m_pdata->getN() + m_pdata->getNGhosts());
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+                // calculate dr
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
 
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
-                {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int) position;
-                int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
-                // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                        + v.x * remainder * remainder * remainder;
-                // if third_law, pair it
-                if (third_law)
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r squared
+                Scalar rsq = dot(dx, dx);
+
+                // only compute the density if the particles are closer than the cut-off
+                if (rsq < r_cut_sq)
                     {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
+                    // calculate position r for rho(r)
+                    Scalar position = sqrt(rsq) * rdr;
+                    unsigned int int_position = (unsigned int) position;
+                    int_position = min(int_position, nr - 1);
+                    Scalar remainder = position - int_position;
+                    // calculate P = sum{rho}
+                    unsigned int idxs = int_position + nr * (typej * ntypes + typei);
+                    Scalar4 v = h_rho.data[idxs];
+                    Pi += v.w + v.z * remainder + v.y * remainder * remainder
                             + v.x * remainder * remainder * remainder;
+                    // if third_law, pair it
+                    if (third_law)
+                        {
+                        idxs = int_position + nr * (typei * ntypes + typej);
+                        v = h_rho.data[idxs];
+                        h_P.data[k] += v.w + v.z * remainder + v.y * remainder * remainder
+                                + v.x * remainder * remainder * remainder;
+                        }
                     }
                 }
+            h_P.data[i] += Pi;
+            };
+
+        // with a full neighbor list, every particle only writes its own density
+        #ifdef ENABLE_TBB
+        if (! third_law)
+            tbb::parallel_for((unsigned int)0, N, compute_density);
+        else
+        #endif
+            for (unsigned int i = 0; i < N; i++)
+                compute_density(i);
+
+        ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::overwrite);
+
+        // loop over local particles, every particle only writes its own values
+        #ifdef ENABLE_TBB
+        tbb::parallel_for((unsigned int)0, N, [&](unsigned int i)
+        #else
+        for (unsigned int i = 0; i < N; i++)
+        #endif
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            // calculate position rho for F(rho)
+            Scalar position = h_P.data[i] * rdrho;
+            unsigned int int_position = (unsigned int) position;
+            int_position = min(int_position, nrho - 1);
+            Scalar remainder = position - int_position;
+
+            unsigned int idxs = int_position + typei * nrho;
+            Scalar4 v = h_F.data[idxs];
+            Scalar4 dv = h_dF.data[idxs];
+            // compute dF / dP
+            h_dFdP.data[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            // compute embedded energy F(P), sum up each particle
+            h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
+                    + v.x * remainder * remainder * remainder;
             }
+        #ifdef ENABLE_TBB
+            );
+        #endif
         }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    #ifdef ENABLE_MPI
+    // the forces on local particles depend on dF/dP of their ghost neighbors
+    if (m_comm)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int) position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                + v.x * remainder * remainder * remainder;
+        if (m_prof)
+            m_prof->pop();
+
+        m_comm->updateGhostField(m_dFdP);
 
+        if (m_prof)
+            m_prof->push("EAM pair");
         }
+    #endif
+
+    ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::read);
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    auto compute_force = [&](unsigned int i)
         {
         // access the particle's position and type
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -489,13 +525,10 @@ void EAMForceCompute::computeForces(unsigned int timestep)
         const unsigned int size = (unsigned int) h_n_neigh.data[i];
         for (unsigned int j = 0; j < size; j++)
             {
-            // increment our calculation counter
-            n_calc++;
-
             // access the index of this neighbor
             unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < m_pdata->getN() + m_pdata->getNGhosts());
 
             // calculate \Delta r
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -518,19 +551,19 @@ void EAMForceCompute::computeForces(unsigned int timestep)
                 continue;
             Scalar r = sqrt(rsq);
             Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int) position;
+            Scalar position = r * rdr;
+            unsigned int int_position = (unsigned int) position;
             int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
+            Scalar remainder = position - int_position;
             // calculate the shift position for type ij
             int shift =
                     (typei >= typej) ?
                             (int) (0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr :
                             (int) (0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
 
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
+            unsigned int idxs = int_position + shift;
+            Scalar4 v = h_rphi.data[idxs];
+            Scalar4 dv = h_drphi.data[idxs];
             // pair_eng = phi
             Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
                     + v.x * remainder * remainder * remainder) * inverseR;
@@ -545,8 +578,8 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             dv = h_drho.data[idxs];
             Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
             // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                    + atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
+            Scalar fullDerivativePhi = h_dFdP.data[i] * derivativeRhoJ
+                    + h_dFdP.data[k] * derivativeRhoI + derivativePhi;
             // compute forces
             Scalar pairForce = -fullDerivativePhi * inverseR;
             viriali[0] += dx.x * dx.x * pairForce;
@@ -574,12 +607,24 @@ void EAMForceCompute::computeForces(unsigned int timestep)
         h_force.data[i].w += pei;
         for (int k = 0; k < 6; k++)
             h_virial.data[k * virial_pitch + i] += viriali[k];
-        }
+        };
+
+    // with a full neighbor list, every particle only writes its own force
+    #ifdef ENABLE_TBB
+    if (! third_law)
+        tbb::parallel_for((unsigned int)0, N, compute_force);
+    else
+    #endif
+        for (unsigned int i = 0; i < N; i++)
+            compute_force(i);
+
+    // both passes loop over the neighbor list
+    n_calc *= 2;
 
-    int64_t flops = m_pdata->getN() * 5 + n_calc * (3 + 5 + 9 + 1 + 9 + 6 + 8);
+    int64_t flops = N * 5 + n_calc * (3 + 5 + 9 + 1 + 9 + 6 + 8);
     if (third_law)
         flops += n_calc * 8;
-    int64_t mem_transfer = m_pdata->getN() * (5 + 4 + 10) * sizeof(Scalar) + n_calc * (1 + 3 + 1) * sizeof(Scalar);
+    int64_t mem_transfer = N * (5 + 4 + 10) * sizeof(Scalar) + n_calc * (1 + 3 + 1) * sizeof(Scalar);
     if (third_law)
         mem_transfer += n_calc * 10 * sizeof(Scalar);
     if (m_prof)
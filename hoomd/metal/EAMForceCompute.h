@@ -42,6 +42,13 @@
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ \b Parallelization
+ The electron density P and the derivative dF/dP of every particle are kept in persistent per-particle arrays.
+ The force on a particle depends on dF/dP of its neighbors, so in MPI simulations the derivatives of the ghost
+ particles are copied from their owning ranks with Communicator::updateGhostField() between the density and the
+ force pass. With a full neighbor list, both passes only write to the particle they loop over and run in parallel
+ in TBB builds. A half neighbor list is processed serially.
+
  \ingroup computes
  */
 class EAMForceCompute: public ForceCompute
@@ -91,7 +98,8 @@ protected:
     GPUArray<Scalar4> m_dF;                //!< derivative embedded function and its coefficients
     GPUArray<Scalar4> m_drho;              //!< derivative electron density and its coefficients
     GPUArray<Scalar4> m_drphi;             //!< derivative pair wise function and its coefficients
-    GPUArray<Scalar> m_dFdP;               //!< derivative F / derivative P
+    GlobalArray<Scalar> m_P;               //!< electron density P of each particle, including ghosts
+    GlobalArray<Scalar> m_dFdP;            //!< derivative F / derivative P of each particle, including ghosts
 
     //! Actually compute the forces
     virtual void computeForces(unsigned int timestep);
@@ -103,6 +111,13 @@ protected:
         throw std::runtime_error("Unsupported feature");
         }
 
+    //! Resize the per-particle buffers when the maximum number of particles changes
+    void slotMaxNumChanged()
+        {
+        m_P.resize(m_pdata->getMaxN());
+        m_dFdP.resize(m_pdata->getMaxN());
+        }
+
     //! cubic interpolation
     virtual void interpolation(int num_all, int num_per, Scalar delta, ArrayHandle<Scalar4> *f,
             ArrayHandle<Scalar4> *df);
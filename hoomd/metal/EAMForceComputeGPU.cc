@@ -93,8 +93,6 @@ void EAMForceComputeGPU::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> d_drphi(m_drphi, access_location::device, access_mode::read);
 
     // Derivative Embedding Function for each atom
-    GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
-    m_dFdP.swap(t_dFdP);
     ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
 
     // Compute energy and forces in GPU
@@ -37,8 +37,11 @@ class eam(force._force):
     (commands eam/alloy and eam/fs) here: http://lammps.sandia.gov/doc/pair_eam.html
     and are also described here: http://enpub.fulton.asu.edu/cms/potentials/submain/format.htm
 
+    In MPI simulations, the derivatives of the embedding function of ghost particles are communicated between the
+    density and the force evaluation.
+
     .. attention::
-        EAM is **NOT** supported in MPI parallel simulations.
+        On the GPU, EAM is **NOT** supported in MPI parallel simulations.
 
     Example::
 
@@ -62,10 +65,10 @@ class eam(force._force):
 
         hoomd.util.print_status_line();
 
-        # Error out in MPI simulations
-        if (_hoomd.is_MPI_available()):
+        # Error out in MPI simulations on the GPU
+        if (_hoomd.is_MPI_available() and hoomd.context.exec_conf.isCUDAEnabled()):
             if hoomd.context.current.system_definition.getParticleData().getDomainDecomposition():
-                hoomd.context.msg.error("pair.eam is not supported in multi-processor simulations.\n\n")
+                hoomd.context.msg.error("pair.eam is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up pair potential.")
 
         # initialize the base class
@@ -89,7 +92,8 @@ class eam(force._force):
 
         #Load neighbor list to compute.
         self.cpp_force.set_neighbor_list(self.nlist.cpp_nlist);
-        if hoomd.context.exec_conf.isCUDAEnabled():
+        # the GPU requires a full neighbor list, and on the CPU it lets both passes run in parallel threads
+        if hoomd.context.exec_conf.isCUDAEnabled() or _hoomd.is_TBB_available():
             self.nlist.cpp_nlist.setStorageMode(_md.NeighborList.storageMode.full);
 
         hoomd.context.msg.notice(2, "Set r_cut = " + str(self.r_cut_new) + " from potential`s file '" +  str(file) + "'.\n");
@@ -6,6 +6,20 @@ import numpy
 import os
 context.initialize()
 
+# the unit test uses a potential, which is sparsed from G.Purja Pun & Y. Mishin, 2009
+def write_potential(potf):
+    if comm.get_rank() == 0:
+        os.system('mkdir -p ' + os.path.dirname(potf))
+        with open(potf, 'w') as outf:
+            outf.write('test potential sparse from:\n Mishin-Ni-Al-2009.eam.alloy\n Alloy\n 2 Ni Al\n 20 0.250661 20 0.31436 6.28721\n 28 58.71 3.52 fcc\n -0.0225464 -1.76636 -2.37638 -2.58753 -2.56335 \n -2.44363 -2.1936 -1.69669 -0.881535 0.259267 \n 1.71214 3.47279 5.52768 7.84679 10.3946 \n 13.1387 16.0533 19.12 22.3271 25.6681 \n 0.166428 0.170459 0.167088 0.158941 0.148264 \n 0.134559 0.116655 0.0950843 0.0717676 0.0494264 \n 0.0305923 0.0166948 0.00778478 0.00291687 0.00076581 \n 9.6658e-05 8.84137e-07 0 0 0 \n 13 26.982 4.05 fcc\n -4.3767e-11 -1.6886 -2.24356 -2.61981 -2.8881 \n -3.03673 -3.07531 -3.14579 -3.15517 -3.04228 \n -2.80696 -2.44921 -1.96903 -1.36641 -0.641356 \n 0.206131 1.17605 2.2684 3.48319 4.82042 \n 0.396504 0.268377 0.182302 0.130397 0.104787 \n 0.09764 0.10114 0.10747 0.108814 0.097359 \n 0.0701286 0.0394937 0.0192524 0.00952344 0.00538008 \n 0.00357488 0.0027837 0.00202854 0.0010566 9.93586e-05 \n 0 1.45214 3.46822 4.73416 4.63266 \n 3.27018 1.42217 0.00246105 -0.578463 -0.528943 \n -0.314831 -0.217411 -0.216257 -0.18649 -0.098564 \n -0.021759 -0.000310685 0 0 0 \n 0 2016.46 1530.29 608.866 120.656 \n 8.56573 1.68568 0.0591469 -0.564815 -0.587964 \n -0.416922 -0.286477 -0.251829 -0.249993 -0.216214 \n -0.137026 -0.0706754 -0.0262716 -1.62953e-08 0 \n 0 10.7294 10.5529 7.42998 5.15814 \n 4.13394 3.26306 1.83395 0.548762 0.044061 \n -0.0987007 -0.134826 -0.151869 -0.205764 -0.215437 \n -0.169569 -0.0703696 0.0113375 0.0283944 0.00186361 \n')
+    comm.barrier_all()
+
+def remove_potential(tmpd):
+    comm.barrier_all()
+    if comm.get_rank() == 0:
+        os.system('rm -rf ' + tmpd)
+    comm.barrier_all()
+
 class eam_tests(unittest.TestCase):
     # setUp is called before the start of every test method
     def setUp(self):
@@ -29,13 +43,9 @@ class eam_tests(unittest.TestCase):
             p.type = typelst[p.tag]
             p.mass = masslst[p.tag]
         cwd = os.getcwd()
-        # the unit test uses a potential, which is sparsed from G.Purja Pun & Y. Mishin, 2009
         tmpd = cwd + '/eamtemp/'
-        os.system('rm -rf ' + tmpd)
-        os.system('mkdir -p ' + tmpd)
-        potf = tmpd + 'testpot'
-        with open(potf, 'w') as outf:
-            outf.write('test potential sparse from:\n Mishin-Ni-Al-2009.eam.alloy\n Alloy\n 2 Ni Al\n 20 0.250661 20 0.31436 6.28721\n 28 58.71 3.52 fcc\n -0.0225464 -1.76636 -2.37638 -2.58753 -2.56335 \n -2.44363 -2.1936 -1.69669 -0.881535 0.259267 \n 1.71214 3.47279 5.52768 7.84679 10.3946 \n 13.1387 16.0533 19.12 22.3271 25.6681 \n 0.166428 0.170459 0.167088 0.158941 0.148264 \n 0.134559 0.116655 0.0950843 0.0717676 0.0494264 \n 0.0305923 0.0166948 0.00778478 0.00291687 0.00076581 \n 9.6658e-05 8.84137e-07 0 0 0 \n 13 26.982 4.05 fcc\n -4.3767e-11 -1.6886 -2.24356 -2.61981 -2.8881 \n -3.03673 -3.07531 -3.14579 -3.15517 -3.04228 \n -2.80696 -2.44921 -1.96903 -1.36641 -0.641356 \n 0.206131 1.17605 2.2684 3.48319 4.82042 \n 0.396504 0.268377 0.182302 0.130397 0.104787 \n 0.09764 0.10114 0.10747 0.108814 0.097359 \n 0.0701286 0.0394937 0.0192524 0.00952344 0.00538008 \n 0.00357488 0.0027837 0.00202854 0.0010566 9.93586e-05 \n 0 1.45214 3.46822 4.73416 4.63266 \n 3.27018 1.42217 0.00246105 -0.578463 -0.528943 \n -0.314831 -0.217411 -0.216257 -0.18649 -0.098564 \n -0.021759 -0.000310685 0 0 0 \n 0 2016.46 1530.29 608.866 120.656 \n 8.56573 1.68568 0.0591469 -0.564815 -0.587964 \n -0.416922 -0.286477 -0.251829 -0.249993 -0.216214 \n -0.137026 -0.0706754 -0.0262716 -1.62953e-08 0 \n 0 10.7294 10.5529 7.42998 5.15814 \n 4.13394 3.26306 1.83395 0.548762 0.044061 \n -0.0987007 -0.134826 -0.151869 -0.205764 -0.215437 \n -0.169569 -0.0703696 0.0113375 0.0283944 0.00186361 \n')
+        remove_potential(tmpd)
+        write_potential(tmpd + 'testpot')
 
     # API test: class initialization
     def test_API(self):
@@ -69,11 +79,100 @@ class eam_tests(unittest.TestCase):
         numpy.testing.assert_allclose(F, F_ref, rtol=1e-5)
         numpy.testing.assert_allclose(U, U_ref, rtol=1e-6)
 
-        os.system('rm -rf ' + tmpd)
+        remove_potential(tmpd)
+
+    # Unit test: the serial half neighbor list path gives the same forces and energies
+    @unittest.skipIf(context.exec_conf.isCUDAEnabled(), "the GPU requires a full neighbor list")
+    def test_force_half_nlist(self):
+        cwd = os.getcwd()
+        tmpd = cwd + '/eamtemp/'
+        potf = tmpd + 'testpot'
+        nl = md.nlist.cell()
+        eam = metal.pair.eam(file=potf, type="Alloy", nlist=nl)
+        nl.cpp_nlist.setStorageMode(md._md.NeighborList.storageMode.half)
+        all = group.all()
+        md.integrate.mode_standard(dt=0.2)
+        md.integrate.nve(group=all)
+        run(1)
+
+        F = numpy.array([x.force for x in eam.forces])
+        U = numpy.array([x.energy for x in eam.forces])
+
+        F_ref = numpy.array([[0.49554526, 1.10342697, -2.7692858],
+                             [0.70281927, -1.43558566, 3.87260803],
+                             [-2.00473055, 1.53052375, -0.60778632],
+                             [0.80636601, -1.19836506, -0.49553591]])
+        U_ref = numpy.array([-0.93424631, -1.23440579, -1.71025268, -1.4023109])
+
+        numpy.testing.assert_allclose(F, F_ref, rtol=1e-5)
+        numpy.testing.assert_allclose(U, U_ref, rtol=1e-6)
+
+        remove_potential(tmpd)
 
     # tearDown is called at the end of every test method
     def tearDown(self):
         context.initialize()
 
+# EAM across domain boundaries, the ctest suite also runs this file on eight ranks
+class eam_decomposition_tests(unittest.TestCase):
+    # two clusters of eight particles each, centered on the corner shared by all domains of a 2x2x2 decomposition
+    # and on the corner of the periodic box, so that every neighbor of a particle is owned by another rank
+    def setUp(self):
+        snapshot = data.make_snapshot(N=16, box=data.boxdim(L=14.4), particle_types=['Al', 'Ni'])
+        if comm.get_rank() == 0:
+            snapshot.particles.position[:] = [[-1.47, -1.19, -1.32], [-1.21, -1.11, 1.32],
+                                              [-1.3, 1.13, -1.39], [-1.3, 1.37, 1.42],
+                                              [1.25, -1.47, -1.38], [1.46, -1.41, 1.28],
+                                              [1.47, 1.11, -1.26], [1.48, 1.19, 1.32],
+                                              [6.06, 5.75, 5.91], [6.0, 5.97, -5.91],
+                                              [5.78, -5.9, 5.85], [5.89, -5.95, -5.76],
+                                              [-5.79, 5.83, 5.93], [-5.99, 5.88, -5.96],
+                                              [-5.84, -5.95, 5.88], [-5.81, -5.93, -5.74]]
+            snapshot.particles.typeid[:] = [0, 1] * 8
+            snapshot.particles.mass[:] = [26.982, 58.710] * 8
+        init.read_snapshot(snapshot)
+
+        self.tmpd = os.getcwd() + '/eamtemp/'
+        remove_potential(self.tmpd)
+        write_potential(self.tmpd + 'testpot')
+
+    # Unit test: the forces and energies on any number of ranks match the single rank reference
+    def test_force(self):
+        nl = md.nlist.cell()
+        eam = metal.pair.eam(file=self.tmpd + 'testpot', type="Alloy", nlist=nl)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+        run(0)
+
+        F = numpy.array([x.force for x in eam.forces])
+        U = numpy.array([x.energy for x in eam.forces])
+
+        F_ref = numpy.array([[0.13964868, -1.72682224, 0.82696235],
+                             [1.06654839, 0.63627481, -0.95013787],
+                             [0.5578591, 1.65993254, 1.11632025],
+                             [1.13781746, -0.76657415, -1.12786424],
+                             [-0.33092185, -0.23434277, 0.81017859],
+                             [-1.01398145, 1.14939799, -0.84643177],
+                             [-0.31172212, 0.24688421, 0.74093854],
+                             [-1.2452482, -0.9647504, -0.56996585],
+                             [-0.40231997, 0.38542183, 0.71791401],
+                             [0.3185929, 0.6360497, -0.64222298],
+                             [0.34904312, -0.33456324, 1.05747641],
+                             [1.12646858, -0.58195856, -1.05021268],
+                             [0.58632115, -0.2019403, 0.46034948],
+                             [-0.37206534, 0.95248806, -0.53658243],
+                             [-0.45155687, 0.09585588, 1.04960363],
+                             [-1.15448356, -0.95135337, -1.05632544]])
+        U_ref = numpy.array([-1.82562801, -2.49595576, -1.82256545, -2.26784177, -2.04260933, -2.36259845,
+                             -2.06939061, -2.32388713, -2.06355848, -2.50655318, -1.99997225, -2.33384662,
+                             -2.00473493, -2.53379658, -2.02940505, -2.29879947])
+
+        numpy.testing.assert_allclose(F, F_ref, rtol=1e-5, atol=1e-5)
+        numpy.testing.assert_allclose(U, U_ref, rtol=1e-6)
+
+    def tearDown(self):
+        remove_potential(self.tmpd)
+        context.initialize()
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
\ No newline at end of file
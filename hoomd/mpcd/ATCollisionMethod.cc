@@ -41,13 +41,24 @@ mpcd::ATCollisionMethod::~ATCollisionMethod()
  */
 void mpcd::ATCollisionMethod::rule(unsigned int timestep)
     {
+    // the embedded particles get their own array for the random velocities, because the alternate arrays of the
+    // particle data are not allocated with in-place permutation
+    if (m_embed_group && m_embed_vel_alt.getNumElements() < m_pdata->getMaxN())
+        {
+        GlobalArray<Scalar4> embed_vel_alt(m_pdata->getMaxN(), m_exec_conf);
+        m_embed_vel_alt.swap(embed_vel_alt);
+        TAG_ALLOCATION(m_embed_vel_alt);
+        }
+
     m_thermo->compute(timestep);
 
     if (m_prof) m_prof->push("MPCD collide");
     // compute the cell average of the random velocities
-    m_pdata->swapVelocities(); m_mpcd_pdata->swapVelocities();
+    if (m_embed_group) m_pdata->swapVelocities(m_embed_vel_alt);
+    m_mpcd_pdata->swapVelocities();
     m_rand_thermo->compute(timestep);
-    m_pdata->swapVelocities(); m_mpcd_pdata->swapVelocities();
+    if (m_embed_group) m_pdata->swapVelocities(m_embed_vel_alt);
+    m_mpcd_pdata->swapVelocities();
 
     if (m_prof) m_prof->push(m_exec_conf, "apply");
     // apply random velocities
@@ -77,7 +88,7 @@ void mpcd::ATCollisionMethod::drawVelocities(unsigned int timestep)
         {
         h_embed_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(), access_location::host, access_mode::read));
         h_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(), access_location::host, access_mode::read));
-        h_alt_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getAltVelocities(), access_location::host, access_mode::overwrite));
+        h_alt_vel_embed.reset(new ArrayHandle<Scalar4>(m_embed_vel_alt, access_location::host, access_mode::overwrite));
         h_tag_embed.reset(new ArrayHandle<unsigned int>(m_pdata->getTags(), access_location::host, access_mode::read));
         N_tot += m_embed_group->getNumMembers();
         }
@@ -137,7 +148,7 @@ void mpcd::ATCollisionMethod::applyVelocities()
         {
         h_embed_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(), access_location::host, access_mode::read));
         h_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(), access_location::host, access_mode::readwrite));
-        h_vel_alt_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getAltVelocities(), access_location::host, access_mode::read));
+        h_vel_alt_embed.reset(new ArrayHandle<Scalar4>(m_embed_vel_alt, access_location::host, access_mode::read));
         h_embed_cell_ids.reset(new ArrayHandle<unsigned int>(m_cl->getEmbeddedGroupCellIds(), access_location::host, access_mode::read));
         N_tot += m_embed_group->getNumMembers();
         }
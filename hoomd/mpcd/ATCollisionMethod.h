@@ -50,6 +50,7 @@ class PYBIND11_EXPORT ATCollisionMethod : public mpcd::CollisionMethod
         std::shared_ptr<mpcd::CellThermoCompute> m_thermo;      //!< Cell thermo
         std::shared_ptr<mpcd::CellThermoCompute> m_rand_thermo; //!< Cell thermo for random velocities
         std::shared_ptr<::Variant> m_T; //!< Temperature for thermostat
+        GlobalArray<Scalar4> m_embed_vel_alt;   //!< Random velocities of the embedded particles
 
         //! Implementation of the collision rule
         virtual void rule(unsigned int timestep);
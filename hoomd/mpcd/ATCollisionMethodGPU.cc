@@ -40,7 +40,7 @@ void mpcd::ATCollisionMethodGPU::drawVelocities(unsigned int timestep)
         {
         ArrayHandle<unsigned int> d_embed_idx(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
         ArrayHandle<Scalar4> d_vel_embed(m_pdata->getVelocities(), access_location::device, access_mode::read);
-        ArrayHandle<Scalar4> d_alt_vel_embed(m_pdata->getAltVelocities(), access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_alt_vel_embed(m_embed_vel_alt, access_location::device, access_mode::overwrite);
         ArrayHandle<unsigned int> d_tag_embed(m_pdata->getTags(), access_location::device, access_mode::read);
         N_tot += m_embed_group->getNumMembers();
 
@@ -98,7 +98,7 @@ void mpcd::ATCollisionMethodGPU::applyVelocities()
         {
         ArrayHandle<unsigned int> d_embed_idx(m_embed_group->getIndexArray(), access_location::device, access_mode::read);
         ArrayHandle<Scalar4> d_vel_embed(m_pdata->getVelocities(), access_location::device, access_mode::readwrite);
-        ArrayHandle<Scalar4> d_vel_alt_embed(m_pdata->getAltVelocities(), access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_vel_alt_embed(m_embed_vel_alt, access_location::device, access_mode::read);
         ArrayHandle<unsigned int> d_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(), access_location::device, access_mode::read);
         N_tot += m_embed_group->getNumMembers();
 
@@ -48,6 +48,12 @@ mpcd::Communicator::Communicator(std::shared_ptr<mpcd::SystemData> system_data)
 
     m_exec_conf->msg->notice(5) << "Constructing MPCD Communicator" << endl;
 
+    if (m_decomposition->isStaggered())
+        {
+        m_exec_conf->msg->error() << "MPCD: staggered domain decompositions are not supported" << endl;
+        throw std::runtime_error("Error initializing MPCD communicator");
+        }
+
     // allocate memory
     GPUArray<unsigned int> neighbors(neigh_max,m_exec_conf);
     m_neighbors.swap(neighbors);
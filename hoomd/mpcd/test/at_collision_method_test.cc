@@ -104,8 +104,12 @@ void at_collision_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec
     }
 
 //! Test that embedding a particle produces valid values (not a rigorous test of physics of embedding)
+/*!
+ * \param exec_conf Execution configuration
+ * \param in_place If true, the particle data does not allocate its alternate arrays
+ */
 template<class CM>
-void at_collision_method_embed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+void at_collision_method_embed_test(std::shared_ptr<ExecutionConfiguration> exec_conf, bool in_place=false)
     {
     std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
     snap->global_box = BoxDim(2.0);
@@ -118,6 +122,8 @@ void at_collision_method_embed_test(std::shared_ptr<ExecutionConfiguration> exec
         pdata_snap.mass[0] = 2.0;
         }
     std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    if (in_place)
+        sysdef->getParticleData()->setInPlacePermutation(true);
 
     // 4 particle system
     auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
@@ -186,6 +192,11 @@ UP_TEST( at_collision_method_embed )
     {
     at_collision_method_embed_test<mpcd::ATCollisionMethod>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+//! test embedding of particles into the MPCD ATCollisionMethod class without the alternate particle data arrays
+UP_TEST( at_collision_method_embed_in_place )
+    {
+    at_collision_method_embed_test<mpcd::ATCollisionMethod>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU), true);
+    }
 #ifdef ENABLE_CUDA
 //! basic test case for MPCD ATCollisionMethodGPU class
 UP_TEST( at_collision_method_basic_gpu )
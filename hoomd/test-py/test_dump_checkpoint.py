@@ -0,0 +1,94 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+import hoomd;
+import unittest
+import os
+import glob
+import numpy
+import tempfile
+
+# unit tests for dump.checkpoint and init.read_checkpoint
+class checkpoint_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+        if comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.ckpt');
+            os.close(tmp[0]);
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+        self.snapshot = data.make_snapshot(N=4, box=data.boxdim(L=10), dtype='float');
+        if comm.get_rank() == 0:
+            self.snapshot.particles.types = ['p1', 'p2'];
+            self.snapshot.particles.position[:] = [[0,1,2], [1,2,3], [0,-1,-2], [-1,-2,-3]];
+            self.snapshot.particles.velocity[:] = [[10,11,12], [11,12,13], [12,13,14], [13,14,15]];
+            self.snapshot.particles.typeid[:] = [0,0,1,1];
+            self.snapshot.particles.mass[:] = [33, 34, 35, 36];
+            self.snapshot.particles.charge[:] = [44, 45, 46, 47];
+            self.snapshot.particles.image[:] = [[60,61,62], [61,62,63], [62,63,64], [63,64,65]];
+
+            self.snapshot.bonds.types = ['b1', 'b2'];
+            self.snapshot.bonds.resize(2);
+            self.snapshot.bonds.typeid[:] = [0, 1];
+            self.snapshot.bonds.group[0] = [0, 1];
+            self.snapshot.bonds.group[1] = [2, 3];
+
+            self.snapshot.angles.types = ['a1'];
+            self.snapshot.angles.resize(1);
+            self.snapshot.angles.typeid[:] = [0];
+            self.snapshot.angles.group[0] = [0, 1, 2];
+
+        self.s = init.read_snapshot(self.snapshot);
+
+    # tests that a checkpoint restores the system and the time step
+    def test_restart(self):
+        ckpt = dump.checkpoint(filename=self.tmp_file, period=10);
+        run(10);
+        context.initialize();
+
+        s = init.read_checkpoint(self.tmp_file);
+        self.assertEqual(get_step(), 10);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            self.assertEqual(snap.bonds.types, self.snapshot.bonds.types);
+            numpy.testing.assert_array_equal(snap.bonds.typeid, self.snapshot.bonds.typeid);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            self.assertEqual(snap.angles.N, self.snapshot.angles.N);
+            numpy.testing.assert_array_equal(snap.angles.group, self.snapshot.angles.group);
+
+    # tests that the tags of removed particles stay free
+    def test_tags(self):
+        self.s.bonds.remove(1);
+        self.s.angles.remove(0);
+        self.s.particles.remove(2);
+        dump.checkpoint(filename=self.tmp_file, period=None);
+        context.initialize();
+
+        s = init.read_checkpoint(self.tmp_file);
+        self.assertEqual(len(s.particles), 3);
+        self.assertEqual(len(s.bonds), 1);
+        tags = [p.tag for p in s.particles];
+        self.assertEqual(tags, [0, 1, 3]);
+        self.assertEqual(s.particles.add('p1'), 2);
+
+    def tearDown(self):
+        comm.barrier_all();
+        if comm.get_rank() == 0:
+            for f in glob.glob(self.tmp_file + '*'):
+                os.remove(f);
+        comm.barrier_all();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -123,6 +123,14 @@ class gsd_write_tests (unittest.TestCase):
         if comm.get_rank() == 0:
             self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=1);
 
+    # tests asynchronous writes
+    def test_async(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, async_write=True, max_queue=1);
+        run(5);
+        data.gsd_snapshot(self.tmp_file, frame=4);
+        if comm.get_rank() == 0:
+            self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=5);
+
     # tests write_restart
     def test_write_restart(self):
         g = dump.gsd(filename=self.tmp_file, group=group.all(), period=1000000, truncate=True, overwrite=True);
@@ -438,6 +446,33 @@ class gsd_read_tests (unittest.TestCase):
             numpy.testing.assert_array_equal(snap.pairs.group, self.snapshot.pairs.group);
 
 
+    # test writing per-particle data from all ranks
+    def test_parallel_io(self):
+        # remove a particle so that the rows in the file do not match the tags
+        self.s.particles.remove(1)
+        self.snapshot = self.s.take_snapshot(all=True)
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True, parallel_io=True, aggregators=1);
+
+        snap = data.gsd_snapshot(self.tmp_file, frame=0);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+
     # tests init.read_gsd
     def test_read_gsd(self):
         dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
@@ -445,6 +480,27 @@ class gsd_read_tests (unittest.TestCase):
 
         init.read_gsd(filename=self.tmp_file, frame=-1);
 
+    # tests init.read_gsd with every rank reading a part of the file
+    def test_read_gsd_parallel_io(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+        context.initialize();
+
+        s = init.read_gsd(filename=self.tmp_file, parallel_io=True);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            numpy.testing.assert_array_equal(snap.bonds.typeid, self.snapshot.bonds.typeid);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+            self.assertEqual(snap.angles.N, self.snapshot.angles.N);
+            numpy.testing.assert_array_equal(snap.angles.group, self.snapshot.angles.group);
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove(self.tmp_file);
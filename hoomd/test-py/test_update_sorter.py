@@ -6,18 +6,86 @@ import hoomd;
 context.initialize()
 import unittest
 import os
+import numpy
 
 # tests for update.sorter
 class update_sorter_tests (unittest.TestCase):
     def setUp(self):
         print
-        init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
 
     # test set_params
     def test_set_params(self):
 
         context.current.sorter.set_params(grid=20);
 
+    # test that in-place permutation keeps the particle data of every tag
+    @unittest.skipIf(context.exec_conf.isCUDAEnabled(), "in-place permutation is not supported on the GPU")
+    def test_in_place(self):
+        # shuffle the particles so that the sort has to move them
+        snap = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            perm = numpy.random.RandomState(12).permutation(snap.particles.N)
+            snap.particles.position[:] = snap.particles.position[perm]
+            snap.particles.velocity[:] = numpy.arange(snap.particles.N*3).reshape((snap.particles.N,3))
+        self.s.restore_snapshot(snap)
+
+        context.current.sorter.set_params(in_place=True)
+        context.current.sorter.set_period(1)
+        run(2)
+
+        snap2 = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            numpy.testing.assert_array_equal(snap.particles.position, snap2.particles.position)
+            numpy.testing.assert_array_equal(snap.particles.velocity, snap2.particles.velocity)
+
+        context.current.sorter.set_params(in_place=False)
+        run(2)
+
+    # test that particles migrating between ranks keep their data with in-place permutation
+    @unittest.skipIf(context.exec_conf.isCUDAEnabled(), "in-place permutation is not supported on the GPU")
+    def test_in_place_migrate(self):
+        context.initialize()
+        comm.decomposition(nx=2, ny=1, nz=1)
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]);
+        context.current.sorter.set_params(in_place=True)
+        context.current.sorter.set_period(1)
+
+        # give every tag distinct data
+        snap = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            N = snap.particles.N
+            snap.particles.velocity[:] = numpy.arange(N*3).reshape((N,3))
+            snap.particles.mass[:] = 1.0 + 0.01*numpy.arange(N)
+            snap.particles.charge[:] = numpy.arange(N)
+            snap.particles.diameter[:] = 1.0 + 0.001*numpy.arange(N)
+        self.s.restore_snapshot(snap)
+
+        # move all particles into the lower half of the box, so that they migrate to one rank
+        N_local = self.s.sysdef.getParticleData().getN()
+        Lx = self.s.box.Lx
+        for p in self.s.particles:
+            x, y, z = p.position
+            p.position = ((x - 0.5*Lx)/2, y, z)
+
+        if comm.get_num_ranks() > 1:
+            self.assertNotEqual(self.s.sysdef.getParticleData().getN(), N_local)
+
+        # the load balancer moves the domain boundary, and the particles migrate back during the run
+        update.balance(period=1)
+        run(5)
+
+        snap2 = self.s.take_snapshot()
+        if comm.get_rank() == 0:
+            expected = numpy.array(snap.particles.position)
+            expected[:,0] = (expected[:,0] - 0.5*Lx)/2
+            numpy.testing.assert_allclose(snap2.particles.position, expected, rtol=1e-6, atol=1e-6)
+            numpy.testing.assert_array_equal(snap.particles.velocity, snap2.particles.velocity)
+            numpy.testing.assert_array_equal(snap.particles.mass, snap2.particles.mass)
+            numpy.testing.assert_array_equal(snap.particles.charge, snap2.particles.charge)
+            numpy.testing.assert_array_equal(snap.particles.diameter, snap2.particles.diameter)
+            numpy.testing.assert_array_equal(snap.particles.image, snap2.particles.image)
+
     def tearDown(self):
         context.initialize();
 
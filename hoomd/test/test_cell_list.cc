@@ -582,3 +582,97 @@ UP_TEST( CellListGPU_large )
     celllist_large_test<CellListGPU>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//! Validate that the compact cell list holds the same members as the padded one
+void celllist_compact_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // a dense cluster in a dilute vapor
+    unsigned int N = 2000;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(40.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        if (i % 2 == 0)
+            {
+            // spread over the whole box
+            h_pos.data[i].x = Scalar(-19.9) + Scalar(39.8) * Scalar((i * 37) % 101) / Scalar(101.0);
+            h_pos.data[i].y = Scalar(-19.9) + Scalar(39.8) * Scalar((i * 53) % 103) / Scalar(103.0);
+            h_pos.data[i].z = Scalar(-19.9) + Scalar(39.8) * Scalar((i * 71) % 107) / Scalar(107.0);
+            }
+        else
+            {
+            // inside a single cell
+            h_pos.data[i].x = Scalar(0.1) + Scalar(2.8) * Scalar((i * 37) % 101) / Scalar(101.0);
+            h_pos.data[i].y = Scalar(0.1) + Scalar(2.8) * Scalar((i * 53) % 103) / Scalar(103.0);
+            h_pos.data[i].z = Scalar(0.1) + Scalar(2.8) * Scalar((i * 71) % 107) / Scalar(107.0);
+            }
+        h_pos.data[i].w = 0.0;
+        }
+    pdata->notifyParticleSort();
+    }
+
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setNominalWidth(Scalar(4.0));
+    cl->setFlagIndex();
+    cl->compute(0);
+
+    std::shared_ptr<CellList> cl_compact(new CellList(sysdef));
+    cl_compact->setNominalWidth(Scalar(4.0));
+    cl_compact->setFlagIndex();
+    cl_compact->setCompact(true);
+    cl_compact->compute(0);
+
+    UP_ASSERT(cl_compact->getCompact());
+    bool thrown = false;
+    try
+        {
+        cl_compact->getCellListIndexer();
+        }
+    catch (std::runtime_error&)
+        {
+        thrown = true;
+        }
+    UP_ASSERT(thrown);
+
+    // the compact cell list only needs one entry per particle
+    UP_ASSERT(cl_compact->getXYZFArray().getNumElements() < cl->getXYZFArray().getNumElements());
+    UP_ASSERT(cl_compact->getXYZFArray().getNumElements() >= N);
+    CHECK_EQUAL_UINT(cl_compact->getNmax(), cl->getNmax());
+
+    ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start(cl->getCellStartArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size_compact(cl_compact->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start_compact(cl_compact->getCellStartArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf_compact(cl_compact->getXYZFArray(), access_location::host, access_mode::read);
+
+    Index2D cli = cl->getCellListIndexer();
+    unsigned int ncell = cl->getCellIndexer().getNumElements();
+    CHECK_EQUAL_UINT(h_cell_start_compact.data[0], 0);
+    CHECK_EQUAL_UINT(h_cell_start_compact.data[ncell], N);
+
+    for (unsigned int cell = 0; cell < ncell; cell++)
+        {
+        CHECK_EQUAL_UINT(h_cell_size_compact.data[cell], h_cell_size.data[cell]);
+        CHECK_EQUAL_UINT(h_cell_start_compact.data[cell+1] - h_cell_start_compact.data[cell], h_cell_size.data[cell]);
+        CHECK_EQUAL_UINT(h_cell_start.data[cell], cli(0, cell));
+
+        // both layouts list the members in the order of the particle index
+        for (unsigned int offset = 0; offset < h_cell_size.data[cell]; offset++)
+            {
+            Scalar4 xyzf = h_xyzf.data[h_cell_start.data[cell] + offset];
+            Scalar4 xyzf_compact = h_xyzf_compact.data[h_cell_start_compact.data[cell] + offset];
+            CHECK_EQUAL_UINT(__scalar_as_int(xyzf_compact.w), __scalar_as_int(xyzf.w));
+            MY_CHECK_CLOSE(xyzf_compact.x, xyzf.x, tol);
+            }
+        }
+    }
+
+//! test case for celllist_compact_test
+UP_TEST( CellList_compact )
+    {
+    celllist_compact_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
@@ -0,0 +1,279 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifdef ENABLE_MPI
+
+// this has to be included after naming the test module
+#include "upp11_config.h"
+HOOMD_UP_MAIN();
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/SystemDefinition.h"
+#include "hoomd/CheckpointWriter.h"
+#include "hoomd/CheckpointReader.h"
+
+#include <memory>
+#include <cstdio>
+
+using namespace std;
+
+//! Name of the checkpoint written by the tests
+static const std::string ckpt_fname("test_checkpoint.ckpt");
+
+//! Reference position of the particle with the given tag
+static Scalar3 ref_position(unsigned int tag)
+    {
+    return make_scalar3(Scalar(-1.75) + Scalar(0.5)*(tag % 8),
+                        Scalar(1.25) - Scalar(0.5)*((tag / 8) % 6),
+                        Scalar(-0.25) + Scalar(0.5)*(tag % 3) * ((tag % 2) ? 1 : -1));
+    }
+
+//! Write a checkpoint of N particles, N/2 bonds and N/3 angles on all ranks of the world communicator
+/*! Bond 5 and angle 2 are removed before writing, so their tags are free.
+    \returns the system that was written
+*/
+static std::shared_ptr<SystemDefinition> write_checkpoint(std::shared_ptr<ExecutionConfiguration> exec_conf,
+    unsigned int N)
+    {
+    BoxDim box(4.0);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL(), 2, 2, 2));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(0, box, 2, 2, 1, 0, 0, exec_conf, decomposition));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    SnapshotParticleData<Scalar> snap(N);
+    snap.type_mapping.push_back("A");
+    snap.type_mapping.push_back("B");
+    for (unsigned int tag = 0; tag < N; ++tag)
+        {
+        snap.pos[tag] = vec3<Scalar>(ref_position(tag));
+        snap.vel[tag] = vec3<Scalar>(Scalar(tag), Scalar(2*tag), Scalar(3*tag));
+        snap.type[tag] = tag % 2;
+        snap.mass[tag] = Scalar(1.0) + tag;
+        snap.image[tag] = make_int3(tag, -int(tag), 1);
+        }
+    pdata->initializeFromSnapshot(snap);
+
+    // bond i joins particles 2i and 2i+1, angle i spans particles 3i to 3i+2
+    std::shared_ptr<BondData> bdata = sysdef->getBondData();
+    bdata->setTypeName(0, "backbone");
+    bdata->setTypeName(1, "side");
+    for (unsigned int i = 0; i < N/2; ++i)
+        bdata->addBondedGroup(Bond(i % 2, 2*i, 2*i+1));
+    bdata->removeBondedGroup(5);
+
+    std::shared_ptr<AngleData> adata = sysdef->getAngleData();
+    adata->setTypeName(0, "bend");
+    for (unsigned int i = 0; i < N/3; ++i)
+        adata->addBondedGroup(Angle(0, 3*i, 3*i+1, 3*i+2));
+    adata->removeBondedGroup(2);
+
+    std::shared_ptr<CheckpointWriter> writer(new CheckpointWriter(sysdef, ckpt_fname));
+    writer->analyze(10);
+    return sysdef;
+    }
+
+//! Check the tags, types and members of the bonds and angles written by write_checkpoint()
+static void check_bonded_groups(std::shared_ptr<SystemDefinition> sysdef, unsigned int N)
+    {
+    std::shared_ptr<BondData> bdata = sysdef->getBondData();
+    UP_ASSERT_EQUAL(bdata->getNGlobal(), N/2 - 1);
+    UP_ASSERT_EQUAL(bdata->getNameByType(0), std::string("backbone"));
+    UP_ASSERT_EQUAL(bdata->getNameByType(1), std::string("side"));
+    for (unsigned int n = 0; n < bdata->getNGlobal(); ++n)
+        {
+        unsigned int tag = bdata->getNthTag(n);
+        UP_ASSERT_EQUAL(tag, n < 5 ? n : n + 1);
+
+        Bond bond = bdata->getGroupByTag(tag);
+        UP_ASSERT_EQUAL(bond.type, tag % 2);
+        UP_ASSERT_EQUAL(bond.a, 2*tag);
+        UP_ASSERT_EQUAL(bond.b, 2*tag+1);
+        }
+
+    std::shared_ptr<AngleData> adata = sysdef->getAngleData();
+    UP_ASSERT_EQUAL(adata->getNGlobal(), N/3 - 1);
+    UP_ASSERT_EQUAL(adata->getNameByType(0), std::string("bend"));
+    for (unsigned int n = 0; n < adata->getNGlobal(); ++n)
+        {
+        unsigned int tag = adata->getNthTag(n);
+        UP_ASSERT_EQUAL(tag, n < 2 ? n : n + 1);
+
+        Angle angle = adata->getGroupByTag(tag);
+        UP_ASSERT_EQUAL(angle.type, (unsigned int)0);
+        UP_ASSERT_EQUAL(angle.a, 3*tag);
+        UP_ASSERT_EQUAL(angle.b, 3*tag+1);
+        UP_ASSERT_EQUAL(angle.c, 3*tag+2);
+        }
+
+    // the free tags are reused first
+    UP_ASSERT_EQUAL(bdata->addBondedGroup(Bond(0, 0, 2)), (unsigned int)5);
+    UP_ASSERT_EQUAL(adata->addBondedGroup(Angle(0, 0, 2, 4)), (unsigned int)2);
+    UP_ASSERT_EQUAL(bdata->getNGlobal(), N/2);
+    UP_ASSERT_EQUAL(adata->getNGlobal(), N/3);
+    }
+
+//! Restore the checkpoint on the ranks of the given communicator and check every particle
+/*! With the rank count of the checkpoint, the system is restored with the decomposition it was written with.
+    \returns the restored system
+*/
+static std::shared_ptr<SystemDefinition> read_checkpoint(MPI_Comm comm, unsigned int N)
+    {
+    std::shared_ptr<MPIConfiguration> mpi_conf(new MPIConfiguration(comm));
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+        std::vector<int>(), false, false, mpi_conf));
+
+    CheckpointReader reader(exec_conf, ckpt_fname);
+    UP_ASSERT_EQUAL(reader.getNRanks(), (unsigned int)8);
+    UP_ASSERT_EQUAL(reader.getTimeStep(), (uint64_t)10);
+    UP_ASSERT_EQUAL(reader.getNumParticleTypes(), (unsigned int)2);
+
+    BoxDim box = reader.getBox();
+    bool same_ranks = exec_conf->getNRanks() == reader.getNRanks();
+    std::shared_ptr<DomainDecomposition> decomposition;
+    if (same_ranks)
+        decomposition = reader.getDomainDecomposition();
+    else if (exec_conf->getNRanks() > 1)
+        decomposition = std::shared_ptr<DomainDecomposition>(new DomainDecomposition(exec_conf, box.getL()));
+
+    std::shared_ptr<SystemDefinition> sysdef;
+    if (decomposition)
+        sysdef = std::shared_ptr<SystemDefinition>(new SystemDefinition(0, box, reader.getNumParticleTypes(),
+            0, 0, 0, 0, exec_conf, decomposition));
+    else
+        sysdef = std::shared_ptr<SystemDefinition>(new SystemDefinition(0, box, reader.getNumParticleTypes(),
+            0, 0, 0, 0, exec_conf));
+    reader.restore(sysdef);
+    UP_ASSERT_EQUAL(reader.restoredInPlace(), same_ranks);
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    UP_ASSERT_EQUAL(pdata->getNGlobal(), N);
+
+    // every particle is owned by the rank of its domain
+    unsigned int N_local = pdata->getN();
+    MPI_Allreduce(MPI_IN_PLACE, &N_local, 1, MPI_UNSIGNED, MPI_SUM, comm);
+    UP_ASSERT_EQUAL(N_local, N);
+
+    SnapshotParticleData<Scalar> snap;
+    pdata->takeSnapshot(snap);
+
+    if (exec_conf->isRoot())
+        {
+        UP_ASSERT_EQUAL(snap.size, N);
+        UP_ASSERT_EQUAL(snap.type_mapping[0], std::string("A"));
+        UP_ASSERT_EQUAL(snap.type_mapping[1], std::string("B"));
+        for (unsigned int tag = 0; tag < N; ++tag)
+            {
+            Scalar3 pos = ref_position(tag);
+            MY_CHECK_CLOSE(snap.pos[tag].x, pos.x, tol);
+            MY_CHECK_CLOSE(snap.pos[tag].y, pos.y, tol);
+            MY_CHECK_CLOSE(snap.pos[tag].z, pos.z, tol);
+            MY_CHECK_CLOSE(snap.vel[tag].y, Scalar(2*tag), tol);
+            UP_ASSERT_EQUAL(snap.type[tag], tag % 2);
+            MY_CHECK_CLOSE(snap.mass[tag], Scalar(1.0) + tag, tol);
+            UP_ASSERT_EQUAL(snap.image[tag].x, (int)tag);
+            UP_ASSERT_EQUAL(snap.image[tag].y, -(int)tag);
+            }
+        }
+
+    return sysdef;
+    }
+
+//! Remove the manifest and all shards of the checkpoint
+static void remove_checkpoint(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    MPI_Barrier(exec_conf->getHOOMDWorldMPICommunicator());
+    if (exec_conf->isRoot())
+        {
+        std::remove(ckpt_fname.c_str());
+        for (unsigned int shard = 0; shard < 8; ++shard)
+            std::remove(getCheckpointShardName(ckpt_fname, shard).c_str());
+        }
+    MPI_Barrier(exec_conf->getHOOMDWorldMPICommunicator());
+    }
+
+//! Tests restarting a checkpoint on the ranks and the decomposition it was written with
+UP_TEST( checkpoint_restart_same_decomposition )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    std::vector<unsigned int> written_tags;
+        {
+        std::shared_ptr<SystemDefinition> sysdef = write_checkpoint(exec_conf, 48);
+        std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        written_tags.assign(h_tag.data, h_tag.data + pdata->getN());
+        }
+
+    std::shared_ptr<SystemDefinition> sysdef = read_checkpoint(exec_conf->getHOOMDWorldMPICommunicator(), 48);
+
+    // every rank holds the particles it wrote, in the same order
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    UP_ASSERT_EQUAL(pdata->getN(), (unsigned int)written_tags.size());
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+            UP_ASSERT_EQUAL(h_tag.data[idx], written_tags[idx]);
+        }
+
+    check_bonded_groups(sysdef, 48);
+
+    remove_checkpoint(exec_conf);
+    }
+
+//! Tests restarting bonds and angles on a different number of ranks
+UP_TEST( checkpoint_restart_bonded_groups )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    write_checkpoint(exec_conf, 48);
+
+    // the groups are sent to the owners of their members on four ranks
+    MPI_Comm comm;
+    MPI_Comm_split(exec_conf->getHOOMDWorldMPICommunicator(), exec_conf->getRank() / 4, exec_conf->getRank(), &comm);
+    check_bonded_groups(read_checkpoint(comm, 48), 48);
+    MPI_Comm_free(&comm);
+
+    remove_checkpoint(exec_conf);
+    }
+
+//! Tests restarting a checkpoint written on eight ranks on four ranks
+UP_TEST( checkpoint_restart_fewer_ranks )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    write_checkpoint(exec_conf, 48);
+
+    // split the world into two groups of four ranks, each restarting the same checkpoint
+    MPI_Comm comm;
+    MPI_Comm_split(exec_conf->getHOOMDWorldMPICommunicator(), exec_conf->getRank() / 4, exec_conf->getRank(), &comm);
+    read_checkpoint(comm, 48);
+    MPI_Comm_free(&comm);
+
+    remove_checkpoint(exec_conf);
+    }
+
+//! Tests restarting a checkpoint written on eight ranks on a single rank
+UP_TEST( checkpoint_restart_single_rank )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    write_checkpoint(exec_conf, 48);
+
+    // every rank restarts the checkpoint on its own
+    read_checkpoint(MPI_COMM_SELF, 48);
+
+    remove_checkpoint(exec_conf);
+    }
+
+#endif // ENABLE_MPI
@@ -352,3 +352,94 @@ UP_TEST( GPUVector_basic_tests )
     UP_ASSERT_EQUAL((unsigned int)vec[9], (unsigned int)890);
     }
 #endif
+
+//! Owns a tagged array for the memory accounting test
+class AccountingTestOwner
+    {
+    public:
+        //! Allocate and tag the array
+        AccountingTestOwner(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+            {
+            GlobalArray<int> data(100, exec_conf);
+            m_data.swap(data);
+            TAG_ALLOCATION(m_data);
+            }
+
+        GlobalArray<int> m_data;    //!< Tagged array
+    };
+
+//! Owns an array tagged with the name of the instance, like the force templates
+template<class T>
+class AccountingTestInstance
+    {
+    public:
+        //! Allocate and tag the array
+        AccountingTestInstance(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name)
+            {
+            GlobalArray<T> data(100, exec_conf);
+            m_data.swap(data);
+            TAG_ALLOCATION_INSTANCE(m_data, name);
+            }
+
+        GlobalArray<T> m_data;      //!< Tagged array
+    };
+
+//! Test if  str ends with  suffix
+static bool ends_with(const std::string& str, const std::string& suffix)
+    {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+//! test case for the accounting of allocated memory
+UP_TEST( GlobalArray_memory_accounting_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    MemoryAccounting& accounting = exec_conf->getMemoryAccounting();
+
+    size_t base = accounting.getAllocatedBytes();
+
+        {
+        // arrays are counted under their tag
+        GlobalArray<int> array_a(100, exec_conf, "array_a");
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes("array_a"), 100*sizeof(int));
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes(), base + 100*sizeof(int));
+
+        // resizing updates the count
+        array_a.resize(300);
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes("array_a"), 300*sizeof(int));
+
+        // retagging moves the allocation
+        array_a.setTag("array_b");
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes("array_a"), (size_t)0);
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes("array_b"), 300*sizeof(int));
+
+        // TAG_ALLOCATION prepends the owning class
+        AccountingTestOwner owner(exec_conf);
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes("AccountingTestOwner::m_data"), 100*sizeof(int));
+
+        // TAG_ALLOCATION_INSTANCE tells the instances of a template apart
+        AccountingTestInstance<int> instance_a(exec_conf, "a");
+        AccountingTestInstance<int> instance_b(exec_conf, "b");
+        UP_ASSERT(ends_with(instance_a.m_data.getTag(), "::m_data [a]"));
+        UP_ASSERT(ends_with(instance_b.m_data.getTag(), "::m_data [b]"));
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes(instance_a.m_data.getTag()), 100*sizeof(int));
+        UP_ASSERT_EQUAL(accounting.getAllocatedBytes(instance_b.m_data.getTag()), 100*sizeof(int));
+        }
+
+    // all memory is released
+    UP_ASSERT_EQUAL(accounting.getAllocatedBytes(), base);
+    UP_ASSERT(accounting.getPeakBytes() >= base + 600*sizeof(int));
+
+    // GPUVector grows by less than the default factor close to the budget
+    UP_ASSERT_EQUAL(accounting.getGrowthFactor(2.0f), 2.0f);
+    accounting.setBudget(1);
+        {
+        GlobalVector<int> vec(exec_conf);
+        for (unsigned int i = 0; i < 1000; i++)
+            vec.push_back(i);
+        UP_ASSERT(accounting.getGrowthFactor(2.0f) < 1.1f);
+        UP_ASSERT(vec.getNumElements() <= 1000 + 1000/64 + 1);
+        }
+    accounting.setBudget(0);
+    UP_ASSERT_EQUAL(accounting.getGrowthFactor(2.0f), 2.0f);
+    }
@@ -359,6 +359,90 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,0,1));
     }
 
+template<class LB>
+void test_load_balancer_staggered(std::shared_ptr<ExecutionConfiguration> exec_conf, const BoxDim& dest_box)
+{
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // create a system with eight particles
+    BoxDim ref_box = BoxDim(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,           // number of particles
+                                                             dest_box,        // box dimensions
+                                                             1,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // the particles sit below the midplane for x < 0 and above it for x > 0
+    pdata->setPosition(0, TO_TRICLINIC(make_scalar3(-0.5,-0.5,-0.75)),false);
+    pdata->setPosition(1, TO_TRICLINIC(make_scalar3(-0.5,-0.5,-0.25)),false);
+    pdata->setPosition(2, TO_TRICLINIC(make_scalar3(-0.5,0.5,-0.75)),false);
+    pdata->setPosition(3, TO_TRICLINIC(make_scalar3(-0.5,0.5,-0.25)),false);
+    pdata->setPosition(4, TO_TRICLINIC(make_scalar3(0.5,-0.5,0.25)),false);
+    pdata->setPosition(5, TO_TRICLINIC(make_scalar3(0.5,-0.5,0.75)),false);
+    pdata->setPosition(6, TO_TRICLINIC(make_scalar3(0.5,0.5,0.25)),false);
+    pdata->setPosition(7, TO_TRICLINIC(make_scalar3(0.5,0.5,0.75)),false);
+
+    SnapshotParticleData<Scalar> snap(8);
+    pdata->takeSnapshot(snap);
+
+    // initialize a staggered 2x2x2 domain decomposition
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(), 2, 2, 2));
+    decomposition->setStaggered(true);
+    UP_ASSERT(decomposition->isStaggered());
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    std::shared_ptr<LoadBalancer> lb(new LB(sysdef,decomposition));
+    lb->setCommunicator(comm);
+    lb->setMaxIterations(2);
+
+    comm->migrateParticles();
+    const Index3D& di = decomposition->getDomainIndexer();
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(0), di(0,0,0));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(1), di(0,0,0));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(4), di(1,0,1));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(5), di(1,0,1));
+
+    // adjust the domain boundaries
+    for (unsigned int t=0; t < 10; ++t)
+        {
+        lb->update(t);
+        }
+
+    // each column moves its own cut plane, so that each rank owns one particle
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(0), di(0,0,0));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(1), di(0,0,1));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(2), di(0,1,0));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(3), di(0,1,1));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(4), di(1,0,0));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(5), di(1,0,1));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(6), di(1,1,0));
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,1,1));
+
+    UP_ASSERT(decomposition->getColumnCumulativeFraction(0,0,1) < Scalar(0.5));
+    UP_ASSERT(decomposition->getColumnCumulativeFraction(1,1,1) > Scalar(0.5));
+
+    // the x and y cut planes are shared by all columns
+    UP_ASSERT_CLOSE(decomposition->getCumulativeFraction(0,1), Scalar(0.5), Scalar(1e-6));
+    UP_ASSERT_CLOSE(decomposition->getCumulativeFraction(1,1), Scalar(0.5), Scalar(1e-6));
+
+    // move a particle diagonally into the neighboring column, it must land on the domain of that column holding it
+    pdata->setPosition(0, TO_TRICLINIC(make_scalar3(0.5,0.5,-0.75)),false);
+    comm->migrateParticles();
+    UP_ASSERT_EQUAL(pdata->getOwnerRank(0), di(1,1,0));
+    }
+
 //! Tests basic particle redistribution
 UP_TEST( LoadBalancer_test_basic)
     {
@@ -395,6 +479,16 @@ UP_TEST( LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0,-.6,.7,.5));
     }
 
+//! Tests per-column balancing of a staggered decomposition
+UP_TEST( LoadBalancer_test_staggered)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    // cubic box
+    test_load_balancer_staggered<LoadBalancer>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_staggered<LoadBalancer>(exec_conf, BoxDim(1.0,.1,.2,.3));
+    }
+
 #ifdef ENABLE_CUDA
 //! Tests basic particle redistribution on the GPU
 UP_TEST( LoadBalancerGPU_test_basic)
@@ -0,0 +1,144 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+
+#include "hoomd/CellList.h"
+#include "hoomd/SFCPackUpdater.h"
+
+#include "upp11_config.h"
+
+using namespace std;
+
+/*! \file test_sfc_pack_updater.cc
+    \brief Implements unit tests for SFCPackUpdater
+    \ingroup unit_tests
+*/
+HOOMD_UP_MAIN();
+
+//! Number of particle sorts seen by count_sort()
+static unsigned int n_sorts = 0;
+
+//! Counts the particle sort signals
+static void count_sort()
+    {
+    n_sorts++;
+    }
+
+//! Index of the cell of the cell list that the particle at local index idx lies in
+static unsigned int cell_of(std::shared_ptr<ParticleData> pdata, std::shared_ptr<CellList> cl, unsigned int idx)
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    const uint3 dim = cl->getDim();
+    Scalar3 f = pdata->getBox().makeFraction(make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z),
+                                             cl->getGhostWidth());
+    unsigned int ib = std::min((unsigned int)std::max(int(f.x * dim.x), 0), dim.x - 1);
+    unsigned int jb = std::min((unsigned int)std::max(int(f.y * dim.y), 0), dim.y - 1);
+    unsigned int kb = std::min((unsigned int)std::max(int(f.z * dim.z), 0), dim.z - 1);
+    return cl->getCellIndexer()(ib, jb, kb);
+    }
+
+//! Tests that the incremental sort puts the particles in cell order and keeps their data
+void sfcpack_incremental_test(std::shared_ptr<ExecutionConfiguration> exec_conf, bool in_place)
+    {
+    const unsigned int N = 2000;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(8.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setInPlacePermutation(in_place);
+
+    // random positions, so that the particles start out of order, and distinct data for every tag
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<Scalar> uniform(Scalar(-4.0), Scalar(4.0));
+    for (unsigned int tag = 0; tag < N; ++tag)
+        {
+        pdata->setPosition(tag, make_scalar3(uniform(rng), uniform(rng), uniform(rng)));
+        pdata->setVelocity(tag, make_scalar3(Scalar(tag), Scalar(2*tag), Scalar(3*tag)));
+        pdata->setMass(tag, Scalar(1.0) + Scalar(0.01)*tag);
+        pdata->setCharge(tag, Scalar(tag));
+        pdata->setDiameter(tag, Scalar(1.0) + Scalar(0.001)*tag);
+        }
+
+    std::vector<Scalar3> ref_pos(N);
+    for (unsigned int tag = 0; tag < N; ++tag)
+        ref_pos[tag] = pdata->getPosition(tag);
+
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setNominalWidth(Scalar(1.0));
+    cl->compute(0);
+
+    std::shared_ptr<SFCPackUpdater> sorter(new SFCPackUpdater(sysdef));
+    sorter->setCellList(cl);
+    sorter->setIncremental(true);
+
+    n_sorts = 0;
+    pdata->getParticleSortSignal().connect<&count_sort>();
+    sorter->update(0);
+    UP_ASSERT_EQUAL(n_sorts, (unsigned int)1);
+
+    // the particles of every cell are contiguous and keep their previous relative order, which was the tag order
+    std::set<unsigned int> done_cells;
+    unsigned int cur_cell = cell_of(pdata, cl, 0);
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int idx = 1; idx < N; ++idx)
+            {
+            unsigned int cell = cell_of(pdata, cl, idx);
+            if (cell == cur_cell)
+                {
+                UP_ASSERT(h_tag.data[idx] > h_tag.data[idx-1]);
+                }
+            else
+                {
+                done_cells.insert(cur_cell);
+                UP_ASSERT(done_cells.count(cell) == 0);
+                cur_cell = cell;
+                }
+            }
+        }
+
+    // all per-tag data moved with the particles
+    for (unsigned int tag = 0; tag < N; ++tag)
+        {
+        Scalar3 pos = pdata->getPosition(tag);
+        UP_ASSERT_EQUAL(pos.x, ref_pos[tag].x);
+        UP_ASSERT_EQUAL(pos.y, ref_pos[tag].y);
+        UP_ASSERT_EQUAL(pos.z, ref_pos[tag].z);
+        MY_CHECK_CLOSE(pdata->getVelocity(tag).y, Scalar(2*tag), tol);
+        MY_CHECK_CLOSE(pdata->getMass(tag), Scalar(1.0) + Scalar(0.01)*tag, tol);
+        MY_CHECK_CLOSE(pdata->getCharge(tag), Scalar(tag), tol);
+        MY_CHECK_CLOSE(pdata->getDiameter(tag), Scalar(1.0) + Scalar(0.001)*tag, tol);
+        }
+
+    // the particles are in order along the curve, so a second sort permutes nothing
+    std::vector<unsigned int> tags(N);
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        tags.assign(h_tag.data, h_tag.data + N);
+        }
+    sorter->update(1);
+    UP_ASSERT_EQUAL(n_sorts, (unsigned int)1);
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < N; ++idx)
+            UP_ASSERT_EQUAL(h_tag.data[idx], tags[idx]);
+        }
+    }
+
+//! Incremental sort with the alternate arrays
+UP_TEST( SFCPackUpdater_incremental )
+    {
+    sfcpack_incremental_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)), false);
+    }
+
+//! Incremental sort with in-place permutation
+UP_TEST( SFCPackUpdater_incremental_in_place )
+    {
+    sfcpack_incremental_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)), true);
+    }
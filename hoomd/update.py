@@ -236,6 +236,17 @@ class sort(_updater):
     Note:
         2D simulations do not use any additional memory and default to grid=4096.
 
+    With *incremental* sorting enabled in :py:meth:`set_params()`, the bins are the cells of the cell list
+    of the given neighbor list, ordered along a Hilbert curve, and the particles are put in order with a linear
+    time counting sort. Particles that are still in order are not moved. In MPI simulations, the sort is
+    performed during the next particle migration, which avoids the extra ghost exchanges of the full sort.
+    This makes it cheap to sort frequently. Incremental sorting is not supported on the GPU.
+
+    With *in_place* enabled in :py:meth:`set_params()`, the particle data does not keep a second copy of every
+    per-particle array for reordering. Sorts follow the cycles of the permutation and particles that leave the
+    domain are removed by compacting the arrays, which lowers the memory used per particle. In-place
+    permutation is not supported on the GPU.
+
     A sorter is created by default. To disable it or modify parameters, save the
     context and access the sorter through it::
 
@@ -262,14 +273,21 @@ class sort(_updater):
 
         self.setupUpdater(default_period);
 
-    def set_params(self, grid=None):
+    def set_params(self, grid=None, incremental=None, nlist=None, in_place=None):
         R""" Change sorter parameters.
 
         Args:
             grid (int): New grid dimension (if set)
+            incremental (bool): Enable or disable incremental sorting (if set)
+            nlist (:py:mod:`hoomd.md.nlist`): Neighbor list whose cell list provides the bins of the incremental sort (if set)
+            in_place (bool): Enable or disable in-place permutation of the particle data (if set)
+
+        Without *nlist*, the incremental sort uses the fixed grid.
 
         Examples::
             sorter.set_params(grid=128)
+            sorter.set_params(incremental=True, nlist=nl)
+            sorter.set_params(in_place=True)
         """
 
         hoomd.util.print_status_line();
@@ -278,6 +296,24 @@ class sort(_updater):
         if grid is not None:
             self.cpp_updater.setGrid(grid);
 
+        if incremental is not None:
+            if incremental and hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.error("update.sort: incremental sorting is not supported on the GPU\n");
+                raise RuntimeError("Error setting sorter parameters");
+            self.cpp_updater.setIncremental(incremental);
+
+        if nlist is not None:
+            if not hasattr(nlist, 'cpp_cl'):
+                hoomd.context.msg.error("update.sort: the neighbor list does not use a cell list\n");
+                raise RuntimeError("Error setting sorter parameters");
+            self.cpp_updater.setCellList(nlist.cpp_cl);
+
+        if in_place is not None:
+            if in_place and hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.error("update.sort: in-place permutation is not supported on the GPU\n");
+                raise RuntimeError("Error setting sorter parameters");
+            hoomd.context.current.system_definition.getParticleData().setInPlacePermutation(in_place);
+
 class box_resize(_updater):
     R""" Rescale the system box size.
 